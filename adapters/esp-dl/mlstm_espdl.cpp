@@ -17,46 +17,22 @@
 
 #include "mlstm_espdl.hpp"
 
-#include <cstring>
+#include "esp_log.h"
 
 namespace dl {
 namespace module {
 
+static const char* TAG = "MLSTM";
+
 MLSTM::MLSTM(const char* name, int hidden_size, int input_size,
               module_inplace_t inplace, quant_type_t quant_type)
     : Module(name, inplace, quant_type),
       m_hidden_size(hidden_size),
       m_input_size(input_size),
-      m_y(nullptr), m_C(nullptr), m_n(nullptr), m_m(nullptr),
-      m_scratch(nullptr), m_initialized(false)
+      m_cell(input_size, hidden_size, 1)
 {
 }
 
-MLSTM::~MLSTM() {
-    free_states();
-}
-
-void MLSTM::init_states() {
-    if (m_initialized) return;
-    int H = m_hidden_size;
-    m_y       = new float[H]();
-    m_C       = new float[H * H]();
-    m_n       = new float[H]();
-    m_m       = new float[1]();
-    m_scratch = new float[4 * H + 2]();
-    m_initialized = true;
-}
-
-void MLSTM::free_states() {
-    delete[] m_y;
-    delete[] m_C;
-    delete[] m_n;
-    delete[] m_m;
-    delete[] m_scratch;
-    m_y = m_C = m_n = m_m = m_scratch = nullptr;
-    m_initialized = false;
-}
-
 std::vector<std::vector<int>> MLSTM::get_output_shape(
     std::vector<std::vector<int>>& input_shapes)
 {
@@ -78,19 +54,24 @@ void MLSTM::forward(std::vector<dl::TensorBase*>& tensors, runtime_mode_t mode)
     int time_steps  = (x_shape.size() == 3) ? x_shape[1] : x_shape[0];
     int input_size  = x_shape.back();
 
-    init_states();
-
-    MlstmParams params = {0.0f};
+    // States are per batch element: resize only when the shape changes
+    if (batch_size != m_cell.batch_size() || input_size != m_cell.input_size()) {
+        m_cell = xlstm::MlstmSession<float>(input_size, m_hidden_size, batch_size);
+    }
 
-    mlstm_eval_f32(
-        input_x->get_element_ptr<float>(),
-        input_W->get_element_ptr<float>(),
-        input_b->get_element_ptr<float>(),
-        m_y, m_C, m_n, m_m,
-        output->get_element_ptr<float>(),
-        m_scratch,
-        batch_size, time_steps, input_size, m_hidden_size,
-        &params);
+    xlstm::MlstmWeights<float> weights{
+        {input_W->get_element_ptr<float>(), (size_t)input_W->get_size()},
+        {},
+        {input_b->get_element_ptr<float>(), (size_t)input_b->get_size()},
+    };
+    int status = m_cell.eval(
+        weights,
+        {input_x->get_element_ptr<float>(), (size_t)input_x->get_size()},
+        {output->get_element_ptr<float>(), (size_t)output->get_size()},
+        time_steps);
+    if (status != XLSTM_OK) {
+        ESP_LOGE(TAG, "eval failed (%d)", status);
+    }
 }
 
 }  // namespace module
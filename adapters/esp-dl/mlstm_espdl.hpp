@@ -18,6 +18,8 @@
  *   [0] X[B,T,I]  [1] W[4H+2,I]  [2] b[4H+2]  [3] output[B,T,H]
  *
  * States (y, C, n, m) are owned by the module and persist across calls.
+ * They live in an xlstm::MlstmSession sized for the batch of the last
+ * forward(), reallocated only when the batch or input size changes.
  * ===========================================================================*/
 
 #ifndef MLSTM_ESPDL_HPP_
@@ -25,9 +27,7 @@
 
 #include "dl_module_base.hpp"
 
-extern "C" {
-#include "mlstm.h"
-}
+#include "xlstm.hpp"
 
 namespace dl {
 namespace module {
@@ -43,8 +43,6 @@ public:
            module_inplace_t inplace = MODULE_NON_INPLACE,
            quant_type_t quant_type = QUANT_TYPE_NONE);
 
-    ~MLSTM();
-
     std::vector<std::vector<int>> get_output_shape(
         std::vector<std::vector<int>>& input_shapes) override;
 
@@ -52,15 +50,7 @@ public:
                  runtime_mode_t mode = RUNTIME_MODE_AUTO) override;
 
 private:
-    float* m_y;
-    float* m_C;       /* [H*H] matrix cell state */
-    float* m_n;
-    float* m_m;       /* [1] scalar stabilizer */
-    float* m_scratch;
-    bool m_initialized;
-
-    void init_states();
-    void free_states();
+    xlstm::MlstmSession<float> m_cell;
 };
 
 }  // namespace module
@@ -18,6 +18,8 @@
  *   [0] X[B,T,I]  [1] W[4H,I]  [2] R[4H,H]  [3] b[4H]  [4] output[B,T,H]
  *
  * States (y, c, n, m) are owned by the module and persist across calls.
+ * They live in an xlstm::SlstmSession sized for the batch of the last
+ * forward(), reallocated only when the batch or input size changes.
  * ===========================================================================*/
 
 #ifndef SLSTM_ESPDL_HPP_
@@ -25,9 +27,7 @@
 
 #include "dl_module_base.hpp"
 
-extern "C" {
-#include "slstm.h"
-}
+#include "xlstm.hpp"
 
 namespace dl {
 namespace module {
@@ -43,8 +43,6 @@ public:
            module_inplace_t inplace = MODULE_NON_INPLACE,
            quant_type_t quant_type = QUANT_TYPE_NONE);
 
-    ~SLSTM();
-
     std::vector<std::vector<int>> get_output_shape(
         std::vector<std::vector<int>>& input_shapes) override;
 
@@ -52,15 +50,7 @@ public:
                  runtime_mode_t mode = RUNTIME_MODE_AUTO) override;
 
 private:
-    float* m_y;
-    float* m_c;
-    float* m_n;
-    float* m_m;
-    float* m_scratch;
-    bool m_initialized;
-
-    void init_states();
-    void free_states();
+    xlstm::SlstmSession<float> m_cell;
 };
 
 }  // namespace module
@@ -54,7 +54,7 @@ int32_t xlstm_tvm_mlstm_eval(
     /* Scratch buffer on stack */
     float scratch[4 * hidden_size + 2];
 
-    MlstmParams params = {0.0f};
+    MlstmParams params = {0.0f, 0};
 
     mlstm_eval_f32(
         dl_float_ptr(x),
@@ -55,7 +55,7 @@ int32_t xlstm_tvm_slstm_eval(
     /* Scratch buffer on stack (fine for small H on MCU) */
     float scratch[4 * hidden_size];
 
-    SlstmParams params = {0.0f};
+    SlstmParams params = {0.0f, 0};
 
     slstm_eval_f32(
         dl_float_ptr(x),
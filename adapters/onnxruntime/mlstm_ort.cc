@@ -18,9 +18,10 @@
 #include "mlstm_ort.h"
 #include "mlstm.h"
 
-#include <cstring>
+MLstmOrtKernel::MLstmOrtKernel(const OrtApi*, const OrtKernelInfo*) {}
 
-void MLstmOrtKernel(
+void MLstmOrtKernel::Compute(
+    OrtKernelContext* context,
     const Ort::Custom::Tensor<float>& x,
     const Ort::Custom::Tensor<float>& W,
     const Ort::Custom::Tensor<float>& b,
@@ -51,21 +52,27 @@ void MLstmOrtKernel(
     float* n_data   = n_out.Allocate(y_shape);
     float* m_data   = m_out.Allocate(m_shape);
 
-    // Copy initial states into mutable outputs
-    std::memcpy(y_data, y_init.Data(), batch_size * hidden_size * sizeof(float));
-    std::memcpy(C_data, C_init.Data(), batch_size * hidden_size * hidden_size * sizeof(float));
-    std::memcpy(n_data, n_init.Data(), batch_size * hidden_size * sizeof(float));
-    std::memcpy(m_data, m_init.Data(), batch_size * 1 * sizeof(float));
+    // Seed state outputs from the inputs (no-op when IOBinding aliases them)
+    CopyState(y_data, y_init.Data(), batch_size * hidden_size);
+    CopyState(C_data, C_init.Data(), batch_size * hidden_size * hidden_size);
+    CopyState(n_data, n_init.Data(), batch_size * hidden_size);
+    CopyState(m_data, m_init.Data(), batch_size * 1);
 
-    // Scratch buffer for gate pre-activations
-    std::vector<float> scratch(4 * hidden_size + 2);
+    MlstmParams params = {0.0f, 0};
 
-    MlstmParams params = {0.0f};
-
-    mlstm_eval_f32(
-        x.Data(), W.Data(), b.Data(),
-        y_data, C_data, n_data, m_data,
-        out_data, scratch.data(),
-        batch_size, time_steps, input_size, hidden_size,
-        &params);
+    // Batch elements are independent: spread them over ORT's intra-op
+    // thread pool, each with its own slice of the cached gate scratch
+    const size_t gates = 4 * hidden_size + 2;
+    const size_t c_len = static_cast<size_t>(hidden_size * hidden_size);
+    scratch_.With(batch_size * gates, [&](float* scratch) {
+        ParallelForBatch(context, batch_size, [&](size_t bt) {
+            mlstm_eval_f32(
+                x.Data() + bt * time_steps * input_size, W.Data(), b.Data(),
+                y_data + bt * hidden_size, C_data + bt * c_len,
+                n_data + bt * hidden_size, m_data + bt,
+                out_data + bt * time_steps * hidden_size, scratch + bt * gates,
+                1, time_steps, input_size, hidden_size,
+                &params);
+        });
+    });
 }
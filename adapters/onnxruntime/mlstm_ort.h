@@ -12,11 +12,15 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  * =========================================================================
- * mLSTM ONNX Runtime custom op — lite API.
+ * mLSTM ONNX Runtime custom op — lite API struct kernel.
  *
  * Inputs:  X[B,T,I], W[4H+2,I], b[4H+2],
  *          y_init[B,H], C_init[B,H*H], n_init[B,H], m_init[B,1]
  * Outputs: output[B,T,H], y[B,H], C[B,H*H], n[B,H], m[B,1]
+ *
+ * Gate scratch is cached per kernel instance. Binding a state output to the
+ * same OrtValue as its *_init input (IOBinding) updates the state in place
+ * without copying; see xlstm_ort_util.h.
  * ===========================================================================*/
 
 #ifndef MLSTM_ORT_H_
@@ -26,19 +30,28 @@
 #include "onnxruntime_cxx_api.h"
 #undef ORT_API_MANUAL_INIT
 #include "onnxruntime_lite_custom_op.h"
+#include "xlstm_ort_util.h"
+
+struct MLstmOrtKernel {
+    MLstmOrtKernel(const OrtApi* api, const OrtKernelInfo* info);
+
+    void Compute(
+        OrtKernelContext* context,
+        const Ort::Custom::Tensor<float>& x,
+        const Ort::Custom::Tensor<float>& W,
+        const Ort::Custom::Tensor<float>& b,
+        const Ort::Custom::Tensor<float>& y_init,
+        const Ort::Custom::Tensor<float>& C_init,
+        const Ort::Custom::Tensor<float>& n_init,
+        const Ort::Custom::Tensor<float>& m_init,
+        Ort::Custom::Tensor<float>& output,
+        Ort::Custom::Tensor<float>& y_out,
+        Ort::Custom::Tensor<float>& C_out,
+        Ort::Custom::Tensor<float>& n_out,
+        Ort::Custom::Tensor<float>& m_out);
 
-void MLstmOrtKernel(
-    const Ort::Custom::Tensor<float>& x,
-    const Ort::Custom::Tensor<float>& W,
-    const Ort::Custom::Tensor<float>& b,
-    const Ort::Custom::Tensor<float>& y_init,
-    const Ort::Custom::Tensor<float>& C_init,
-    const Ort::Custom::Tensor<float>& n_init,
-    const Ort::Custom::Tensor<float>& m_init,
-    Ort::Custom::Tensor<float>& output,
-    Ort::Custom::Tensor<float>& y_out,
-    Ort::Custom::Tensor<float>& C_out,
-    Ort::Custom::Tensor<float>& n_out,
-    Ort::Custom::Tensor<float>& m_out);
+  private:
+    ScratchCache<float> scratch_;
+};
 
 #endif /* MLSTM_ORT_H_ */
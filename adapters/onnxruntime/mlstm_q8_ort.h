@@ -0,0 +1,69 @@
+/* Copyright 2026 RAWS labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * =========================================================================
+ * mLSTM INT8 ONNX Runtime custom op (QLinearMLSTM) — lite API struct kernel.
+ *
+ * Same conventions as QLinearSLSTM; no recurrent weights, C is [B,H*H]
+ * INT16 and m one float per batch element.
+ *
+ * Inputs:  X[B,T,I] int8, x_scale, x_zero_point int8,
+ *          W[4H+2,I] int8, W_scale, b[4H+2] int32,
+ *          y_scale, y_zero_point int8, C_scale, n_scale,
+ *          y_init[B,H] int8, C_init[B,H*H] int16, n_init[B,H] int16,
+ *          m_init[B,1] float
+ * Outputs: output[B,T,H] int8, y[B,H] int8, C[B,H*H] int16, n[B,H] int16,
+ *          m[B,1] float
+ * ===========================================================================*/
+
+#ifndef MLSTM_Q8_ORT_H_
+#define MLSTM_Q8_ORT_H_
+
+#define ORT_API_MANUAL_INIT
+#include "onnxruntime_cxx_api.h"
+#undef ORT_API_MANUAL_INIT
+#include "onnxruntime_lite_custom_op.h"
+#include "xlstm_ort_util.h"
+
+#include <cstdint>
+
+struct MLstmS8OrtKernel {
+    MLstmS8OrtKernel(const OrtApi* api, const OrtKernelInfo* info);
+
+    void Compute(
+        OrtKernelContext* context,
+        const Ort::Custom::Tensor<int8_t>& x,
+        const Ort::Custom::Tensor<float>& x_scale,
+        const Ort::Custom::Tensor<int8_t>& x_zero_point,
+        const Ort::Custom::Tensor<int8_t>& W,
+        const Ort::Custom::Tensor<float>& W_scale,
+        const Ort::Custom::Tensor<int32_t>& b,
+        const Ort::Custom::Tensor<float>& y_scale,
+        const Ort::Custom::Tensor<int8_t>& y_zero_point,
+        const Ort::Custom::Tensor<float>& C_scale,
+        const Ort::Custom::Tensor<float>& n_scale,
+        const Ort::Custom::Tensor<int8_t>& y_init,
+        const Ort::Custom::Tensor<int16_t>& C_init,
+        const Ort::Custom::Tensor<int16_t>& n_init,
+        const Ort::Custom::Tensor<float>& m_init,
+        Ort::Custom::Tensor<int8_t>& output,
+        Ort::Custom::Tensor<int8_t>& y_out,
+        Ort::Custom::Tensor<int16_t>& C_out,
+        Ort::Custom::Tensor<int16_t>& n_out,
+        Ort::Custom::Tensor<float>& m_out);
+
+  private:
+    ScratchCache<int32_t> scratch_;
+};
+
+#endif /* MLSTM_Q8_ORT_H_ */
@@ -18,9 +18,10 @@
 #include "slstm_ort.h"
 #include "slstm.h"
 
-#include <cstring>
+SLstmOrtKernel::SLstmOrtKernel(const OrtApi*, const OrtKernelInfo*) {}
 
-void SLstmOrtKernel(
+void SLstmOrtKernel::Compute(
+    OrtKernelContext* context,
     const Ort::Custom::Tensor<float>& x,
     const Ort::Custom::Tensor<float>& W,
     const Ort::Custom::Tensor<float>& R,
@@ -50,21 +51,79 @@ void SLstmOrtKernel(
     float* n_data   = n_out.Allocate(y_shape);
     float* m_data   = m_out.Allocate(y_shape);
 
-    // Copy initial states into mutable outputs
-    std::memcpy(y_data, y_init.Data(), batch_size * hidden_size * sizeof(float));
-    std::memcpy(c_data, c_init.Data(), batch_size * hidden_size * sizeof(float));
-    std::memcpy(n_data, n_init.Data(), batch_size * hidden_size * sizeof(float));
-    std::memcpy(m_data, m_init.Data(), batch_size * hidden_size * sizeof(float));
+    // Seed state outputs from the inputs (no-op when IOBinding aliases them)
+    CopyState(y_data, y_init.Data(), batch_size * hidden_size);
+    CopyState(c_data, c_init.Data(), batch_size * hidden_size);
+    CopyState(n_data, n_init.Data(), batch_size * hidden_size);
+    CopyState(m_data, m_init.Data(), batch_size * hidden_size);
 
-    // Scratch buffer for gate pre-activations
-    std::vector<float> scratch(4 * hidden_size);
+    SlstmParams params = {0.0f, 0};
 
-    SlstmParams params = {0.0f};
+    // Batch elements are independent: spread them over ORT's intra-op
+    // thread pool, each with its own slice of the cached gate scratch
+    const size_t gates = 4 * hidden_size;
+    scratch_.With(batch_size * gates, [&](float* scratch) {
+        ParallelForBatch(context, batch_size, [&](size_t bt) {
+            slstm_eval_f32(
+                x.Data() + bt * time_steps * input_size, W.Data(), R.Data(), b.Data(),
+                y_data + bt * hidden_size, c_data + bt * hidden_size,
+                n_data + bt * hidden_size, m_data + bt * hidden_size,
+                out_data + bt * time_steps * hidden_size, scratch + bt * gates,
+                1, time_steps, input_size, hidden_size,
+                &params);
+        });
+    });
+}
+
+SLstmPreactOrtKernel::SLstmPreactOrtKernel(const OrtApi*, const OrtKernelInfo*) {}
+
+void SLstmPreactOrtKernel::Compute(
+    OrtKernelContext* context,
+    const Ort::Custom::Tensor<float>& gx,
+    const Ort::Custom::Tensor<float>& R,
+    const Ort::Custom::Tensor<float>& y_init,
+    const Ort::Custom::Tensor<float>& c_init,
+    const Ort::Custom::Tensor<float>& n_init,
+    const Ort::Custom::Tensor<float>& m_init,
+    Ort::Custom::Tensor<float>& output,
+    Ort::Custom::Tensor<float>& y_out,
+    Ort::Custom::Tensor<float>& c_out,
+    Ort::Custom::Tensor<float>& n_out,
+    Ort::Custom::Tensor<float>& m_out)
+{
+    auto gx_shape = gx.Shape();
+    auto y_shape = y_init.Shape();
+
+    int batch_size  = static_cast<int>(gx_shape[0]);
+    int time_steps  = static_cast<int>(gx_shape[1]);
+    int hidden_size = static_cast<int>(y_shape[1]);
+
+    // Allocate outputs
+    float* out_data = output.Allocate({gx_shape[0], gx_shape[1], y_shape[1]});
+    float* y_data   = y_out.Allocate(y_shape);
+    float* c_data   = c_out.Allocate(y_shape);
+    float* n_data   = n_out.Allocate(y_shape);
+    float* m_data   = m_out.Allocate(y_shape);
+
+    // Seed state outputs from the inputs (no-op when IOBinding aliases them)
+    CopyState(y_data, y_init.Data(), batch_size * hidden_size);
+    CopyState(c_data, c_init.Data(), batch_size * hidden_size);
+    CopyState(n_data, n_init.Data(), batch_size * hidden_size);
+    CopyState(m_data, m_init.Data(), batch_size * hidden_size);
+
+    SlstmParams params = {0.0f, 0};
 
-    slstm_eval_f32(
-        x.Data(), W.Data(), R.Data(), b.Data(),
-        y_data, c_data, n_data, m_data,
-        out_data, scratch.data(),
-        batch_size, time_steps, input_size, hidden_size,
-        &params);
+    // One task per batch element on the intra-op thread pool, as in SLSTM
+    const size_t gates = 4 * hidden_size;
+    scratch_.With(batch_size * gates, [&](float* scratch) {
+        ParallelForBatch(context, batch_size, [&](size_t bt) {
+            slstm_eval_preact_f32(
+                gx.Data() + bt * time_steps * gates, R.Data(),
+                y_data + bt * hidden_size, c_data + bt * hidden_size,
+                n_data + bt * hidden_size, m_data + bt * hidden_size,
+                out_data + bt * time_steps * hidden_size, scratch + bt * gates,
+                1, time_steps, hidden_size,
+                &params);
+        });
+    });
 }
@@ -12,11 +12,22 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  * =========================================================================
- * sLSTM ONNX Runtime custom op — lite API.
+ * sLSTM ONNX Runtime custom op — lite API struct kernel.
  *
  * Inputs:  X[B,T,I], W[4H,I], R[4H,H], b[4H],
  *          y_init[B,H], c_init[B,H], n_init[B,H], m_init[B,H]
  * Outputs: output[B,T,H], y[B,H], c[B,H], n[B,H], m[B,H]
+ *
+ * Gate scratch is cached per kernel instance. Binding a state output to the
+ * same OrtValue as its *_init input (IOBinding) updates the state in place
+ * without copying; see xlstm_ort_util.h.
+ *
+ * SLSTMPreact runs only the recurrence on precomputed input projections
+ * (slstm_eval_preact_f32), so W*x + b can be a graph MatMul + Add:
+ *
+ * Inputs:  Gx[B,T,4H], R[4H,H], y_init[B,H], c_init[B,H], n_init[B,H],
+ *          m_init[B,H]
+ * Outputs: output[B,T,H], y[B,H], c[B,H], n[B,H], m[B,H]
  * ===========================================================================*/
 
 #ifndef SLSTM_ORT_H_
@@ -26,20 +37,50 @@
 #include "onnxruntime_cxx_api.h"
 #undef ORT_API_MANUAL_INIT
 #include "onnxruntime_lite_custom_op.h"
+#include "xlstm_ort_util.h"
+
+struct SLstmOrtKernel {
+    SLstmOrtKernel(const OrtApi* api, const OrtKernelInfo* info);
+
+    void Compute(
+        OrtKernelContext* context,
+        const Ort::Custom::Tensor<float>& x,
+        const Ort::Custom::Tensor<float>& W,
+        const Ort::Custom::Tensor<float>& R,
+        const Ort::Custom::Tensor<float>& b,
+        const Ort::Custom::Tensor<float>& y_init,
+        const Ort::Custom::Tensor<float>& c_init,
+        const Ort::Custom::Tensor<float>& n_init,
+        const Ort::Custom::Tensor<float>& m_init,
+        Ort::Custom::Tensor<float>& output,
+        Ort::Custom::Tensor<float>& y_out,
+        Ort::Custom::Tensor<float>& c_out,
+        Ort::Custom::Tensor<float>& n_out,
+        Ort::Custom::Tensor<float>& m_out);
+
+  private:
+    ScratchCache<float> scratch_;
+};
+
+struct SLstmPreactOrtKernel {
+    SLstmPreactOrtKernel(const OrtApi* api, const OrtKernelInfo* info);
+
+    void Compute(
+        OrtKernelContext* context,
+        const Ort::Custom::Tensor<float>& gx,
+        const Ort::Custom::Tensor<float>& R,
+        const Ort::Custom::Tensor<float>& y_init,
+        const Ort::Custom::Tensor<float>& c_init,
+        const Ort::Custom::Tensor<float>& n_init,
+        const Ort::Custom::Tensor<float>& m_init,
+        Ort::Custom::Tensor<float>& output,
+        Ort::Custom::Tensor<float>& y_out,
+        Ort::Custom::Tensor<float>& c_out,
+        Ort::Custom::Tensor<float>& n_out,
+        Ort::Custom::Tensor<float>& m_out);
 
-void SLstmOrtKernel(
-    const Ort::Custom::Tensor<float>& x,
-    const Ort::Custom::Tensor<float>& W,
-    const Ort::Custom::Tensor<float>& R,
-    const Ort::Custom::Tensor<float>& b,
-    const Ort::Custom::Tensor<float>& y_init,
-    const Ort::Custom::Tensor<float>& c_init,
-    const Ort::Custom::Tensor<float>& n_init,
-    const Ort::Custom::Tensor<float>& m_init,
-    Ort::Custom::Tensor<float>& output,
-    Ort::Custom::Tensor<float>& y_out,
-    Ort::Custom::Tensor<float>& c_out,
-    Ort::Custom::Tensor<float>& n_out,
-    Ort::Custom::Tensor<float>& m_out);
+  private:
+    ScratchCache<float> scratch_;
+};
 
 #endif /* SLSTM_ORT_H_ */
@@ -0,0 +1,95 @@
+/* Copyright 2026 RAWS labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * =========================================================================
+ * sLSTM INT8 ONNX Runtime custom op — unpacks ORT tensors and calls core.
+ * ===========================================================================*/
+
+#include "slstm_q8_ort.h"
+#include "slstm_q8.h"
+
+SLstmS8OrtKernel::SLstmS8OrtKernel(const OrtApi*, const OrtKernelInfo*) {}
+
+void SLstmS8OrtKernel::Compute(
+    OrtKernelContext* context,
+    const Ort::Custom::Tensor<int8_t>& x,
+    const Ort::Custom::Tensor<float>& x_scale,
+    const Ort::Custom::Tensor<int8_t>& x_zero_point,
+    const Ort::Custom::Tensor<int8_t>& W,
+    const Ort::Custom::Tensor<float>& W_scale,
+    const Ort::Custom::Tensor<int8_t>& R,
+    const Ort::Custom::Tensor<float>& R_scale,
+    const Ort::Custom::Tensor<int32_t>& b,
+    const Ort::Custom::Tensor<float>& y_scale,
+    const Ort::Custom::Tensor<int8_t>& y_zero_point,
+    const Ort::Custom::Tensor<float>& c_scale,
+    const Ort::Custom::Tensor<float>& n_scale,
+    const Ort::Custom::Tensor<int8_t>& y_init,
+    const Ort::Custom::Tensor<int16_t>& c_init,
+    const Ort::Custom::Tensor<int16_t>& n_init,
+    const Ort::Custom::Tensor<float>& m_init,
+    Ort::Custom::Tensor<int8_t>& output,
+    Ort::Custom::Tensor<int8_t>& y_out,
+    Ort::Custom::Tensor<int16_t>& c_out,
+    Ort::Custom::Tensor<int16_t>& n_out,
+    Ort::Custom::Tensor<float>& m_out)
+{
+    auto x_shape = x.Shape();
+    auto y_shape = y_init.Shape();
+
+    int batch_size  = static_cast<int>(x_shape[0]);
+    int time_steps  = static_cast<int>(x_shape[1]);
+    int input_size  = static_cast<int>(x_shape[2]);
+    int hidden_size = static_cast<int>(y_shape[1]);
+    size_t state_len = static_cast<size_t>(batch_size) * hidden_size;
+
+    // Allocate outputs
+    int8_t* out_data  = output.Allocate({x_shape[0], x_shape[1], y_shape[1]});
+    int8_t* y_data    = y_out.Allocate(y_shape);
+    int16_t* c_data   = c_out.Allocate(y_shape);
+    int16_t* n_data   = n_out.Allocate(y_shape);
+    float* m_data     = m_out.Allocate(y_shape);
+
+    // Seed state outputs from the inputs (no-op when IOBinding aliases them)
+    CopyState(y_data, y_init.Data(), state_len);
+    CopyState(c_data, c_init.Data(), state_len);
+    CopyState(n_data, n_init.Data(), state_len);
+    CopyState(m_data, m_init.Data(), state_len);
+
+    // Scalar quantization inputs; INT16 states are symmetric (zero point 0)
+    SlstmS8Params params = {};
+    params.W_scale = W_scale.Data()[0];
+    params.R_scale = R_scale.Data()[0];
+    params.x_quant.scale = x_scale.Data()[0];
+    params.x_quant.zero_point = x_zero_point.Data()[0];
+    params.y_quant.scale = y_scale.Data()[0];
+    params.y_quant.zero_point = y_zero_point.Data()[0];
+    params.c_quant.scale = c_scale.Data()[0];
+    params.n_quant.scale = n_scale.Data()[0];
+    params.stats = nullptr;
+
+    // Batch elements are independent: spread them over ORT's intra-op
+    // thread pool, each with its own slice of the cached gate scratch
+    const size_t gates = 4 * hidden_size;
+    scratch_.With(batch_size * gates, [&](int32_t* scratch) {
+        ParallelForBatch(context, batch_size, [&](size_t bt) {
+            slstm_eval_s8(
+                x.Data() + bt * time_steps * input_size, W.Data(), R.Data(), b.Data(),
+                y_data + bt * hidden_size, c_data + bt * hidden_size,
+                n_data + bt * hidden_size, m_data + bt * hidden_size,
+                out_data + bt * time_steps * hidden_size, scratch + bt * gates,
+                1, time_steps, input_size, hidden_size,
+                &params);
+        });
+    });
+}
@@ -0,0 +1,74 @@
+/* Copyright 2026 RAWS labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * =========================================================================
+ * sLSTM INT8 ONNX Runtime custom op (QLinearSLSTM) — lite API struct kernel.
+ *
+ * QLinear-style: each quantized tensor is followed by its scale (and, for
+ * INT8 activations, its zero point) as scalar inputs. Weights are symmetric
+ * INT8, bias INT32 at scale W_scale * x_scale, c/n symmetric INT16, m float.
+ *
+ * Inputs:  X[B,T,I] int8, x_scale, x_zero_point int8,
+ *          W[4H,I] int8, W_scale, R[4H,H] int8, R_scale, b[4H] int32,
+ *          y_scale, y_zero_point int8, c_scale, n_scale,
+ *          y_init[B,H] int8, c_init[B,H] int16, n_init[B,H] int16,
+ *          m_init[B,H] float
+ * Outputs: output[B,T,H] int8, y[B,H] int8, c[B,H] int16, n[B,H] int16,
+ *          m[B,H] float
+ *
+ * Scratch caching and in-place state updates as for SLSTM.
+ * ===========================================================================*/
+
+#ifndef SLSTM_Q8_ORT_H_
+#define SLSTM_Q8_ORT_H_
+
+#define ORT_API_MANUAL_INIT
+#include "onnxruntime_cxx_api.h"
+#undef ORT_API_MANUAL_INIT
+#include "onnxruntime_lite_custom_op.h"
+#include "xlstm_ort_util.h"
+
+#include <cstdint>
+
+struct SLstmS8OrtKernel {
+    SLstmS8OrtKernel(const OrtApi* api, const OrtKernelInfo* info);
+
+    void Compute(
+        OrtKernelContext* context,
+        const Ort::Custom::Tensor<int8_t>& x,
+        const Ort::Custom::Tensor<float>& x_scale,
+        const Ort::Custom::Tensor<int8_t>& x_zero_point,
+        const Ort::Custom::Tensor<int8_t>& W,
+        const Ort::Custom::Tensor<float>& W_scale,
+        const Ort::Custom::Tensor<int8_t>& R,
+        const Ort::Custom::Tensor<float>& R_scale,
+        const Ort::Custom::Tensor<int32_t>& b,
+        const Ort::Custom::Tensor<float>& y_scale,
+        const Ort::Custom::Tensor<int8_t>& y_zero_point,
+        const Ort::Custom::Tensor<float>& c_scale,
+        const Ort::Custom::Tensor<float>& n_scale,
+        const Ort::Custom::Tensor<int8_t>& y_init,
+        const Ort::Custom::Tensor<int16_t>& c_init,
+        const Ort::Custom::Tensor<int16_t>& n_init,
+        const Ort::Custom::Tensor<float>& m_init,
+        Ort::Custom::Tensor<int8_t>& output,
+        Ort::Custom::Tensor<int8_t>& y_out,
+        Ort::Custom::Tensor<int16_t>& c_out,
+        Ort::Custom::Tensor<int16_t>& n_out,
+        Ort::Custom::Tensor<float>& m_out);
+
+  private:
+    ScratchCache<int32_t> scratch_;
+};
+
+#endif /* SLSTM_Q8_ORT_H_ */
@@ -12,11 +12,13 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  * =========================================================================
- * ONNX Runtime shared library entry point — registers sLSTM + mLSTM ops.
+ * ONNX Runtime shared library entry point — registers sLSTM + mLSTM ops,
+ * float and INT8 (QLinearSLSTM / QLinearMLSTM).
  *
  * Build as shared library:
  *   g++ -std=c++17 -shared -fPIC -o libxlstm_ort.so \
  *       adapters/onnxruntime/*.cc src/slstm.c src/mlstm.c \
+ *       src/slstm_q8.c src/mlstm_q8.c \
  *       -Iinclude -Iadapters/onnxruntime -I<onnxruntime>/include -lm
  *
  * Load in consumer:
@@ -25,6 +27,8 @@
 
 #include "slstm_ort.h"
 #include "mlstm_ort.h"
+#include "slstm_q8_ort.h"
+#include "mlstm_q8_ort.h"
 
 #include <memory>
 #include <mutex>
@@ -50,17 +54,35 @@ extern "C" OrtStatus* ORT_API_CALL RegisterCustomOps(
     using Ort::Custom::OrtLiteCustomOp;
 
     static std::unique_ptr<OrtLiteCustomOp> slstm_op{
-        Ort::Custom::CreateLiteCustomOp(
-            "SLSTM", "CPUExecutionProvider", SLstmOrtKernel)
+        Ort::Custom::CreateLiteCustomOp<SLstmOrtKernel>(
+            "SLSTM", "CPUExecutionProvider")
     };
     domain.Add(slstm_op.get());
 
+    static std::unique_ptr<OrtLiteCustomOp> slstm_preact_op{
+        Ort::Custom::CreateLiteCustomOp<SLstmPreactOrtKernel>(
+            "SLSTMPreact", "CPUExecutionProvider")
+    };
+    domain.Add(slstm_preact_op.get());
+
     static std::unique_ptr<OrtLiteCustomOp> mlstm_op{
-        Ort::Custom::CreateLiteCustomOp(
-            "MLSTM", "CPUExecutionProvider", MLstmOrtKernel)
+        Ort::Custom::CreateLiteCustomOp<MLstmOrtKernel>(
+            "MLSTM", "CPUExecutionProvider")
     };
     domain.Add(mlstm_op.get());
 
+    static std::unique_ptr<OrtLiteCustomOp> slstm_s8_op{
+        Ort::Custom::CreateLiteCustomOp<SLstmS8OrtKernel>(
+            "QLinearSLSTM", "CPUExecutionProvider")
+    };
+    domain.Add(slstm_s8_op.get());
+
+    static std::unique_ptr<OrtLiteCustomOp> mlstm_s8_op{
+        Ort::Custom::CreateLiteCustomOp<MLstmS8OrtKernel>(
+            "QLinearMLSTM", "CPUExecutionProvider")
+    };
+    domain.Add(mlstm_s8_op.get());
+
     Ort::UnownedSessionOptions session_options(options);
     session_options.Add(domain);
     KeepDomainAlive(std::move(domain));
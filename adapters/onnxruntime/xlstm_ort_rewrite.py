@@ -0,0 +1,93 @@
+#!/usr/bin/env python3
+"""Graph rewrite: move the sLSTM input projection onto ORT's MatMul.
+
+Every com.raws.xlstm::SLSTM node whose W and b are initializers becomes
+
+    MatMul(X, W^T) -> Add(b) -> SLSTMPreact(Gx, R, y_init, c_init, ...)
+
+so the [B*T, I] x [I, 4H] projection for the whole sequence runs as one
+MLAS GEMM and the custom op is left with only the recurrence. Outputs and
+state inputs are unchanged; W^T is stored as a new initializer and each
+rewritten node's original W is dropped unless another node, a subgraph
+(If/Loop/Scan body), a graph input or a graph output still references it.
+
+Usage:
+    python3 xlstm_ort_rewrite.py model.onnx model_preact.onnx
+"""
+
+import sys
+
+import numpy as np
+import onnx
+from onnx import helper, numpy_helper
+
+CUSTOM_DOMAIN = "com.raws.xlstm"
+
+
+def referenced_names(graph):
+    """Names used by the graph's nodes, nested subgraphs and outputs."""
+    names = {o.name for o in graph.output}
+    for node in graph.node:
+        names.update(node.input)
+        for attr in node.attribute:
+            if attr.type == onnx.AttributeProto.GRAPH:
+                names |= referenced_names(attr.g)
+            elif attr.type == onnx.AttributeProto.GRAPHS:
+                for sub in attr.graphs:
+                    names |= referenced_names(sub)
+    return names
+
+
+def use_preact_slstm(model):
+    """Rewrite SLSTM nodes in place; returns the number rewritten."""
+    graph = model.graph
+    inits = {t.name: t for t in graph.initializer}
+    nodes = []
+    replaced = set()
+    rewritten = 0
+
+    for node in graph.node:
+        if (node.domain != CUSTOM_DOMAIN or node.op_type != "SLSTM"
+                or node.input[1] not in inits or node.input[3] not in inits):
+            nodes.append(node)
+            continue
+
+        x, W, R, b = node.input[:4]
+        prefix = node.name or node.output[0]
+        W_t = np.ascontiguousarray(numpy_helper.to_array(inits[W]).T)
+        graph.initializer.append(numpy_helper.from_array(W_t, prefix + "_W_t"))
+
+        nodes.append(helper.make_node(
+            "MatMul", [x, prefix + "_W_t"], [prefix + "_xW"], name=prefix + "_proj"))
+        nodes.append(helper.make_node(
+            "Add", [prefix + "_xW", b], [prefix + "_gx"], name=prefix + "_bias"))
+        nodes.append(helper.make_node(
+            "SLSTMPreact", [prefix + "_gx", R] + list(node.input[4:]),
+            list(node.output), name=prefix, domain=CUSTOM_DOMAIN))
+        replaced.add(W)
+        rewritten += 1
+
+    del graph.node[:]
+    graph.node.extend(nodes)
+
+    # Drop the original W of rewritten nodes once nothing else uses it
+    used = referenced_names(graph) | {i.name for i in graph.input}
+    unused = [t for t in graph.initializer
+              if t.name in replaced and t.name not in used]
+    for t in unused:
+        graph.initializer.remove(t)
+    return rewritten
+
+
+def main():
+    if len(sys.argv) != 3:
+        print(f"usage: {sys.argv[0]} in.onnx out.onnx")
+        sys.exit(1)
+    model = onnx.load(sys.argv[1])
+    count = use_preact_slstm(model)
+    onnx.save(model, sys.argv[2])
+    print(f"rewrote {count} SLSTM node(s)")
+
+
+if __name__ == "__main__":
+    main()
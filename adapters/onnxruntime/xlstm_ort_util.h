@@ -0,0 +1,84 @@
+/* Copyright 2026 RAWS labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * =========================================================================
+ * Shared helpers for the ONNX Runtime struct kernels.
+ *
+ * ScratchCache keeps one kernel instance's gate scratch across Compute
+ * calls. ORT may run the same instance from several threads; a call that
+ * finds the cache busy falls back to a temporary buffer instead of waiting.
+ *
+ * CopyState seeds a state output from its *_init input. Bind the output to
+ * the same OrtValue as the input (IOBinding) and the two share a buffer: the
+ * copy is skipped and the kernel updates the state in place.
+ *
+ * ParallelForBatch runs one task per batch element on the session's
+ * intra-op thread pool (KernelContext::ParallelFor), so the ops scale with
+ * SessionOptions.intra_op_num_threads. Streams are independent; each task
+ * gets its own state, output and scratch slices.
+ * ===========================================================================*/
+
+#ifndef XLSTM_ORT_UTIL_H_
+#define XLSTM_ORT_UTIL_H_
+
+#define ORT_API_MANUAL_INIT
+#include "onnxruntime_cxx_api.h"
+#undef ORT_API_MANUAL_INIT
+
+#include <cstddef>
+#include <cstring>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+template <typename T>
+class ScratchCache {
+  public:
+    /* Run fn(T* scratch) with at least len elements of scratch */
+    template <typename Fn>
+    void With(size_t len, Fn&& fn) {
+        std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+        if (!lock.owns_lock()) {
+            std::vector<T> tmp(len);
+            fn(tmp.data());
+            return;
+        }
+        if (buf_.size() < len) buf_.resize(len);
+        fn(buf_.data());
+    }
+
+  private:
+    std::mutex mutex_;
+    std::vector<T> buf_;
+};
+
+template <typename T>
+inline void CopyState(T* dst, const T* src, size_t count) {
+    if (dst != src) std::memcpy(dst, src, count * sizeof(T));
+}
+
+/* Run fn(b) for b in [0, batch_size); inline for a single element */
+template <typename Fn>
+inline void ParallelForBatch(OrtKernelContext* context, int batch_size, Fn&& fn) {
+    using Task = std::remove_reference_t<Fn>;
+    if (batch_size <= 1) {
+        if (batch_size == 1) fn(size_t{0});
+        return;
+    }
+    Ort::KernelContext ctx(context);
+    ctx.ParallelFor(
+        [](void* data, size_t b) { (*static_cast<Task*>(data))(b); },
+        static_cast<size_t>(batch_size), 0, &fn);
+}
+
+#endif /* XLSTM_ORT_UTIL_H_ */
@@ -18,6 +18,7 @@
 #include "mlstm_tflm.h"
 
 #include "mlstm.h"
+#include "mlstm_q8.h"
 
 #include "tensorflow/lite/kernels/internal/tensor_ctypes.h"
 #include "tensorflow/lite/kernels/kernel_util.h"
@@ -32,6 +33,76 @@ void* MLstmInit(TfLiteContext* context, const char* buffer, size_t length) {
     return context->AllocatePersistentBuffer(context, sizeof(OpDataMLstm));
 }
 
+// INT8 graph: int8 X/W/y/output, int32 b, int16 C/n, float m. Reads the
+// per-tensor quantization into op_data->q8_params.
+TfLiteStatus MLstmPrepareInt8(TfLiteContext* context, TfLiteNode* node,
+                              OpDataMLstm* op_data) {
+    static const TfLiteType kInputTypes[kMLstmNumInputs] = {
+        kTfLiteInt8, kTfLiteInt8, kTfLiteInt32,
+        kTfLiteInt8, kTfLiteInt16, kTfLiteInt16, kTfLiteFloat32};
+    MicroContext* micro_context = GetMicroContext(context);
+    TfLiteTensor* tensors[kMLstmNumInputs];
+    TfLiteStatus status = kTfLiteOk;
+
+    for (int i = 0; i < kMLstmNumInputs; ++i) {
+        tensors[i] = micro_context->AllocateTempInputTensor(node, i);
+        TF_LITE_ENSURE(context, tensors[i] != nullptr);
+        if (tensors[i]->type != kInputTypes[i]) {
+            MicroPrintf("mLSTM int8: input %d is %s, expected %s.", i,
+                        TfLiteTypeGetName(tensors[i]->type),
+                        TfLiteTypeGetName(kInputTypes[i]));
+            status = kTfLiteError;
+        }
+    }
+    TfLiteTensor* output =
+        micro_context->AllocateTempOutputTensor(node, kMLstmOutputTensor);
+    TF_LITE_ENSURE(context, output != nullptr);
+    if (output->type != kTfLiteInt8 ||
+        output->params.scale != tensors[kMLstmHiddenStateTensor]->params.scale ||
+        output->params.zero_point != tensors[kMLstmHiddenStateTensor]->params.zero_point) {
+        MicroPrintf("mLSTM int8: output must be int8 quantized like y.");
+        status = kTfLiteError;
+    }
+
+    MlstmS8Params* q = &op_data->q8_params;
+    q->cell_clip = op_data->cell_clip;
+    q->W_scale = tensors[kMLstmInputWeightsTensor]->params.scale;
+    q->x_quant.scale = tensors[kMLstmInputTensor]->params.scale;
+    q->x_quant.zero_point = tensors[kMLstmInputTensor]->params.zero_point;
+    q->y_quant.scale = tensors[kMLstmHiddenStateTensor]->params.scale;
+    q->y_quant.zero_point = tensors[kMLstmHiddenStateTensor]->params.zero_point;
+    q->C_quant.scale = tensors[kMLstmCellStateTensor]->params.scale;
+    q->C_quant.zero_point = 0;
+    q->n_quant.scale = tensors[kMLstmNormalizerStateTensor]->params.scale;
+    q->n_quant.zero_point = 0;
+    q->stats = nullptr;
+    if (q->W_scale <= 0.0f || q->x_quant.scale <= 0.0f ||
+        q->y_quant.scale <= 0.0f || q->C_quant.scale <= 0.0f ||
+        q->n_quant.scale <= 0.0f) {
+        MicroPrintf("mLSTM int8: missing quantization scale.");
+        status = kTfLiteError;
+    }
+
+    op_data->packed = 0;
+#ifdef XLSTM_TFLM_PACK_WEIGHTS
+    if (status == kTfLiteOk && IsConstantTensor(tensors[kMLstmInputWeightsTensor])) {
+        void* buf = context->AllocatePersistentBuffer(
+            context, mlstm_pack_s8_size(op_data->input_size, op_data->hidden_size));
+        TF_LITE_ENSURE(context, buf != nullptr);
+        mlstm_pack_s8(GetTensorData<int8_t>(tensors[kMLstmInputWeightsTensor]),
+                      op_data->input_size, op_data->hidden_size, q, buf,
+                      &op_data->q8_packed);
+        op_data->packed = 1;
+    }
+#endif
+
+    for (int i = 0; i < kMLstmNumInputs; ++i) {
+        micro_context->DeallocateTempTfLiteTensor(tensors[i]);
+    }
+    micro_context->DeallocateTempTfLiteTensor(output);
+    return status;
+}
+
 TfLiteStatus MLstmPrepare(TfLiteContext* context, TfLiteNode* node) {
     TFLITE_DCHECK(node->user_data != nullptr);
     OpDataMLstm* op_data = static_cast<OpDataMLstm*>(node->user_data);
@@ -53,18 +124,37 @@ TfLiteStatus MLstmPrepare(TfLiteContext* context, TfLiteNode* node) {
     op_data->time_steps = input->dims->data[1];
     op_data->input_size = input->dims->data[2];
     op_data->hidden_size = hidden_state->dims->data[1];
+    TfLiteType input_type = input->type;
 
     micro_context->DeallocateTempTfLiteTensor(input);
     micro_context->DeallocateTempTfLiteTensor(hidden_state);
 
+    // y [B, H], C [B, H*H], n [B, H], m [B, 1]: graph inputs or variable
+    // tensors that the interpreter keeps across Invoke calls
+    const int B = op_data->batch_size, H = op_data->hidden_size;
+    const int state_sizes[] = {B * H, B * H * H, B * H, B};
+    for (int i = kMLstmHiddenStateTensor; i <= kMLstmStabilizerStateTensor; ++i) {
+        TfLiteTensor* state = micro_context->AllocateTempInputTensor(node, i);
+        TF_LITE_ENSURE(context, state != nullptr);
+        TF_LITE_ENSURE_EQ(context, NumElements(state),
+                          state_sizes[i - kMLstmHiddenStateTensor]);
+        micro_context->DeallocateTempTfLiteTensor(state);
+    }
+
     op_data->cell_clip = 0.0f;
 
-    // Scratch buffer: (4*H+2) floats for gate pre-activations
+    // Scratch buffer: (4*H+2) gate pre-activations, float or int32 accumulators
+    size_t gate_bytes = sizeof(float);
+    if (input_type == kTfLiteInt8) {
+        TF_LITE_ENSURE_OK(context, MLstmPrepareInt8(context, node, op_data));
+        gate_bytes = sizeof(int32_t);
+    }
+
     TF_LITE_ENSURE_OK(
         context,
         context->RequestScratchBufferInArena(
             context,
-            (4 * op_data->hidden_size + 2) * sizeof(float),
+            (4 * op_data->hidden_size + 2) * gate_bytes,
             &op_data->scratch_buffer_index));
 
     return kTfLiteOk;
@@ -98,6 +188,7 @@ TfLiteStatus MLstmEvalFloat(TfLiteContext* context, TfLiteNode* node,
     // Set up core params
     MlstmParams params;
     params.cell_clip = op_data->cell_clip;
+    params.flush_denormals = 0;
 
     // Call portable core
     mlstm_eval_f32(
@@ -129,6 +220,79 @@ TfLiteStatus MLstmEvalFloat(TfLiteContext* context, TfLiteNode* node,
     return kTfLiteOk;
 }
 
+TfLiteStatus MLstmEvalInt8(TfLiteContext* context, TfLiteNode* node,
+                           const OpDataMLstm* op_data) {
+    MicroContext* micro_context = GetMicroContext(context);
+
+    // Unpack tensors
+    TfLiteTensor* input =
+        micro_context->AllocateTempInputTensor(node, kMLstmInputTensor);
+    TfLiteTensor* input_weights =
+        micro_context->AllocateTempInputTensor(node, kMLstmInputWeightsTensor);
+    TfLiteTensor* bias =
+        micro_context->AllocateTempInputTensor(node, kMLstmBiasTensor);
+    TfLiteTensor* hidden_state =
+        micro_context->AllocateTempInputTensor(node, kMLstmHiddenStateTensor);
+    TfLiteTensor* cell_state =
+        micro_context->AllocateTempInputTensor(node, kMLstmCellStateTensor);
+    TfLiteTensor* normalizer_state =
+        micro_context->AllocateTempInputTensor(node, kMLstmNormalizerStateTensor);
+    TfLiteTensor* stabilizer_state =
+        micro_context->AllocateTempInputTensor(node, kMLstmStabilizerStateTensor);
+    TfLiteTensor* output =
+        micro_context->AllocateTempOutputTensor(node, kMLstmOutputTensor);
+
+    int32_t* scratch = static_cast<int32_t*>(
+        context->GetScratchBuffer(context, op_data->scratch_buffer_index));
+
+    // Call portable core with the params (and packed weights) from Prepare
+    if (op_data->packed) {
+        mlstm_eval_packed_s8(
+            GetTensorData<int8_t>(input),
+            &op_data->q8_packed,
+            GetTensorData<int32_t>(bias),
+            GetTensorData<int8_t>(hidden_state),
+            GetTensorData<int16_t>(cell_state),
+            GetTensorData<int16_t>(normalizer_state),
+            GetTensorData<float>(stabilizer_state),
+            GetTensorData<int8_t>(output),
+            scratch,
+            op_data->batch_size,
+            op_data->time_steps,
+            op_data->input_size,
+            op_data->hidden_size,
+            &op_data->q8_params);
+    } else {
+        mlstm_eval_s8(
+            GetTensorData<int8_t>(input),
+            GetTensorData<int8_t>(input_weights),
+            GetTensorData<int32_t>(bias),
+            GetTensorData<int8_t>(hidden_state),
+            GetTensorData<int16_t>(cell_state),
+            GetTensorData<int16_t>(normalizer_state),
+            GetTensorData<float>(stabilizer_state),
+            GetTensorData<int8_t>(output),
+            scratch,
+            op_data->batch_size,
+            op_data->time_steps,
+            op_data->input_size,
+            op_data->hidden_size,
+            &op_data->q8_params);
+    }
+
+    // Deallocate temp tensors
+    micro_context->DeallocateTempTfLiteTensor(input);
+    micro_context->DeallocateTempTfLiteTensor(input_weights);
+    micro_context->DeallocateTempTfLiteTensor(bias);
+    micro_context->DeallocateTempTfLiteTensor(hidden_state);
+    micro_context->DeallocateTempTfLiteTensor(cell_state);
+    micro_context->DeallocateTempTfLiteTensor(normalizer_state);
+    micro_context->DeallocateTempTfLiteTensor(stabilizer_state);
+    micro_context->DeallocateTempTfLiteTensor(output);
+
+    return kTfLiteOk;
+}
+
 TfLiteStatus MLstmEval(TfLiteContext* context, TfLiteNode* node) {
     TFLITE_DCHECK(node->user_data != nullptr);
     const OpDataMLstm* op_data =
@@ -143,6 +307,8 @@ TfLiteStatus MLstmEval(TfLiteContext* context, TfLiteNode* node) {
     switch (input_type) {
         case kTfLiteFloat32:
             return MLstmEvalFloat(context, node, op_data);
+        case kTfLiteInt8:
+            return MLstmEvalInt8(context, node, op_data);
         default:
             MicroPrintf("Type %s (%d) not supported for mLSTM.",
                         TfLiteTypeGetName(input_type), input_type);
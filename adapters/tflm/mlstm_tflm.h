@@ -21,12 +21,17 @@
 #include "tensorflow/lite/c/common.h"
 #include "tensorflow/lite/micro/micro_common.h"
 
+#include "mlstm_q8.h"
+
 namespace tflite {
 
 // Register mLSTM operator for TFLM
 TFLMRegistration Register_MLSTM();
 
 // Input tensor indices for mLSTM (no recurrent weights)
+// The state tensors (y onwards) are updated in place. Mark them is_variable
+// in the model to have the interpreter own them across Invoke calls; they
+// are then not graph inputs and ResetVariableTensors() zeroes them.
 enum MLstmTensorIndex {
     kMLstmInputTensor = 0,              // [batch, time, features]
     kMLstmInputWeightsTensor = 1,       // [(4*hidden+2), input]
@@ -46,7 +51,7 @@ enum MLstmOutputIndex {
 
 // OpData structure for scratch buffers and precomputed values
 struct OpDataMLstm {
-    int scratch_buffer_index;  // For gate computations [4*hidden+2]
+    int scratch_buffer_index;  // Gate pre-activations [4*hidden+2], float or int32
 
     int batch_size;
     int time_steps;
@@ -54,6 +59,15 @@ struct OpDataMLstm {
     int hidden_size;
 
     float cell_clip;
+
+    // kTfLiteInt8 only: scales / zero points read from the tensors in Prepare
+    MlstmS8Params q8_params;
+
+    // Built with XLSTM_TFLM_PACK_WEIGHTS and constant int8 W: Prepare puts
+    // the zero-point row corrections in a persistent arena buffer
+    // (mlstm_pack_s8); Eval reads them with W from the flatbuffer.
+    int packed;
+    MlstmS8Packed q8_packed;
 };
 
 }  // namespace tflite
@@ -18,6 +18,7 @@
 #include "slstm_tflm.h"
 
 #include "slstm.h"
+#include "slstm_q8.h"
 
 #include "tensorflow/lite/kernels/internal/tensor_ctypes.h"
 #include "tensorflow/lite/kernels/kernel_util.h"
@@ -32,6 +33,79 @@ void* SLstmInit(TfLiteContext* context, const char* buffer, size_t length) {
     return context->AllocatePersistentBuffer(context, sizeof(OpDataSLstm));
 }
 
+// INT8 graph: int8 X/W/R/y/output, int32 b, int16 c/n, float m. Reads the
+// per-tensor quantization into op_data->q8_params.
+TfLiteStatus SLstmPrepareInt8(TfLiteContext* context, TfLiteNode* node,
+                              OpDataSLstm* op_data) {
+    static const TfLiteType kInputTypes[kSLstmNumInputs] = {
+        kTfLiteInt8, kTfLiteInt8, kTfLiteInt8, kTfLiteInt32,
+        kTfLiteInt8, kTfLiteInt16, kTfLiteInt16, kTfLiteFloat32};
+    MicroContext* micro_context = GetMicroContext(context);
+    TfLiteTensor* tensors[kSLstmNumInputs];
+    TfLiteStatus status = kTfLiteOk;
+
+    for (int i = 0; i < kSLstmNumInputs; ++i) {
+        tensors[i] = micro_context->AllocateTempInputTensor(node, i);
+        TF_LITE_ENSURE(context, tensors[i] != nullptr);
+        if (tensors[i]->type != kInputTypes[i]) {
+            MicroPrintf("sLSTM int8: input %d is %s, expected %s.", i,
+                        TfLiteTypeGetName(tensors[i]->type),
+                        TfLiteTypeGetName(kInputTypes[i]));
+            status = kTfLiteError;
+        }
+    }
+    TfLiteTensor* output =
+        micro_context->AllocateTempOutputTensor(node, kSLstmOutputTensor);
+    TF_LITE_ENSURE(context, output != nullptr);
+    if (output->type != kTfLiteInt8 ||
+        output->params.scale != tensors[kSLstmHiddenStateTensor]->params.scale ||
+        output->params.zero_point != tensors[kSLstmHiddenStateTensor]->params.zero_point) {
+        MicroPrintf("sLSTM int8: output must be int8 quantized like y.");
+        status = kTfLiteError;
+    }
+
+    SlstmS8Params* q = &op_data->q8_params;
+    q->cell_clip = op_data->cell_clip;
+    q->W_scale = tensors[kSLstmInputWeightsTensor]->params.scale;
+    q->R_scale = tensors[kSLstmRecurrentWeightsTensor]->params.scale;
+    q->x_quant.scale = tensors[kSLstmInputTensor]->params.scale;
+    q->x_quant.zero_point = tensors[kSLstmInputTensor]->params.zero_point;
+    q->y_quant.scale = tensors[kSLstmHiddenStateTensor]->params.scale;
+    q->y_quant.zero_point = tensors[kSLstmHiddenStateTensor]->params.zero_point;
+    q->c_quant.scale = tensors[kSLstmCellStateTensor]->params.scale;
+    q->c_quant.zero_point = 0;
+    q->n_quant.scale = tensors[kSLstmNormalizerStateTensor]->params.scale;
+    q->n_quant.zero_point = 0;
+    q->stats = nullptr;
+    if (q->W_scale <= 0.0f || q->R_scale <= 0.0f || q->x_quant.scale <= 0.0f ||
+        q->y_quant.scale <= 0.0f || q->c_quant.scale <= 0.0f ||
+        q->n_quant.scale <= 0.0f) {
+        MicroPrintf("sLSTM int8: missing quantization scale.");
+        status = kTfLiteError;
+    }
+
+    op_data->packed = 0;
+#ifdef XLSTM_TFLM_PACK_WEIGHTS
+    if (status == kTfLiteOk && IsConstantTensor(tensors[kSLstmInputWeightsTensor]) &&
+        IsConstantTensor(tensors[kSLstmRecurrentWeightsTensor])) {
+        void* buf = context->AllocatePersistentBuffer(
+            context, slstm_pack_s8_size(op_data->input_size, op_data->hidden_size));
+        TF_LITE_ENSURE(context, buf != nullptr);
+        slstm_pack_s8(GetTensorData<int8_t>(tensors[kSLstmInputWeightsTensor]),
+                      GetTensorData<int8_t>(tensors[kSLstmRecurrentWeightsTensor]),
+                      op_data->input_size, op_data->hidden_size, q, buf,
+                      &op_data->q8_packed);
+        op_data->packed = 1;
+    }
+#endif
+
+    for (int i = 0; i < kSLstmNumInputs; ++i) {
+        micro_context->DeallocateTempTfLiteTensor(tensors[i]);
+    }
+    micro_context->DeallocateTempTfLiteTensor(output);
+    return status;
+}
+
 TfLiteStatus SLstmPrepare(TfLiteContext* context, TfLiteNode* node) {
     TFLITE_DCHECK(node->user_data != nullptr);
     OpDataSLstm* op_data = static_cast<OpDataSLstm*>(node->user_data);
@@ -53,16 +127,34 @@ TfLiteStatus SLstmPrepare(TfLiteContext* context, TfLiteNode* node) {
     op_data->time_steps = input->dims->data[1];
     op_data->input_size = input->dims->data[2];
     op_data->hidden_size = hidden_state->dims->data[1];
+    TfLiteType input_type = input->type;
 
     micro_context->DeallocateTempTfLiteTensor(input);
     micro_context->DeallocateTempTfLiteTensor(hidden_state);
 
+    // y, c, n, m: [B, H] each, either graph inputs or variable tensors that
+    // the interpreter keeps across Invoke calls
+    for (int i = kSLstmHiddenStateTensor; i <= kSLstmStabilizerStateTensor; ++i) {
+        TfLiteTensor* state = micro_context->AllocateTempInputTensor(node, i);
+        TF_LITE_ENSURE(context, state != nullptr);
+        TF_LITE_ENSURE_EQ(context, NumElements(state),
+                          op_data->batch_size * op_data->hidden_size);
+        micro_context->DeallocateTempTfLiteTensor(state);
+    }
+
     op_data->cell_clip = 0.0f;
 
+    // Scratch: 4*H gate pre-activations, float or int32 accumulators
+    size_t gate_bytes = sizeof(float);
+    if (input_type == kTfLiteInt8) {
+        TF_LITE_ENSURE_OK(context, SLstmPrepareInt8(context, node, op_data));
+        gate_bytes = sizeof(int32_t);
+    }
+
     TF_LITE_ENSURE_OK(
         context,
         context->RequestScratchBufferInArena(
-            context, 4 * op_data->hidden_size * sizeof(float),
+            context, 4 * op_data->hidden_size * gate_bytes,
             &op_data->scratch_buffer_index));
 
     return kTfLiteOk;
@@ -98,6 +190,7 @@ TfLiteStatus SLstmEvalFloat(TfLiteContext* context, TfLiteNode* node,
     // Set up core params
     SlstmParams params;
     params.cell_clip = op_data->cell_clip;
+    params.flush_denormals = 0;
 
     // Call portable core
     slstm_eval_f32(
@@ -131,6 +224,83 @@ TfLiteStatus SLstmEvalFloat(TfLiteContext* context, TfLiteNode* node,
     return kTfLiteOk;
 }
 
+TfLiteStatus SLstmEvalInt8(TfLiteContext* context, TfLiteNode* node,
+                           const OpDataSLstm* op_data) {
+    MicroContext* micro_context = GetMicroContext(context);
+
+    // Unpack tensors
+    TfLiteTensor* input =
+        micro_context->AllocateTempInputTensor(node, kSLstmInputTensor);
+    TfLiteTensor* input_weights =
+        micro_context->AllocateTempInputTensor(node, kSLstmInputWeightsTensor);
+    TfLiteTensor* recurrent_weights =
+        micro_context->AllocateTempInputTensor(node, kSLstmRecurrentWeightsTensor);
+    TfLiteTensor* bias =
+        micro_context->AllocateTempInputTensor(node, kSLstmBiasTensor);
+    TfLiteTensor* hidden_state =
+        micro_context->AllocateTempInputTensor(node, kSLstmHiddenStateTensor);
+    TfLiteTensor* cell_state =
+        micro_context->AllocateTempInputTensor(node, kSLstmCellStateTensor);
+    TfLiteTensor* normalizer_state =
+        micro_context->AllocateTempInputTensor(node, kSLstmNormalizerStateTensor);
+    TfLiteTensor* stabilizer_state =
+        micro_context->AllocateTempInputTensor(node, kSLstmStabilizerStateTensor);
+    TfLiteTensor* output =
+        micro_context->AllocateTempOutputTensor(node, kSLstmOutputTensor);
+
+    int32_t* scratch = static_cast<int32_t*>(
+        context->GetScratchBuffer(context, op_data->scratch_buffer_index));
+
+    // Call portable core with the params (and packed weights) from Prepare
+    if (op_data->packed) {
+        slstm_eval_packed_s8(
+            GetTensorData<int8_t>(input),
+            &op_data->q8_packed,
+            GetTensorData<int32_t>(bias),
+            GetTensorData<int8_t>(hidden_state),
+            GetTensorData<int16_t>(cell_state),
+            GetTensorData<int16_t>(normalizer_state),
+            GetTensorData<float>(stabilizer_state),
+            GetTensorData<int8_t>(output),
+            scratch,
+            op_data->batch_size,
+            op_data->time_steps,
+            op_data->input_size,
+            op_data->hidden_size,
+            &op_data->q8_params);
+    } else {
+        slstm_eval_s8(
+            GetTensorData<int8_t>(input),
+            GetTensorData<int8_t>(input_weights),
+            GetTensorData<int8_t>(recurrent_weights),
+            GetTensorData<int32_t>(bias),
+            GetTensorData<int8_t>(hidden_state),
+            GetTensorData<int16_t>(cell_state),
+            GetTensorData<int16_t>(normalizer_state),
+            GetTensorData<float>(stabilizer_state),
+            GetTensorData<int8_t>(output),
+            scratch,
+            op_data->batch_size,
+            op_data->time_steps,
+            op_data->input_size,
+            op_data->hidden_size,
+            &op_data->q8_params);
+    }
+
+    // Deallocate temp tensors
+    micro_context->DeallocateTempTfLiteTensor(input);
+    micro_context->DeallocateTempTfLiteTensor(input_weights);
+    micro_context->DeallocateTempTfLiteTensor(recurrent_weights);
+    micro_context->DeallocateTempTfLiteTensor(bias);
+    micro_context->DeallocateTempTfLiteTensor(hidden_state);
+    micro_context->DeallocateTempTfLiteTensor(cell_state);
+    micro_context->DeallocateTempTfLiteTensor(normalizer_state);
+    micro_context->DeallocateTempTfLiteTensor(stabilizer_state);
+    micro_context->DeallocateTempTfLiteTensor(output);
+
+    return kTfLiteOk;
+}
+
 TfLiteStatus SLstmEval(TfLiteContext* context, TfLiteNode* node) {
     TFLITE_DCHECK(node->user_data != nullptr);
     const OpDataSLstm* op_data =
@@ -145,6 +315,8 @@ TfLiteStatus SLstmEval(TfLiteContext* context, TfLiteNode* node) {
     switch (input_type) {
         case kTfLiteFloat32:
             return SLstmEvalFloat(context, node, op_data);
+        case kTfLiteInt8:
+            return SLstmEvalInt8(context, node, op_data);
         default:
             MicroPrintf("Type %s (%d) not supported for sLSTM.",
                         TfLiteTypeGetName(input_type), input_type);
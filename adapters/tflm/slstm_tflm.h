@@ -21,12 +21,17 @@
 #include "tensorflow/lite/c/common.h"
 #include "tensorflow/lite/micro/micro_common.h"
 
+#include "slstm_q8.h"
+
 namespace tflite {
 
 // Register sLSTM operator for TFLM
 TFLMRegistration Register_SLSTM();
 
 // Input tensor indices for sLSTM
+// The state tensors (y onwards) are updated in place. Mark them is_variable
+// in the model to have the interpreter own them across Invoke calls; they
+// are then not graph inputs and ResetVariableTensors() zeroes them.
 enum SLstmTensorIndex {
     kSLstmInputTensor = 0,              // [batch, time, features]
     kSLstmInputWeightsTensor = 1,       // [4*hidden, input]
@@ -47,7 +52,7 @@ enum SLstmOutputIndex {
 
 // OpData structure for scratch buffers and precomputed values
 struct OpDataSLstm {
-    int scratch_buffer_index;  // For gate computations [4 * hidden]
+    int scratch_buffer_index;  // Gate pre-activations [4 * hidden], float or int32
 
     int batch_size;
     int time_steps;
@@ -55,6 +60,15 @@ struct OpDataSLstm {
     int hidden_size;
 
     float cell_clip;
+
+    // kTfLiteInt8 only: scales / zero points read from the tensors in Prepare
+    SlstmS8Params q8_params;
+
+    // Built with XLSTM_TFLM_PACK_WEIGHTS and constant int8 W/R: Prepare puts
+    // the zero-point row corrections in a persistent arena buffer
+    // (slstm_pack_s8); Eval reads them with W/R from the flatbuffer.
+    int packed;
+    SlstmS8Packed q8_packed;
 };
 
 }  // namespace tflite
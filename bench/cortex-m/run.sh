@@ -0,0 +1,60 @@
+#!/bin/sh
+# Instructions per cell step under qemu-system-arm -icount for each
+# bare-metal q8_bench build, then each SIMD build's exactness table.
+#
+# Usage: run.sh QEMU_BUILD_DIR [steps]   (run from the directory holding
+#        q8_bench_<cpu>_<variant>.elf)
+#
+# Each count is insns(steps) - insns(0): start-up cancels out.
+
+QEMU_BUILD=$1
+STEPS=${2:-256}
+PLUGIN="-plugin $QEMU_BUILD/tests/plugin/libinsn.so -d plugin"
+
+# qemu MACHINE ELF [ARGS...]: boot ELF with ARGS as its semihosting argv
+qemu() {
+    machine=$1
+    elf=$2
+    shift 2
+    timeout 600 "$QEMU_BUILD/qemu-system-arm" -M "$machine" -nographic \
+        -icount shift=0 -semihosting-config enable=on,target=native \
+        -kernel "$elf" -append "$*" $EXTRA
+}
+
+insns() {
+    EXTRA=$PLUGIN
+    qemu "$@" 2>&1 | awk '/insns/ { n = $NF } END { print n }'
+}
+
+status=0
+for board in "mps2-an386 m4" "mps3-an547 m55"; do
+    set -- $board
+    machine=$1
+    cpu=$2
+
+    printf "%s (%s), instructions per step (%d steps, -icount, insn plugin)\n" \
+        "$machine" "$cpu" "$STEPS"
+    printf "  %-13s %-7s %10s %10s %8s\n" cell shape portable simd ratio
+    for cell in slstm mlstm slstm_packed mlstm_packed; do
+        for H in 16 32 64; do
+            p0=$(insns "$machine" q8_bench_${cpu}_portable.elf $cell $H 0)
+            p1=$(insns "$machine" q8_bench_${cpu}_portable.elf $cell $H "$STEPS")
+            s0=$(insns "$machine" q8_bench_${cpu}_simd.elf $cell $H 0)
+            s1=$(insns "$machine" q8_bench_${cpu}_simd.elf $cell $H "$STEPS")
+            awk -v c=$cell -v h=$H -v n="$STEPS" -v p=$((p1 - p0)) -v s=$((s1 - s0)) \
+                'BEGIN { printf "  %-13s I=H=%-3d %10.0f %10.0f %7.2fx\n", c, h, p / n, s / n, p / s }'
+        done
+    done
+
+    # Table mode checks the backend against the scalar loop (x_zp = -3 and 0)
+    # and the packed cells against the unpacked ones
+    EXTRA=
+    qemu "$machine" q8_bench_${cpu}_simd.elf > table_$cpu.txt
+    cat table_$cpu.txt
+    if grep -q MISMATCH table_$cpu.txt || [ "$(grep -c identical table_$cpu.txt)" -ne 3 ]; then
+        echo "FAIL: $machine SIMD build differs from the scalar loop"
+        status=1
+    fi
+    echo
+done
+exit $status
@@ -0,0 +1,95 @@
+/* Copyright 2026 RAWS labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * =========================================================================
+ * Bare-metal start-up for the bench programs on QEMU's Cortex-M boards
+ * (mps2-an386, mps3-an547), linked with cortex-m.ld, -nostartfiles and
+ * newlib's rdimon (semihosting) syscalls.
+ *
+ * Reset enables the FPU (and with it MVE), clears .bss, opens the
+ * semihosting stdio handles, splits the QEMU command line (-append) into
+ * argv and exits with main's return value. Any fault exits with status 1.
+ * ===========================================================================*/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SYS_GET_CMDLINE 0x15
+#define MAX_ARGS 8
+
+extern uint32_t __stack;
+extern char __bss_start__[], __bss_end__[];
+
+int main(int argc, char** argv);
+void initialise_monitor_handles(void);
+void reset_handler(void);
+
+static char g_cmdline[256];
+static char* g_argv[MAX_ARGS + 1];
+
+static int semihost(int op, void* arg) {
+    register int r0 __asm__("r0") = op;
+    register void* r1 __asm__("r1") = arg;
+    __asm__ volatile("bkpt 0xab" : "+r"(r0) : "r"(r1) : "memory");
+    return r0;
+}
+
+static int split_cmdline(void) {
+    struct { char* buf; int len; } block = {g_cmdline, (int)sizeof(g_cmdline) - 1};
+    char* p = g_cmdline;
+    int argc = 0;
+
+    if (semihost(SYS_GET_CMDLINE, &block) != 0) return 0;
+    g_cmdline[block.len] = '\0';
+    while (*p && argc < MAX_ARGS) {
+        while (*p == ' ') *p++ = '\0';
+        if (!*p) break;
+        g_argv[argc++] = p;
+        while (*p && *p != ' ') ++p;
+    }
+    g_argv[argc] = NULL;
+    return argc;
+}
+
+/* Runs once the FPU is on, so it may use FP/MVE code */
+static void __attribute__((noinline)) start(void) {
+    int argc;
+
+    memset(__bss_start__, 0, (size_t)(__bss_end__ - __bss_start__));
+    initialise_monitor_handles();
+    argc = split_cmdline();
+    exit(main(argc, g_argv));
+}
+
+void reset_handler(void) {
+    *(volatile uint32_t*)0xE000ED88u |= 0xFu << 20;   /* CPACR: CP10/CP11 full access */
+    __asm__ volatile("dsb\n\tisb" ::: "memory");
+    start();
+}
+
+static void fault_handler(void) {
+    _Exit(1);
+}
+
+__attribute__((section(".vectors"), used))
+static void (* const g_vectors[16])(void) = {
+    (void (*)(void))&__stack,
+    reset_handler,
+    fault_handler,  /* NMI */
+    fault_handler,  /* HardFault */
+    fault_handler,  /* MemManage */
+    fault_handler,  /* BusFault */
+    fault_handler,  /* UsageFault */
+    fault_handler,  /* SecureFault */
+};
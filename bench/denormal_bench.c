@@ -0,0 +1,156 @@
+/* Copyright 2026 RAWS labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * =========================================================================
+ * Long-stream throughput with and without denormal flushing.
+ *
+ * One stream is fed a short burst of input and then silence. With a forget
+ * gate of ~0.9999 the mLSTM C and the sLSTM c decay by that factor every
+ * step and reach the subnormal range roughly 900k steps in. Without
+ * flushing they never leave it: f * x rounds back to x for the smallest
+ * subnormals, so throughput stays down for the rest of the stream. Each
+ * cell is run in 1000-step eval chunks, as a streaming caller would, with
+ * params.flush_denormals off and on, and steps/s is reported per window.
+ *
+ * Usage: denormal_bench [steps] [hidden_size]   (default 2000000 16)
+ * ===========================================================================*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "slstm.h"
+#include "mlstm.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define INPUT_SIZE 8
+#define CHUNK 1000
+#define BURST 1000
+#define WINDOWS 20
+#define F_BIAS 9.21f   /* sigmoid(9.21) ~ 0.9999 */
+
+typedef struct {
+    const char* name;
+    int slstm;
+    int gates;         /* rows of W */
+    int f_row;         /* first forget-gate bias row */
+    int f_rows;        /* forget-gate bias rows */
+} Cell;
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
+
+static float* alloc_f32(size_t n) {
+    float* p = (float*)calloc(n, sizeof(float));
+    if (!p) {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+    return p;
+}
+
+/* Steps per second for each window of one run */
+static void run(const Cell* cell, int H, long steps, int flush, double* rate) {
+    const int I = INPUT_SIZE;
+    const long window = steps / WINDOWS;
+    float* W = alloc_f32((size_t)cell->gates * I);
+    float* R = alloc_f32((size_t)cell->gates * H);   /* zero: no feedback */
+    float* b = alloc_f32((size_t)cell->gates);
+    float* y = alloc_f32((size_t)H);
+    float* c = alloc_f32(cell->slstm ? (size_t)H : (size_t)H * H);
+    float* n = alloc_f32((size_t)H);
+    float* m = alloc_f32((size_t)H);
+    float* burst = alloc_f32((size_t)CHUNK * I);
+    float* silence = alloc_f32((size_t)CHUNK * I);
+    float* out = alloc_f32((size_t)CHUNK * H);
+    float* scratch = alloc_f32((size_t)cell->gates);
+    SlstmParams sp = {0.0f, 0};
+    MlstmParams mp = {0.0f, 0};
+    long done = 0;
+    int w = 0, i;
+    double t0;
+
+    for (i = 0; i < cell->gates * I; ++i) W[i] = 0.3f * sinf(0.37f * (float)i);
+    for (i = 0; i < cell->f_rows; ++i) b[cell->f_row + i] = F_BIAS;
+    for (i = 0; i < BURST * I; ++i) burst[i] = sinf(1.3f * (float)i);
+    sp.flush_denormals = flush;
+    mp.flush_denormals = flush;
+
+    t0 = now_s();
+    while (done < steps && w < WINDOWS) {
+        const float* x = done < BURST ? burst : silence;
+        if (cell->slstm) {
+            slstm_eval_f32(x, W, R, b, y, c, n, m, out, scratch, 1, CHUNK, I, H, &sp);
+        } else {
+            mlstm_eval_f32(x, W, b, y, c, n, m, out, scratch, 1, CHUNK, I, H, &mp);
+        }
+        done += CHUNK;
+        if (done >= (long)(w + 1) * window) {
+            double t1 = now_s();
+            rate[w++] = (double)window / (t1 - t0);
+            t0 = t1;
+        }
+    }
+
+    free(W); free(R); free(b); free(y); free(c); free(n); free(m);
+    free(burst); free(silence); free(out); free(scratch);
+}
+
+int main(int argc, char** argv) {
+    long steps = argc > 1 ? atol(argv[1]) : 2000000;
+    int H = argc > 2 ? atoi(argv[2]) : 16;
+    double rate[2][WINDOWS];
+    int k, f, w;
+
+    if (steps < (long)WINDOWS * CHUNK || H <= 0) {
+        fprintf(stderr, "usage: %s [steps >= %d] [hidden_size]\n", argv[0], WINDOWS * CHUNK);
+        return 1;
+    }
+    steps -= steps % ((long)WINDOWS * CHUNK);
+
+    {
+        const Cell cells[2] = {
+            {"mLSTM", 0, 4 * H + 2, 3 * H + 1, 1},
+            {"sLSTM", 1, 4 * H, H, H},
+        };
+
+        for (k = 0; k < 2; ++k) {
+            double lo[2] = {1e30, 1e30}, hi[2] = {0.0, 0.0};
+
+            for (f = 0; f < 2; ++f) run(&cells[k], H, steps, f, rate[f]);
+
+            printf("%s H=%d, %ld steps, f=%.4f, silence after %d steps\n",
+                   cells[k].name, H, steps, 1.0 / (1.0 + exp(-F_BIAS)), BURST);
+            printf("  %-22s %14s %14s\n", "steps", "default", "flush");
+            for (w = 0; w < WINDOWS; ++w) {
+                long s0 = (long)w * (steps / WINDOWS);
+                char span[48];
+                snprintf(span, sizeof(span), "%ld-%ld", s0, s0 + steps / WINDOWS);
+                printf("  %-22s %9.3f M/s %9.3f M/s\n", span,
+                       rate[0][w] * 1e-6, rate[1][w] * 1e-6);
+                for (f = 0; f < 2; ++f) {
+                    if (rate[f][w] < lo[f]) lo[f] = rate[f][w];
+                    if (rate[f][w] > hi[f]) hi[f] = rate[f][w];
+                }
+            }
+            printf("  slowest / fastest window: default %.2f, flush %.2f\n\n",
+                   lo[0] / hi[0], lo[1] / hi[1]);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,148 @@
+/* Copyright 2026 RAWS labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * =========================================================================
+ * Generic vs fixed-dimension (xlstm_fixed.h) f32 cells.
+ *
+ * For a few square shapes, runs the same stream through slstm/mlstm_eval_f32
+ * and through the macro-instantiated kernels, checks the outputs are
+ * identical and reports ns per step and the speedup.
+ *
+ * Usage: fixed_bench [min_seconds]   (default 0.2 per kernel and shape)
+ * ===========================================================================*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "xlstm_fixed.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define T 256
+#define MAX_H 64
+
+XLSTM_DEFINE_SLSTM_F32(s16, 16, 16)
+XLSTM_DEFINE_SLSTM_F32(s32, 32, 32)
+XLSTM_DEFINE_SLSTM_F32(s64, 64, 64)
+XLSTM_DEFINE_MLSTM_F32(m16, 16, 16)
+XLSTM_DEFINE_MLSTM_F32(m32, 32, 32)
+XLSTM_DEFINE_MLSTM_F32(m64, 64, 64)
+
+typedef void (*SlstmFixedEval)(const float*, const float*, const float*, const float*,
+                               float*, float*, float*, float*, float*, int, int,
+                               const SlstmParams*);
+typedef void (*MlstmFixedEval)(const float*, const float*, const float*,
+                               float*, float*, float*, float*, float*, int, int,
+                               const MlstmParams*);
+
+static float g_input[T * MAX_H];
+static float g_W[(4 * MAX_H + 2) * MAX_H], g_R[4 * MAX_H * MAX_H], g_b[4 * MAX_H + 2];
+static float g_y[MAX_H], g_c[MAX_H * MAX_H], g_n[MAX_H], g_m[MAX_H];
+static float g_scratch[4 * MAX_H + 2];
+static float g_out[2][T * MAX_H];
+static double g_min_seconds = 0.2;
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
+
+static void fill(float* p, int len, float seed, float scale) {
+    int i;
+    for (i = 0; i < len; ++i) p[i] = scale * sinf(seed + 0.91f * (float)i);
+}
+
+static void reset_state(void) {
+    memset(g_y, 0, sizeof(g_y));
+    memset(g_c, 0, sizeof(g_c));
+    memset(g_n, 0, sizeof(g_n));
+    memset(g_m, 0, sizeof(g_m));
+}
+
+/* One T-step eval of the generic (fixed == NULL) or the fixed kernel */
+static void run_slstm(SlstmFixedEval fixed, int H, float* out) {
+    SlstmParams p = {0.0f, 0};
+    if (fixed) {
+        fixed(g_input, g_W, g_R, g_b, g_y, g_c, g_n, g_m, out, 1, T, &p);
+    } else {
+        slstm_eval_f32(g_input, g_W, g_R, g_b, g_y, g_c, g_n, g_m, out, g_scratch,
+                       1, T, H, H, &p);
+    }
+}
+
+static void run_mlstm(MlstmFixedEval fixed, int H, float* out) {
+    MlstmParams p = {0.0f, 0};
+    if (fixed) {
+        fixed(g_input, g_W, g_b, g_y, g_c, g_n, g_m, out, 1, T, &p);
+    } else {
+        mlstm_eval_f32(g_input, g_W, g_b, g_y, g_c, g_n, g_m, out, g_scratch,
+                       1, T, H, H, &p);
+    }
+}
+
+/* ns per step: repeat T-step evals for at least g_min_seconds */
+static double time_ns(SlstmFixedEval sf, MlstmFixedEval mf, int slstm, int H) {
+    long calls = 0;
+    double t0 = now_s(), t1;
+
+    reset_state();
+    do {
+        if (slstm) run_slstm(sf, H, g_out[1]);
+        else run_mlstm(mf, H, g_out[1]);
+        ++calls;
+        t1 = now_s();
+    } while (t1 - t0 < g_min_seconds);
+    return (t1 - t0) * 1e9 / ((double)calls * T);
+}
+
+static void bench(const char* name, SlstmFixedEval sf, MlstmFixedEval mf, int H) {
+    int slstm = sf != NULL;
+    double generic, fixed;
+    int same;
+
+    fill(g_input, T * H, 0.1f, 1.0f);
+    fill(g_W, (4 * H + 2) * H, 0.2f, 0.3f / sqrtf((float)H));
+    fill(g_R, 4 * H * H, 0.3f, 0.3f / sqrtf((float)H));
+    fill(g_b, 4 * H + 2, 0.4f, 0.1f);
+
+    reset_state();
+    if (slstm) run_slstm(NULL, H, g_out[0]);
+    else run_mlstm(NULL, H, g_out[0]);
+    reset_state();
+    if (slstm) run_slstm(sf, H, g_out[1]);
+    else run_mlstm(mf, H, g_out[1]);
+    same = memcmp(g_out[0], g_out[1], (size_t)T * H * sizeof(float)) == 0;
+
+    generic = time_ns(NULL, NULL, slstm, H);
+    fixed = time_ns(sf, mf, slstm, H);
+    printf("  %-6s I=H=%-3d %10.1f %10.1f %8.2fx  %s\n", name, H, generic, fixed,
+           generic / fixed, same ? "identical" : "MISMATCH");
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1) g_min_seconds = atof(argv[1]);
+
+    printf("Fixed-dimension kernels, %d-step evals, ns/step\n", T);
+    printf("  %-6s %-7s %10s %10s %9s\n", "cell", "shape", "generic", "fixed", "speedup");
+    bench("sLSTM", s16_eval_f32, NULL, 16);
+    bench("sLSTM", s32_eval_f32, NULL, 32);
+    bench("sLSTM", s64_eval_f32, NULL, 64);
+    bench("mLSTM", NULL, m16_eval_f32, 16);
+    bench("mLSTM", NULL, m32_eval_f32, 32);
+    bench("mLSTM", NULL, m64_eval_f32, 64);
+    return 0;
+}
@@ -0,0 +1,213 @@
+/* Copyright 2026 RAWS labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * =========================================================================
+ * INT8 projections and cells on the selected xlstm_q8_dot.h backend.
+ *
+ * For I=H=16/32/64 checks that the backend dot product matches a plain
+ * scalar loop on every row, with the zero point applied (x_zp = -3) and
+ * folded out (x_zp = 0, the packed-weight path), and that the packed cells
+ * reproduce slstm_eval_s8 / mlstm_eval_s8. It then reports cycles per step
+ * (xlstm_profile_cycles) of the [4H, I] projection alone, for the scalar
+ * loop and for the backend, and of full slstm_eval_s8 / mlstm_eval_s8
+ * steps. On Cortex-M the DWT cycle counter is enabled first; QEMU does not
+ * model it, so there only the check column means anything.
+ *
+ * Usage: q8_bench                     table (default)
+ *        q8_bench CELL H steps         run one cell for `steps` steps and
+ *                                      print nothing else — for external
+ *                                      counters such as an emulator's
+ *                                      instruction count (bench/cortex-m).
+ *                                      CELL: slstm, mlstm, slstm_packed,
+ *                                      mlstm_packed
+ * ===========================================================================*/
+
+#include "slstm_q8.h"
+#include "mlstm_q8.h"
+#include "xlstm_q8_dot.h"
+#include "xlstm_profile.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define T 32
+#define MAX_H 64
+#define REPS 20
+
+static int8_t g_input[T * MAX_H];
+static int8_t g_W[(4 * MAX_H + 2) * MAX_H], g_R[4 * MAX_H * MAX_H];
+static int32_t g_b[4 * MAX_H + 2], g_acc[2][4 * MAX_H + 2];
+static int8_t g_y[MAX_H], g_out[T * MAX_H], g_ref[T * MAX_H];
+static int16_t g_c[MAX_H * MAX_H], g_n[MAX_H];
+static float g_m[MAX_H];
+static int32_t g_scratch[4 * MAX_H + 2];
+static int32_t g_s_corr[8 * MAX_H], g_m_corr[4 * MAX_H + 2];
+static SlstmS8Packed g_s_packed;
+static MlstmS8Packed g_m_packed;
+
+enum { SLSTM, MLSTM, SLSTM_PACKED, MLSTM_PACKED, NUM_CELLS };
+static const char* const kCellNames[NUM_CELLS] = {
+    "slstm", "mlstm", "slstm_packed", "mlstm_packed"};
+
+static const SlstmS8Params kSlstmParams = {
+    0.0f, 0.004f, 0.004f, {0.02f, -3}, {1.0f / 128, 0},
+    {1.0f / 1024, 0}, {1.0f / 1024, 0}, NULL};
+static const MlstmS8Params kMlstmParams = {
+    0.0f, 0.004f, {0.02f, -3}, {1.0f / 128, 0},
+    {1.0f / 1024, 0}, {1.0f / 1024, 0}, NULL};
+
+static void enable_cycle_counter(void) {
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || \
+    defined(__ARM_ARCH_8M_MAIN__) || defined(__ARM_ARCH_8_1M_MAIN__)
+    *(volatile uint32_t*)0xE000EDFCu |= 1u << 24;  /* DEMCR.TRCENA */
+    *(volatile uint32_t*)0xE0001004u = 0;          /* DWT->CYCCNT */
+    *(volatile uint32_t*)0xE0001000u |= 1u;        /* DWT->CTRL.CYCCNTENA */
+#endif
+}
+
+static void fill(int8_t* p, int len, int seed) {
+    int i;
+    for (i = 0; i < len; ++i) p[i] = (int8_t)((i * 37 + seed * 11) % 255 - 127);
+}
+
+static void reset_state(void) {
+    memset(g_y, 0, sizeof(g_y));
+    memset(g_c, 0, sizeof(g_c));
+    memset(g_n, 0, sizeof(g_n));
+    memset(g_m, 0, sizeof(g_m));
+}
+
+static void setup(int H) {
+    fill(g_input, T * H, 1);
+    fill(g_W, (4 * H + 2) * H, 2);
+    fill(g_R, 4 * H * H, 3);
+    slstm_pack_s8(g_W, g_R, H, H, &kSlstmParams, g_s_corr, &g_s_packed);
+    mlstm_pack_s8(g_W, H, H, &kMlstmParams, g_m_corr, &g_m_packed);
+    reset_state();
+}
+
+static void run_cell(int cell, int H, int steps) {
+    int done;
+
+    for (done = 0; done < steps; done += T) {
+        int t = steps - done < T ? steps - done : T;
+        switch (cell) {
+        case SLSTM:
+            slstm_eval_s8(g_input, g_W, g_R, g_b, g_y, g_c, g_n, g_m, g_out, g_scratch,
+                          1, t, H, H, &kSlstmParams);
+            break;
+        case MLSTM:
+            mlstm_eval_s8(g_input, g_W, g_b, g_y, g_c, g_n, g_m, g_out, g_scratch,
+                          1, t, H, H, &kMlstmParams);
+            break;
+        case SLSTM_PACKED:
+            slstm_eval_packed_s8(g_input, &g_s_packed, g_b, g_y, g_c, g_n, g_m, g_out,
+                                 g_scratch, 1, t, H, H, &kSlstmParams);
+            break;
+        default:
+            mlstm_eval_packed_s8(g_input, &g_m_packed, g_b, g_y, g_c, g_n, g_m, g_out,
+                                 g_scratch, 1, t, H, H, &kMlstmParams);
+            break;
+        }
+    }
+}
+
+/* [rows, H] x H projection, scalar loop (which == 0) or backend (1) */
+static void project(int which, int rows, int H, int32_t x_zp) {
+    int i, j;
+
+    for (i = 0; i < rows; ++i) {
+        const int8_t* w = g_W + i * H;
+        int32_t acc = 0;
+        if (which) {
+            acc = xlstm_dot_s8(w, g_input, x_zp, H);
+        } else {
+            for (j = 0; j < H; ++j) acc += (int32_t)w[j] * ((int32_t)g_input[j] - x_zp);
+        }
+        g_acc[which][i] = acc;
+    }
+}
+
+/* Backend dot product == scalar loop for one zero point */
+static int project_matches(int H, int32_t x_zp) {
+    project(0, 4 * H, H, x_zp);
+    project(1, 4 * H, H, x_zp);
+    return memcmp(g_acc[0], g_acc[1], (size_t)4 * H * sizeof(int32_t)) == 0;
+}
+
+/* Packed cell output == unpacked cell output over T steps */
+static int packed_matches(int cell, int H) {
+    reset_state();
+    run_cell(cell, H, T);
+    memcpy(g_ref, g_out, (size_t)T * H);
+    reset_state();
+    run_cell(cell + SLSTM_PACKED, H, T);
+    return memcmp(g_ref, g_out, (size_t)T * H) == 0;
+}
+
+static double cycles_per_call(int which, int cell, int H) {
+    uint64_t t0, t1;
+    int r;
+
+    t0 = xlstm_profile_cycles();
+    for (r = 0; r < REPS; ++r) {
+        if (which < 2) project(which, 4 * H, H, -3);
+        else run_cell(cell, H, T);
+    }
+    t1 = xlstm_profile_cycles();
+    return (double)(t1 - t0) / (which < 2 ? REPS : REPS * T);
+}
+
+static void bench(int H) {
+    double scalar, backend, s8, m8;
+    int same;
+
+    setup(H);
+    same = project_matches(H, -3) && project_matches(H, 0) &&
+           packed_matches(SLSTM, H) && packed_matches(MLSTM, H);
+
+    scalar = cycles_per_call(0, 0, H);
+    backend = cycles_per_call(1, 0, H);
+    reset_state();
+    s8 = cycles_per_call(2, SLSTM, H);
+    reset_state();
+    m8 = cycles_per_call(2, MLSTM, H);
+    printf("  I=H=%-3d %10.0f %10.0f %7.2fx %10.0f %10.0f  %s\n", H, scalar, backend,
+           backend > 0 ? scalar / backend : 0.0, s8, m8, same ? "identical" : "MISMATCH");
+}
+
+int main(int argc, char** argv) {
+    enable_cycle_counter();
+
+    if (argc == 4) {
+        int H = atoi(argv[2]);
+        int cell;
+        for (cell = 0; cell < NUM_CELLS; ++cell) {
+            if (strcmp(argv[1], kCellNames[cell]) == 0) break;
+        }
+        if (cell == NUM_CELLS || H < 1 || H > MAX_H) return 1;
+        setup(H);
+        run_cell(cell, H, atoi(argv[3]));
+        return 0;
+    }
+
+    printf("INT8 backend: %s, cycles per [4H,I] projection and per cell step\n",
+           XLSTM_Q8_BACKEND);
+    printf("  %-8s %10s %10s %8s %10s %10s  %s\n", "shape", "scalar", "backend",
+           "speedup", "sLSTM s8", "mLSTM s8", "check");
+    bench(16);
+    bench(32);
+    bench(64);
+    return 0;
+}
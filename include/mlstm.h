@@ -33,12 +33,18 @@
 #ifndef MLSTM_H_
 #define MLSTM_H_
 
+#include <stdint.h>
+
+#include "xlstm_types.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 typedef struct {
     float cell_clip; /* 0 = no clipping */
+    int flush_denormals; /* 1 = evals run with subnormals flushed to zero,
+                          * restoring the caller's FP mode (xlstm_fpenv.h) */
 } MlstmParams;
 
 /* Single timestep of mLSTM.
@@ -60,6 +66,55 @@ void mlstm_step_f32(
     int hidden_size,
     const MlstmParams* params);
 
+/* Batched single timestep over a set of state slots.
+ *
+ * Advances num_slots independent streams by one step. Stream k reads
+ * x[k*I .. k*I+I) and its state lives in row slots[k] of the y/C/n/m slot
+ * arrays, which may hold more rows than are stepped. Each weight row is read
+ * once and applied to every stream. Results are identical to calling
+ * mlstm_step_f32 per stream. Slot indices must be distinct.
+ * Caller must provide a scratch buffer of at least num_slots*(4*H+2) floats. */
+void mlstm_step_batch_f32(
+    const float* x,       /* [num_slots, input_size] */
+    const int* slots,     /* [num_slots] state row per stream */
+    int num_slots,
+    const float* W,       /* [(4*hidden_size+2), input_size] */
+    const float* b,       /* [4*hidden_size+2] */
+    float* y,             /* [capacity, hidden_size] out */
+    float* C,             /* [capacity, hidden_size * hidden_size] in/out */
+    float* n,             /* [capacity, hidden_size] in/out */
+    float* m,             /* [capacity, 1] in/out */
+    float* scratch,       /* [num_slots*(4*hidden_size+2)] caller-provided */
+    int input_size,
+    int hidden_size,
+    const MlstmParams* params);
+
+/* Single timestep on a row-tiled C with separate source and destination.
+ *
+ * C is split into ceil(H/tile_rows) tiles of tile_rows consecutive rows (the
+ * last tile may be shorter); tile t is a row-major [rows, H] block. The step
+ * reads tile t from C_src[t] and writes the updated tile to C_dst[t], and
+ * reads n from n_src and writes it to n_dst. A destination may alias its
+ * source (in-place update) or be a fresh buffer, in which case a shared tile
+ * is copied and updated in one pass — this is what copy-on-write forking
+ * (xlstm_cow) builds on. Results are identical to mlstm_step_f32.
+ * Caller must provide a scratch buffer of at least (4*H+2) floats. */
+void mlstm_step_tiled_f32(
+    const float* x,               /* [input_size] */
+    const float* W,               /* [(4*hidden_size+2), input_size] */
+    const float* b,               /* [4*hidden_size+2] */
+    float* y,                     /* [hidden_size] out */
+    const float* const* C_src,    /* [num_tiles] tile_rows*hidden_size each */
+    float* const* C_dst,          /* [num_tiles] may alias C_src */
+    int tile_rows,
+    const float* n_src,           /* [hidden_size] */
+    float* n_dst,                 /* [hidden_size] may alias n_src */
+    float* m,                     /* [1] in/out */
+    float* scratch,               /* [4*hidden_size+2] caller-provided */
+    int input_size,
+    int hidden_size,
+    const MlstmParams* params);
+
 /* Full sequence evaluation: batch + time loop.
  *
  * Processes input[B, T, I] and writes output[B, T, H].
@@ -81,6 +136,77 @@ void mlstm_eval_f32(
     int hidden_size,
     const MlstmParams* params);
 
+/* Full sequence evaluation with per-step state resets.
+ *
+ * Same as mlstm_eval_f32, but when reset[b*T + t] is non-zero the state of
+ * batch element b is reinitialized (y = C = n = m = 0) before timestep t is
+ * processed. This lets several episodes be packed into one [B, T, I] buffer.
+ * reset may be NULL, in which case this is identical to mlstm_eval_f32. */
+void mlstm_eval_reset_f32(
+    const float* input,   /* [batch_size, time_steps, input_size] */
+    const uint8_t* reset, /* [batch_size, time_steps] or NULL */
+    const float* W,       /* [(4*hidden_size+2), input_size] */
+    const float* b,       /* [4*hidden_size+2] */
+    float* y,             /* [batch_size, hidden_size] in/out */
+    float* C,             /* [batch_size, hidden_size * hidden_size] in/out */
+    float* n,             /* [batch_size, hidden_size] in/out */
+    float* m,             /* [batch_size, 1] in/out */
+    float* output,        /* [batch_size, time_steps, hidden_size] */
+    float* scratch,       /* [4*hidden_size+2] caller-provided */
+    int batch_size,
+    int time_steps,
+    int input_size,
+    int hidden_size,
+    const MlstmParams* params);
+
+/* Speculative evaluation: run K = time_steps draft steps without touching
+ * the live state, recording a compact checkpoint after every step.
+ *
+ * C is never updated during the call. Instead each step records its scaled
+ * key k, value v, stabilized gates f and i, and the resulting n, y and m;
+ * the readout at step t uses the exact low-rank expansion
+ *   C_t = (f_1 ... f_t) C_0 + sum_{s<=t} i_s (f_{s+1} ... f_t) k_s v_s^T
+ * so a step costs one H×H read of C_0 plus O(t*H) instead of an H×H write.
+ *
+ * ckpt[b, t] layout: [k(H), v(H), n(H), y(H), f, i, m] (4*H+3 floats).
+ * cell_clip, if set, is applied once at commit rather than after every
+ * step, so clipped results can differ from mlstm_eval_f32.
+ * Caller must provide a scratch buffer of at least (4*H+2+T) floats. */
+void mlstm_eval_spec_f32(
+    const float* input,   /* [batch_size, time_steps, input_size] */
+    const float* W,       /* [(4*hidden_size+2), input_size] */
+    const float* b,       /* [4*hidden_size+2] */
+    const float* C,       /* [batch_size, hidden_size * hidden_size] */
+    const float* n,       /* [batch_size, hidden_size] */
+    const float* m,       /* [batch_size, 1] */
+    float* output,        /* [batch_size, time_steps, hidden_size] */
+    float* ckpt,          /* [batch_size, time_steps, 4*hidden_size+3] */
+    float* scratch,       /* [4*hidden_size+2+time_steps] caller-provided */
+    int batch_size,
+    int time_steps,
+    int input_size,
+    int hidden_size,
+    const MlstmParams* params);
+
+/* Accept the first accepted[b] steps (0..time_steps) of a speculative eval.
+ *
+ * Applies the deferred rank-1 updates of the accepted steps to C and copies
+ * y, n, m from the last accepted checkpoint; accepted[b] == 0 leaves batch
+ * element b unchanged (full rollback). Returns XLSTM_OK, or XLSTM_ERR_ARG
+ * (NULL pointer, negative size or an accepted[b] outside 0..time_steps)
+ * without touching the state. */
+int mlstm_spec_commit_f32(
+    const float* ckpt,    /* [batch_size, time_steps, 4*hidden_size+3] */
+    const int* accepted,  /* [batch_size] */
+    float* y,             /* [batch_size, hidden_size] out */
+    float* C,             /* [batch_size, hidden_size * hidden_size] in/out */
+    float* n,             /* [batch_size, hidden_size] out */
+    float* m,             /* [batch_size, 1] out */
+    int batch_size,
+    int time_steps,
+    int hidden_size,
+    const MlstmParams* params);
+
 #ifdef __cplusplus
 }
 #endif
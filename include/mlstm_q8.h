@@ -27,6 +27,7 @@
 
 #include "xlstm_quant.h"
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -40,8 +41,16 @@ typedef struct {
     XlstmQuantParam y_quant;
     XlstmQuantParam C_quant;   /* cell matrix (INT16) — H×H */
     XlstmQuantParam n_quant;   /* normalizer (INT16) */
+    XlstmQ8Stats* stats;       /* optional saturation counters, NULL = off */
 } MlstmS8Params;
 
+/* Weights prepared once by mlstm_pack_s8 for a fixed x zero point; see
+ * SlstmS8Packed. Results are bit-identical to the unpacked kernels. */
+typedef struct {
+    const int8_t* W_q;        /* [(4*H+2), I] */
+    const int32_t* W_corr;    /* [4*H+2] = -x_zp * row sum of W_q */
+} MlstmS8Packed;
+
 /* Single timestep of mLSTM (INT8 quantized).
  *
  * State pointers (y, C, n, m) are updated in-place.
@@ -61,6 +70,26 @@ void mlstm_step_s8(
     int hidden_size,
     const MlstmS8Params* params);
 
+/* Batched single timestep (INT8 quantized) over a set of state slots.
+ *
+ * INT8 counterpart of mlstm_step_batch_f32: stream k reads x[k*I..] and
+ * updates state row slots[k]. Each weight row is read once per call.
+ * Caller must provide a scratch buffer of at least num_slots*(4*H+2) int32_t. */
+void mlstm_step_batch_s8(
+    const int8_t* x,          /* [num_slots, I] */
+    const int* slots,         /* [num_slots] state row per stream */
+    int num_slots,
+    const int8_t* W_q,        /* [(4*H+2), I] */
+    const int32_t* b_q,       /* [4*H+2] */
+    int8_t* y,                /* [capacity, H] out */
+    int16_t* C,               /* [capacity, H*H] in/out */
+    int16_t* n,               /* [capacity, H] in/out */
+    float* m,                 /* [capacity, 1] in/out */
+    int32_t* scratch,         /* [num_slots*(4*H+2)] */
+    int input_size,
+    int hidden_size,
+    const MlstmS8Params* params);
+
 /* Full sequence evaluation (INT8 quantized): batch + time loop.
  *
  * Processes input[B, T, I] and writes output[B, T, H] (all INT8).
@@ -82,6 +111,59 @@ void mlstm_eval_s8(
     int hidden_size,
     const MlstmS8Params* params);
 
+/* Full sequence evaluation (INT8 quantized) with per-step state resets.
+ *
+ * Same as mlstm_eval_s8, but when reset[b*T + t] is non-zero the state of
+ * batch element b is reinitialized before timestep t: y is set to
+ * y_quant.zero_point (real 0), C/n/m to 0. reset may be NULL. */
+void mlstm_eval_reset_s8(
+    const int8_t* input,      /* [B, T, I] */
+    const uint8_t* reset,     /* [B, T] or NULL */
+    const int8_t* W_q,        /* [(4*H+2), I] */
+    const int32_t* b_q,       /* [4*H+2] */
+    int8_t* y,                /* [B, H] in/out */
+    int16_t* C,               /* [B, H*H] in/out */
+    int16_t* n,               /* [B, H] in/out */
+    float* m,                 /* [B, 1] in/out */
+    int8_t* output,           /* [B, T, H] */
+    int32_t* scratch,         /* [4*H+2] */
+    int batch_size,
+    int time_steps,
+    int input_size,
+    int hidden_size,
+    const MlstmS8Params* params);
+
+/* Bytes of the buffer mlstm_pack_s8 fills: the corrections only. */
+size_t mlstm_pack_s8_size(int input_size, int hidden_size);
+
+/* Write the row corrections for params->x_quant.zero_point to buf
+ * (mlstm_pack_s8_size bytes, 4-byte aligned) and point *packed at them and
+ * at W_q, which is not copied (see slstm_pack_s8). */
+void mlstm_pack_s8(
+    const int8_t* W_q,        /* [(4*H+2), I] */
+    int input_size,
+    int hidden_size,
+    const MlstmS8Params* params,
+    void* buf,
+    MlstmS8Packed* packed);
+
+/* mlstm_eval_s8 on packed weights. */
+void mlstm_eval_packed_s8(
+    const int8_t* input,      /* [B, T, I] */
+    const MlstmS8Packed* packed,
+    const int32_t* b_q,       /* [4*H+2] */
+    int8_t* y,                /* [B, H] in/out */
+    int16_t* C,               /* [B, H*H] in/out */
+    int16_t* n,               /* [B, H] in/out */
+    float* m,                 /* [B] in/out */
+    int8_t* output,           /* [B, T, H] */
+    int32_t* scratch,         /* [4*H+2] */
+    int batch_size,
+    int time_steps,
+    int input_size,
+    int hidden_size,
+    const MlstmS8Params* params);
+
 #ifdef __cplusplus
 }
 #endif
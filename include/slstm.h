@@ -24,12 +24,18 @@
 #ifndef SLSTM_H_
 #define SLSTM_H_
 
+#include <stdint.h>
+
+#include "xlstm_types.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 typedef struct {
     float cell_clip; /* 0 = no clipping */
+    int flush_denormals; /* 1 = evals run with subnormals flushed to zero,
+                          * restoring the caller's FP mode (xlstm_fpenv.h) */
 } SlstmParams;
 
 /* Single timestep of sLSTM.
@@ -50,6 +56,31 @@ void slstm_step_f32(
     int hidden_size,
     const SlstmParams* params);
 
+/* Batched single timestep over a set of state slots.
+ *
+ * Advances num_slots independent streams by one step. Stream k reads
+ * x[k*I .. k*I+I) and its state lives in row slots[k] of the y/c/n/m slot
+ * arrays, which may hold more rows than are stepped. Each weight row is read
+ * once and applied to every stream. Results are identical to calling
+ * slstm_step_f32 per stream. Slot indices must be distinct.
+ * Caller must provide a scratch buffer of at least num_slots*4*hidden_size
+ * floats. */
+void slstm_step_batch_f32(
+    const float* x,       /* [num_slots, input_size] */
+    const int* slots,     /* [num_slots] state row per stream */
+    int num_slots,
+    const float* W,       /* [4*hidden_size, input_size] */
+    const float* R,       /* [4*hidden_size, hidden_size] */
+    const float* b,       /* [4*hidden_size] */
+    float* y,             /* [capacity, hidden_size] in/out */
+    float* c,             /* [capacity, hidden_size] in/out */
+    float* n,             /* [capacity, hidden_size] in/out */
+    float* m,             /* [capacity, hidden_size] in/out */
+    float* scratch,       /* [num_slots*4*hidden_size] caller-provided */
+    int input_size,
+    int hidden_size,
+    const SlstmParams* params);
+
 /* Full sequence evaluation: batch + time loop.
  *
  * Processes input[B, T, I] and writes output[B, T, H].
@@ -72,6 +103,94 @@ void slstm_eval_f32(
     int hidden_size,
     const SlstmParams* params);
 
+/* Full sequence evaluation with per-step state resets.
+ *
+ * Same as slstm_eval_f32, but when reset[b*T + t] is non-zero the state of
+ * batch element b is reinitialized (y = c = n = m = 0) before timestep t is
+ * processed. This lets several episodes be packed into one [B, T, I] buffer.
+ * reset may be NULL, in which case this is identical to slstm_eval_f32. */
+void slstm_eval_reset_f32(
+    const float* input,   /* [batch_size, time_steps, input_size] */
+    const uint8_t* reset, /* [batch_size, time_steps] or NULL */
+    const float* W,       /* [4*hidden_size, input_size] */
+    const float* R,       /* [4*hidden_size, hidden_size] */
+    const float* b,       /* [4*hidden_size] */
+    float* y,             /* [batch_size, hidden_size] in/out */
+    float* c,             /* [batch_size, hidden_size] in/out */
+    float* n,             /* [batch_size, hidden_size] in/out */
+    float* m,             /* [batch_size, hidden_size] in/out */
+    float* output,        /* [batch_size, time_steps, hidden_size] */
+    float* scratch,       /* [4*hidden_size] caller-provided */
+    int batch_size,
+    int time_steps,
+    int input_size,
+    int hidden_size,
+    const SlstmParams* params);
+
+/* Recurrence-only evaluation on precomputed input projections.
+ *
+ * preact[b, t] holds W*x_t + b for batch element b, layout [i, f, z, o]
+ * each of size H, e.g. from one [B*T, I] x [I, 4H] GEMM done up front. Each
+ * step adds R*y and applies the gating; output and states are as in
+ * slstm_eval_f32 up to float rounding of the summation order.
+ * Caller must provide a scratch buffer of at least 4*hidden_size floats. */
+void slstm_eval_preact_f32(
+    const float* preact,  /* [batch_size, time_steps, 4*hidden_size] */
+    const float* R,       /* [4*hidden_size, hidden_size] */
+    float* y,             /* [batch_size, hidden_size] in/out */
+    float* c,             /* [batch_size, hidden_size] in/out */
+    float* n,             /* [batch_size, hidden_size] in/out */
+    float* m,             /* [batch_size, hidden_size] in/out */
+    float* output,        /* [batch_size, time_steps, hidden_size] */
+    float* scratch,       /* [4*hidden_size] caller-provided */
+    int batch_size,
+    int time_steps,
+    int hidden_size,
+    const SlstmParams* params);
+
+/* Speculative evaluation: run K = time_steps draft steps without touching
+ * the live state, recording a full checkpoint after every step.
+ *
+ * ckpt[b, t] holds (y, c, n, m) of batch element b after step t, each [H].
+ * y/c/n/m are read as the starting state and left unchanged; output is
+ * written as in slstm_eval_f32. Follow with slstm_spec_commit_f32 once the
+ * number of accepted steps is known.
+ * Caller must provide a scratch buffer of at least 4*H floats. */
+void slstm_eval_spec_f32(
+    const float* input,   /* [batch_size, time_steps, input_size] */
+    const float* W,       /* [4*hidden_size, input_size] */
+    const float* R,       /* [4*hidden_size, hidden_size] */
+    const float* b,       /* [4*hidden_size] */
+    const float* y,       /* [batch_size, hidden_size] */
+    const float* c,       /* [batch_size, hidden_size] */
+    const float* n,       /* [batch_size, hidden_size] */
+    const float* m,       /* [batch_size, hidden_size] */
+    float* output,        /* [batch_size, time_steps, hidden_size] */
+    float* ckpt,          /* [batch_size, time_steps, 4, hidden_size] */
+    float* scratch,       /* [4*hidden_size] caller-provided */
+    int batch_size,
+    int time_steps,
+    int input_size,
+    int hidden_size,
+    const SlstmParams* params);
+
+/* Accept the first accepted[b] steps (0..time_steps) of a speculative eval.
+ *
+ * Copies the checkpoint after the last accepted step into the live state;
+ * accepted[b] == 0 leaves batch element b unchanged (full rollback).
+ * Returns XLSTM_OK, or XLSTM_ERR_ARG (NULL pointer, negative size or an
+ * accepted[b] outside 0..time_steps) without touching the state. */
+int slstm_spec_commit_f32(
+    const float* ckpt,    /* [batch_size, time_steps, 4, hidden_size] */
+    const int* accepted,  /* [batch_size] */
+    float* y,             /* [batch_size, hidden_size] out */
+    float* c,             /* [batch_size, hidden_size] out */
+    float* n,             /* [batch_size, hidden_size] out */
+    float* m,             /* [batch_size, hidden_size] out */
+    int batch_size,
+    int time_steps,
+    int hidden_size);
+
 #ifdef __cplusplus
 }
 #endif
@@ -26,6 +26,7 @@
 
 #include "xlstm_quant.h"
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -43,8 +44,21 @@ typedef struct {
     XlstmQuantParam c_quant;     /* cell state (INT16) */
     XlstmQuantParam n_quant;     /* normalizer (INT16) */
     /* m stays float — no param needed */
+    XlstmQ8Stats* stats;         /* optional saturation counters, NULL = off */
 } SlstmS8Params;
 
+/* Weights prepared once by slstm_pack_s8 for fixed x/y zero points. The
+ * per-row corrections fold the zero points out of the projection:
+ *   sum_j W[i,j] * (x[j] - x_zp) = sum_j W[i,j] * x[j] + W_corr[i]
+ * so each step is a plain INT8×INT8 dot. W_q/R_q are the caller's weights,
+ * not a copy. Results are bit-identical to the unpacked kernels. */
+typedef struct {
+    const int8_t* W_q;        /* [4*H, I] */
+    const int8_t* R_q;        /* [4*H, H] */
+    const int32_t* W_corr;    /* [4*H] = -x_zp * row sum of W_q */
+    const int32_t* R_corr;    /* [4*H] = -y_zp * row sum of R_q */
+} SlstmS8Packed;
+
 /* Single timestep of sLSTM (INT8 quantized).
  *
  * All state pointers (y, c, n, m) are updated in-place.
@@ -63,6 +77,27 @@ void slstm_step_s8(
     int hidden_size,
     const SlstmS8Params* params);
 
+/* Batched single timestep (INT8 quantized) over a set of state slots.
+ *
+ * INT8 counterpart of slstm_step_batch_f32: stream k reads x[k*I..] and
+ * updates state row slots[k]. Each weight row is read once per call.
+ * Caller must provide a scratch buffer of at least num_slots*4*H int32_t. */
+void slstm_step_batch_s8(
+    const int8_t* x,          /* [num_slots, I] */
+    const int* slots,         /* [num_slots] state row per stream */
+    int num_slots,
+    const int8_t* W_q,        /* [4*H, I] */
+    const int8_t* R_q,        /* [4*H, H] */
+    const int32_t* b_q,       /* [4*H] */
+    int8_t* y,                /* [capacity, H] in/out */
+    int16_t* c,               /* [capacity, H] in/out */
+    int16_t* n,               /* [capacity, H] in/out */
+    float* m,                 /* [capacity, H] in/out */
+    int32_t* scratch,         /* [num_slots*4*H] */
+    int input_size,
+    int hidden_size,
+    const SlstmS8Params* params);
+
 /* Full sequence evaluation (INT8 quantized): batch + time loop.
  *
  * Processes input[B, T, I] and writes output[B, T, H] (all INT8).
@@ -85,6 +120,63 @@ void slstm_eval_s8(
     int hidden_size,
     const SlstmS8Params* params);
 
+/* Full sequence evaluation (INT8 quantized) with per-step state resets.
+ *
+ * Same as slstm_eval_s8, but when reset[b*T + t] is non-zero the state of
+ * batch element b is reinitialized before timestep t: y is set to
+ * y_quant.zero_point (real 0), c/n/m to 0. reset may be NULL. */
+void slstm_eval_reset_s8(
+    const int8_t* input,      /* [B, T, I] */
+    const uint8_t* reset,     /* [B, T] or NULL */
+    const int8_t* W_q,        /* [4*H, I] */
+    const int8_t* R_q,        /* [4*H, H] */
+    const int32_t* b_q,       /* [4*H] */
+    int8_t* y,                /* [B, H] in/out */
+    int16_t* c,               /* [B, H] in/out */
+    int16_t* n,               /* [B, H] in/out */
+    float* m,                 /* [B, H] in/out */
+    int8_t* output,           /* [B, T, H] */
+    int32_t* scratch,         /* [4*H] */
+    int batch_size,
+    int time_steps,
+    int input_size,
+    int hidden_size,
+    const SlstmS8Params* params);
+
+/* Bytes of the buffer slstm_pack_s8 fills: the corrections only. */
+size_t slstm_pack_s8_size(int input_size, int hidden_size);
+
+/* Write the row corrections for params->x_quant / y_quant zero points to buf
+ * (slstm_pack_s8_size bytes, 4-byte aligned) and point *packed at them and
+ * at W_q/R_q, which are not copied and must outlive *packed. To run from
+ * faster memory, copy W_q (4*H*I bytes) and R_q (4*H*H bytes) there first
+ * and pack from the copies. Repack when a zero point changes. */
+void slstm_pack_s8(
+    const int8_t* W_q,        /* [4*H, I] */
+    const int8_t* R_q,        /* [4*H, H] */
+    int input_size,
+    int hidden_size,
+    const SlstmS8Params* params,
+    void* buf,
+    SlstmS8Packed* packed);
+
+/* slstm_eval_s8 on packed weights. */
+void slstm_eval_packed_s8(
+    const int8_t* input,      /* [B, T, I] */
+    const SlstmS8Packed* packed,
+    const int32_t* b_q,       /* [4*H] */
+    int8_t* y,                /* [B, H] in/out */
+    int16_t* c,               /* [B, H] in/out */
+    int16_t* n,               /* [B, H] in/out */
+    float* m,                 /* [B, H] in/out */
+    int8_t* output,           /* [B, T, H] */
+    int32_t* scratch,         /* [4*H] */
+    int batch_size,
+    int time_steps,
+    int input_size,
+    int hidden_size,
+    const SlstmS8Params* params);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,319 @@
+/* Copyright 2026 RAWS labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * =========================================================================
+ * C++17 wrapper over the cell kernels — header-only, no extra code.
+ *
+ *   xlstm::MlstmSession<float> cell(I, H, B);        // states + scratch
+ *   xlstm::MlstmWeights<float> w{W, {}, b};          // spans, no copy
+ *   if (cell.eval(w, x, out, T) != XLSTM_OK) ...     // sizes checked
+ *
+ * Span<T> is a pointer + length view (std::span is C++20). A Session owns
+ * the y/c|C/n/m states of batch_size streams and the kernel scratch; both
+ * are allocated once in the constructor, sized from the cell dimensions,
+ * and nothing is allocated per call. Sessions are move-only.
+ *
+ * The dtype picks the kernels at compile time: float runs slstm/mlstm_*_f32,
+ * int8_t runs the INT8 kernels (INT8 activations, INT16 c|C/n, INT32 bias
+ * and scratch, float m; Params is SlstmS8Params/MlstmS8Params). eval checks
+ * every span against the dimensions before touching the kernels:
+ * XLSTM_ERR_SHAPE for weights of the wrong size, XLSTM_ERR_SIZE for
+ * input/output/reset spans that are too small. No exceptions are thrown;
+ * allocation uses nothrow new and a failed session reports !valid().
+ * ===========================================================================*/
+
+#ifndef XLSTM_HPP_
+#define XLSTM_HPP_
+
+#include "slstm.h"
+#include "mlstm.h"
+#include "slstm_q8.h"
+#include "mlstm_q8.h"
+#include "xlstm_types.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace xlstm {
+
+// ============================================================================
+// Span
+// ============================================================================
+
+template <typename T>
+class Span {
+  public:
+    constexpr Span() noexcept = default;
+    constexpr Span(T* data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+    template <std::size_t N>
+    constexpr Span(T (&array)[N]) noexcept : data_(array), size_(N) {}
+
+    /* Any contiguous container with data() and size() (std::vector, Span) */
+    template <typename C,
+              typename = std::enable_if_t<
+                  std::is_convertible_v<decltype(std::declval<C&>().data()), T*>>>
+    constexpr Span(C& c) noexcept : data_(c.data()), size_(c.size()) {}
+
+    constexpr T* data() const noexcept { return data_; }
+    constexpr std::size_t size() const noexcept { return size_; }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+    constexpr T& operator[](std::size_t i) const noexcept { return data_[i]; }
+    constexpr T* begin() const noexcept { return data_; }
+    constexpr T* end() const noexcept { return data_ + size_; }
+
+    /* Elements [offset, offset + count), clamped to the view */
+    constexpr Span subspan(std::size_t offset, std::size_t count) const noexcept {
+        if (offset > size_) offset = size_;
+        if (count > size_ - offset) count = size_ - offset;
+        return Span(data_ + offset, count);
+    }
+
+  private:
+    T* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+// ============================================================================
+// Cell traits — compile-time dtype dispatch
+// ============================================================================
+
+template <typename T>
+struct Slstm;
+
+template <typename T>
+struct Mlstm;
+
+template <>
+struct Slstm<float> {
+    using Weight = float;
+    using Bias = float;
+    using Act = float;
+    using State = float;
+    using Scratch = float;
+    using Params = SlstmParams;
+    static constexpr bool kRecurrent = true;
+
+    static std::size_t gates(int H) { return 4 * (std::size_t)H; }
+    static std::size_t c_size(int H) { return (std::size_t)H; }
+    static std::size_t m_size(int H) { return (std::size_t)H; }
+    static Act y_zero(const Params&) { return 0.0f; }
+
+    static void eval(const Act* x, const uint8_t* reset, const Weight* W, const Weight* R,
+                     const Bias* b, Act* y, State* c, State* n, float* m, Act* out,
+                     Scratch* scratch, int B, int T, int I, int H, const Params* p) {
+        slstm_eval_reset_f32(x, reset, W, R, b, y, c, n, m, out, scratch, B, T, I, H, p);
+    }
+};
+
+template <>
+struct Slstm<int8_t> {
+    using Weight = int8_t;
+    using Bias = int32_t;
+    using Act = int8_t;
+    using State = int16_t;
+    using Scratch = int32_t;
+    using Params = SlstmS8Params;
+    static constexpr bool kRecurrent = true;
+
+    static std::size_t gates(int H) { return 4 * (std::size_t)H; }
+    static std::size_t c_size(int H) { return (std::size_t)H; }
+    static std::size_t m_size(int H) { return (std::size_t)H; }
+    static Act y_zero(const Params& p) { return (Act)p.y_quant.zero_point; }
+
+    static void eval(const Act* x, const uint8_t* reset, const Weight* W, const Weight* R,
+                     const Bias* b, Act* y, State* c, State* n, float* m, Act* out,
+                     Scratch* scratch, int B, int T, int I, int H, const Params* p) {
+        slstm_eval_reset_s8(x, reset, W, R, b, y, c, n, m, out, scratch, B, T, I, H, p);
+    }
+};
+
+template <>
+struct Mlstm<float> {
+    using Weight = float;
+    using Bias = float;
+    using Act = float;
+    using State = float;
+    using Scratch = float;
+    using Params = MlstmParams;
+    static constexpr bool kRecurrent = false;
+
+    static std::size_t gates(int H) { return 4 * (std::size_t)H + 2; }
+    static std::size_t c_size(int H) { return (std::size_t)H * H; }
+    static std::size_t m_size(int) { return 1; }
+    static Act y_zero(const Params&) { return 0.0f; }
+
+    static void eval(const Act* x, const uint8_t* reset, const Weight* W, const Weight*,
+                     const Bias* b, Act* y, State* C, State* n, float* m, Act* out,
+                     Scratch* scratch, int B, int T, int I, int H, const Params* p) {
+        mlstm_eval_reset_f32(x, reset, W, b, y, C, n, m, out, scratch, B, T, I, H, p);
+    }
+};
+
+template <>
+struct Mlstm<int8_t> {
+    using Weight = int8_t;
+    using Bias = int32_t;
+    using Act = int8_t;
+    using State = int16_t;
+    using Scratch = int32_t;
+    using Params = MlstmS8Params;
+    static constexpr bool kRecurrent = false;
+
+    static std::size_t gates(int H) { return 4 * (std::size_t)H + 2; }
+    static std::size_t c_size(int H) { return (std::size_t)H * H; }
+    static std::size_t m_size(int) { return 1; }
+    static Act y_zero(const Params& p) { return (Act)p.y_quant.zero_point; }
+
+    static void eval(const Act* x, const uint8_t* reset, const Weight* W, const Weight*,
+                     const Bias* b, Act* y, State* C, State* n, float* m, Act* out,
+                     Scratch* scratch, int B, int T, int I, int H, const Params* p) {
+        mlstm_eval_reset_s8(x, reset, W, b, y, C, n, m, out, scratch, B, T, I, H, p);
+    }
+};
+
+// ============================================================================
+// Weights and sessions
+// ============================================================================
+
+/* Packed cell weights in kernel layout: W [gates, I], R [gates, H] (sLSTM
+ * only, leave empty for mLSTM), b [gates]. */
+template <typename Cell>
+struct Weights {
+    Span<const typename Cell::Weight> W;
+    Span<const typename Cell::Weight> R;
+    Span<const typename Cell::Bias> b;
+};
+
+template <typename Cell>
+class Session {
+  public:
+    using Act = typename Cell::Act;
+    using State = typename Cell::State;
+    using Scratch = typename Cell::Scratch;
+    using Params = typename Cell::Params;
+    using CellWeights = Weights<Cell>;
+
+    /* States start at zero (y at the INT8 zero point). */
+    Session(int input_size, int hidden_size, int batch_size,
+            const Params& params = Params()) noexcept
+        : I_(input_size), H_(hidden_size), B_(batch_size), params_(params) {
+        if (I_ <= 0 || H_ <= 0 || B_ <= 0) return;
+        y_ = Alloc<Act>((std::size_t)B_ * H_);
+        c_ = Alloc<State>((std::size_t)B_ * Cell::c_size(H_));
+        n_ = Alloc<State>((std::size_t)B_ * H_);
+        m_ = Alloc<float>((std::size_t)B_ * Cell::m_size(H_));
+        scratch_ = Alloc<Scratch>(Cell::gates(H_));
+        if (!y_ || !c_ || !n_ || !m_ || !scratch_) {
+            scratch_.reset();
+            return;
+        }
+        reset();
+    }
+
+    Session(const Session&) = delete;
+    Session& operator=(const Session&) = delete;
+    Session(Session&&) noexcept = default;
+    Session& operator=(Session&&) noexcept = default;
+
+    /* Dimensions were positive and every buffer was allocated */
+    bool valid() const noexcept { return scratch_ != nullptr; }
+
+    int input_size() const noexcept { return I_; }
+    int hidden_size() const noexcept { return H_; }
+    int batch_size() const noexcept { return B_; }
+
+    Params& params() noexcept { return params_; }
+    const Params& params() const noexcept { return params_; }
+
+    /* Run time_steps steps of every stream: input [B, T, I] -> output
+     * [B, T, H], states carried over from the previous call. reset is
+     * empty or [B, T] (non-zero clears that stream before the step). */
+    int eval(const CellWeights& w, Span<const Act> input, Span<Act> output,
+             int time_steps, Span<const uint8_t> reset = {}) noexcept {
+        std::size_t rows = (std::size_t)B_ * (std::size_t)time_steps;
+
+        if (!valid() || time_steps < 0) return XLSTM_ERR_ARG;
+        if (w.W.size() != Cell::gates(H_) * I_ || w.b.size() != Cell::gates(H_)) {
+            return XLSTM_ERR_SHAPE;
+        }
+        if (Cell::kRecurrent ? w.R.size() != Cell::gates(H_) * H_ : !w.R.empty()) {
+            return XLSTM_ERR_SHAPE;
+        }
+        if (input.size() < rows * I_ || output.size() < rows * H_) return XLSTM_ERR_SIZE;
+        if (!reset.empty() && reset.size() < rows) return XLSTM_ERR_SIZE;
+        if (time_steps == 0) return XLSTM_OK;
+
+        Cell::eval(input.data(), reset.empty() ? nullptr : reset.data(),
+                   w.W.data(), w.R.data(), w.b.data(), y_.get(), c_.get(), n_.get(),
+                   m_.get(), output.data(), scratch_.get(), B_, time_steps, I_, H_,
+                   &params_);
+        return XLSTM_OK;
+    }
+
+    /* Clear every stream's state */
+    void reset() noexcept {
+        if (!valid()) return;
+        Fill(y(), Cell::y_zero(params_));
+        Fill(c(), State(0));
+        Fill(n(), State(0));
+        Fill(m(), 0.0f);
+    }
+
+    /* State views: y [B, H], c [B, H] resp. C [B, H*H], n [B, H],
+     * m [B, H] resp. [B] */
+    Span<Act> y() const noexcept { return Span<Act>(y_.get(), Size((std::size_t)H_)); }
+    Span<State> c() const noexcept { return Span<State>(c_.get(), Size(Cell::c_size(H_))); }
+    Span<State> n() const noexcept { return Span<State>(n_.get(), Size((std::size_t)H_)); }
+    Span<float> m() const noexcept { return Span<float>(m_.get(), Size(Cell::m_size(H_))); }
+
+  private:
+    template <typename U>
+    static std::unique_ptr<U[]> Alloc(std::size_t n) noexcept {
+        return std::unique_ptr<U[]>(new (std::nothrow) U[n]());
+    }
+
+    template <typename U>
+    static void Fill(Span<U> s, U v) noexcept {
+        for (U& e : s) e = v;
+    }
+
+    std::size_t Size(std::size_t per_stream) const noexcept {
+        return valid() ? (std::size_t)B_ * per_stream : 0;
+    }
+
+    int I_ = 0, H_ = 0, B_ = 0;
+    Params params_;
+    std::unique_ptr<Act[]> y_;
+    std::unique_ptr<State[]> c_;
+    std::unique_ptr<State[]> n_;
+    std::unique_ptr<float[]> m_;
+    std::unique_ptr<Scratch[]> scratch_;
+};
+
+template <typename T>
+using SlstmWeights = Weights<Slstm<T>>;
+template <typename T>
+using MlstmWeights = Weights<Mlstm<T>>;
+template <typename T>
+using SlstmSession = Session<Slstm<T>>;
+template <typename T>
+using MlstmSession = Session<Mlstm<T>>;
+
+}  // namespace xlstm
+
+#endif /* XLSTM_HPP_ */
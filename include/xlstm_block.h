@@ -0,0 +1,151 @@
+/* Copyright 2026 RAWS labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * =========================================================================
+ * xLSTM residual blocks — fused per-timestep pipelines around the cells.
+ *
+ * mLSTM block (pre up-projection), D = embed_dim, H = inner_dim:
+ *   xn     = LayerNorm(x)                                   [D]
+ *   xm, z  = split(W_up xn + b_up)                          [H], [H]
+ *   xc     = swish(CausalConv_K(xm))                        [H]
+ *   h      = mLSTM cell on [xc | xm]                        [H]
+ *   h      = (GroupNorm(h) + skip * xc) * swish(z)
+ *   out    = x + W_down h + b_down                          [D]
+ *
+ * sLSTM block (post up-projection), cell hidden size = D, F = ffn_dim:
+ *   xn     = LayerNorm(x)                                   [D]
+ *   xc     = swish(CausalConv_K(xn))                        [D]
+ *   r      = x + GroupNorm(sLSTM cell on [xc | xn])         [D]
+ *   u, g   = split(W_up LayerNorm2(r) + b_up)               [F], [F]
+ *   out    = r + W_down (gelu(u) * g) + b_down              [D]
+ *
+ * The cells take the concatenation [conv branch | unconvolved branch] as
+ * their input (input_size = 2*H resp. 2*D), so the packed cell W can give
+ * each gate the branch it uses in the reference blocks (q/k and i/f from
+ * the conv branch, v resp. z/o from the other) by zeroing the other half.
+ *
+ * GroupNorm runs over num_heads equal groups of the cell output. Biases
+ * marked "or NULL" are optional. All intermediates live in caller scratch.
+ * ===========================================================================*/
+
+#ifndef XLSTM_BLOCK_H_
+#define XLSTM_BLOCK_H_
+
+#include "slstm.h"
+#include "mlstm.h"
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    int embed_dim;            /* D */
+    int inner_dim;            /* H, cell hidden size */
+    int conv_kernel;          /* K >= 1 */
+    int num_heads;            /* GroupNorm groups, divides H */
+    const float* ln_w;        /* [D] */
+    const float* ln_b;        /* [D] or NULL */
+    const float* up_W;        /* [2*H, D] */
+    const float* up_b;        /* [2*H] or NULL */
+    const float* conv_w;      /* [H, K], tap K-1 = current step */
+    const float* conv_b;      /* [H] or NULL */
+    const float* cell_W;      /* [4*H+2, 2*H] */
+    const float* cell_b;      /* [4*H+2] */
+    const float* gn_w;        /* [H] */
+    const float* skip;        /* [H] */
+    const float* down_W;      /* [D, H] */
+    const float* down_b;      /* [D] or NULL */
+    MlstmParams cell_params;
+} XlstmMlstmBlock;
+
+typedef struct {
+    int embed_dim;            /* D, also the cell hidden size */
+    int ffn_dim;              /* F */
+    int conv_kernel;          /* K >= 1 */
+    int num_heads;            /* GroupNorm groups, divides D */
+    const float* ln_w;        /* [D] */
+    const float* ln_b;        /* [D] or NULL */
+    const float* conv_w;      /* [D, K], tap K-1 = current step */
+    const float* conv_b;      /* [D] or NULL */
+    const float* cell_W;      /* [4*D, 2*D] */
+    const float* cell_R;      /* [4*D, D] */
+    const float* cell_b;      /* [4*D] */
+    const float* gn_w;        /* [D] */
+    const float* ln2_w;       /* [D] */
+    const float* ln2_b;       /* [D] or NULL */
+    const float* up_W;        /* [2*F, D] */
+    const float* up_b;        /* [2*F] or NULL */
+    const float* down_W;      /* [D, F] */
+    const float* down_b;      /* [D] or NULL */
+    SlstmParams cell_params;
+} XlstmSlstmBlock;
+
+/* Recurrent state of one block for batch_size streams. Cell arrays use the
+ * layouts of the matching *_eval_f32; conv holds the last K-1 conv inputs
+ * per stream, oldest first: [B, K-1, H] (mLSTM) or [B, K-1, D] (sLSTM).
+ * conv may be NULL when K == 1. Zero everything to start a sequence. */
+typedef struct {
+    float* y;
+    float* c;                 /* sLSTM c or mLSTM C */
+    float* n;
+    float* m;
+    float* conv;
+} XlstmBlockState;
+
+/* Scratch sizes in floats */
+size_t mlstm_block_scratch_size(const XlstmMlstmBlock* blk);
+size_t slstm_block_scratch_size(const XlstmSlstmBlock* blk);
+
+/* Single timestep for batch element `batch` of the state. out may alias x. */
+void mlstm_block_step_f32(
+    const XlstmMlstmBlock* blk,
+    const float* x,           /* [D] */
+    float* out,               /* [D] */
+    const XlstmBlockState* state,
+    int batch,
+    float* scratch);
+
+void slstm_block_step_f32(
+    const XlstmSlstmBlock* blk,
+    const float* x,           /* [D] */
+    float* out,               /* [D] */
+    const XlstmBlockState* state,
+    int batch,
+    float* scratch);
+
+/* Full sequence: input[B, T, D] -> output[B, T, D]. output may alias input. */
+void mlstm_block_eval_f32(
+    const XlstmMlstmBlock* blk,
+    const float* input,
+    float* output,
+    const XlstmBlockState* state,
+    float* scratch,
+    int batch_size,
+    int time_steps);
+
+void slstm_block_eval_f32(
+    const XlstmSlstmBlock* blk,
+    const float* input,
+    float* output,
+    const XlstmBlockState* state,
+    float* scratch,
+    int batch_size,
+    int time_steps);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XLSTM_BLOCK_H_ */
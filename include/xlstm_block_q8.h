@@ -0,0 +1,140 @@
+/* Copyright 2026 RAWS labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * =========================================================================
+ * xLSTM residual blocks, INT8 — same pipelines as xlstm_block.h.
+ *
+ * Storage: INT8 projection and cell weights (symmetric, per tensor), float
+ *          norms, conv, skip and biases of the projections.
+ * Compute: up/down projections are INT8×INT8 → INT32 with the activation
+ *          vector quantized symmetrically per timestep (dynamic scale, no
+ *          calibration needed). The cell runs slstm_step_s8/mlstm_step_s8;
+ *          its input is quantized with cell_params.x_quant and its output
+ *          dequantized with cell_params.y_quant. Norms, conv and gating run
+ *          in float between stages.
+ *
+ * All intermediates live in one caller-provided byte workspace.
+ * ===========================================================================*/
+
+#ifndef XLSTM_BLOCK_Q8_H_
+#define XLSTM_BLOCK_Q8_H_
+
+#include "slstm_q8.h"
+#include "mlstm_q8.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    int embed_dim;            /* D */
+    int inner_dim;            /* H, cell hidden size */
+    int conv_kernel;          /* K >= 1 */
+    int num_heads;            /* GroupNorm groups, divides H */
+    const float* ln_w;        /* [D] */
+    const float* ln_b;        /* [D] or NULL */
+    const int8_t* up_W;       /* [2*H, D] */
+    float up_scale;
+    const float* up_b;        /* [2*H] or NULL */
+    const float* conv_w;      /* [H, K] */
+    const float* conv_b;      /* [H] or NULL */
+    const int8_t* cell_W;     /* [4*H+2, 2*H] */
+    const int32_t* cell_b;    /* [4*H+2] */
+    const float* gn_w;        /* [H] */
+    const float* skip;        /* [H] */
+    const int8_t* down_W;     /* [D, H] */
+    float down_scale;
+    const float* down_b;      /* [D] or NULL */
+    MlstmS8Params cell_params;
+} XlstmMlstmBlockQ8;
+
+typedef struct {
+    int embed_dim;            /* D, also the cell hidden size */
+    int ffn_dim;              /* F */
+    int conv_kernel;          /* K >= 1 */
+    int num_heads;            /* GroupNorm groups, divides D */
+    const float* ln_w;        /* [D] */
+    const float* ln_b;        /* [D] or NULL */
+    const float* conv_w;      /* [D, K] */
+    const float* conv_b;      /* [D] or NULL */
+    const int8_t* cell_W;     /* [4*D, 2*D] */
+    const int8_t* cell_R;     /* [4*D, D] */
+    const int32_t* cell_b;    /* [4*D] */
+    const float* gn_w;        /* [D] */
+    const float* ln2_w;       /* [D] */
+    const float* ln2_b;       /* [D] or NULL */
+    const int8_t* up_W;       /* [2*F, D] */
+    float up_scale;
+    const float* up_b;        /* [2*F] or NULL */
+    const int8_t* down_W;     /* [D, F] */
+    float down_scale;
+    const float* down_b;      /* [D] or NULL */
+    SlstmS8Params cell_params;
+} XlstmSlstmBlockQ8;
+
+/* Block state in the INT8 cell formats; conv as in XlstmBlockState. */
+typedef struct {
+    int8_t* y;
+    int16_t* c;               /* sLSTM c or mLSTM C */
+    int16_t* n;
+    float* m;
+    float* conv;              /* [B, K-1, channels] or NULL when K == 1 */
+} XlstmBlockStateQ8;
+
+/* Workspace sizes in bytes (workspace must be 4-byte aligned) */
+size_t mlstm_block_q8_workspace_size(const XlstmMlstmBlockQ8* blk);
+size_t slstm_block_q8_workspace_size(const XlstmSlstmBlockQ8* blk);
+
+void mlstm_block_step_q8(
+    const XlstmMlstmBlockQ8* blk,
+    const float* x,           /* [D] */
+    float* out,               /* [D], may alias x */
+    const XlstmBlockStateQ8* state,
+    int batch,
+    void* workspace);
+
+void slstm_block_step_q8(
+    const XlstmSlstmBlockQ8* blk,
+    const float* x,
+    float* out,
+    const XlstmBlockStateQ8* state,
+    int batch,
+    void* workspace);
+
+/* Full sequence: input[B, T, D] -> output[B, T, D]. */
+void mlstm_block_eval_q8(
+    const XlstmMlstmBlockQ8* blk,
+    const float* input,
+    float* output,
+    const XlstmBlockStateQ8* state,
+    void* workspace,
+    int batch_size,
+    int time_steps);
+
+void slstm_block_eval_q8(
+    const XlstmSlstmBlockQ8* blk,
+    const float* input,
+    float* output,
+    const XlstmBlockStateQ8* state,
+    void* workspace,
+    int batch_size,
+    int time_steps);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XLSTM_BLOCK_Q8_H_ */
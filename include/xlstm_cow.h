@@ -0,0 +1,140 @@
+/* Copyright 2026 RAWS labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * =========================================================================
+ * Copy-on-write mLSTM state handles for beam search and sampling — C99.
+ *
+ * The H×H matrix C and the vector n live in reference-counted blocks of a
+ * caller-provided pool. C is split into row tiles of tile_rows rows, one
+ * tile block (tile_rows*H floats) per tile; n lives in a block of a second,
+ * H-float class, so sharing or unsharing n never costs a C-sized block. A
+ * state handle is a table of tile ids and an n id plus its private y and m.
+ *
+ * Forking copies the block table and bumps reference counts — no C data is
+ * touched. When a handle steps, each tile it shares with another handle is
+ * written to a freshly allocated block while being updated
+ * (mlstm_step_tiled_f32), so divergence costs no extra pass over C; tiles
+ * it owns alone are updated in place.
+ *
+ * Pool sizing: every live handle needs at most xlstm_cow_blocks_per_state()
+ * tile blocks of tile_rows*H floats and one n block of H floats.
+ * ===========================================================================*/
+
+#ifndef XLSTM_COW_H_
+#define XLSTM_COW_H_
+
+#include "mlstm.h"
+#include "xlstm_types.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* One block class: equally sized reference-counted blocks */
+typedef struct {
+    float* data;             /* [num_blocks, block_size] */
+    int32_t* refcount;       /* [num_blocks] */
+    int32_t* free_list;      /* [num_blocks] stack of free block ids */
+    int num_blocks;
+    int num_free;
+    int block_size;          /* floats per block */
+} XlstmCowBlocks;
+
+typedef struct {
+    XlstmCowBlocks tiles;    /* C row tiles, tile_rows * H floats */
+    XlstmCowBlocks n;        /* n vectors, H floats */
+    const float** tile_src;  /* [num_tiles] step workspace */
+    float** tile_dst;        /* [num_tiles] step workspace */
+    int hidden_size;
+    int tile_rows;
+    int num_tiles;           /* ceil(H / tile_rows) */
+} XlstmCowPool;
+
+typedef struct {
+    int32_t* blocks;         /* [num_tiles] C tile ids */
+    int32_t n_block;         /* n block id */
+    float* y;                /* [H] private */
+    float m;                 /* private */
+} XlstmCowState;
+
+/* Tile blocks referenced by one state handle: ceil(H / tile_rows). Each
+ * handle also references one n block. */
+int xlstm_cow_blocks_per_state(int hidden_size, int tile_rows);
+
+/* Initialize a pool over caller-provided memory (1 <= tile_rows <= H).
+ * Returns XLSTM_OK or XLSTM_ERR_ARG. */
+int xlstm_cow_init(
+    XlstmCowPool* pool,
+    float* blocks,           /* [num_blocks * tile_rows * hidden_size] */
+    int32_t* refcount,       /* [num_blocks] */
+    int32_t* free_list,      /* [num_blocks] */
+    int num_blocks,
+    float* n_blocks,         /* [num_n_blocks * hidden_size] */
+    int32_t* n_refcount,     /* [num_n_blocks] */
+    int32_t* n_free_list,    /* [num_n_blocks] */
+    int num_n_blocks,
+    const float** tile_src,  /* [ceil(hidden_size / tile_rows)] */
+    float** tile_dst,        /* [ceil(hidden_size / tile_rows)] */
+    int hidden_size,
+    int tile_rows);
+
+/* Create a zero state. blocks and y are caller-provided arrays of
+ * xlstm_cow_blocks_per_state() ids and H floats. Returns XLSTM_OK or
+ * XLSTM_ERR_SIZE if either block class is exhausted. */
+int xlstm_cow_state_init(
+    XlstmCowPool* pool,
+    XlstmCowState* state,
+    int32_t* blocks,
+    float* y);
+
+/* Fork src into dst (which provides its own blocks/y arrays). O(num_tiles+H),
+ * independent of the size of C; no block is allocated. */
+void xlstm_cow_fork(
+    XlstmCowPool* pool,
+    XlstmCowState* dst,
+    int32_t* blocks,
+    float* y,
+    const XlstmCowState* src);
+
+/* Drop a handle's references; blocks no longer referenced return to the
+ * pool. */
+void xlstm_cow_release(XlstmCowPool* pool, XlstmCowState* state);
+
+/* Pointer to C tile t or n of a handle (read-only: writing would leak into
+ * every handle sharing the block). */
+const float* xlstm_cow_tile(const XlstmCowPool* pool, const XlstmCowState* state, int t);
+const float* xlstm_cow_n(const XlstmCowPool* pool, const XlstmCowState* state);
+
+/* One mLSTM timestep on a handle; the new output is state->y.
+ *
+ * Shared blocks are unshared as part of the update. Returns XLSTM_OK, or
+ * XLSTM_ERR_SIZE (state untouched) if a block class has too few free
+ * blocks.
+ * Scratch: 4*H+2 floats. */
+int xlstm_cow_step_mlstm_f32(
+    XlstmCowPool* pool,
+    XlstmCowState* state,
+    const float* x,          /* [input_size] */
+    const float* W,          /* [(4*H+2), input_size] */
+    const float* b,          /* [4*H+2] */
+    float* scratch,
+    int input_size,
+    const MlstmParams* params);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XLSTM_COW_H_ */
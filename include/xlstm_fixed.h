@@ -0,0 +1,195 @@
+/* Copyright 2026 RAWS labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * =========================================================================
+ * Fixed-dimension f32 cells — header-only C99, instantiated by macro.
+ *
+ * When input_size and hidden_size are known at build time, instantiate
+ * kernels specialized for them in one translation unit:
+ *
+ *   #include "xlstm_fixed.h"
+ *   XLSTM_DEFINE_SLSTM_F32(enc, 16, 32)   enc_step_f32, enc_eval_f32
+ *   XLSTM_DEFINE_MLSTM_F32(dec, 32, 64)   dec_step_f32, dec_eval_f32
+ *
+ * The generated functions are static and take the arguments of
+ * slstm_step_f32 / slstm_eval_f32 (resp. mlstm_*) minus the sizes and the
+ * scratch buffer: pre-activations live in a [4*H] (mLSTM [4*H+2]) array on
+ * the stack. With the sizes as constants the compiler unrolls the inner
+ * loops and folds the row addressing. The per-unit gate and state math is
+ * the generic kernels' own (xlstm_util.h), so results are identical and
+ * params (cell_clip, flush_denormals) are honoured the same way.
+ * The instrumentation hooks (XLSTM_PROFILE, XLSTM_TRACE) are not included.
+ * ===========================================================================*/
+
+#ifndef XLSTM_FIXED_H_
+#define XLSTM_FIXED_H_
+
+#include "slstm.h"
+#include "mlstm.h"
+#include "xlstm_util.h"
+#include "xlstm_fpenv.h"
+
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define XLSTM_FIXED_INLINE static inline __attribute__((always_inline))
+#define XLSTM_FIXED_FN static __attribute__((unused))
+#else
+#define XLSTM_FIXED_INLINE static inline
+#define XLSTM_FIXED_FN static
+#endif
+
+/* ========================================================================== */
+/* Kernel bodies — sizes are constants after inlining                         */
+/* ========================================================================== */
+
+XLSTM_FIXED_INLINE void xlstm_fixed_slstm_step(
+    const float* x, const float* W, const float* R, const float* b,
+    float* y, float* c, float* n, float* m, float* preact,
+    const int I, const int H, const SlstmParams* params)
+{
+    float clip = params ? params->cell_clip : 0.0f;
+    int i, j;
+
+    /* preact = W*x + R*y + b, layout [i_raw, f_raw, z_raw, o_raw] */
+    for (i = 0; i < 4 * H; ++i) {
+        float acc = b[i];
+        for (j = 0; j < I; ++j) acc += W[i * I + j] * x[j];
+        for (j = 0; j < H; ++j) acc += R[i * H + j] * y[j];
+        preact[i] = acc;
+    }
+
+    for (i = 0; i < H; ++i) {
+        slstm_unit_f32(preact[i], preact[H + i], preact[2 * H + i], preact[3 * H + i],
+                       clip, &y[i], &c[i], &n[i], &m[i]);
+    }
+}
+
+XLSTM_FIXED_INLINE void xlstm_fixed_mlstm_step(
+    const float* x, const float* W, const float* b,
+    float* y, float* C, float* n, float* m, float* preact,
+    const int I, const int H, const MlstmParams* params)
+{
+    float* q = preact;
+    float* k = preact + H;
+    float* v = preact + 2 * H;
+    float* o_raw = preact + 3 * H + 2;
+    float clip = params ? params->cell_clip : 0.0f;
+    float k_scale, m_new, f_gate, i_gate, qn, denom;
+    int i, j;
+
+    /* preact = W*x + b, layout [q, k, v, i_raw, f_raw, o_raw] */
+    for (i = 0; i < 4 * H + 2; ++i) {
+        float acc = b[i];
+        for (j = 0; j < I; ++j) acc += W[i * I + j] * x[j];
+        preact[i] = acc;
+    }
+
+    k_scale = 1.0f / sqrtf((float)H);
+    for (i = 0; i < H; ++i) k[i] *= k_scale;
+
+    m_new = mlstm_gates_f32(preact[3 * H], preact[3 * H + 1], m[0], &f_gate, &i_gate);
+
+    for (i = 0; i < H; ++i) {
+        float ik = i_gate * k[i];
+        for (j = 0; j < H; ++j) {
+            C[i * H + j] = mlstm_c_update_f32(C[i * H + j], f_gate, ik, v[j], clip);
+        }
+    }
+    for (i = 0; i < H; ++i) n[i] = f_gate * n[i] + i_gate * k[i];
+    m[0] = m_new;
+
+    qn = 0.0f;
+    for (i = 0; i < H; ++i) qn += q[i] * n[i];
+    denom = mlstm_denom_f32(qn, m_new);
+
+    for (j = 0; j < H; ++j) {
+        float qC_j = 0.0f;
+        for (i = 0; i < H; ++i) qC_j += q[i] * C[i * H + j];
+        y[j] = sigmoid_f32(o_raw[j]) * (qC_j / denom);
+    }
+}
+
+/* ========================================================================== */
+/* Instantiation macros                                                       */
+/* ========================================================================== */
+
+/* name##_step_f32(x, W, R, b, y, c, n, m, params)
+ * name##_eval_f32(input, W, R, b, y, c, n, m, output, B, T, params) */
+#define XLSTM_DEFINE_SLSTM_F32(name, I, H)                                    \
+XLSTM_FIXED_FN void name##_step_f32(                                          \
+    const float* x, const float* W, const float* R, const float* b,           \
+    float* y, float* c, float* n, float* m, const SlstmParams* params)        \
+{                                                                             \
+    float preact[4 * (H)];                                                    \
+    xlstm_fixed_slstm_step(x, W, R, b, y, c, n, m, preact, (I), (H), params); \
+}                                                                             \
+XLSTM_FIXED_FN void name##_eval_f32(                                          \
+    const float* input, const float* W, const float* R, const float* b,       \
+    float* y, float* c, float* n, float* m, float* output,                    \
+    int batch_size, int time_steps, const SlstmParams* params)                \
+{                                                                             \
+    float preact[4 * (H)];                                                    \
+    XlstmFpEnv fpenv = {0, 0};                                                \
+    int flush = params && params->flush_denormals;                            \
+    int bt, t;                                                                \
+    if (flush) xlstm_fpenv_flush_begin(&fpenv);                               \
+    for (bt = 0; bt < batch_size; ++bt) {                                     \
+        for (t = 0; t < time_steps; ++t) {                                    \
+            size_t row = (size_t)bt * time_steps + t;                         \
+            xlstm_fixed_slstm_step(input + row * (I), W, R, b,                \
+                                   y + bt * (H), c + bt * (H),                \
+                                   n + bt * (H), m + bt * (H),                \
+                                   preact, (I), (H), params);                 \
+            memcpy(output + row * (H), y + bt * (H), (H) * sizeof(float));    \
+        }                                                                     \
+    }                                                                         \
+    if (flush) xlstm_fpenv_flush_end(&fpenv);                                 \
+}
+
+/* name##_step_f32(x, W, b, y, C, n, m, params)
+ * name##_eval_f32(input, W, b, y, C, n, m, output, B, T, params) */
+#define XLSTM_DEFINE_MLSTM_F32(name, I, H)                                    \
+XLSTM_FIXED_FN void name##_step_f32(                                          \
+    const float* x, const float* W, const float* b,                           \
+    float* y, float* C, float* n, float* m, const MlstmParams* params)        \
+{                                                                             \
+    float preact[4 * (H) + 2];                                                \
+    xlstm_fixed_mlstm_step(x, W, b, y, C, n, m, preact, (I), (H), params);    \
+}                                                                             \
+XLSTM_FIXED_FN void name##_eval_f32(                                          \
+    const float* input, const float* W, const float* b,                       \
+    float* y, float* C, float* n, float* m, float* output,                    \
+    int batch_size, int time_steps, const MlstmParams* params)                \
+{                                                                             \
+    float preact[4 * (H) + 2];                                                \
+    XlstmFpEnv fpenv = {0, 0};                                                \
+    int flush = params && params->flush_denormals;                            \
+    int bt, t;                                                                \
+    if (flush) xlstm_fpenv_flush_begin(&fpenv);                               \
+    for (bt = 0; bt < batch_size; ++bt) {                                     \
+        for (t = 0; t < time_steps; ++t) {                                    \
+            size_t row = (size_t)bt * time_steps + t;                         \
+            xlstm_fixed_mlstm_step(input + row * (I), W, b,                   \
+                                   y + bt * (H), C + (size_t)bt * (H) * (H),  \
+                                   n + bt * (H), m + bt,                      \
+                                   preact, (I), (H), params);                 \
+            memcpy(output + row * (H), y + bt * (H), (H) * sizeof(float));    \
+        }                                                                     \
+    }                                                                         \
+    if (flush) xlstm_fpenv_flush_end(&fpenv);                                 \
+}
+
+#endif /* XLSTM_FIXED_H_ */
@@ -0,0 +1,92 @@
+/* Copyright 2026 RAWS labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * =========================================================================
+ * Denormal-flushing FP mode — pure inline C99.
+ *
+ * Under a forget gate below 1, untouched entries of the mLSTM C and the
+ * sLSTM c/n shrink geometrically and, over long streams, pass through the
+ * subnormal range, where x86 arithmetic is 10-100x slower. The f32 evals
+ * set flush-to-zero (and denormals-are-zero on x86) for their duration
+ * when params->flush_denormals is set, and restore the caller's mode on
+ * return. Only the control bits are changed; rounding and exception masks
+ * are left alone.
+ *
+ *   x86 (SSE)          MXCSR FTZ (bit 15) + DAZ (bit 6)
+ *   AArch64            FPCR FZ (bit 24)
+ *   ARM with VFP/FPv4  FPSCR FZ (bit 24), flushes inputs and outputs
+ *   other targets      no-op (xlstm_fpenv_flush_begin returns 0)
+ * ===========================================================================*/
+
+#ifndef XLSTM_FPENV_H_
+#define XLSTM_FPENV_H_
+
+#include <stdint.h>
+
+#if defined(__SSE__) || defined(__x86_64__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define XLSTM_FPENV_SSE 1
+#elif defined(__aarch64__)
+#define XLSTM_FPENV_A64 1
+#elif defined(__arm__) && defined(__ARM_FP)
+#define XLSTM_FPENV_VFP 1
+#endif
+
+typedef struct {
+    uint64_t saved;   /* control register before flush_begin */
+    int active;       /* 1 if saved must be restored */
+} XlstmFpEnv;
+
+/* Enable flushing, saving the current mode in env. Returns 1 if the
+ * target supports it, 0 otherwise (env is then a no-op for flush_end). */
+static inline int xlstm_fpenv_flush_begin(XlstmFpEnv* env) {
+#if defined(XLSTM_FPENV_SSE)
+    unsigned int csr = _mm_getcsr();
+    env->saved = csr;
+    env->active = 1;
+    _mm_setcsr(csr | 0x8040u);
+    return 1;
+#elif defined(XLSTM_FPENV_A64)
+    uint64_t fpcr;
+    __asm__ __volatile__("mrs %0, fpcr" : "=r"(fpcr));
+    env->saved = fpcr;
+    env->active = 1;
+    __asm__ __volatile__("msr fpcr, %0" : : "r"(fpcr | (1u << 24)));
+    return 1;
+#elif defined(XLSTM_FPENV_VFP)
+    uint32_t fpscr;
+    __asm__ __volatile__("vmrs %0, fpscr" : "=r"(fpscr));
+    env->saved = fpscr;
+    env->active = 1;
+    __asm__ __volatile__("vmsr fpscr, %0" : : "r"(fpscr | (1u << 24)));
+    return 1;
+#else
+    env->saved = 0;
+    env->active = 0;
+    return 0;
+#endif
+}
+
+/* Restore the mode saved by xlstm_fpenv_flush_begin. */
+static inline void xlstm_fpenv_flush_end(const XlstmFpEnv* env) {
+    if (!env->active) return;
+#if defined(XLSTM_FPENV_SSE)
+    _mm_setcsr((unsigned int)env->saved);
+#elif defined(XLSTM_FPENV_A64)
+    __asm__ __volatile__("msr fpcr, %0" : : "r"(env->saved));
+#elif defined(XLSTM_FPENV_VFP)
+    __asm__ __volatile__("vmsr fpscr, %0" : : "r"((uint32_t)env->saved));
+#endif
+}
+
+#endif /* XLSTM_FPENV_H_ */
@@ -0,0 +1,218 @@
+/* Copyright 2026 RAWS labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * =========================================================================
+ * Model weight files — self-describing binary format, zero-copy loader.
+ *
+ * File layout (native byte order, all offsets from the file start):
+ *   [0, 64)          XlstmModelHeader
+ *   layer table      num_layers   x XlstmModelLayer  (64 bytes each)
+ *   tensor table     num_tensors  x XlstmModelTensor (48 bytes each)
+ *   tensor data      each tensor aligned to XLSTM_MODEL_ALIGN bytes
+ *
+ * Tensors are stored exactly as the kernels consume them (the packed W/R/b
+ * layouts documented in slstm.h, mlstm.h, *_q8.h and xlstm_block*.h), so
+ * binding a layer only hands out pointers into the file. Map the file
+ * read-only (xlstm_model_map) and startup costs a header walk regardless of
+ * model size; the pages are shared between processes through the page cache.
+ *
+ * Layer dims by kind:
+ *   SLSTM_F32 / SLSTM_S8 / MLSTM_F32 / MLSTM_S8     input_size, hidden_size
+ *   MLSTM_BLOCK_F32 / _Q8    embed_dim, inner_dim, conv_kernel, num_heads
+ *   SLSTM_BLOCK_F32 / _Q8    embed_dim, ffn_dim, conv_kernel, num_heads
+ *
+ * Tensor shapes are [rows, cols]; vectors are [len, 1]. INT8 weight tensors
+ * carry their symmetric scale in quant; the layer record carries the cell's
+ * activation/state quant params. Optional tensors (biases marked "or NULL"
+ * in the block headers) may be omitted.
+ * ===========================================================================*/
+
+#ifndef XLSTM_MODEL_H_
+#define XLSTM_MODEL_H_
+
+#include "xlstm_types.h"
+#include "xlstm_quant.h"
+#include "slstm_q8.h"
+#include "mlstm_q8.h"
+#include "xlstm_stack.h"
+#include "xlstm_block.h"
+#include "xlstm_block_q8.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define XLSTM_MODEL_MAGIC 0x4D534C58u /* "XLSM" */
+#define XLSTM_MODEL_VERSION 1
+#define XLSTM_MODEL_ALIGN 64
+
+/* Tensor roles within a layer (stored in files — values are stable) */
+typedef enum {
+    XLSTM_ROLE_CELL_W = 1,
+    XLSTM_ROLE_CELL_R = 2,
+    XLSTM_ROLE_CELL_B = 3,
+    XLSTM_ROLE_LN_W = 4,
+    XLSTM_ROLE_LN_B = 5,
+    XLSTM_ROLE_UP_W = 6,
+    XLSTM_ROLE_UP_B = 7,
+    XLSTM_ROLE_CONV_W = 8,
+    XLSTM_ROLE_CONV_B = 9,
+    XLSTM_ROLE_GN_W = 10,
+    XLSTM_ROLE_SKIP = 11,
+    XLSTM_ROLE_DOWN_W = 12,
+    XLSTM_ROLE_DOWN_B = 13,
+    XLSTM_ROLE_LN2_W = 14,
+    XLSTM_ROLE_LN2_B = 15
+} XlstmTensorRole;
+
+typedef struct {
+    uint32_t magic;              /* XLSTM_MODEL_MAGIC */
+    uint16_t version;            /* XLSTM_MODEL_VERSION */
+    uint16_t reserved0;
+    uint32_t num_layers;
+    uint32_t num_tensors;
+    uint64_t total_size;         /* file size in bytes */
+    uint64_t layer_offset;       /* start of the layer table */
+    uint64_t tensor_offset;      /* start of the tensor table */
+    uint32_t reserved1[6];
+} XlstmModelHeader;              /* 64 bytes */
+
+typedef struct {
+    uint8_t kind;                /* XlstmKind */
+    uint8_t reserved0[3];
+    uint32_t dims[4];            /* see the table above, unused dims are 0 */
+    uint32_t first_tensor;       /* index into the tensor table */
+    uint32_t num_tensors;
+    float cell_clip;
+    XlstmQuantParam x_quant;     /* INT8 kinds only, zero otherwise */
+    XlstmQuantParam y_quant;
+    XlstmQuantParam c_quant;     /* c (sLSTM) or C (mLSTM) */
+    XlstmQuantParam n_quant;
+} XlstmModelLayer;               /* 64 bytes */
+
+typedef struct {
+    uint8_t role;                /* XlstmTensorRole */
+    uint8_t dtype;               /* XlstmDtype */
+    uint16_t reserved0;
+    uint32_t rows;
+    uint32_t cols;
+    uint32_t reserved1;
+    uint64_t offset;             /* XLSTM_MODEL_ALIGN-aligned */
+    uint64_t nbytes;             /* rows * cols * dtype size */
+    XlstmQuantParam quant;       /* weight scale for INT8 tensors */
+    uint64_t reserved2;
+} XlstmModelTensor;              /* 48 bytes */
+
+/* Validated model. Pointers alias the file memory. */
+typedef struct {
+    const uint8_t* data;
+    size_t size;
+    const XlstmModelLayer* layers;
+    const XlstmModelTensor* tensors;
+    int num_layers;
+    int num_tensors;
+} XlstmModel;
+
+/* Validate a model file image and fill model. data must be aligned to
+ * XLSTM_MODEL_ALIGN bytes (mmap and the aligned allocators guarantee it).
+ * Every tensor is bounds-, alignment- and size-checked here, so the bind
+ * functions below only need to match roles and shapes.
+ * Returns XLSTM_OK or a negative XlstmStatus. */
+int xlstm_model_open(XlstmModel* model, const void* data, size_t size);
+
+/* Tensor of the given role in layer l, or NULL if the layer has none. */
+const XlstmModelTensor* xlstm_model_find(
+    const XlstmModel* model, int layer, XlstmTensorRole role);
+
+/* Bind layer l to the kernel-facing structs. Weight pointers alias the
+ * file; state, scratch and any field the file does not describe are left
+ * untouched. Returns XLSTM_OK, XLSTM_ERR_ARG (l out of range),
+ * XLSTM_ERR_FORMAT (wrong kind, missing tensor or wrong dtype) or
+ * XLSTM_ERR_SHAPE (a layer dim is 0 or above 0x1FFFFFFF, or a tensor shape
+ * does not match the layer dims). */
+
+/* SLSTM_F32 or MLSTM_F32 layer: kind, sizes, W, R, b and cell params. */
+int xlstm_model_bind_stack_layer(
+    const XlstmModel* model, int layer, XlstmStackLayer* out);
+
+int xlstm_model_bind_slstm_s8(
+    const XlstmModel* model, int layer,
+    const int8_t** W, const int8_t** R, const int32_t** b,
+    SlstmS8Params* params);
+
+int xlstm_model_bind_mlstm_s8(
+    const XlstmModel* model, int layer,
+    const int8_t** W, const int32_t** b,
+    MlstmS8Params* params);
+
+int xlstm_model_bind_mlstm_block(
+    const XlstmModel* model, int layer, XlstmMlstmBlock* out);
+
+int xlstm_model_bind_slstm_block(
+    const XlstmModel* model, int layer, XlstmSlstmBlock* out);
+
+int xlstm_model_bind_mlstm_block_q8(
+    const XlstmModel* model, int layer, XlstmMlstmBlockQ8* out);
+
+int xlstm_model_bind_slstm_block_q8(
+    const XlstmModel* model, int layer, XlstmSlstmBlockQ8* out);
+
+/* ---- Writer ---- */
+
+typedef struct {
+    XlstmTensorRole role;
+    XlstmDtype dtype;
+    int rows;
+    int cols;
+    const void* data;
+    XlstmQuantParam quant;
+} XlstmModelTensorDesc;
+
+typedef struct {
+    XlstmModelLayer layer;       /* kind, dims, cell_clip, quant params;
+                                  * first_tensor/num_tensors are filled in */
+    const XlstmModelTensorDesc* tensors;
+    int num_tensors;
+} XlstmModelLayerDesc;
+
+/* Serialize layers into out. Returns the file size in bytes; the file is
+ * written only if out is non-NULL and out_size is at least that size, so a
+ * NULL out queries the size. Returns 0 for invalid descriptors. */
+size_t xlstm_model_write(
+    const XlstmModelLayerDesc* layers, int num_layers,
+    void* out, size_t out_size);
+
+/* ---- File mapping (POSIX, xlstm_model_posix.c) ---- */
+
+typedef struct {
+    void* addr;
+    size_t size;
+} XlstmModelMapping;
+
+/* mmap path read-only and open it into model. On success the mapping must
+ * be released with xlstm_model_unmap once the model is no longer used.
+ * Returns XLSTM_OK, XLSTM_ERR_ARG (file cannot be opened or mapped) or the
+ * status of xlstm_model_open. */
+int xlstm_model_map(const char* path, XlstmModelMapping* mapping,
+                    XlstmModel* model);
+
+void xlstm_model_unmap(XlstmModelMapping* mapping);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XLSTM_MODEL_H_ */
@@ -0,0 +1,115 @@
+/* Copyright 2026 RAWS labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * =========================================================================
+ * Buffer size queries and static arena planning — C99.
+ *
+ * Size queries return bytes for every buffer a kernel or block call needs:
+ * the persistent state arrays (y, c|C, n, m, conv history) and the
+ * per-call scratch/workspace, so callers no longer derive 4*H+2 or B*H*H
+ * by hand.
+ *
+ * The planner lays out a set of buffers with known lifetimes in one arena.
+ * A lifetime is an inclusive range of steps [first_use, last_use]; two
+ * buffers whose lifetimes overlap never share bytes, all others may.
+ * Placement is greedy, largest buffer first, each at the lowest aligned
+ * offset that is free for its whole lifetime. Plan once at startup,
+ * allocate the returned size once, then slice it with the offsets.
+ *
+ * xlstm_plan_model builds that buffer list for a model file: step l runs
+ * layer l, states live for the whole model, scratch only during its layer,
+ * and the [B, T, D] activations of layer l live for steps l and l+1, so
+ * scratch and activations are reused across layers.
+ * ===========================================================================*/
+
+#ifndef XLSTM_PLAN_H_
+#define XLSTM_PLAN_H_
+
+#include "xlstm_types.h"
+#include "xlstm_model.h"
+#include "xlstm_block.h"
+#include "xlstm_block_q8.h"
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define XLSTM_PLAN_ALIGN 64
+
+/* Indices into XlstmBufferSizes.state */
+enum {
+    XLSTM_BUF_Y = 0,
+    XLSTM_BUF_C = 1,           /* c (sLSTM) or C (mLSTM) */
+    XLSTM_BUF_N = 2,
+    XLSTM_BUF_M = 3,
+    XLSTM_BUF_CONV = 4,        /* block conv history, 0 for cells and K == 1 */
+    XLSTM_BUF_STATES = 5
+};
+
+typedef struct {
+    size_t state[XLSTM_BUF_STATES];  /* bytes per persistent state array */
+    size_t scratch;                  /* bytes of per-call scratch/workspace */
+} XlstmBufferSizes;
+
+/* Cell kinds (*_eval_f32 / *_eval_s8). Returns XLSTM_OK, XLSTM_ERR_ARG or
+ * XLSTM_ERR_FORMAT for a block kind. */
+int xlstm_cell_sizes(XlstmKind kind, int batch_size, int hidden_size,
+                     XlstmBufferSizes* out);
+
+/* Blocks (*_block_eval_f32 / *_block_eval_q8) */
+void xlstm_mlstm_block_sizes(const XlstmMlstmBlock* blk, int batch_size,
+                             XlstmBufferSizes* out);
+void xlstm_slstm_block_sizes(const XlstmSlstmBlock* blk, int batch_size,
+                             XlstmBufferSizes* out);
+void xlstm_mlstm_block_q8_sizes(const XlstmMlstmBlockQ8* blk, int batch_size,
+                                XlstmBufferSizes* out);
+void xlstm_slstm_block_q8_sizes(const XlstmSlstmBlockQ8* blk, int batch_size,
+                                XlstmBufferSizes* out);
+
+typedef struct {
+    size_t size;               /* bytes, 0 = unused (offset 0) */
+    int first_use;             /* first step that touches the buffer */
+    int last_use;              /* last step, inclusive */
+    size_t offset;             /* out: byte offset into the arena */
+} XlstmPlanBuffer;
+
+/* Assign offsets to num_buffers buffers. alignment is a power of two
+ * (0 = XLSTM_PLAN_ALIGN); order is caller scratch of num_buffers ints.
+ * Returns the arena size in bytes (a multiple of alignment), or 0 for
+ * invalid arguments. O(n^2) in the number of buffers. */
+size_t xlstm_plan(XlstmPlanBuffer* buffers, int num_buffers,
+                  size_t alignment, int* order);
+
+/* Buffers per model layer in xlstm_plan_model: the state arrays
+ * (XLSTM_BUF_*), then scratch, then the layer's output activations. */
+#define XLSTM_PLAN_SCRATCH XLSTM_BUF_STATES
+#define XLSTM_PLAN_OUTPUT (XLSTM_BUF_STATES + 1)
+#define XLSTM_PLAN_BUFS_PER_LAYER (XLSTM_BUF_STATES + 2)
+
+/* Plan states, scratch and [B, T, hidden] outputs (int8 for the INT8 cell
+ * kinds, float otherwise) of every layer of model. buffers holds num_layers * XLSTM_PLAN_BUFS_PER_LAYER entries,
+ * layer l at l * XLSTM_PLAN_BUFS_PER_LAYER; order as in xlstm_plan.
+ * Stores the arena size (alignment XLSTM_PLAN_ALIGN) in *arena_size.
+ * Returns XLSTM_OK, XLSTM_ERR_ARG, XLSTM_ERR_SIZE (max_buffers too small)
+ * or the status of binding a layer. */
+int xlstm_plan_model(const XlstmModel* model, int batch_size, int time_steps,
+                     XlstmPlanBuffer* buffers, int max_buffers, int* order,
+                     size_t* arena_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XLSTM_PLAN_H_ */
@@ -0,0 +1,135 @@
+/* Copyright 2026 RAWS labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * =========================================================================
+ * Prefix state cache — bounded LRU of recurrent states keyed by input prefix.
+ *
+ * xLSTM state has a fixed size regardless of how many timesteps produced it,
+ * so the state after a shared prompt prefix can be cached and reused instead
+ * of re-running prefill. Prefixes are hashed at chunk granularity
+ * (chunk_steps timesteps of step_bytes each); only prefixes whose length is
+ * a multiple of chunk_steps are cached.
+ *
+ * Each entry owns one slot_size-byte blob in a caller-provided pool. The
+ * cache does not interpret blobs; the intended content is an xlstm_state
+ * snapshot (slot_size = xlstm_state_size(kind, 1, H)).
+ *
+ * Typical use for one stream:
+ *   len = xlstm_prefix_cache_lookup(&cache, input, T, &blob);
+ *   if (len > 0) xlstm_state_restore_*(blob, cache.slot_size, ...);
+ *   else         zero the state;
+ *   for each remaining chunk: eval it, then
+ *       slot = xlstm_prefix_cache_reserve(&cache, input, end_of_chunk);
+ *       xlstm_prefix_cache_commit(&cache, slot,
+ *                                 xlstm_state_save_*(..., slot, cache.slot_size));
+ *
+ * A reserved entry is invisible to lookups until it is committed with
+ * XLSTM_OK, so a failed or skipped save never serves a stale blob.
+ *
+ * Keys are 64-bit FNV-1a hashes of the prefix bytes plus the prefix length;
+ * the prefix itself is not stored, so distinct prefixes colliding on all 64
+ * bits share an entry and the second one resumes from the wrong state. FNV
+ * is not collision-resistant: accidental collisions are negligible, but
+ * inputs chosen by an adversary can be made to collide. When prefixes come
+ * from untrusted sources, keep the prefix next to the blob (e.g. in the
+ * slot after the state) and compare it after a hit.
+ * ===========================================================================*/
+
+#ifndef XLSTM_PREFIX_CACHE_H_
+#define XLSTM_PREFIX_CACHE_H_
+
+#include "xlstm_types.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint64_t key;          /* prefix hash */
+    uint32_t prefix_len;   /* timesteps covered, 0 = empty entry */
+    uint32_t last_used;    /* LRU stamp */
+    uint32_t ready;        /* blob committed; lookups skip reserved entries */
+} XlstmPrefixEntry;
+
+typedef struct {
+    XlstmPrefixEntry* entries; /* [capacity] */
+    unsigned char* pool;       /* [capacity * slot_size] blobs */
+    int capacity;
+    size_t slot_size;          /* bytes per blob, multiple of 16 */
+    int chunk_steps;           /* hashing granularity in timesteps */
+    size_t step_bytes;         /* bytes of one input timestep */
+    uint32_t clock;            /* LRU counter */
+} XlstmPrefixCache;
+
+/* Initialize an empty cache. pool must hold capacity * slot_size bytes and
+ * be 16-byte aligned; slot_size must be a multiple of 16 (xlstm_state_size
+ * already is). Returns XLSTM_OK or a negative XlstmStatus. */
+int xlstm_prefix_cache_init(
+    XlstmPrefixCache* cache,
+    XlstmPrefixEntry* entries,
+    int capacity,
+    void* pool,
+    size_t pool_size,
+    size_t slot_size,
+    int chunk_steps,
+    size_t step_bytes);
+
+/* Chained FNV-1a 64: extend hash h (start from XLSTM_PREFIX_HASH_INIT) with
+ * len bytes of data. */
+#define XLSTM_PREFIX_HASH_INIT 0xcbf29ce484222325ull
+uint64_t xlstm_prefix_hash(uint64_t h, const void* data, size_t len);
+
+/* Find the longest cached prefix of input[0 .. time_steps).
+ *
+ * Returns the number of timesteps covered (a multiple of chunk_steps, 0 on
+ * a miss) and points *blob at the cached state. A hit refreshes the entry's
+ * LRU stamp. */
+int xlstm_prefix_cache_lookup(
+    XlstmPrefixCache* cache,
+    const void* input,    /* [time_steps, step_bytes] */
+    int time_steps,
+    const void** blob);
+
+/* Reserve the blob for prefix input[0 .. prefix_len).
+ *
+ * Reuses the entry if the prefix is already cached, otherwise takes an empty
+ * entry or evicts the least recently used one. Either way the entry stops
+ * matching lookups until xlstm_prefix_cache_commit. The caller writes the
+ * state into the returned slot_size-byte blob. Returns NULL if prefix_len is
+ * not a positive multiple of chunk_steps. A reservation that is never
+ * committed stays hidden and is evicted like any other entry. */
+void* xlstm_prefix_cache_reserve(
+    XlstmPrefixCache* cache,
+    const void* input,    /* [prefix_len, step_bytes] */
+    int prefix_len);
+
+/* Publish a reserved blob. status is the result of writing it (e.g. the
+ * xlstm_state_save_* return value): XLSTM_OK makes the entry visible to
+ * lookups, any other value drops it. Returns XLSTM_OK, or XLSTM_ERR_ARG if
+ * blob is not a slot of this cache's pool. */
+int xlstm_prefix_cache_commit(
+    XlstmPrefixCache* cache,
+    const void* blob,
+    int status);
+
+/* Drop all entries. */
+void xlstm_prefix_cache_clear(XlstmPrefixCache* cache);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XLSTM_PREFIX_CACHE_H_ */
@@ -0,0 +1,103 @@
+/* Copyright 2026 RAWS labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * =========================================================================
+ * Per-phase kernel instrumentation — C99, compiled out by default.
+ *
+ * Build the kernel sources with -DXLSTM_PROFILE and every step call of the
+ * four cells (single-stream, batched and tiled, and through them the eval,
+ * block and runtime paths) records cycles spent in each phase:
+ *
+ *   PROJECTION   W*x (+ R*y) + b, including INT8 dequantization
+ *   GATES        key scaling and stabilized exponential gates; for sLSTM
+ *                the whole fused pointwise update (gates, c/n, output),
+ *                which stays one loop so profiling does not change it
+ *   STATE        mLSTM C and n update (INT8: dequant, update, requant)
+ *   READOUT      mLSTM q^T C, q^T n and the output gate
+ *
+ * Counters accumulate per kind; an optional callback receives the phase
+ * cycles of each call as it ends. Without XLSTM_PROFILE the hooks expand
+ * to nothing and the counters stay zero.
+ *
+ * Cycles come from rdtsc (x86), cntvct_el0 (AArch64), DWT->CYCCNT
+ * (Cortex-M3 and up; the application enables the DWT counter) or clock()
+ * elsewhere. Define XLSTM_PROFILE_CYCLES to the name of a
+ * uint64_t (void) function to supply another source.
+ *
+ * The counters are process-global and unsynchronized: profile one thread
+ * at a time (not the pthread stack driver).
+ * ===========================================================================*/
+
+#ifndef XLSTM_PROFILE_H_
+#define XLSTM_PROFILE_H_
+
+#include "xlstm_types.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    XLSTM_PHASE_PROJECTION = 0,
+    XLSTM_PHASE_GATES = 1,
+    XLSTM_PHASE_STATE = 2,
+    XLSTM_PHASE_READOUT = 3,
+    XLSTM_PHASE_COUNT = 4
+} XlstmPhase;
+
+typedef struct {
+    uint64_t calls;                           /* step calls that ended */
+    uint64_t cycles[XLSTM_PHASE_COUNT];       /* summed over those calls */
+} XlstmProfileCounters;
+
+/* Called at the end of every profiled step call with that call's cycles */
+typedef void (*XlstmProfileCallback)(
+    XlstmKind kind, const uint64_t cycles[XLSTM_PHASE_COUNT], void* user);
+
+/* Install (or with NULL remove) the per-call callback. */
+void xlstm_profile_set_callback(XlstmProfileCallback callback, void* user);
+
+/* Accumulated counters of a cell kind (zeros for other kinds). */
+void xlstm_profile_get(XlstmKind kind, XlstmProfileCounters* out);
+
+/* Zero all counters. */
+void xlstm_profile_reset(void);
+
+/* "projection", "gates", "state", "readout" */
+const char* xlstm_profile_phase_name(XlstmPhase phase);
+
+/* Current cycle counter */
+uint64_t xlstm_profile_cycles(void);
+
+/* Kernel hooks: charge the cycles since *t to phase and restart *t; end
+ * the current call of kind. Use the macros below. */
+void xlstm_profile_phase(XlstmKind kind, XlstmPhase phase, uint64_t* t);
+void xlstm_profile_end(XlstmKind kind);
+
+#ifdef XLSTM_PROFILE
+#define XLSTM_PROFILE_BEGIN(t) uint64_t t = xlstm_profile_cycles()
+#define XLSTM_PROFILE_PHASE(kind, phase, t) xlstm_profile_phase(kind, phase, &(t))
+#define XLSTM_PROFILE_END(kind) xlstm_profile_end(kind)
+#else
+#define XLSTM_PROFILE_BEGIN(t)
+#define XLSTM_PROFILE_PHASE(kind, phase, t)
+#define XLSTM_PROFILE_END(kind)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XLSTM_PROFILE_H_ */
@@ -0,0 +1,102 @@
+/* Copyright 2026 RAWS labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * =========================================================================
+ * INT8×INT8 → INT32 dot product used by the q8 projections — inline C99.
+ *
+ *   xlstm_dot_s8(w, x, x_zp, len) = sum_j w[j] * (x[j] - x_zp)
+ *
+ * The portable loop is the default. Building with -DXLSTM_USE_ARM_SIMD
+ * selects a Cortex-M backend in the style of the CMSIS-NN s8 kernels:
+ *
+ *   Helium (MVE, Cortex-M55/M85)   8 lanes per VMLADAVA on int16-widened
+ *                                   bytes, predicated tail
+ *   DSP (SIMD32, Cortex-M4/M7/M33)  4 bytes per iteration, SXTAB16 folds the
+ *                                   zero point in while widening, two SMLAD
+ *
+ * x - x_zp always fits int16, so every backend accumulates exactly the same
+ * int32 sum and kernel outputs do not depend on the backend.
+ * XLSTM_Q8_BACKEND names the selected one.
+ *
+ * With packed weights (slstm_pack_s8 / mlstm_pack_s8) the zero point is
+ * folded into per-row corrections, -x_zp * xlstm_row_sum_s8(w), and the
+ * kernels call xlstm_dot_s8 with x_zp = 0; Helium then runs 16 int8 lanes
+ * per VMLADAVA instead of 8 widened ones. The DSP and portable loops cost
+ * the same either way (the SXTAB16 offset is just 0).
+ * ===========================================================================*/
+
+#ifndef XLSTM_Q8_DOT_H_
+#define XLSTM_Q8_DOT_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(XLSTM_USE_ARM_SIMD) && defined(__ARM_FEATURE_MVE) && (__ARM_FEATURE_MVE & 1)
+#include <arm_mve.h>
+#define XLSTM_Q8_BACKEND "mve"
+#elif defined(XLSTM_USE_ARM_SIMD) && defined(__ARM_FEATURE_SIMD32)
+#include <arm_acle.h>
+#define XLSTM_Q8_BACKEND "dsp"
+#elif defined(XLSTM_USE_ARM_SIMD)
+#error "XLSTM_USE_ARM_SIMD needs a target with MVE or the DSP extension"
+#else
+#define XLSTM_Q8_BACKEND "portable"
+#endif
+
+static inline int32_t xlstm_dot_s8(const int8_t* w, const int8_t* x,
+                                   int32_t x_zp, int len) {
+    int32_t acc = 0;
+    int j = 0;
+
+#if defined(XLSTM_USE_ARM_SIMD) && defined(__ARM_FEATURE_MVE) && (__ARM_FEATURE_MVE & 1)
+    if (x_zp == 0) {
+        for (; j < len; j += 16) {
+            mve_pred16_t p = vctp8q((uint32_t)(len - j));
+            acc = vmladavaq_p_s8(acc, vldrbq_z_s8(w + j, p), vldrbq_z_s8(x + j, p), p);
+        }
+        return acc;
+    }
+    for (; j < len; j += 8) {
+        mve_pred16_t p = vctp16q((uint32_t)(len - j));
+        int16x8_t wv = vldrbq_z_s16(w + j, p);
+        int16x8_t xv = vsubq_n_s16(vldrbq_z_s16(x + j, p), (int16_t)x_zp);
+        acc = vmladavaq_p_s16(acc, wv, xv, p);
+    }
+#elif defined(XLSTM_USE_ARM_SIMD)
+    /* -x_zp in both halfwords; SXTAB16 adds it to the sign-extended bytes */
+    uint32_t neg_zp = (uint16_t)(-x_zp);
+    int32_t offset = (int32_t)(neg_zp | (neg_zp << 16));
+
+    for (; j + 4 <= len; j += 4) {
+        uint32_t wv, xv;
+        memcpy(&wv, w + j, 4);
+        memcpy(&xv, x + j, 4);
+        acc = __smlad(__sxtb16((int32_t)wv), __sxtab16(offset, (int32_t)xv), acc);
+        acc = __smlad(__sxtb16((int32_t)((wv >> 8) | (wv << 24))),
+                      __sxtab16(offset, (int32_t)((xv >> 8) | (xv << 24))), acc);
+    }
+#endif
+    for (; j < len; ++j) {
+        acc += (int32_t)w[j] * ((int32_t)x[j] - x_zp);
+    }
+    return acc;
+}
+
+static inline int32_t xlstm_row_sum_s8(const int8_t* w, int len) {
+    int32_t sum = 0;
+    int j;
+    for (j = 0; j < len; ++j) sum += w[j];
+    return sum;
+}
+
+#endif /* XLSTM_Q8_DOT_H_ */
@@ -36,6 +36,28 @@ typedef struct {
     int32_t zero_point; /* 0 for symmetric (weights), variable for asymmetric */
 } XlstmQuantParam;
 
+/* Range and saturation statistics of one requantized tensor */
+typedef struct {
+    uint64_t count;     /* values requantized */
+    uint64_t saturated; /* values clamped to the integer range */
+    float max_abs;      /* largest |real value| before requantization */
+} XlstmQuantStats;
+
+/* Statistics of one INT8 cell, updated by every step when the kernel
+ * params carry a stats pointer (batched calls sum over all streams) */
+typedef struct {
+    XlstmQuantStats y;  /* INT8 hidden output */
+    XlstmQuantStats c;  /* INT16 c (sLSTM) or C (mLSTM) */
+    XlstmQuantStats n;  /* INT16 normalizer */
+} XlstmQ8Stats;
+
+void xlstm_q8_stats_reset(XlstmQ8Stats* stats);
+
+/* Symmetric scale that covers the observed range with qmax (127 for INT8,
+ * 32767 for INT16) — the recalibration target for a saturating tensor.
+ * 0 if nothing was recorded. */
+float xlstm_quant_stats_scale(const XlstmQuantStats* stats, int qmax);
+
 /* Compute symmetric quant params from float tensor (weights: zp=0) */
 void xlstm_quant_symmetric(const float* data, int len, XlstmQuantParam* out);
 
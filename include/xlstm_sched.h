@@ -0,0 +1,148 @@
+/* Copyright 2026 RAWS labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * =========================================================================
+ * Continuous-batching scheduler for many concurrent streams — pure C99.
+ *
+ * Keeps a slot table of per-stream recurrent states. Streams are admitted
+ * and retired between ticks; each tick advances every active stream by one
+ * timestep with a single batched step (*_step_batch_*), so weights are read
+ * once per tick regardless of how many streams are in flight.
+ *
+ * The scheduler only does bookkeeping. State arrays are owned by the caller
+ * and sized for `capacity` slots:
+ *   sLSTM: y/c/n/m [capacity, H]
+ *   mLSTM: y/n [capacity, H], C [capacity, H*H], m [capacity, 1]
+ *
+ * Per tick, input rows x[k] and output rows output[k] follow the order of
+ * sched->active[0 .. num_active). Admission appends to that order; retiring
+ * a stream removes it and keeps the relative order of the others.
+ * ===========================================================================*/
+
+#ifndef XLSTM_SCHED_H_
+#define XLSTM_SCHED_H_
+
+#include "slstm.h"
+#include "mlstm.h"
+#include "slstm_q8.h"
+#include "mlstm_q8.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    int capacity;        /* number of state slots */
+    int num_active;      /* streams currently admitted */
+    int32_t* stream_ids; /* [capacity] stream id owning each slot, -1 = free */
+    int* active;         /* [capacity] slot of each active stream, in order */
+    uint8_t* fresh;      /* [capacity] per active stream: reset before next tick */
+} XlstmScheduler;
+
+/* Initialize an empty scheduler over caller-provided bookkeeping arrays. */
+void xlstm_sched_init(
+    XlstmScheduler* sched,
+    int capacity,
+    int32_t* stream_ids,  /* [capacity] */
+    int* active,          /* [capacity] */
+    uint8_t* fresh);      /* [capacity] */
+
+/* Admit a stream (stream_id >= 0) into a free slot.
+ *
+ * If init_state is non-zero the slot's state is zeroed at the start of the
+ * next tick; pass 0 when the caller has written the slot's state itself
+ * (e.g. a restored session). Returns the slot index, or -1 if the table is
+ * full or the stream is already admitted. */
+int xlstm_sched_admit(XlstmScheduler* sched, int32_t stream_id, int init_state);
+
+/* Retire a stream and free its slot. Returns the freed slot, or -1 if the
+ * stream is not active. */
+int xlstm_sched_retire(XlstmScheduler* sched, int32_t stream_id);
+
+/* Slot index of an active stream, or -1. */
+int xlstm_sched_slot(const XlstmScheduler* sched, int32_t stream_id);
+
+/* One tick: advance all active streams by one timestep.
+ *
+ * x is [num_active, I], output is [num_active, H] (the new y of each stream).
+ * Scratch: num_active*4*H floats (sLSTM) or num_active*(4*H+2) (mLSTM). */
+void xlstm_sched_tick_slstm_f32(
+    XlstmScheduler* sched,
+    const float* x,
+    const float* W,
+    const float* R,
+    const float* b,
+    float* y,
+    float* c,
+    float* n,
+    float* m,
+    float* output,
+    float* scratch,
+    int input_size,
+    int hidden_size,
+    const SlstmParams* params);
+
+void xlstm_sched_tick_mlstm_f32(
+    XlstmScheduler* sched,
+    const float* x,
+    const float* W,
+    const float* b,
+    float* y,
+    float* C,
+    float* n,
+    float* m,
+    float* output,
+    float* scratch,
+    int input_size,
+    int hidden_size,
+    const MlstmParams* params);
+
+/* INT8 ticks: same contract, scratch is int32_t of the same element count. */
+void xlstm_sched_tick_slstm_s8(
+    XlstmScheduler* sched,
+    const int8_t* x,
+    const int8_t* W_q,
+    const int8_t* R_q,
+    const int32_t* b_q,
+    int8_t* y,
+    int16_t* c,
+    int16_t* n,
+    float* m,
+    int8_t* output,
+    int32_t* scratch,
+    int input_size,
+    int hidden_size,
+    const SlstmS8Params* params);
+
+void xlstm_sched_tick_mlstm_s8(
+    XlstmScheduler* sched,
+    const int8_t* x,
+    const int8_t* W_q,
+    const int32_t* b_q,
+    int8_t* y,
+    int16_t* C,
+    int16_t* n,
+    float* m,
+    int8_t* output,
+    int32_t* scratch,
+    int input_size,
+    int hidden_size,
+    const MlstmS8Params* params);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XLSTM_SCHED_H_ */
@@ -0,0 +1,179 @@
+/* Copyright 2026 RAWS labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * =========================================================================
+ * Multi-layer stack runtime with time/layer wavefront scheduling — C99.
+ *
+ * A stack of f32 sLSTM/mLSTM layers is evaluated in chunks of chunk_steps
+ * timesteps. Work item (l, k) runs layer l over chunk k; it depends only on
+ * (l-1, k) and (l, k-1). All items on the anti-diagonal l + k == w form
+ * wave w and are independent, so layer l on chunk k can run on one core
+ * while layer l+1 runs chunk k-1 on another.
+ *
+ * Between consecutive layers, chunk outputs go through a two-slot ring
+ * buffer of [B, chunk_steps, H_l] floats instead of a full [B, T, H_l]
+ * intermediate: at wave w layer l writes slot (k % 2) while layer l+1 reads
+ * slot ((k-1) % 2). Pick chunk_steps so a ring slot stays cache-resident.
+ *
+ * Threading is left to the caller: run xlstm_stack_wave(w, worker, n) on
+ * n workers with a barrier between waves. xlstm_stack_eval is the serial
+ * driver; with XLSTM_USE_PTHREADS, xlstm_stack_eval_parallel runs the waves
+ * on a worker pool kept on the stack (xlstm_stack_pool_init), so streaming
+ * calls of a few tokens do not pay for thread creation each time.
+ *
+ * Each layer needs its own scratch (4*H or 4*H+2 floats) so that layers can
+ * run concurrently. Results are identical to chaining *_eval_f32 calls.
+ * ===========================================================================*/
+
+#ifndef XLSTM_STACK_H_
+#define XLSTM_STACK_H_
+
+#include "slstm.h"
+#include "mlstm.h"
+#include "xlstm_types.h"
+
+#include <stddef.h>
+
+#ifdef XLSTM_USE_PTHREADS
+#include <pthread.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    XlstmKind kind;          /* XLSTM_KIND_SLSTM_F32 or XLSTM_KIND_MLSTM_F32 */
+    int input_size;          /* previous layer's hidden_size (or model input) */
+    int hidden_size;
+    const float* W;
+    const float* R;          /* sLSTM only */
+    const float* b;
+    float* y;                /* [B, H] in/out */
+    float* c;                /* sLSTM c [B, H] or mLSTM C [B, H*H], in/out */
+    float* n;                /* [B, H] in/out */
+    float* m;                /* [B, H] (sLSTM) or [B, 1] (mLSTM) in/out */
+    float* scratch;          /* [4*H] (sLSTM) or [4*H+2] (mLSTM) */
+    SlstmParams slstm_params;
+    MlstmParams mlstm_params;
+} XlstmStackLayer;
+
+typedef struct {
+    XlstmStackLayer* layers;
+    int num_layers;
+    float* ring;             /* two slots per layer boundary */
+    int batch_size;
+    int chunk_steps;
+    /* Set by xlstm_stack_begin */
+    const float* input;
+    float* output;
+    int time_steps;
+    int num_chunks;
+    /* Set by xlstm_stack_pool_init (XLSTM_USE_PTHREADS), else NULL */
+    struct XlstmStackPool* pool;
+} XlstmStack;
+
+/* Ring buffer size in floats: sum over l < L-1 of 2 * B * chunk_steps * H_l. */
+size_t xlstm_stack_ring_size(
+    const XlstmStackLayer* layers,
+    int num_layers,
+    int batch_size,
+    int chunk_steps);
+
+/* Validate the layer chain and bind the ring buffer.
+ * Returns XLSTM_OK, XLSTM_ERR_ARG, XLSTM_ERR_SHAPE (input_size of a layer
+ * differs from the previous hidden_size) or XLSTM_ERR_SIZE (ring too small). */
+int xlstm_stack_init(
+    XlstmStack* stack,
+    XlstmStackLayer* layers,
+    int num_layers,
+    float* ring,
+    size_t ring_size,        /* floats */
+    int batch_size,
+    int chunk_steps);
+
+/* Bind one sequence. Returns the number of waves to run. */
+int xlstm_stack_begin(
+    XlstmStack* stack,
+    const float* input,      /* [B, T, I_0] */
+    float* output,           /* [B, T, H_{L-1}] */
+    int time_steps);
+
+/* Run this worker's share of wave w (items are dealt round-robin across
+ * num_workers). All workers must finish wave w before any starts w+1. */
+void xlstm_stack_wave(XlstmStack* stack, int wave, int worker, int num_workers);
+
+/* Serial driver: begin + every wave on one worker. */
+void xlstm_stack_eval(
+    XlstmStack* stack,
+    const float* input,
+    float* output,
+    int time_steps);
+
+#ifdef XLSTM_USE_PTHREADS
+#define XLSTM_STACK_MAX_THREADS 64
+
+typedef struct {
+    struct XlstmStackPool* pool;
+    int worker;
+} XlstmStackWorker;
+
+/* Persistent workers for xlstm_stack_eval_parallel; caller-owned storage,
+ * fields are private. */
+typedef struct XlstmStackPool {
+    pthread_t threads[XLSTM_STACK_MAX_THREADS];
+    XlstmStackWorker workers[XLSTM_STACK_MAX_THREADS];
+    int num_threads;         /* workers including the caller's thread */
+    /* Current job, guarded by lock */
+    XlstmStack* stack;
+    int num_waves;
+    int num_workers;
+    unsigned job;
+    int shutdown;
+    /* Wave barrier */
+    int waiting;
+    unsigned generation;
+    pthread_mutex_t lock;
+    pthread_cond_t job_cond;
+    pthread_cond_t barrier_cond;
+} XlstmStackPool;
+
+/* Start num_threads - 1 worker threads (capped at the layer count and
+ * XLSTM_STACK_MAX_THREADS; the caller's thread is worker 0) that sleep
+ * until xlstm_stack_eval_parallel hands them waves, and attach the pool to
+ * the initialized stack. If some threads cannot be created the pool runs
+ * with fewer. Returns XLSTM_OK or XLSTM_ERR_ARG. */
+int xlstm_stack_pool_init(XlstmStack* stack, XlstmStackPool* pool, int num_threads);
+
+/* Stop and join the stack's pool workers and detach the pool. Call before
+ * the pool storage goes away or the stack is re-initialized. */
+void xlstm_stack_pool_destroy(XlstmStack* stack);
+
+/* Parallel driver: up to num_threads workers (the caller's thread is one of
+ * them) with a barrier between waves. Runs on the stack's pool when one is
+ * attached; otherwise it creates and joins the threads on every call, which
+ * costs more than a short streaming call saves. Returns XLSTM_OK or
+ * XLSTM_ERR_ARG. */
+int xlstm_stack_eval_parallel(
+    XlstmStack* stack,
+    const float* input,
+    float* output,
+    int time_steps,
+    int num_threads);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XLSTM_STACK_H_ */
@@ -0,0 +1,141 @@
+/* Copyright 2026 RAWS labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * =========================================================================
+ * Recurrent state snapshots — versioned blob format, save/restore/view.
+ *
+ * Blob layout (native byte order, all offsets from the blob start):
+ *   [0, 64)          XlstmStateHeader
+ *   y, c|C, n, m     raw state arrays in kernel dtype, each section
+ *                    aligned to XLSTM_STATE_ALIGN bytes
+ *
+ * Section dtypes and element counts:
+ *   kind         y            c | C            n            m
+ *   SLSTM_F32    f32  B*H     f32  B*H         f32  B*H     f32 B*H
+ *   MLSTM_F32    f32  B*H     f32  B*H*H       f32  B*H     f32 B
+ *   SLSTM_S8     i8   B*H     i16  B*H         i16  B*H     f32 B*H
+ *   MLSTM_S8     i8   B*H     i16  B*H*H       i16  B*H     f32 B
+ *
+ * INT8 blobs carry the y/c/n quantization params the states were written
+ * with; restoring under different params requantizes instead of copying.
+ * A byte-swapped blob fails the magic check rather than loading garbage.
+ * ===========================================================================*/
+
+#ifndef XLSTM_STATE_H_
+#define XLSTM_STATE_H_
+
+#include "xlstm_types.h"
+#include "xlstm_quant.h"
+#include "slstm_q8.h"
+#include "mlstm_q8.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define XLSTM_STATE_MAGIC 0x54534C58u /* "XLST" */
+#define XLSTM_STATE_VERSION 1
+#define XLSTM_STATE_ALIGN 16
+
+typedef struct {
+    uint32_t magic;              /* XLSTM_STATE_MAGIC */
+    uint16_t version;            /* XLSTM_STATE_VERSION */
+    uint8_t kind;                /* XlstmKind */
+    uint8_t reserved0;
+    uint32_t batch_size;
+    uint32_t hidden_size;
+    uint32_t total_size;         /* blob size in bytes */
+    uint32_t offset[4];          /* y, c|C, n, m section offsets */
+    XlstmQuantParam y_quant;     /* INT8 kinds only, zero otherwise */
+    XlstmQuantParam c_quant;     /* c (sLSTM) or C (mLSTM) */
+    XlstmQuantParam n_quant;
+    uint32_t reserved1;
+} XlstmStateHeader;              /* 64 bytes */
+
+/* Zero-copy view into a blob. Pointers alias the blob memory. */
+typedef struct {
+    XlstmKind kind;
+    int batch_size;
+    int hidden_size;
+    const void* y;               /* float* or int8_t* */
+    const void* c;               /* float* or int16_t* (C for mLSTM) */
+    const void* n;               /* float* or int16_t* */
+    const float* m;
+    XlstmQuantParam y_quant;
+    XlstmQuantParam c_quant;
+    XlstmQuantParam n_quant;
+} XlstmStateView;
+
+/* Exact blob size in bytes for a state of the given kind and shape. */
+size_t xlstm_state_size(XlstmKind kind, int batch_size, int hidden_size);
+
+/* Validate a blob and fill a zero-copy view of it. The blob must be at
+ * least 4-byte aligned. Returns XLSTM_OK or a negative XlstmStatus. */
+int xlstm_state_view(const void* blob, size_t blob_size, XlstmStateView* view);
+
+/* Save: serialize states into blob (blob_size >= xlstm_state_size(...)).
+ * The header stores sizes as uint32, so states whose blob would exceed
+ * 4 GiB are rejected with XLSTM_ERR_SIZE.
+ * Restore: validate kind and shape, then copy states out of the blob.
+ * All return XLSTM_OK or a negative XlstmStatus; NULL pointers are
+ * XLSTM_ERR_ARG. */
+int xlstm_state_save_slstm_f32(
+    const float* y, const float* c, const float* n, const float* m,
+    int batch_size, int hidden_size,
+    void* blob, size_t blob_size);
+
+int xlstm_state_restore_slstm_f32(
+    const void* blob, size_t blob_size,
+    float* y, float* c, float* n, float* m,
+    int batch_size, int hidden_size);
+
+int xlstm_state_save_mlstm_f32(
+    const float* y, const float* C, const float* n, const float* m,
+    int batch_size, int hidden_size,
+    void* blob, size_t blob_size);
+
+int xlstm_state_restore_mlstm_f32(
+    const void* blob, size_t blob_size,
+    float* y, float* C, float* n, float* m,
+    int batch_size, int hidden_size);
+
+/* INT8 states: params supplies the quant params the states are written with
+ * (save) or must be expressed in (restore). */
+int xlstm_state_save_slstm_s8(
+    const int8_t* y, const int16_t* c, const int16_t* n, const float* m,
+    int batch_size, int hidden_size, const SlstmS8Params* params,
+    void* blob, size_t blob_size);
+
+int xlstm_state_restore_slstm_s8(
+    const void* blob, size_t blob_size,
+    int8_t* y, int16_t* c, int16_t* n, float* m,
+    int batch_size, int hidden_size, const SlstmS8Params* params);
+
+int xlstm_state_save_mlstm_s8(
+    const int8_t* y, const int16_t* C, const int16_t* n, const float* m,
+    int batch_size, int hidden_size, const MlstmS8Params* params,
+    void* blob, size_t blob_size);
+
+int xlstm_state_restore_mlstm_s8(
+    const void* blob, size_t blob_size,
+    int8_t* y, int16_t* C, int16_t* n, float* m,
+    int batch_size, int hidden_size, const MlstmS8Params* params);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XLSTM_STATE_H_ */
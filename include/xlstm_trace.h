@@ -0,0 +1,107 @@
+/* Copyright 2026 RAWS labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * =========================================================================
+ * Timeline tracing — C99, Chrome trace JSON export, compiled out by default.
+ *
+ * Build the library sources with -DXLSTM_TRACE and, while a trace is
+ * started, these spans are recorded into a caller-provided event array:
+ *
+ *   slstm_eval_f32, mlstm_eval_f32, *_eval_s8 (also for the _reset
+ *   variants), *_eval_spec_f32, *_block_eval_f32, *_block_eval_q8
+ *                                          one span per eval call
+ *   layer                                  stack work item (layer, chunk)
+ *   barrier                                pthread stack driver, time a
+ *                                          worker waits for the others
+ *
+ * Each span records the calling thread's id (xlstm_trace_set_thread; the
+ * stack sets its worker index) and, where known, layer and chunk. Export
+ * with xlstm_trace_write_json and open the file in chrome://tracing or
+ * ui.perfetto.dev; nested spans on one thread stack up in the viewer.
+ *
+ * Without XLSTM_TRACE the hooks expand to nothing. With it and no trace
+ * started, each hook costs one pointer load. Recording reserves slots with
+ * an atomic add (GCC/Clang builtins), so workers may record concurrently;
+ * start, stop and export must not race with recording. Timestamps are
+ * CLOCK_MONOTONIC nanoseconds on POSIX and clock() elsewhere; define
+ * XLSTM_TRACE_CLOCK to the name of a uint64_t (void) nanosecond clock to
+ * supply another.
+ * ===========================================================================*/
+
+#ifndef XLSTM_TRACE_H_
+#define XLSTM_TRACE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    const char* name;          /* static string */
+    int32_t layer;             /* -1 if not known */
+    int32_t chunk;             /* -1 if not known */
+    int32_t tid;
+    uint32_t reserved;
+    uint64_t begin_ns;
+    uint64_t end_ns;
+} XlstmTraceEvent;
+
+typedef struct {
+    XlstmTraceEvent* events;
+    uint32_t capacity;
+    uint32_t count;            /* reserved slots, may exceed capacity */
+    uint64_t origin_ns;        /* timestamps are exported relative to this */
+} XlstmTrace;
+
+/* Bind an event array and clear the trace. */
+void xlstm_trace_init(XlstmTrace* trace, XlstmTraceEvent* events, int capacity);
+
+/* Make trace the active recorder (restarting its clock origin), or stop
+ * recording. One trace is active at a time. */
+void xlstm_trace_start(XlstmTrace* trace);
+void xlstm_trace_stop(void);
+
+/* Recorded events and events lost to a full array */
+int xlstm_trace_count(const XlstmTrace* trace);
+int xlstm_trace_dropped(const XlstmTrace* trace);
+
+/* Thread id stored with the calling thread's spans (default 0). Thread
+ * local with GCC/Clang, one global otherwise. */
+void xlstm_trace_set_thread(int tid);
+
+/* Span hooks: begin returns a timestamp (0 if no trace is active), end
+ * records [begin, now) under name. Use the macros below in library code;
+ * applications may call them directly to wrap their own layers. */
+uint64_t xlstm_trace_begin(void);
+void xlstm_trace_end(const char* name, int layer, int chunk, uint64_t begin);
+
+/* Write the events as Chrome trace JSON ("X" complete events, ts/dur in
+ * microseconds). Returns the size in bytes; out is written only when
+ * out_size is at least that large (no terminating NUL). */
+size_t xlstm_trace_write_json(const XlstmTrace* trace, char* out, size_t out_size);
+
+#ifdef XLSTM_TRACE
+#define XLSTM_TRACE_BEGIN(t) uint64_t t = xlstm_trace_begin()
+#define XLSTM_TRACE_END(name, layer, chunk, t) xlstm_trace_end(name, layer, chunk, t)
+#else
+#define XLSTM_TRACE_BEGIN(t)
+#define XLSTM_TRACE_END(name, layer, chunk, t)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XLSTM_TRACE_H_ */
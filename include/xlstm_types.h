@@ -0,0 +1,60 @@
+/* Copyright 2026 RAWS labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * =========================================================================
+ * Shared public types for the xLSTM runtime modules — status codes, kernel
+ * kinds and tensor dtypes. The kernels themselves never fail and do not use
+ * these.
+ * ===========================================================================*/
+
+#ifndef XLSTM_TYPES_H_
+#define XLSTM_TYPES_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Return codes of runtime functions that can fail (0 = success) */
+typedef enum {
+    XLSTM_OK = 0,
+    XLSTM_ERR_ARG = -1,      /* invalid argument (NULL, negative size, ...) */
+    XLSTM_ERR_SIZE = -2,     /* buffer too small or blob truncated */
+    XLSTM_ERR_FORMAT = -3,   /* bad magic, unsupported version or kind */
+    XLSTM_ERR_SHAPE = -4     /* dimensions do not match the caller's */
+} XlstmStatus;
+
+/* Kernel variants (stored in serialized blobs — values are stable) */
+typedef enum {
+    XLSTM_KIND_SLSTM_F32 = 1,
+    XLSTM_KIND_MLSTM_F32 = 2,
+    XLSTM_KIND_SLSTM_S8 = 3,
+    XLSTM_KIND_MLSTM_S8 = 4,
+    XLSTM_KIND_MLSTM_BLOCK_F32 = 5,   /* xlstm_block.h */
+    XLSTM_KIND_SLSTM_BLOCK_F32 = 6,
+    XLSTM_KIND_MLSTM_BLOCK_Q8 = 7,    /* xlstm_block_q8.h */
+    XLSTM_KIND_SLSTM_BLOCK_Q8 = 8
+} XlstmKind;
+
+/* Element types of serialized tensors (values are stable) */
+typedef enum {
+    XLSTM_DTYPE_F32 = 1,
+    XLSTM_DTYPE_S8 = 2,
+    XLSTM_DTYPE_S16 = 3,
+    XLSTM_DTYPE_S32 = 4
+} XlstmDtype;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XLSTM_TYPES_H_ */
@@ -18,8 +18,22 @@
 #ifndef XLSTM_UTIL_H_
 #define XLSTM_UTIL_H_
 
+#include "xlstm_quant.h"
+
 #include <math.h>
 
+/* Count one requantized value: real is the float value, q the unrounded
+ * quantized value, [lo, hi] the integer range it is clamped to. */
+static inline void quant_stats_add(XlstmQuantStats* s, float real, float q,
+                                   float lo, float hi) {
+    float r = roundf(q);
+    float a = fabsf(real);
+
+    s->count++;
+    if (r < lo || r > hi) s->saturated++;
+    if (a > s->max_abs) s->max_abs = a;
+}
+
 static inline float sigmoid_f32(float x) {
     return 1.0f / (1.0f + expf(-x));
 }
@@ -34,4 +48,133 @@ static inline float log_sigmoid_f32(float x) {
     }
 }
 
+static inline float swish_f32(float x) {
+    return x * sigmoid_f32(x);
+}
+
+static inline float gelu_f32(float x) {
+    /* Exact GELU: x * Phi(x) */
+    return 0.5f * x * (1.0f + erff(x * 0.70710678f));
+}
+
+/* ========================================================================== */
+/* Cell math shared by the generic kernels and xlstm_fixed.h                  */
+/* ========================================================================== */
+
+/* sLSTM gating and state update for one unit, given its pre-activations.
+ * Log-space stabilized exponential gates clamped to 1; cell_clip <= 0
+ * disables clipping. Updates y, c, n, m of that unit. */
+static inline void slstm_unit_f32(float i_raw, float f_raw, float z_raw, float o_raw,
+                                  float cell_clip,
+                                  float* y, float* c, float* n, float* m) {
+    float log_f_plus_m = *m + log_sigmoid_f32(f_raw);
+
+    /* n == 0: first timestep */
+    float m_new = *n == 0.0f ? i_raw : fmaxf(i_raw, log_f_plus_m);
+    float i_gate = fminf(expf(i_raw - m_new), 1.0f);
+    float f_gate = fminf(expf(log_f_plus_m - m_new), 1.0f);
+    float o_gate = sigmoid_f32(o_raw);
+    float c_new = f_gate * *c + i_gate * tanhf(z_raw);
+    float n_new = f_gate * *n + i_gate;
+
+    if (cell_clip > 0.0f) c_new = fmaxf(-cell_clip, fminf(cell_clip, c_new));
+
+    *c = c_new;
+    *n = n_new;
+    *m = m_new;
+    /* Normalized output (with epsilon for stability) */
+    *y = o_gate * (c_new / fmaxf(n_new, 1e-6f));
+}
+
+/* mLSTM stabilized scalar gates. Returns the new m and sets the forget and
+ * input gates. */
+static inline float mlstm_gates_f32(float i_raw, float f_raw, float m_prev,
+                                    float* f_gate, float* i_gate) {
+    float log_f_plus_m = log_sigmoid_f32(f_raw) + m_prev;
+    float m_new = fmaxf(log_f_plus_m, i_raw);
+
+    *f_gate = expf(log_f_plus_m - m_new);
+    *i_gate = expf(i_raw - m_new);
+    return m_new;
+}
+
+/* One C entry: f_gate * C + (i_gate * k_r) * v_c, clipped when clip > 0 */
+static inline float mlstm_c_update_f32(float C, float f_gate, float ik, float v,
+                                       float clip) {
+    float c_new = f_gate * C + ik * v;
+    return clip > 0.0f ? fmaxf(-clip, fminf(clip, c_new)) : c_new;
+}
+
+/* Readout denominator: max(|q^T n|, exp(-m)) + eps */
+static inline float mlstm_denom_f32(float qn, float m_new) {
+    return fmaxf(fabsf(qn), expf(-m_new)) + 1e-6f;
+}
+
+/* LayerNorm over len values: out = (x - mean) / sqrt(var + 1e-5) * w + b.
+ * b may be NULL. out may alias x. */
+static inline void layer_norm_f32(const float* x, const float* w, const float* b,
+                                  float* out, int len) {
+    float mean = 0.0f, var = 0.0f, inv;
+    int i;
+
+    for (i = 0; i < len; ++i) mean += x[i];
+    mean /= (float)len;
+    for (i = 0; i < len; ++i) var += (x[i] - mean) * (x[i] - mean);
+    inv = 1.0f / sqrtf(var / (float)len + 1e-5f);
+    for (i = 0; i < len; ++i) {
+        out[i] = (x[i] - mean) * inv * w[i] + (b ? b[i] : 0.0f);
+    }
+}
+
+/* GroupNorm with num_groups equal groups and a per-channel weight (no bias),
+ * as used on the multi-head cell output. out may alias x. */
+static inline void group_norm_f32(const float* x, const float* w, float* out,
+                                  int len, int num_groups) {
+    int group = len / num_groups;
+    int g, i;
+
+    for (g = 0; g < num_groups; ++g) {
+        const float* xg = x + g * group;
+        float mean = 0.0f, var = 0.0f, inv;
+
+        for (i = 0; i < group; ++i) mean += xg[i];
+        mean /= (float)group;
+        for (i = 0; i < group; ++i) var += (xg[i] - mean) * (xg[i] - mean);
+        inv = 1.0f / sqrtf(var / (float)group + 1e-5f);
+        for (i = 0; i < group; ++i) {
+            out[g * group + i] = (xg[i] - mean) * inv * w[g * group + i];
+        }
+    }
+}
+
+/* One step of a depthwise causal conv1d over channels channels.
+ *
+ * history holds the previous K-1 inputs, oldest first ([K-1, channels]);
+ * w is [channels, K] with tap K-1 applied to the current input. Writes
+ * out[channels] and shifts x into history. b may be NULL. */
+static inline void causal_conv_step_f32(const float* x, const float* w, const float* b,
+                                        float* history, float* out,
+                                        int channels, int K) {
+    int ch, k;
+
+    for (ch = 0; ch < channels; ++ch) {
+        float acc = b ? b[ch] : 0.0f;
+        for (k = 0; k < K - 1; ++k) {
+            acc += w[ch * K + k] * history[k * channels + ch];
+        }
+        acc += w[ch * K + K - 1] * x[ch];
+        out[ch] = acc;
+    }
+    for (k = 0; k + 1 < K - 1; ++k) {
+        for (ch = 0; ch < channels; ++ch) {
+            history[k * channels + ch] = history[(k + 1) * channels + ch];
+        }
+    }
+    if (K > 1) {
+        for (ch = 0; ch < channels; ++ch) {
+            history[(K - 2) * channels + ch] = x[ch];
+        }
+    }
+}
+
 #endif /* XLSTM_UTIL_H_ */
@@ -17,47 +17,47 @@
 
 #include "mlstm.h"
 #include "xlstm_util.h"
+#include "xlstm_fpenv.h"
+#include "xlstm_profile.h"
+#include "xlstm_trace.h"
 
 #include <math.h>
+#include <stddef.h>
 
 /* ========================================================================== */
 /* Core mLSTM computation                                                     */
 /* ========================================================================== */
 
-void mlstm_step_f32(
-    const float* x,
-    const float* W,
-    const float* b,
+/* Steps 2-8 of the mLSTM update for one stream, given its pre-activations.
+ * preact layout: [q(H), k(H), v(H), i_raw(1), f_raw(1), o_raw(H)]
+ * (k is scaled in place).
+ *
+ * C is addressed as row tiles of tile_rows rows (the last may be shorter).
+ * The update reads tile t from C_src[t] and writes it to C_dst[t]; likewise
+ * n_src -> n_dst. Source and destination may alias. */
+static void mlstm_cell_tiled_f32(
+    float* preact,
     float* y,
-    float* C,
-    float* n,
+    const float* const* C_src,
+    float* const* C_dst,
+    int tile_rows,
+    const float* n_src,
+    float* n_dst,
     float* m,
-    float* scratch,
-    int input_size,
-    int hidden_size,
+    int H,
     const MlstmParams* params)
 {
-    int H = hidden_size;
-    int I = input_size;
-    int total = 4 * H + 2;
-    int i, j, r, c;
+    int i, j, r, c, t;
+    int num_tiles = (H + tile_rows - 1) / tile_rows;
+    XLSTM_PROFILE_BEGIN(prof_t);
 
-    /* 1. Compute pre-activations: scratch = W*x + b
-     *    scratch layout: [q(H), k(H), v(H), i_raw(1), f_raw(1), o_raw(H)] */
-    for (i = 0; i < total; ++i) {
-        scratch[i] = b[i];
-        for (j = 0; j < I; ++j) {
-            scratch[i] += W[i * I + j] * x[j];
-        }
-    }
-
-    /* 2. Extract projections from scratch */
-    float* q     = scratch;              /* [H] */
-    float* k     = scratch + H;          /* [H] */
-    float* v     = scratch + 2 * H;      /* [H] */
-    float i_raw  = scratch[3 * H];       /* scalar */
-    float f_raw  = scratch[3 * H + 1];   /* scalar */
-    float* o_raw = scratch + 3 * H + 2;  /* [H] */
+    /* 2. Extract projections from pre-activations */
+    float* q     = preact;              /* [H] */
+    float* k     = preact + H;          /* [H] */
+    float* v     = preact + 2 * H;      /* [H] */
+    float i_raw  = preact[3 * H];       /* scalar */
+    float f_raw  = preact[3 * H + 1];   /* scalar */
+    float* o_raw = preact + 3 * H + 2;  /* [H] */
 
     /* 3. Scale key: k /= sqrt(H) */
     float k_scale = 1.0f / sqrtf((float)H);
@@ -66,35 +66,35 @@ void mlstm_step_f32(
     }
 
     /* 4. Stabilized gates (scalar m) */
-    float m_prev = m[0];
-    float log_f_plus_m = log_sigmoid_f32(f_raw) + m_prev;
-    float m_new = fmaxf(log_f_plus_m, i_raw);
-
-    float f_gate = expf(log_f_plus_m - m_new);
-    float i_gate = expf(i_raw - m_new);
+    float f_gate, i_gate;
+    float m_new = mlstm_gates_f32(i_raw, f_raw, m[0], &f_gate, &i_gate);
+    float clip = params ? params->cell_clip : 0.0f;
+    XLSTM_PROFILE_PHASE(XLSTM_KIND_MLSTM_F32, XLSTM_PHASE_GATES, prof_t);
 
-    /* 5. Update C: C[r][c] = f_gate * C[r][c] + i_gate * k[r] * v[c] */
-    for (r = 0; r < H; ++r) {
-        for (c = 0; c < H; ++c) {
-            C[r * H + c] = f_gate * C[r * H + c] + i_gate * k[r] * v[c];
-        }
-    }
+    /* 5. Update C: C[r][c] = f_gate * C[r][c] + i_gate * k[r] * v[c]
+     *    (with optional cell clipping) */
+    for (t = 0; t < num_tiles; ++t) {
+        const float* src = C_src[t];
+        float* dst = C_dst[t];
+        int r0 = t * tile_rows;
+        int rows = (H - r0 < tile_rows) ? H - r0 : tile_rows;
 
-    /* Optional cell clipping */
-    if (params && params->cell_clip > 0.0f) {
-        float clip = params->cell_clip;
-        for (r = 0; r < H * H; ++r) {
-            C[r] = fmaxf(-clip, fminf(clip, C[r]));
+        for (r = 0; r < rows; ++r) {
+            float ik = i_gate * k[r0 + r];
+            for (c = 0; c < H; ++c) {
+                dst[r * H + c] = mlstm_c_update_f32(src[r * H + c], f_gate, ik, v[c], clip);
+            }
         }
     }
 
     /* 6. Update n: n = f_gate * n + i_gate * k */
     for (i = 0; i < H; ++i) {
-        n[i] = f_gate * n[i] + i_gate * k[i];
+        n_dst[i] = f_gate * n_src[i] + i_gate * k[i];
     }
 
     /* 7. Update m */
     m[0] = m_new;
+    XLSTM_PROFILE_PHASE(XLSTM_KIND_MLSTM_F32, XLSTM_PHASE_STATE, prof_t);
 
     /* 8. Compute output: y = sigmoid(o) * (q^T C) / max(|q^T n|, exp(-m)) + eps
      *
@@ -102,17 +102,157 @@ void mlstm_step_f32(
      *    q^T n gives a scalar: qn = sum_i q[i] * n[i] */
     float qn = 0.0f;
     for (i = 0; i < H; ++i) {
-        qn += q[i] * n[i];
+        qn += q[i] * n_dst[i];
     }
-    float denom = fmaxf(fabsf(qn), expf(-m_new)) + 1e-6f;
+    float denom = mlstm_denom_f32(qn, m_new);
 
     for (j = 0; j < H; ++j) {
         float qC_j = 0.0f;
-        for (i = 0; i < H; ++i) {
-            qC_j += q[i] * C[i * H + j];
+        for (t = 0; t < num_tiles; ++t) {
+            const float* tile = C_dst[t];
+            int r0 = t * tile_rows;
+            int rows = (H - r0 < tile_rows) ? H - r0 : tile_rows;
+
+            for (r = 0; r < rows; ++r) {
+                qC_j += q[r0 + r] * tile[r * H + j];
+            }
         }
         y[j] = sigmoid_f32(o_raw[j]) * (qC_j / denom);
     }
+    XLSTM_PROFILE_PHASE(XLSTM_KIND_MLSTM_F32, XLSTM_PHASE_READOUT, prof_t);
+}
+
+/* Untiled C: a single H-row tile updated in place */
+static void mlstm_cell_f32(
+    float* preact,
+    float* y,
+    float* C,
+    float* n,
+    float* m,
+    int H,
+    const MlstmParams* params)
+{
+    const float* C_src = C;
+    mlstm_cell_tiled_f32(preact, y, &C_src, &C, H, n, n, m, H, params);
+}
+
+/* Pre-activations for one stream: out = W*x + b */
+static void mlstm_preact_f32(
+    const float* x,
+    const float* W,
+    const float* b,
+    float* out,
+    int I,
+    int total)
+{
+    int i, j;
+
+    for (i = 0; i < total; ++i) {
+        out[i] = b[i];
+        for (j = 0; j < I; ++j) {
+            out[i] += W[i * I + j] * x[j];
+        }
+    }
+}
+
+void mlstm_step_f32(
+    const float* x,
+    const float* W,
+    const float* b,
+    float* y,
+    float* C,
+    float* n,
+    float* m,
+    float* scratch,
+    int input_size,
+    int hidden_size,
+    const MlstmParams* params)
+{
+    int H = hidden_size;
+    XLSTM_PROFILE_BEGIN(prof_t);
+
+    /* 1. Compute pre-activations: scratch = W*x + b
+     *    scratch layout: [q(H), k(H), v(H), i_raw(1), f_raw(1), o_raw(H)] */
+    mlstm_preact_f32(x, W, b, scratch, input_size, 4 * H + 2);
+    XLSTM_PROFILE_PHASE(XLSTM_KIND_MLSTM_F32, XLSTM_PHASE_PROJECTION, prof_t);
+
+    mlstm_cell_f32(scratch, y, C, n, m, H, params);
+    XLSTM_PROFILE_END(XLSTM_KIND_MLSTM_F32);
+}
+
+void mlstm_step_tiled_f32(
+    const float* x,
+    const float* W,
+    const float* b,
+    float* y,
+    const float* const* C_src,
+    float* const* C_dst,
+    int tile_rows,
+    const float* n_src,
+    float* n_dst,
+    float* m,
+    float* scratch,
+    int input_size,
+    int hidden_size,
+    const MlstmParams* params)
+{
+    int H = hidden_size;
+    XLSTM_PROFILE_BEGIN(prof_t);
+
+    mlstm_preact_f32(x, W, b, scratch, input_size, 4 * H + 2);
+    XLSTM_PROFILE_PHASE(XLSTM_KIND_MLSTM_F32, XLSTM_PHASE_PROJECTION, prof_t);
+
+    mlstm_cell_tiled_f32(scratch, y, C_src, C_dst, tile_rows,
+                         n_src, n_dst, m, H, params);
+    XLSTM_PROFILE_END(XLSTM_KIND_MLSTM_F32);
+}
+
+void mlstm_step_batch_f32(
+    const float* x,
+    const int* slots,
+    int num_slots,
+    const float* W,
+    const float* b,
+    float* y,
+    float* C,
+    float* n,
+    float* m,
+    float* scratch,
+    int input_size,
+    int hidden_size,
+    const MlstmParams* params)
+{
+    int H = hidden_size;
+    int I = input_size;
+    int total = 4 * H + 2;
+    int i, j, k;
+    XLSTM_PROFILE_BEGIN(prof_t);
+
+    /* 1. Pre-activations for every stream, one weight row at a time so each
+     *    row of W is read once per call instead of once per stream.
+     *    scratch layout: [num_slots][4*H+2] */
+    for (i = 0; i < total; ++i) {
+        const float* W_i = W + i * I;
+
+        for (k = 0; k < num_slots; ++k) {
+            const float* x_k = x + k * I;
+            float acc = b[i];
+
+            for (j = 0; j < I; ++j) {
+                acc += W_i[j] * x_k[j];
+            }
+            scratch[k * total + i] = acc;
+        }
+    }
+    XLSTM_PROFILE_PHASE(XLSTM_KIND_MLSTM_F32, XLSTM_PHASE_PROJECTION, prof_t);
+
+    for (k = 0; k < num_slots; ++k) {
+        int s = slots[k];
+        mlstm_cell_f32(scratch + k * total,
+                       y + s * H, C + s * H * H, n + s * H, m + s,
+                       H, params);
+    }
+    XLSTM_PROFILE_END(XLSTM_KIND_MLSTM_F32);
 }
 
 void mlstm_eval_f32(
@@ -130,17 +270,56 @@ void mlstm_eval_f32(
     int input_size,
     int hidden_size,
     const MlstmParams* params)
+{
+    mlstm_eval_reset_f32(
+        input, NULL, W, b, y, C, n, m, output, scratch,
+        batch_size, time_steps, input_size, hidden_size, params);
+}
+
+void mlstm_eval_reset_f32(
+    const float* input,
+    const uint8_t* reset,
+    const float* W,
+    const float* b,
+    float* y,
+    float* C,
+    float* n,
+    float* m,
+    float* output,
+    float* scratch,
+    int batch_size,
+    int time_steps,
+    int input_size,
+    int hidden_size,
+    const MlstmParams* params)
 {
     int B = batch_size;
     int T = time_steps;
     int I = input_size;
     int H = hidden_size;
     int batch, t, i;
+    XlstmFpEnv fpenv;
+    int flush = params && params->flush_denormals;
+    XLSTM_TRACE_BEGIN(trace_t);
+
+    if (flush) xlstm_fpenv_flush_begin(&fpenv);
 
     for (batch = 0; batch < B; ++batch) {
         for (t = 0; t < T; ++t) {
             const float* x_t = input + (batch * T + t) * I;
 
+            /* Episode boundary: start from a zero state */
+            if (reset && reset[batch * T + t]) {
+                for (i = 0; i < H * H; ++i) {
+                    C[batch * H * H + i] = 0.0f;
+                }
+                for (i = 0; i < H; ++i) {
+                    y[batch * H + i] = 0.0f;
+                    n[batch * H + i] = 0.0f;
+                }
+                m[batch] = 0.0f;
+            }
+
             mlstm_step_f32(
                 x_t, W, b,
                 y + batch * H,
@@ -156,4 +335,186 @@ void mlstm_eval_f32(
             }
         }
     }
+    if (flush) xlstm_fpenv_flush_end(&fpenv);
+    XLSTM_TRACE_END("mlstm_eval_f32", -1, -1, trace_t);
+}
+
+/* ========================================================================== */
+/* Speculative evaluation                                                     */
+/* ========================================================================== */
+
+void mlstm_eval_spec_f32(
+    const float* input,
+    const float* W,
+    const float* b,
+    const float* C,
+    const float* n,
+    const float* m,
+    float* output,
+    float* ckpt,
+    float* scratch,
+    int batch_size,
+    int time_steps,
+    int input_size,
+    int hidden_size,
+    const MlstmParams* params)
+{
+    int B = batch_size;
+    int T = time_steps;
+    int I = input_size;
+    int H = hidden_size;
+    int S = 4 * H + 3;
+    int batch, t, s, i, j;
+    float* coef = scratch + 4 * H + 2;   /* [T] per-step readout weights */
+    XlstmFpEnv fpenv;
+    int flush = params && params->flush_denormals;
+    XLSTM_TRACE_BEGIN(trace_t);
+
+    if (flush) xlstm_fpenv_flush_begin(&fpenv);
+
+    for (batch = 0; batch < B; ++batch) {
+        const float* C0 = C + (size_t)batch * H * H;
+        float* rec0 = ckpt + (size_t)batch * T * S;
+
+        for (t = 0; t < T; ++t) {
+            float* rec = rec0 + (size_t)t * S;
+            const float* n_prev = (t == 0) ? n + batch * H : rec - S + 2 * H;
+            float m_prev = (t == 0) ? m[batch] : rec[-1];
+            XLSTM_PROFILE_BEGIN(prof_t);
+
+            mlstm_preact_f32(input + (batch * T + t) * I, W, b, scratch, I, 4 * H + 2);
+            XLSTM_PROFILE_PHASE(XLSTM_KIND_MLSTM_F32, XLSTM_PHASE_PROJECTION, prof_t);
+
+            float* q     = scratch;
+            float* k     = scratch + H;
+            float* v     = scratch + 2 * H;
+            float i_raw  = scratch[3 * H];
+            float f_raw  = scratch[3 * H + 1];
+            float* o_raw = scratch + 3 * H + 2;
+
+            float k_scale = 1.0f / sqrtf((float)H);
+            float f_gate, i_gate;
+            float m_new = mlstm_gates_f32(i_raw, f_raw, m_prev, &f_gate, &i_gate);
+            XLSTM_PROFILE_PHASE(XLSTM_KIND_MLSTM_F32, XLSTM_PHASE_GATES, prof_t);
+
+            /* Record k, v, n, gates and m for this step */
+            for (i = 0; i < H; ++i) {
+                rec[i] = k[i] * k_scale;
+                rec[H + i] = v[i];
+                rec[2 * H + i] = f_gate * n_prev[i] + i_gate * rec[i];
+            }
+            rec[4 * H] = f_gate;
+            rec[4 * H + 1] = i_gate;
+            rec[4 * H + 2] = m_new;
+            XLSTM_PROFILE_PHASE(XLSTM_KIND_MLSTM_F32, XLSTM_PHASE_STATE, prof_t);
+
+            /* Decay of C_0 and weight of each pending rank-1 term at step t:
+             * coef[s] = i_s * f_{s+1} * ... * f_t * (q . k_s) */
+            float decay = 1.0f;
+            for (s = t; s >= 0; --s) {
+                const float* rs = rec0 + (size_t)s * S;
+                float qk = 0.0f;
+                for (i = 0; i < H; ++i) {
+                    qk += q[i] * rs[i];
+                }
+                coef[s] = rs[4 * H + 1] * decay * qk;
+                decay *= rs[4 * H];
+            }
+
+            float qn = 0.0f;
+            for (i = 0; i < H; ++i) {
+                qn += q[i] * rec[2 * H + i];
+            }
+            float denom = mlstm_denom_f32(qn, m_new);
+
+            for (j = 0; j < H; ++j) {
+                float qC_j = 0.0f;
+                for (i = 0; i < H; ++i) {
+                    qC_j += q[i] * C0[i * H + j];
+                }
+                qC_j *= decay;
+                for (s = 0; s <= t; ++s) {
+                    qC_j += coef[s] * rec0[(size_t)s * S + H + j];
+                }
+                rec[3 * H + j] = sigmoid_f32(o_raw[j]) * (qC_j / denom);
+                output[(batch * T + t) * H + j] = rec[3 * H + j];
+            }
+            XLSTM_PROFILE_PHASE(XLSTM_KIND_MLSTM_F32, XLSTM_PHASE_READOUT, prof_t);
+            XLSTM_PROFILE_END(XLSTM_KIND_MLSTM_F32);
+        }
+    }
+    if (flush) xlstm_fpenv_flush_end(&fpenv);
+    XLSTM_TRACE_END("mlstm_eval_spec_f32", -1, -1, trace_t);
+}
+
+int mlstm_spec_commit_f32(
+    const float* ckpt,
+    const int* accepted,
+    float* y,
+    float* C,
+    float* n,
+    float* m,
+    int batch_size,
+    int time_steps,
+    int hidden_size,
+    const MlstmParams* params)
+{
+    int T = time_steps;
+    int H = hidden_size;
+    int S = 4 * H + 3;
+    int batch, s, r, c;
+
+    if (!ckpt || !accepted || !y || !C || !n || !m) return XLSTM_ERR_ARG;
+    if (batch_size < 0 || T < 0 || H < 0) return XLSTM_ERR_ARG;
+    for (batch = 0; batch < batch_size; ++batch) {
+        if (accepted[batch] < 0 || accepted[batch] > T) return XLSTM_ERR_ARG;
+    }
+
+    for (batch = 0; batch < batch_size; ++batch) {
+        int a = accepted[batch];
+        const float* rec0 = ckpt + (size_t)batch * T * S;
+        const float* last;
+        float* Cb = C + (size_t)batch * H * H;
+        float decay = 1.0f;
+
+        if (a <= 0) continue;
+        last = rec0 + (size_t)(a - 1) * S;
+
+        /* Total decay of C_0 over the accepted steps */
+        for (s = 0; s < a; ++s) {
+            decay *= rec0[(size_t)s * S + 4 * H];
+        }
+        for (r = 0; r < H * H; ++r) {
+            Cb[r] *= decay;
+        }
+
+        /* Pending rank-1 terms, newest first:
+         * weight of step s = i_s * f_{s+1} * ... * f_a */
+        decay = 1.0f;
+        for (s = a - 1; s >= 0; --s) {
+            const float* rs = rec0 + (size_t)s * S;
+            float w = rs[4 * H + 1] * decay;
+            for (r = 0; r < H; ++r) {
+                float wk = w * rs[r];
+                for (c = 0; c < H; ++c) {
+                    Cb[r * H + c] += wk * rs[H + c];
+                }
+            }
+            decay *= rs[4 * H];
+        }
+
+        if (params && params->cell_clip > 0.0f) {
+            float clip = params->cell_clip;
+            for (r = 0; r < H * H; ++r) {
+                Cb[r] = fmaxf(-clip, fminf(clip, Cb[r]));
+            }
+        }
+
+        for (r = 0; r < H; ++r) {
+            n[batch * H + r] = last[2 * H + r];
+            y[batch * H + r] = last[3 * H + r];
+        }
+        m[batch] = last[4 * H + 2];
+    }
+    return XLSTM_OK;
 }
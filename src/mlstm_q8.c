@@ -15,7 +15,7 @@
  * mLSTM INT8 quantized implementation — pure C99
  *
  * Compute flow:
- *   1. INT8×INT8 matmul → INT32 accumulator (SIMD-ready)
+ *   1. INT8×INT8 matmul → INT32 accumulator (xlstm_q8_dot.h backends)
  *   2. Dequantize pre-activations to float
  *   3. Key scaling, stabilized gating in float
  *   4. Dequantize INT16 states, update in float, requantize to INT16
@@ -23,41 +23,29 @@
  * ===========================================================================*/
 
 #include "mlstm_q8.h"
+#include "xlstm_q8_dot.h"
 #include "xlstm_util.h"
+#include "xlstm_profile.h"
+#include "xlstm_trace.h"
 
 #include <math.h>
+#include <stddef.h>
 
-void mlstm_step_s8(
-    const int8_t* x,
-    const int8_t* W_q,
-    const int32_t* b_q,
+/* Steps 3-8 of the mLSTM update for one stream, given its float
+ * pre-activations [q(H), k(H), v(H), i_raw(1), f_raw(1), o_raw(H)]
+ * (k is scaled in place). */
+static void mlstm_cell_s8(
+    float* preact,
     int8_t* y,
     int16_t* C,
     int16_t* n,
     float* m,
-    int32_t* scratch,
-    int input_size,
-    int hidden_size,
+    int H,
     const MlstmS8Params* params)
 {
-    int H = hidden_size;
-    int I = input_size;
-    int total = 4 * H + 2;
+    XlstmQ8Stats* stats = params->stats;
     int i, j, r, c;
-
-    float wx_scale = params->W_scale * params->x_quant.scale;
-    int32_t x_zp = params->x_quant.zero_point;
-
-    /* 1+2. INT8×INT8 matmul → float pre-activations.
-     *       scratch layout: [q(H), k(H), v(H), i_raw(1), f_raw(1), o_raw(H)] */
-    float* preact = (float*)scratch;
-    for (i = 0; i < total; ++i) {
-        int32_t acc = 0;
-        for (j = 0; j < I; ++j) {
-            acc += (int32_t)W_q[i * I + j] * ((int32_t)x[j] - x_zp);
-        }
-        preact[i] = (float)acc * wx_scale + (float)b_q[i] * wx_scale;
-    }
+    XLSTM_PROFILE_BEGIN(prof_t);
 
     /* Extract projections from pre-activations */
     float* q     = preact;              /* [H] */
@@ -80,6 +68,7 @@ void mlstm_step_s8(
 
     float f_gate = expf(log_f_plus_m - m_new);
     float i_gate = expf(i_raw - m_new);
+    XLSTM_PROFILE_PHASE(XLSTM_KIND_MLSTM_S8, XLSTM_PHASE_GATES, prof_t);
 
     /* 5. Update C: dequant → float update → requant */
     for (r = 0; r < H; ++r) {
@@ -93,6 +82,7 @@ void mlstm_step_s8(
 
             float C_q = C_new / params->C_quant.scale;
             C[r * H + c] = (int16_t)fmaxf(-32768.0f, fminf(32767.0f, roundf(C_q)));
+            if (stats) quant_stats_add(&stats->c, C_new, C_q, -32768.0f, 32767.0f);
         }
     }
 
@@ -102,10 +92,12 @@ void mlstm_step_s8(
         float n_new = f_gate * n_prev + i_gate * k[i];
         float n_q = n_new / params->n_quant.scale;
         n[i] = (int16_t)fmaxf(-32768.0f, fminf(32767.0f, roundf(n_q)));
+        if (stats) quant_stats_add(&stats->n, n_new, n_q, -32768.0f, 32767.0f);
     }
 
     /* 7. Update m */
     m[0] = m_new;
+    XLSTM_PROFILE_PHASE(XLSTM_KIND_MLSTM_S8, XLSTM_PHASE_STATE, prof_t);
 
     /* 8. Compute output: y = sigmoid(o) * (q^T C) / max(|q^T n|, exp(-m)) + eps
      *    Read back quantized states for output computation. */
@@ -127,12 +119,120 @@ void mlstm_step_s8(
         /* Requantize output to INT8 */
         float y_q = y_new / params->y_quant.scale + (float)params->y_quant.zero_point;
         y[j] = (int8_t)fmaxf(-128.0f, fminf(127.0f, roundf(y_q)));
+        if (stats) quant_stats_add(&stats->y, y_new, y_q, -128.0f, 127.0f);
     }
+    XLSTM_PROFILE_PHASE(XLSTM_KIND_MLSTM_S8, XLSTM_PHASE_READOUT, prof_t);
 }
 
-void mlstm_eval_s8(
+/* One step; with W_corr (packed weights) the zero point is already folded
+ * into the row corrections and the dots are plain. */
+static void mlstm_step_impl(
+    const int8_t* x,
+    const int8_t* W_q,
+    const int32_t* W_corr,
+    const int32_t* b_q,
+    int8_t* y,
+    int16_t* C,
+    int16_t* n,
+    float* m,
+    int32_t* scratch,
+    int input_size,
+    int hidden_size,
+    const MlstmS8Params* params)
+{
+    int H = hidden_size;
+    int I = input_size;
+    int total = 4 * H + 2;
+    int i;
+
+    float wx_scale = params->W_scale * params->x_quant.scale;
+    int32_t x_zp = params->x_quant.zero_point;
+    XLSTM_PROFILE_BEGIN(prof_t);
+
+    /* 1+2. INT8×INT8 matmul → float pre-activations.
+     *       scratch layout: [q(H), k(H), v(H), i_raw(1), f_raw(1), o_raw(H)] */
+    float* preact = (float*)scratch;
+    for (i = 0; i < total; ++i) {
+        int32_t acc = W_corr ? xlstm_dot_s8(W_q + i * I, x, 0, I) + W_corr[i]
+                             : xlstm_dot_s8(W_q + i * I, x, x_zp, I);
+        preact[i] = (float)acc * wx_scale + (float)b_q[i] * wx_scale;
+    }
+    XLSTM_PROFILE_PHASE(XLSTM_KIND_MLSTM_S8, XLSTM_PHASE_PROJECTION, prof_t);
+
+    mlstm_cell_s8(preact, y, C, n, m, H, params);
+    XLSTM_PROFILE_END(XLSTM_KIND_MLSTM_S8);
+}
+
+void mlstm_step_s8(
+    const int8_t* x,
+    const int8_t* W_q,
+    const int32_t* b_q,
+    int8_t* y,
+    int16_t* C,
+    int16_t* n,
+    float* m,
+    int32_t* scratch,
+    int input_size,
+    int hidden_size,
+    const MlstmS8Params* params)
+{
+    mlstm_step_impl(x, W_q, NULL, b_q, y, C, n, m, scratch,
+                    input_size, hidden_size, params);
+}
+
+void mlstm_step_batch_s8(
+    const int8_t* x,
+    const int* slots,
+    int num_slots,
+    const int8_t* W_q,
+    const int32_t* b_q,
+    int8_t* y,
+    int16_t* C,
+    int16_t* n,
+    float* m,
+    int32_t* scratch,
+    int input_size,
+    int hidden_size,
+    const MlstmS8Params* params)
+{
+    int H = hidden_size;
+    int I = input_size;
+    int total = 4 * H + 2;
+    int i, k;
+
+    float wx_scale = params->W_scale * params->x_quant.scale;
+    int32_t x_zp = params->x_quant.zero_point;
+    XLSTM_PROFILE_BEGIN(prof_t);
+
+    /* 1+2. Pre-activations for every stream, one weight row at a time so each
+     *       row of W_q is read once per call instead of once per stream.
+     *       scratch layout: [num_slots][4*H+2], reused as float. */
+    float* preact = (float*)scratch;
+    for (i = 0; i < total; ++i) {
+        const int8_t* W_i = W_q + i * I;
+
+        for (k = 0; k < num_slots; ++k) {
+            const int8_t* x_k = x + k * I;
+            int32_t acc = xlstm_dot_s8(W_i, x_k, x_zp, I);
+            preact[k * total + i] = (float)acc * wx_scale + (float)b_q[i] * wx_scale;
+        }
+    }
+    XLSTM_PROFILE_PHASE(XLSTM_KIND_MLSTM_S8, XLSTM_PHASE_PROJECTION, prof_t);
+
+    for (k = 0; k < num_slots; ++k) {
+        int s = slots[k];
+        mlstm_cell_s8(preact + k * total,
+                      y + s * H, C + s * H * H, n + s * H, m + s,
+                      H, params);
+    }
+    XLSTM_PROFILE_END(XLSTM_KIND_MLSTM_S8);
+}
+
+static void mlstm_eval_impl(
     const int8_t* input,
+    const uint8_t* reset,
     const int8_t* W_q,
+    const int32_t* W_corr,
     const int32_t* b_q,
     int8_t* y,
     int16_t* C,
@@ -151,13 +251,26 @@ void mlstm_eval_s8(
     int I = input_size;
     int H = hidden_size;
     int batch, t, i;
+    XLSTM_TRACE_BEGIN(trace_t);
 
     for (batch = 0; batch < B; ++batch) {
         for (t = 0; t < T; ++t) {
             const int8_t* x_t = input + (batch * T + t) * I;
 
-            mlstm_step_s8(
-                x_t, W_q, b_q,
+            /* Episode boundary: start from a zero state (y at its zero point) */
+            if (reset && reset[batch * T + t]) {
+                for (i = 0; i < H * H; ++i) {
+                    C[batch * H * H + i] = 0;
+                }
+                for (i = 0; i < H; ++i) {
+                    y[batch * H + i] = (int8_t)params->y_quant.zero_point;
+                    n[batch * H + i] = 0;
+                }
+                m[batch] = 0.0f;
+            }
+
+            mlstm_step_impl(
+                x_t, W_q, W_corr, b_q,
                 y + batch * H,
                 C + batch * H * H,
                 n + batch * H,
@@ -171,4 +284,98 @@ void mlstm_eval_s8(
             }
         }
     }
+    XLSTM_TRACE_END("mlstm_eval_s8", -1, -1, trace_t);
+}
+
+void mlstm_eval_s8(
+    const int8_t* input,
+    const int8_t* W_q,
+    const int32_t* b_q,
+    int8_t* y,
+    int16_t* C,
+    int16_t* n,
+    float* m,
+    int8_t* output,
+    int32_t* scratch,
+    int batch_size,
+    int time_steps,
+    int input_size,
+    int hidden_size,
+    const MlstmS8Params* params)
+{
+    mlstm_eval_impl(
+        input, NULL, W_q, NULL, b_q, y, C, n, m, output, scratch,
+        batch_size, time_steps, input_size, hidden_size, params);
+}
+
+void mlstm_eval_reset_s8(
+    const int8_t* input,
+    const uint8_t* reset,
+    const int8_t* W_q,
+    const int32_t* b_q,
+    int8_t* y,
+    int16_t* C,
+    int16_t* n,
+    float* m,
+    int8_t* output,
+    int32_t* scratch,
+    int batch_size,
+    int time_steps,
+    int input_size,
+    int hidden_size,
+    const MlstmS8Params* params)
+{
+    mlstm_eval_impl(
+        input, reset, W_q, NULL, b_q, y, C, n, m, output, scratch,
+        batch_size, time_steps, input_size, hidden_size, params);
+}
+
+/* ========================================================================== */
+/* Packed weights                                                             */
+/* ========================================================================== */
+
+size_t mlstm_pack_s8_size(int input_size, int hidden_size) {
+    (void)input_size;
+    return (4 * (size_t)hidden_size + 2) * sizeof(int32_t);
+}
+
+void mlstm_pack_s8(
+    const int8_t* W_q,
+    int input_size,
+    int hidden_size,
+    const MlstmS8Params* params,
+    void* buf,
+    MlstmS8Packed* packed)
+{
+    int I = input_size;
+    int total = 4 * hidden_size + 2;
+    int32_t* W_corr = (int32_t*)buf;
+    int i;
+
+    for (i = 0; i < total; ++i) {
+        W_corr[i] = -params->x_quant.zero_point * xlstm_row_sum_s8(W_q + i * I, I);
+    }
+    packed->W_q = W_q;
+    packed->W_corr = W_corr;
+}
+
+void mlstm_eval_packed_s8(
+    const int8_t* input,
+    const MlstmS8Packed* packed,
+    const int32_t* b_q,
+    int8_t* y,
+    int16_t* C,
+    int16_t* n,
+    float* m,
+    int8_t* output,
+    int32_t* scratch,
+    int batch_size,
+    int time_steps,
+    int input_size,
+    int hidden_size,
+    const MlstmS8Params* params)
+{
+    mlstm_eval_impl(
+        input, NULL, packed->W_q, packed->W_corr, b_q, y, C, n, m, output, scratch,
+        batch_size, time_steps, input_size, hidden_size, params);
 }
@@ -17,13 +17,37 @@
 
 #include "slstm.h"
 #include "xlstm_util.h"
+#include "xlstm_fpenv.h"
+#include "xlstm_profile.h"
+#include "xlstm_trace.h"
 
 #include <math.h>
+#include <stddef.h>
 
 /* ========================================================================== */
 /* Core sLSTM computation                                                     */
 /* ========================================================================== */
 
+/* Gating + state update for one stream, given its pre-activations.
+ * preact layout: [i_raw, f_raw, z_raw, o_raw] each of size H */
+static void slstm_gates_f32(
+    const float* preact,
+    float* y,
+    float* c,
+    float* n,
+    float* m,
+    int H,
+    const SlstmParams* params)
+{
+    float clip = params ? params->cell_clip : 0.0f;
+    int i;
+
+    for (i = 0; i < H; ++i) {
+        slstm_unit_f32(preact[i], preact[H + i], preact[2 * H + i], preact[3 * H + i],
+                       clip, &y[i], &c[i], &n[i], &m[i]);
+    }
+}
+
 void slstm_step_f32(
     const float* x,
     const float* W,
@@ -41,6 +65,7 @@ void slstm_step_f32(
     int H = hidden_size;
     int I = input_size;
     int i, j;
+    XLSTM_PROFILE_BEGIN(prof_t);
 
     /* Gate pre-activations: scratch = W*x + R*y + b
      * scratch layout: [i_raw, f_raw, z_raw, o_raw] each of size H */
@@ -57,54 +82,66 @@ void slstm_step_f32(
             scratch[i] += R[i * H + j] * y[j];
         }
     }
+    XLSTM_PROFILE_PHASE(XLSTM_KIND_SLSTM_F32, XLSTM_PHASE_PROJECTION, prof_t);
 
-    /* Apply sLSTM gating with log-space stabilization */
-    for (i = 0; i < H; ++i) {
-        float i_raw = scratch[i];
-        float f_raw = scratch[H + i];
-        float z_raw = scratch[2 * H + i];
-        float o_raw = scratch[3 * H + i];
-
-        float c_prev = c[i];
-        float n_prev = n[i];
-        float m_prev = m[i];
-
-        float log_f_plus_m = m_prev + log_sigmoid_f32(f_raw);
-
-        float m_new;
-        if (n_prev == 0.0f) {
-            /* First timestep */
-            m_new = i_raw;
-        } else {
-            m_new = fmaxf(i_raw, log_f_plus_m);
-        }
+    slstm_gates_f32(scratch, y, c, n, m, H, params);
+    XLSTM_PROFILE_PHASE(XLSTM_KIND_SLSTM_F32, XLSTM_PHASE_GATES, prof_t);
+    XLSTM_PROFILE_END(XLSTM_KIND_SLSTM_F32);
+}
 
-        /* Clamped exponential gates */
-        float i_gate = fminf(expf(i_raw - m_new), 1.0f);
-        float f_gate = fminf(expf(log_f_plus_m - m_new), 1.0f);
+void slstm_step_batch_f32(
+    const float* x,
+    const int* slots,
+    int num_slots,
+    const float* W,
+    const float* R,
+    const float* b,
+    float* y,
+    float* c,
+    float* n,
+    float* m,
+    float* scratch,
+    int input_size,
+    int hidden_size,
+    const SlstmParams* params)
+{
+    int H = hidden_size;
+    int I = input_size;
+    int i, j, k;
+    XLSTM_PROFILE_BEGIN(prof_t);
 
-        /* Standard activations */
-        float o_gate = sigmoid_f32(o_raw);
-        float c_input = tanhf(z_raw);
+    /* Pre-activations for every stream, one weight row at a time so each
+     * row of W and R is read once per call instead of once per stream.
+     * scratch layout: [num_slots][4*H] */
+    for (i = 0; i < 4 * H; ++i) {
+        const float* W_i = W + i * I;
+        const float* R_i = R + i * H;
 
-        /* State updates */
-        float c_new = f_gate * c_prev + i_gate * c_input;
-        float n_new = f_gate * n_prev + i_gate;
+        for (k = 0; k < num_slots; ++k) {
+            const float* x_k = x + k * I;
+            const float* y_k = y + slots[k] * H;
+            float acc = b[i];
 
-        /* Optional cell clipping */
-        if (params && params->cell_clip > 0.0f) {
-            c_new = fmaxf(-params->cell_clip, fminf(params->cell_clip, c_new));
+            for (j = 0; j < I; ++j) {
+                acc += W_i[j] * x_k[j];
+            }
+            for (j = 0; j < H; ++j) {
+                acc += R_i[j] * y_k[j];
+            }
+            scratch[k * 4 * H + i] = acc;
         }
+    }
+    XLSTM_PROFILE_PHASE(XLSTM_KIND_SLSTM_F32, XLSTM_PHASE_PROJECTION, prof_t);
 
-        /* Normalized output (with epsilon for stability) */
-        float y_new = o_gate * (c_new / fmaxf(n_new, 1e-6f));
-
-        /* Store updated states */
-        c[i] = c_new;
-        n[i] = n_new;
-        m[i] = m_new;
-        y[i] = y_new;
+    /* All R*y terms are read before any y is overwritten */
+    for (k = 0; k < num_slots; ++k) {
+        int s = slots[k];
+        slstm_gates_f32(scratch + k * 4 * H,
+                        y + s * H, c + s * H, n + s * H, m + s * H,
+                        H, params);
     }
+    XLSTM_PROFILE_PHASE(XLSTM_KIND_SLSTM_F32, XLSTM_PHASE_GATES, prof_t);
+    XLSTM_PROFILE_END(XLSTM_KIND_SLSTM_F32);
 }
 
 void slstm_eval_f32(
@@ -123,17 +160,55 @@ void slstm_eval_f32(
     int input_size,
     int hidden_size,
     const SlstmParams* params)
+{
+    slstm_eval_reset_f32(
+        input, NULL, W, R, b, y, c, n, m, output, scratch,
+        batch_size, time_steps, input_size, hidden_size, params);
+}
+
+void slstm_eval_reset_f32(
+    const float* input,
+    const uint8_t* reset,
+    const float* W,
+    const float* R,
+    const float* b,
+    float* y,
+    float* c,
+    float* n,
+    float* m,
+    float* output,
+    float* scratch,
+    int batch_size,
+    int time_steps,
+    int input_size,
+    int hidden_size,
+    const SlstmParams* params)
 {
     int B = batch_size;
     int T = time_steps;
     int I = input_size;
     int H = hidden_size;
     int batch, t, i;
+    XlstmFpEnv fpenv;
+    int flush = params && params->flush_denormals;
+    XLSTM_TRACE_BEGIN(trace_t);
+
+    if (flush) xlstm_fpenv_flush_begin(&fpenv);
 
     for (batch = 0; batch < B; ++batch) {
         for (t = 0; t < T; ++t) {
             const float* x_t = input + (batch * T + t) * I;
 
+            /* Episode boundary: start from a zero state */
+            if (reset && reset[batch * T + t]) {
+                for (i = 0; i < H; ++i) {
+                    y[batch * H + i] = 0.0f;
+                    c[batch * H + i] = 0.0f;
+                    n[batch * H + i] = 0.0f;
+                    m[batch * H + i] = 0.0f;
+                }
+            }
+
             slstm_step_f32(
                 x_t, W, R, b,
                 y + batch * H,
@@ -149,4 +224,160 @@ void slstm_eval_f32(
             }
         }
     }
+    if (flush) xlstm_fpenv_flush_end(&fpenv);
+    XLSTM_TRACE_END("slstm_eval_f32", -1, -1, trace_t);
+}
+
+void slstm_eval_preact_f32(
+    const float* preact,
+    const float* R,
+    float* y,
+    float* c,
+    float* n,
+    float* m,
+    float* output,
+    float* scratch,
+    int batch_size,
+    int time_steps,
+    int hidden_size,
+    const SlstmParams* params)
+{
+    int B = batch_size;
+    int T = time_steps;
+    int H = hidden_size;
+    int batch, t, i, j;
+    XlstmFpEnv fpenv;
+    int flush = params && params->flush_denormals;
+    XLSTM_TRACE_BEGIN(trace_t);
+
+    if (flush) xlstm_fpenv_flush_begin(&fpenv);
+
+    for (batch = 0; batch < B; ++batch) {
+        float* y_b = y + batch * H;
+
+        for (t = 0; t < T; ++t) {
+            const float* p_t = preact + (size_t)(batch * T + t) * 4 * H;
+            XLSTM_PROFILE_BEGIN(prof_t);
+
+            /* scratch = preact + R*y; only the recurrent term is left */
+            for (i = 0; i < 4 * H; ++i) {
+                float acc = p_t[i];
+                for (j = 0; j < H; ++j) {
+                    acc += R[i * H + j] * y_b[j];
+                }
+                scratch[i] = acc;
+            }
+            XLSTM_PROFILE_PHASE(XLSTM_KIND_SLSTM_F32, XLSTM_PHASE_PROJECTION, prof_t);
+
+            slstm_gates_f32(scratch, y_b, c + batch * H, n + batch * H,
+                            m + batch * H, H, params);
+            XLSTM_PROFILE_PHASE(XLSTM_KIND_SLSTM_F32, XLSTM_PHASE_GATES, prof_t);
+            XLSTM_PROFILE_END(XLSTM_KIND_SLSTM_F32);
+
+            for (i = 0; i < H; ++i) {
+                output[(batch * T + t) * H + i] = y_b[i];
+            }
+        }
+    }
+    if (flush) xlstm_fpenv_flush_end(&fpenv);
+    XLSTM_TRACE_END("slstm_eval_preact_f32", -1, -1, trace_t);
+}
+
+void slstm_eval_spec_f32(
+    const float* input,
+    const float* W,
+    const float* R,
+    const float* b,
+    const float* y,
+    const float* c,
+    const float* n,
+    const float* m,
+    float* output,
+    float* ckpt,
+    float* scratch,
+    int batch_size,
+    int time_steps,
+    int input_size,
+    int hidden_size,
+    const SlstmParams* params)
+{
+    int B = batch_size;
+    int T = time_steps;
+    int I = input_size;
+    int H = hidden_size;
+    int batch, t, i;
+    XlstmFpEnv fpenv;
+    int flush = params && params->flush_denormals;
+    XLSTM_TRACE_BEGIN(trace_t);
+
+    if (flush) xlstm_fpenv_flush_begin(&fpenv);
+
+    for (batch = 0; batch < B; ++batch) {
+        for (t = 0; t < T; ++t) {
+            const float* x_t = input + (batch * T + t) * I;
+            float* cur = ckpt + (size_t)(batch * T + t) * 4 * H;
+
+            /* Seed this step's checkpoint with the previous state */
+            if (t == 0) {
+                for (i = 0; i < H; ++i) {
+                    cur[i]         = y[batch * H + i];
+                    cur[H + i]     = c[batch * H + i];
+                    cur[2 * H + i] = n[batch * H + i];
+                    cur[3 * H + i] = m[batch * H + i];
+                }
+            } else {
+                const float* prev = cur - 4 * H;
+                for (i = 0; i < 4 * H; ++i) {
+                    cur[i] = prev[i];
+                }
+            }
+
+            slstm_step_f32(
+                x_t, W, R, b,
+                cur, cur + H, cur + 2 * H, cur + 3 * H,
+                scratch, I, H, params);
+
+            for (i = 0; i < H; ++i) {
+                output[(batch * T + t) * H + i] = cur[i];
+            }
+        }
+    }
+    if (flush) xlstm_fpenv_flush_end(&fpenv);
+    XLSTM_TRACE_END("slstm_eval_spec_f32", -1, -1, trace_t);
+}
+
+int slstm_spec_commit_f32(
+    const float* ckpt,
+    const int* accepted,
+    float* y,
+    float* c,
+    float* n,
+    float* m,
+    int batch_size,
+    int time_steps,
+    int hidden_size)
+{
+    int T = time_steps;
+    int H = hidden_size;
+    int batch, i;
+
+    if (!ckpt || !accepted || !y || !c || !n || !m) return XLSTM_ERR_ARG;
+    if (batch_size < 0 || T < 0 || H < 0) return XLSTM_ERR_ARG;
+    for (batch = 0; batch < batch_size; ++batch) {
+        if (accepted[batch] < 0 || accepted[batch] > T) return XLSTM_ERR_ARG;
+    }
+
+    for (batch = 0; batch < batch_size; ++batch) {
+        const float* src;
+
+        if (accepted[batch] <= 0) continue;
+        src = ckpt + (size_t)(batch * T + accepted[batch] - 1) * 4 * H;
+        for (i = 0; i < H; ++i) {
+            y[batch * H + i] = src[i];
+            c[batch * H + i] = src[H + i];
+            n[batch * H + i] = src[2 * H + i];
+            m[batch * H + i] = src[3 * H + i];
+        }
+    }
+    return XLSTM_OK;
 }
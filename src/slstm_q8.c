@@ -15,7 +15,7 @@
  * sLSTM INT8 quantized implementation — pure C99
  *
  * Compute flow:
- *   1. INT8×INT8 matmul → INT32 accumulator (SIMD-ready)
+ *   1. INT8×INT8 matmul → INT32 accumulator (xlstm_q8_dot.h backends)
  *   2. Dequantize pre-activations to float
  *   3. Gating + m-stabilization in float
  *   4. Dequantize INT16 states, update in float, requantize to INT16
@@ -23,53 +23,27 @@
  * ===========================================================================*/
 
 #include "slstm_q8.h"
+#include "xlstm_q8_dot.h"
 #include "xlstm_util.h"
+#include "xlstm_profile.h"
+#include "xlstm_trace.h"
 
 #include <math.h>
+#include <stddef.h>
 
-void slstm_step_s8(
-    const int8_t* x,
-    const int8_t* W_q,
-    const int8_t* R_q,
-    const int32_t* b_q,
+/* Gating + requantized state update for one stream (steps 3-7), given its
+ * float pre-activations [i_raw, f_raw, z_raw, o_raw] each of size H. */
+static void slstm_gates_s8(
+    const float* preact,
     int8_t* y,
     int16_t* c,
     int16_t* n,
     float* m,
-    int32_t* scratch,
-    int input_size,
-    int hidden_size,
+    int H,
     const SlstmS8Params* params)
 {
-    int H = hidden_size;
-    int I = input_size;
-    int i, j;
-
-    float wx_scale = params->W_scale * params->x_quant.scale;
-    float ry_scale = params->R_scale * params->y_quant.scale;
-    float b_scale  = wx_scale; /* bias quantized with input*weight scale */
-
-    int32_t x_zp = params->x_quant.zero_point;
-    int32_t y_zp = params->y_quant.zero_point;
-
-    /* 1+2. INT8×INT8 matmul → INT32, then dequantize to float pre-activations.
-     *       Scratch is reused as float* (sizeof(int32_t) == sizeof(float)). */
-    float* preact = (float*)scratch;
-    for (i = 0; i < 4 * H; ++i) {
-        int32_t acc_wx = 0;
-        for (j = 0; j < I; ++j) {
-            acc_wx += (int32_t)W_q[i * I + j] * ((int32_t)x[j] - x_zp);
-        }
-
-        int32_t acc_ry = 0;
-        for (j = 0; j < H; ++j) {
-            acc_ry += (int32_t)R_q[i * H + j] * ((int32_t)y[j] - y_zp);
-        }
-
-        preact[i] = (float)acc_wx * wx_scale
-                   + (float)acc_ry * ry_scale
-                   + (float)b_q[i] * b_scale;
-    }
+    XlstmQ8Stats* stats = params->stats;
+    int i;
 
     /* 3-7. Gating + state updates (same math as f32 kernel) */
     for (i = 0; i < H; ++i) {
@@ -122,13 +96,155 @@ void slstm_step_s8(
         /* 7. Requantize output to INT8 */
         float y_q = y_new / params->y_quant.scale + (float)params->y_quant.zero_point;
         y[i] = (int8_t)fmaxf(-128.0f, fminf(127.0f, roundf(y_q)));
+
+        if (stats) {
+            quant_stats_add(&stats->c, c_new, c_q, -32768.0f, 32767.0f);
+            quant_stats_add(&stats->n, n_new, n_q, -32768.0f, 32767.0f);
+            quant_stats_add(&stats->y, y_new, y_q, -128.0f, 127.0f);
+        }
     }
 }
 
-void slstm_eval_s8(
+/* One step; with W_corr/R_corr (packed weights) the zero points are
+ * already folded into the row corrections and the dots are plain. */
+static void slstm_step_impl(
+    const int8_t* x,
+    const int8_t* W_q,
+    const int8_t* R_q,
+    const int32_t* W_corr,
+    const int32_t* R_corr,
+    const int32_t* b_q,
+    int8_t* y,
+    int16_t* c,
+    int16_t* n,
+    float* m,
+    int32_t* scratch,
+    int input_size,
+    int hidden_size,
+    const SlstmS8Params* params)
+{
+    int H = hidden_size;
+    int I = input_size;
+    int i;
+
+    float wx_scale = params->W_scale * params->x_quant.scale;
+    float ry_scale = params->R_scale * params->y_quant.scale;
+    float b_scale  = wx_scale; /* bias quantized with input*weight scale */
+
+    int32_t x_zp = params->x_quant.zero_point;
+    int32_t y_zp = params->y_quant.zero_point;
+    XLSTM_PROFILE_BEGIN(prof_t);
+
+    /* 1+2. INT8×INT8 matmul → INT32, then dequantize to float pre-activations.
+     *       Scratch is reused as float* (sizeof(int32_t) == sizeof(float)). */
+    float* preact = (float*)scratch;
+    for (i = 0; i < 4 * H; ++i) {
+        int32_t acc_wx, acc_ry;
+        if (W_corr) {
+            acc_wx = xlstm_dot_s8(W_q + i * I, x, 0, I) + W_corr[i];
+            acc_ry = xlstm_dot_s8(R_q + i * H, y, 0, H) + R_corr[i];
+        } else {
+            acc_wx = xlstm_dot_s8(W_q + i * I, x, x_zp, I);
+            acc_ry = xlstm_dot_s8(R_q + i * H, y, y_zp, H);
+        }
+
+        preact[i] = (float)acc_wx * wx_scale
+                   + (float)acc_ry * ry_scale
+                   + (float)b_q[i] * b_scale;
+    }
+    XLSTM_PROFILE_PHASE(XLSTM_KIND_SLSTM_S8, XLSTM_PHASE_PROJECTION, prof_t);
+
+    slstm_gates_s8(preact, y, c, n, m, H, params);
+    XLSTM_PROFILE_PHASE(XLSTM_KIND_SLSTM_S8, XLSTM_PHASE_GATES, prof_t);
+    XLSTM_PROFILE_END(XLSTM_KIND_SLSTM_S8);
+}
+
+void slstm_step_s8(
+    const int8_t* x,
+    const int8_t* W_q,
+    const int8_t* R_q,
+    const int32_t* b_q,
+    int8_t* y,
+    int16_t* c,
+    int16_t* n,
+    float* m,
+    int32_t* scratch,
+    int input_size,
+    int hidden_size,
+    const SlstmS8Params* params)
+{
+    slstm_step_impl(x, W_q, R_q, NULL, NULL, b_q, y, c, n, m, scratch,
+                    input_size, hidden_size, params);
+}
+
+void slstm_step_batch_s8(
+    const int8_t* x,
+    const int* slots,
+    int num_slots,
+    const int8_t* W_q,
+    const int8_t* R_q,
+    const int32_t* b_q,
+    int8_t* y,
+    int16_t* c,
+    int16_t* n,
+    float* m,
+    int32_t* scratch,
+    int input_size,
+    int hidden_size,
+    const SlstmS8Params* params)
+{
+    int H = hidden_size;
+    int I = input_size;
+    int i, k;
+
+    float wx_scale = params->W_scale * params->x_quant.scale;
+    float ry_scale = params->R_scale * params->y_quant.scale;
+    float b_scale  = wx_scale;
+
+    int32_t x_zp = params->x_quant.zero_point;
+    int32_t y_zp = params->y_quant.zero_point;
+    XLSTM_PROFILE_BEGIN(prof_t);
+
+    /* 1+2. Pre-activations for every stream, one weight row at a time so each
+     *       row of W_q and R_q is read once per call instead of once per stream.
+     *       scratch layout: [num_slots][4*H], reused as float. */
+    float* preact = (float*)scratch;
+    for (i = 0; i < 4 * H; ++i) {
+        const int8_t* W_i = W_q + i * I;
+        const int8_t* R_i = R_q + i * H;
+
+        for (k = 0; k < num_slots; ++k) {
+            const int8_t* x_k = x + k * I;
+            const int8_t* y_k = y + slots[k] * H;
+
+            int32_t acc_wx = xlstm_dot_s8(W_i, x_k, x_zp, I);
+            int32_t acc_ry = xlstm_dot_s8(R_i, y_k, y_zp, H);
+
+            preact[k * 4 * H + i] = (float)acc_wx * wx_scale
+                                  + (float)acc_ry * ry_scale
+                                  + (float)b_q[i] * b_scale;
+        }
+    }
+    XLSTM_PROFILE_PHASE(XLSTM_KIND_SLSTM_S8, XLSTM_PHASE_PROJECTION, prof_t);
+
+    /* All R*y terms are read before any y is overwritten */
+    for (k = 0; k < num_slots; ++k) {
+        int s = slots[k];
+        slstm_gates_s8(preact + k * 4 * H,
+                       y + s * H, c + s * H, n + s * H, m + s * H,
+                       H, params);
+    }
+    XLSTM_PROFILE_PHASE(XLSTM_KIND_SLSTM_S8, XLSTM_PHASE_GATES, prof_t);
+    XLSTM_PROFILE_END(XLSTM_KIND_SLSTM_S8);
+}
+
+static void slstm_eval_impl(
     const int8_t* input,
+    const uint8_t* reset,
     const int8_t* W_q,
     const int8_t* R_q,
+    const int32_t* W_corr,
+    const int32_t* R_corr,
     const int32_t* b_q,
     int8_t* y,
     int16_t* c,
@@ -147,13 +263,24 @@ void slstm_eval_s8(
     int I = input_size;
     int H = hidden_size;
     int batch, t, i;
+    XLSTM_TRACE_BEGIN(trace_t);
 
     for (batch = 0; batch < B; ++batch) {
         for (t = 0; t < T; ++t) {
             const int8_t* x_t = input + (batch * T + t) * I;
 
-            slstm_step_s8(
-                x_t, W_q, R_q, b_q,
+            /* Episode boundary: start from a zero state (y at its zero point) */
+            if (reset && reset[batch * T + t]) {
+                for (i = 0; i < H; ++i) {
+                    y[batch * H + i] = (int8_t)params->y_quant.zero_point;
+                    c[batch * H + i] = 0;
+                    n[batch * H + i] = 0;
+                    m[batch * H + i] = 0.0f;
+                }
+            }
+
+            slstm_step_impl(
+                x_t, W_q, R_q, W_corr, R_corr, b_q,
                 y + batch * H,
                 c + batch * H,
                 n + batch * H,
@@ -167,4 +294,106 @@ void slstm_eval_s8(
             }
         }
     }
+    XLSTM_TRACE_END("slstm_eval_s8", -1, -1, trace_t);
+}
+
+void slstm_eval_s8(
+    const int8_t* input,
+    const int8_t* W_q,
+    const int8_t* R_q,
+    const int32_t* b_q,
+    int8_t* y,
+    int16_t* c,
+    int16_t* n,
+    float* m,
+    int8_t* output,
+    int32_t* scratch,
+    int batch_size,
+    int time_steps,
+    int input_size,
+    int hidden_size,
+    const SlstmS8Params* params)
+{
+    slstm_eval_impl(
+        input, NULL, W_q, R_q, NULL, NULL, b_q, y, c, n, m, output, scratch,
+        batch_size, time_steps, input_size, hidden_size, params);
+}
+
+void slstm_eval_reset_s8(
+    const int8_t* input,
+    const uint8_t* reset,
+    const int8_t* W_q,
+    const int8_t* R_q,
+    const int32_t* b_q,
+    int8_t* y,
+    int16_t* c,
+    int16_t* n,
+    float* m,
+    int8_t* output,
+    int32_t* scratch,
+    int batch_size,
+    int time_steps,
+    int input_size,
+    int hidden_size,
+    const SlstmS8Params* params)
+{
+    slstm_eval_impl(
+        input, reset, W_q, R_q, NULL, NULL, b_q, y, c, n, m, output, scratch,
+        batch_size, time_steps, input_size, hidden_size, params);
+}
+
+/* ========================================================================== */
+/* Packed weights                                                             */
+/* ========================================================================== */
+
+size_t slstm_pack_s8_size(int input_size, int hidden_size) {
+    (void)input_size;
+    return 4 * (size_t)hidden_size * 2 * sizeof(int32_t);
+}
+
+void slstm_pack_s8(
+    const int8_t* W_q,
+    const int8_t* R_q,
+    int input_size,
+    int hidden_size,
+    const SlstmS8Params* params,
+    void* buf,
+    SlstmS8Packed* packed)
+{
+    int I = input_size;
+    int H = hidden_size;
+    int32_t* W_corr = (int32_t*)buf;
+    int32_t* R_corr = W_corr + 4 * H;
+    int i;
+
+    for (i = 0; i < 4 * H; ++i) {
+        W_corr[i] = -params->x_quant.zero_point * xlstm_row_sum_s8(W_q + i * I, I);
+        R_corr[i] = -params->y_quant.zero_point * xlstm_row_sum_s8(R_q + i * H, H);
+    }
+    packed->W_q = W_q;
+    packed->R_q = R_q;
+    packed->W_corr = W_corr;
+    packed->R_corr = R_corr;
+}
+
+void slstm_eval_packed_s8(
+    const int8_t* input,
+    const SlstmS8Packed* packed,
+    const int32_t* b_q,
+    int8_t* y,
+    int16_t* c,
+    int16_t* n,
+    float* m,
+    int8_t* output,
+    int32_t* scratch,
+    int batch_size,
+    int time_steps,
+    int input_size,
+    int hidden_size,
+    const SlstmS8Params* params)
+{
+    slstm_eval_impl(
+        input, NULL, packed->W_q, packed->R_q, packed->W_corr, packed->R_corr, b_q,
+        y, c, n, m, output, scratch,
+        batch_size, time_steps, input_size, hidden_size, params);
 }
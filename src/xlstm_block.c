@@ -0,0 +1,234 @@
+/* Copyright 2026 RAWS labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * =========================================================================
+ * xLSTM residual blocks (f32) — pure C99, only depends on math.h
+ * ===========================================================================*/
+
+#include "xlstm_block.h"
+#include "xlstm_util.h"
+#include "xlstm_fpenv.h"
+#include "xlstm_trace.h"
+
+#include <math.h>
+#include <stddef.h>
+
+/* out[rows] = W[rows, cols] * x + b (b may be NULL) */
+static void linear_f32(const float* W, const float* b, const float* x,
+                       float* out, int rows, int cols) {
+    int i, j;
+
+    for (i = 0; i < rows; ++i) {
+        float acc = b ? b[i] : 0.0f;
+        for (j = 0; j < cols; ++j) {
+            acc += W[i * cols + j] * x[j];
+        }
+        out[i] = acc;
+    }
+}
+
+/* ========================================================================== */
+/* mLSTM block                                                                */
+/* ========================================================================== */
+
+size_t mlstm_block_scratch_size(const XlstmMlstmBlock* blk) {
+    size_t D = (size_t)blk->embed_dim;
+    size_t H = (size_t)blk->inner_dim;
+    /* xn, up, cat, cell scratch, h */
+    return D + 2 * H + 2 * H + (4 * H + 2) + H;
+}
+
+void mlstm_block_step_f32(
+    const XlstmMlstmBlock* blk,
+    const float* x,
+    float* out,
+    const XlstmBlockState* state,
+    int batch,
+    float* scratch)
+{
+    int D = blk->embed_dim;
+    int H = blk->inner_dim;
+    int K = blk->conv_kernel;
+    int i;
+
+    float* xn   = scratch;               /* [D] */
+    float* up   = xn + D;                /* [2H]: xm, z */
+    float* cat  = up + 2 * H;            /* [2H]: xc, xm */
+    float* cs   = cat + 2 * H;           /* [4H+2] cell scratch */
+    float* h    = cs + 4 * H + 2;        /* [H] */
+    float* xm   = up;
+    float* z    = up + H;
+    float* xc   = cat;
+
+    /* 1. Norm and up-projection */
+    layer_norm_f32(x, blk->ln_w, blk->ln_b, xn, D);
+    linear_f32(blk->up_W, blk->up_b, xn, up, 2 * H, D);
+
+    /* 2. Causal conv + swish on the mLSTM branch */
+    causal_conv_step_f32(xm, blk->conv_w, blk->conv_b,
+                         K > 1 ? state->conv + (size_t)batch * (K - 1) * H : NULL,
+                         xc, H, K);
+    for (i = 0; i < H; ++i) {
+        xc[i] = swish_f32(xc[i]);
+        cat[H + i] = xm[i];
+    }
+
+    /* 3. Cell */
+    mlstm_step_f32(cat, blk->cell_W, blk->cell_b,
+                   state->y + batch * H,
+                   state->c + (size_t)batch * H * H,
+                   state->n + batch * H,
+                   state->m + batch,
+                   cs, 2 * H, H, &blk->cell_params);
+
+    /* 4. Head norm, learnable skip, output gate */
+    group_norm_f32(state->y + batch * H, blk->gn_w, h, H, blk->num_heads);
+    for (i = 0; i < H; ++i) {
+        h[i] = (h[i] + blk->skip[i] * xc[i]) * swish_f32(z[i]);
+    }
+
+    /* 5. Down-projection + residual */
+    for (i = 0; i < D; ++i) {
+        float acc = blk->down_b ? blk->down_b[i] : 0.0f;
+        int j;
+        for (j = 0; j < H; ++j) {
+            acc += blk->down_W[i * H + j] * h[j];
+        }
+        out[i] = x[i] + acc;
+    }
+}
+
+void mlstm_block_eval_f32(
+    const XlstmMlstmBlock* blk,
+    const float* input,
+    float* output,
+    const XlstmBlockState* state,
+    float* scratch,
+    int batch_size,
+    int time_steps)
+{
+    int D = blk->embed_dim;
+    int batch, t;
+    XlstmFpEnv fpenv;
+    int flush = blk->cell_params.flush_denormals;
+    XLSTM_TRACE_BEGIN(trace_t);
+
+    if (flush) xlstm_fpenv_flush_begin(&fpenv);
+
+    for (batch = 0; batch < batch_size; ++batch) {
+        for (t = 0; t < time_steps; ++t) {
+            size_t offset = ((size_t)batch * time_steps + t) * D;
+            mlstm_block_step_f32(blk, input + offset, output + offset,
+                                 state, batch, scratch);
+        }
+    }
+    if (flush) xlstm_fpenv_flush_end(&fpenv);
+    XLSTM_TRACE_END("mlstm_block_eval_f32", -1, -1, trace_t);
+}
+
+/* ========================================================================== */
+/* sLSTM block                                                                */
+/* ========================================================================== */
+
+size_t slstm_block_scratch_size(const XlstmSlstmBlock* blk) {
+    size_t D = (size_t)blk->embed_dim;
+    size_t F = (size_t)blk->ffn_dim;
+    /* cat, cell scratch, r, rn, ffn */
+    return 2 * D + 4 * D + D + D + 2 * F;
+}
+
+void slstm_block_step_f32(
+    const XlstmSlstmBlock* blk,
+    const float* x,
+    float* out,
+    const XlstmBlockState* state,
+    int batch,
+    float* scratch)
+{
+    int D = blk->embed_dim;
+    int F = blk->ffn_dim;
+    int K = blk->conv_kernel;
+    int i;
+
+    float* cat  = scratch;               /* [2D]: xc, xn */
+    float* cs   = cat + 2 * D;           /* [4D] cell scratch */
+    float* r    = cs + 4 * D;            /* [D] */
+    float* rn   = r + D;                 /* [D] */
+    float* ffn  = rn + D;                /* [2F]: u, g */
+    float* xc   = cat;
+    float* xn   = cat + D;
+
+    /* 1. Norm, causal conv + swish */
+    layer_norm_f32(x, blk->ln_w, blk->ln_b, xn, D);
+    causal_conv_step_f32(xn, blk->conv_w, blk->conv_b,
+                         K > 1 ? state->conv + (size_t)batch * (K - 1) * D : NULL,
+                         xc, D, K);
+    for (i = 0; i < D; ++i) {
+        xc[i] = swish_f32(xc[i]);
+    }
+
+    /* 2. Cell, head norm, residual */
+    slstm_step_f32(cat, blk->cell_W, blk->cell_R, blk->cell_b,
+                   state->y + batch * D,
+                   state->c + batch * D,
+                   state->n + batch * D,
+                   state->m + batch * D,
+                   cs, 2 * D, D, &blk->cell_params);
+    group_norm_f32(state->y + batch * D, blk->gn_w, r, D, blk->num_heads);
+    for (i = 0; i < D; ++i) {
+        r[i] += x[i];
+    }
+
+    /* 3. Gated GELU feed-forward + residual */
+    layer_norm_f32(r, blk->ln2_w, blk->ln2_b, rn, D);
+    linear_f32(blk->up_W, blk->up_b, rn, ffn, 2 * F, D);
+    for (i = 0; i < F; ++i) {
+        ffn[i] = gelu_f32(ffn[i]) * ffn[F + i];
+    }
+    for (i = 0; i < D; ++i) {
+        float acc = blk->down_b ? blk->down_b[i] : 0.0f;
+        int j;
+        for (j = 0; j < F; ++j) {
+            acc += blk->down_W[i * F + j] * ffn[j];
+        }
+        out[i] = r[i] + acc;
+    }
+}
+
+void slstm_block_eval_f32(
+    const XlstmSlstmBlock* blk,
+    const float* input,
+    float* output,
+    const XlstmBlockState* state,
+    float* scratch,
+    int batch_size,
+    int time_steps)
+{
+    int D = blk->embed_dim;
+    int batch, t;
+    XlstmFpEnv fpenv;
+    int flush = blk->cell_params.flush_denormals;
+    XLSTM_TRACE_BEGIN(trace_t);
+
+    if (flush) xlstm_fpenv_flush_begin(&fpenv);
+
+    for (batch = 0; batch < batch_size; ++batch) {
+        for (t = 0; t < time_steps; ++t) {
+            size_t offset = ((size_t)batch * time_steps + t) * D;
+            slstm_block_step_f32(blk, input + offset, output + offset,
+                                 state, batch, scratch);
+        }
+    }
+    if (flush) xlstm_fpenv_flush_end(&fpenv);
+    XLSTM_TRACE_END("slstm_block_eval_f32", -1, -1, trace_t);
+}
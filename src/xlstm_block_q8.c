@@ -0,0 +1,238 @@
+/* Copyright 2026 RAWS labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * =========================================================================
+ * xLSTM residual blocks (INT8) — pure C99, only depends on math.h
+ * ===========================================================================*/
+
+#include "xlstm_block_q8.h"
+#include "xlstm_quant.h"
+#include "xlstm_q8_dot.h"
+#include "xlstm_util.h"
+#include "xlstm_trace.h"
+
+#include <math.h>
+
+/* out[rows] = dequant(W_q[rows, cols] * quant(x)) + b, with x quantized
+ * symmetrically on the fly into xq[cols]. b may be NULL. */
+static void linear_s8(const int8_t* W_q, float W_scale, const float* b,
+                      const float* x, int8_t* xq, float* out,
+                      int rows, int cols) {
+    XlstmQuantParam x_qp;
+    float scale;
+    int i;
+
+    xlstm_quant_symmetric(x, cols, &x_qp);
+    xlstm_quantize_f32_to_s8(x, xq, cols, &x_qp);
+    scale = W_scale * x_qp.scale;
+
+    for (i = 0; i < rows; ++i) {
+        const int8_t* W_i = W_q + i * cols;
+        int32_t acc = xlstm_dot_s8(W_i, xq, 0, cols);
+        out[i] = (float)acc * scale + (b ? b[i] : 0.0f);
+    }
+}
+
+static int max_int(int a, int b) {
+    return a > b ? a : b;
+}
+
+/* ========================================================================== */
+/* mLSTM block                                                                */
+/* ========================================================================== */
+
+size_t mlstm_block_q8_workspace_size(const XlstmMlstmBlockQ8* blk) {
+    size_t D = (size_t)blk->embed_dim;
+    size_t H = (size_t)blk->inner_dim;
+    size_t floats = D + 2 * H + 2 * H + H;        /* xn, up, cat, h */
+    size_t ints = 4 * H + 2;                      /* cell accumulators */
+    size_t bytes = (size_t)max_int((int)D, (int)H) + 2 * H;  /* xq, cat_q */
+    return floats * sizeof(float) + ints * sizeof(int32_t) + bytes;
+}
+
+void mlstm_block_step_q8(
+    const XlstmMlstmBlockQ8* blk,
+    const float* x,
+    float* out,
+    const XlstmBlockStateQ8* state,
+    int batch,
+    void* workspace)
+{
+    int D = blk->embed_dim;
+    int H = blk->inner_dim;
+    int K = blk->conv_kernel;
+    int i;
+
+    float* xn     = (float*)workspace;       /* [D] */
+    float* up     = xn + D;                  /* [2H]: xm, z */
+    float* cat    = up + 2 * H;              /* [2H]: xc, xm */
+    float* h      = cat + 2 * H;             /* [H] */
+    int32_t* acc  = (int32_t*)(h + H);       /* [4H+2] */
+    int8_t* xq    = (int8_t*)(acc + 4 * H + 2);   /* [max(D, H)] */
+    int8_t* cat_q = xq + max_int(D, H);      /* [2H] */
+    float* xm     = up;
+    float* z      = up + H;
+    float* xc     = cat;
+
+    /* 1. Norm and up-projection */
+    layer_norm_f32(x, blk->ln_w, blk->ln_b, xn, D);
+    linear_s8(blk->up_W, blk->up_scale, blk->up_b, xn, xq, up, 2 * H, D);
+
+    /* 2. Causal conv + swish on the mLSTM branch */
+    causal_conv_step_f32(xm, blk->conv_w, blk->conv_b,
+                         K > 1 ? state->conv + (size_t)batch * (K - 1) * H : NULL,
+                         xc, H, K);
+    for (i = 0; i < H; ++i) {
+        xc[i] = swish_f32(xc[i]);
+        cat[H + i] = xm[i];
+    }
+
+    /* 3. Cell on the quantized input */
+    xlstm_quantize_f32_to_s8(cat, cat_q, 2 * H, &blk->cell_params.x_quant);
+    mlstm_step_s8(cat_q, blk->cell_W, blk->cell_b,
+                  state->y + batch * H,
+                  state->c + (size_t)batch * H * H,
+                  state->n + batch * H,
+                  state->m + batch,
+                  acc, 2 * H, H, &blk->cell_params);
+    xlstm_dequantize_s8_to_f32(state->y + batch * H, h, H, &blk->cell_params.y_quant);
+
+    /* 4. Head norm, learnable skip, output gate */
+    group_norm_f32(h, blk->gn_w, h, H, blk->num_heads);
+    for (i = 0; i < H; ++i) {
+        h[i] = (h[i] + blk->skip[i] * xc[i]) * swish_f32(z[i]);
+    }
+
+    /* 5. Down-projection + residual (xn is free again) */
+    linear_s8(blk->down_W, blk->down_scale, blk->down_b, h, xq, xn, D, H);
+    for (i = 0; i < D; ++i) {
+        out[i] = x[i] + xn[i];
+    }
+}
+
+void mlstm_block_eval_q8(
+    const XlstmMlstmBlockQ8* blk,
+    const float* input,
+    float* output,
+    const XlstmBlockStateQ8* state,
+    void* workspace,
+    int batch_size,
+    int time_steps)
+{
+    int D = blk->embed_dim;
+    int batch, t;
+    XLSTM_TRACE_BEGIN(trace_t);
+
+    for (batch = 0; batch < batch_size; ++batch) {
+        for (t = 0; t < time_steps; ++t) {
+            size_t offset = ((size_t)batch * time_steps + t) * D;
+            mlstm_block_step_q8(blk, input + offset, output + offset,
+                                state, batch, workspace);
+        }
+    }
+    XLSTM_TRACE_END("mlstm_block_eval_q8", -1, -1, trace_t);
+}
+
+/* ========================================================================== */
+/* sLSTM block                                                                */
+/* ========================================================================== */
+
+size_t slstm_block_q8_workspace_size(const XlstmSlstmBlockQ8* blk) {
+    size_t D = (size_t)blk->embed_dim;
+    size_t F = (size_t)blk->ffn_dim;
+    size_t floats = 2 * D + D + D + 2 * F;        /* cat, r, rn, ffn */
+    size_t ints = 4 * D;                          /* cell accumulators */
+    size_t bytes = (size_t)max_int((int)D, (int)F) + 2 * D;  /* xq, cat_q */
+    return floats * sizeof(float) + ints * sizeof(int32_t) + bytes;
+}
+
+void slstm_block_step_q8(
+    const XlstmSlstmBlockQ8* blk,
+    const float* x,
+    float* out,
+    const XlstmBlockStateQ8* state,
+    int batch,
+    void* workspace)
+{
+    int D = blk->embed_dim;
+    int F = blk->ffn_dim;
+    int K = blk->conv_kernel;
+    int i;
+
+    float* cat    = (float*)workspace;       /* [2D]: xc, xn */
+    float* r      = cat + 2 * D;             /* [D] */
+    float* rn     = r + D;                   /* [D] */
+    float* ffn    = rn + D;                  /* [2F]: u, g */
+    int32_t* acc  = (int32_t*)(ffn + 2 * F); /* [4D] */
+    int8_t* xq    = (int8_t*)(acc + 4 * D);  /* [max(D, F)] */
+    int8_t* cat_q = xq + max_int(D, F);      /* [2D] */
+    float* xc     = cat;
+    float* xn     = cat + D;
+
+    /* 1. Norm, causal conv + swish */
+    layer_norm_f32(x, blk->ln_w, blk->ln_b, xn, D);
+    causal_conv_step_f32(xn, blk->conv_w, blk->conv_b,
+                         K > 1 ? state->conv + (size_t)batch * (K - 1) * D : NULL,
+                         xc, D, K);
+    for (i = 0; i < D; ++i) {
+        xc[i] = swish_f32(xc[i]);
+    }
+
+    /* 2. Cell, head norm, residual */
+    xlstm_quantize_f32_to_s8(cat, cat_q, 2 * D, &blk->cell_params.x_quant);
+    slstm_step_s8(cat_q, blk->cell_W, blk->cell_R, blk->cell_b,
+                  state->y + batch * D,
+                  state->c + batch * D,
+                  state->n + batch * D,
+                  state->m + batch * D,
+                  acc, 2 * D, D, &blk->cell_params);
+    xlstm_dequantize_s8_to_f32(state->y + batch * D, r, D, &blk->cell_params.y_quant);
+    group_norm_f32(r, blk->gn_w, r, D, blk->num_heads);
+    for (i = 0; i < D; ++i) {
+        r[i] += x[i];
+    }
+
+    /* 3. Gated GELU feed-forward + residual */
+    layer_norm_f32(r, blk->ln2_w, blk->ln2_b, rn, D);
+    linear_s8(blk->up_W, blk->up_scale, blk->up_b, rn, xq, ffn, 2 * F, D);
+    for (i = 0; i < F; ++i) {
+        ffn[i] = gelu_f32(ffn[i]) * ffn[F + i];
+    }
+    linear_s8(blk->down_W, blk->down_scale, blk->down_b, ffn, xq, rn, D, F);
+    for (i = 0; i < D; ++i) {
+        out[i] = r[i] + rn[i];
+    }
+}
+
+void slstm_block_eval_q8(
+    const XlstmSlstmBlockQ8* blk,
+    const float* input,
+    float* output,
+    const XlstmBlockStateQ8* state,
+    void* workspace,
+    int batch_size,
+    int time_steps)
+{
+    int D = blk->embed_dim;
+    int batch, t;
+    XLSTM_TRACE_BEGIN(trace_t);
+
+    for (batch = 0; batch < batch_size; ++batch) {
+        for (t = 0; t < time_steps; ++t) {
+            size_t offset = ((size_t)batch * time_steps + t) * D;
+            slstm_block_step_q8(blk, input + offset, output + offset,
+                                state, batch, workspace);
+        }
+    }
+    XLSTM_TRACE_END("slstm_block_eval_q8", -1, -1, trace_t);
+}
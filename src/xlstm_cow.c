@@ -0,0 +1,226 @@
+/* Copyright 2026 RAWS labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * =========================================================================
+ * Copy-on-write mLSTM state handles — pure C99, no allocation.
+ * ===========================================================================*/
+
+#include "xlstm_cow.h"
+
+#include <stddef.h>
+
+/* ========================================================================== */
+/* Block pool                                                                 */
+/* ========================================================================== */
+
+int xlstm_cow_blocks_per_state(int hidden_size, int tile_rows) {
+    return (hidden_size + tile_rows - 1) / tile_rows;
+}
+
+static void blocks_init(XlstmCowBlocks* cls, float* data, int32_t* refcount,
+                        int32_t* free_list, int num_blocks, int block_size) {
+    int i;
+
+    cls->data = data;
+    cls->refcount = refcount;
+    cls->free_list = free_list;
+    cls->num_blocks = num_blocks;
+    cls->block_size = block_size;
+
+    /* Free stack pops block 0 first */
+    for (i = 0; i < num_blocks; ++i) {
+        refcount[i] = 0;
+        free_list[i] = num_blocks - 1 - i;
+    }
+    cls->num_free = num_blocks;
+}
+
+int xlstm_cow_init(
+    XlstmCowPool* pool,
+    float* blocks,
+    int32_t* refcount,
+    int32_t* free_list,
+    int num_blocks,
+    float* n_blocks,
+    int32_t* n_refcount,
+    int32_t* n_free_list,
+    int num_n_blocks,
+    const float** tile_src,
+    float** tile_dst,
+    int hidden_size,
+    int tile_rows)
+{
+    if (!pool || !blocks || !refcount || !free_list || !n_blocks ||
+        !n_refcount || !n_free_list || !tile_src || !tile_dst ||
+        num_blocks <= 0 || num_n_blocks <= 0 || hidden_size <= 0 ||
+        tile_rows <= 0 || tile_rows > hidden_size) {
+        return XLSTM_ERR_ARG;
+    }
+
+    blocks_init(&pool->tiles, blocks, refcount, free_list, num_blocks,
+                tile_rows * hidden_size);
+    blocks_init(&pool->n, n_blocks, n_refcount, n_free_list, num_n_blocks,
+                hidden_size);
+    pool->tile_src = tile_src;
+    pool->tile_dst = tile_dst;
+    pool->hidden_size = hidden_size;
+    pool->tile_rows = tile_rows;
+    pool->num_tiles = (hidden_size + tile_rows - 1) / tile_rows;
+    return XLSTM_OK;
+}
+
+static float* block_ptr(const XlstmCowBlocks* cls, int32_t id) {
+    return cls->data + (size_t)id * (size_t)cls->block_size;
+}
+
+static int32_t block_alloc(XlstmCowBlocks* cls) {
+    int32_t id = cls->free_list[--cls->num_free];
+    cls->refcount[id] = 1;
+    return id;
+}
+
+static void block_unref(XlstmCowBlocks* cls, int32_t id) {
+    if (--cls->refcount[id] == 0) {
+        cls->free_list[cls->num_free++] = id;
+    }
+}
+
+/* Allocate a zeroed block */
+static int32_t block_alloc_zero(XlstmCowBlocks* cls) {
+    int32_t id = block_alloc(cls);
+    float* p = block_ptr(cls, id);
+    int i;
+    for (i = 0; i < cls->block_size; ++i) p[i] = 0.0f;
+    return id;
+}
+
+/* ========================================================================== */
+/* State handles                                                              */
+/* ========================================================================== */
+
+int xlstm_cow_state_init(
+    XlstmCowPool* pool,
+    XlstmCowState* state,
+    int32_t* blocks,
+    float* y)
+{
+    int i, t;
+
+    if (pool->tiles.num_free < pool->num_tiles || pool->n.num_free < 1) {
+        return XLSTM_ERR_SIZE;
+    }
+
+    state->blocks = blocks;
+    state->y = y;
+    state->m = 0.0f;
+    for (t = 0; t < pool->num_tiles; ++t) blocks[t] = block_alloc_zero(&pool->tiles);
+    state->n_block = block_alloc_zero(&pool->n);
+    for (i = 0; i < pool->hidden_size; ++i) y[i] = 0.0f;
+    return XLSTM_OK;
+}
+
+void xlstm_cow_fork(
+    XlstmCowPool* pool,
+    XlstmCowState* dst,
+    int32_t* blocks,
+    float* y,
+    const XlstmCowState* src)
+{
+    int i;
+
+    for (i = 0; i < pool->num_tiles; ++i) {
+        blocks[i] = src->blocks[i];
+        pool->tiles.refcount[blocks[i]]++;
+    }
+    dst->n_block = src->n_block;
+    pool->n.refcount[dst->n_block]++;
+    for (i = 0; i < pool->hidden_size; ++i) y[i] = src->y[i];
+    dst->blocks = blocks;
+    dst->y = y;
+    dst->m = src->m;
+}
+
+void xlstm_cow_release(XlstmCowPool* pool, XlstmCowState* state) {
+    int i;
+
+    for (i = 0; i < pool->num_tiles; ++i) {
+        block_unref(&pool->tiles, state->blocks[i]);
+        state->blocks[i] = -1;
+    }
+    block_unref(&pool->n, state->n_block);
+    state->n_block = -1;
+}
+
+const float* xlstm_cow_tile(const XlstmCowPool* pool, const XlstmCowState* state, int t) {
+    return block_ptr(&pool->tiles, state->blocks[t]);
+}
+
+const float* xlstm_cow_n(const XlstmCowPool* pool, const XlstmCowState* state) {
+    return block_ptr(&pool->n, state->n_block);
+}
+
+/* ========================================================================== */
+/* Step                                                                       */
+/* ========================================================================== */
+
+int xlstm_cow_step_mlstm_f32(
+    XlstmCowPool* pool,
+    XlstmCowState* state,
+    const float* x,
+    const float* W,
+    const float* b,
+    float* scratch,
+    int input_size,
+    const MlstmParams* params)
+{
+    int T = pool->num_tiles;
+    int shared = 0;
+    int n_shared = pool->n.refcount[state->n_block] > 1;
+    int t;
+    const float* n_src;
+    float* n_dst;
+
+    for (t = 0; t < T; ++t) {
+        if (pool->tiles.refcount[state->blocks[t]] > 1) shared++;
+    }
+    if (shared > pool->tiles.num_free || n_shared > pool->n.num_free) {
+        return XLSTM_ERR_SIZE;
+    }
+
+    /* Shared blocks: read the old block, write a private copy. The old
+     * block keeps its other owners, so dropping our reference never frees
+     * it before the step has read it. */
+    for (t = 0; t < T; ++t) {
+        int32_t id = state->blocks[t];
+
+        pool->tile_src[t] = block_ptr(&pool->tiles, id);
+        if (pool->tiles.refcount[id] > 1) {
+            block_unref(&pool->tiles, id);
+            state->blocks[t] = block_alloc(&pool->tiles);
+        }
+        pool->tile_dst[t] = block_ptr(&pool->tiles, state->blocks[t]);
+    }
+    n_src = block_ptr(&pool->n, state->n_block);
+    if (n_shared) {
+        block_unref(&pool->n, state->n_block);
+        state->n_block = block_alloc(&pool->n);
+    }
+    n_dst = block_ptr(&pool->n, state->n_block);
+
+    mlstm_step_tiled_f32(
+        x, W, b, state->y,
+        pool->tile_src, pool->tile_dst, pool->tile_rows,
+        n_src, n_dst, &state->m, scratch,
+        input_size, pool->hidden_size, params);
+    return XLSTM_OK;
+}
@@ -0,0 +1,576 @@
+/* Copyright 2026 RAWS labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * =========================================================================
+ * Model weight files — pure C99, no dependencies. File mapping lives in
+ * xlstm_model_posix.c so bare-metal builds can leave it out.
+ * ===========================================================================*/
+
+#include "xlstm_model.h"
+
+#include <string.h>
+
+typedef char xlstm_model_header_is_64_bytes[
+    (sizeof(XlstmModelHeader) == 64) ? 1 : -1];
+typedef char xlstm_model_layer_is_64_bytes[
+    (sizeof(XlstmModelLayer) == 64) ? 1 : -1];
+typedef char xlstm_model_tensor_is_48_bytes[
+    (sizeof(XlstmModelTensor) == 48) ? 1 : -1];
+
+#define XLSTM_MODEL_MAX_COUNT 0x7FFFFFFFu
+/* Largest layer dim: the bind row counts (up to 4 * dim + 2) stay in int */
+#define XLSTM_MODEL_MAX_DIM ((XLSTM_MODEL_MAX_COUNT - 2) / 4)
+
+/* ========================================================================== */
+/* Helpers                                                                    */
+/* ========================================================================== */
+
+static uint64_t align_up(uint64_t v) {
+    return (v + XLSTM_MODEL_ALIGN - 1) & ~(uint64_t)(XLSTM_MODEL_ALIGN - 1);
+}
+
+/* Element size in bytes, 0 for an unknown dtype */
+static uint64_t dtype_size(uint32_t dtype) {
+    switch (dtype) {
+        case XLSTM_DTYPE_F32: return 4;
+        case XLSTM_DTYPE_S8: return 1;
+        case XLSTM_DTYPE_S16: return 2;
+        case XLSTM_DTYPE_S32: return 4;
+    }
+    return 0;
+}
+
+static int known_kind(uint32_t kind) {
+    return kind >= XLSTM_KIND_SLSTM_F32 && kind <= XLSTM_KIND_SLSTM_BLOCK_Q8;
+}
+
+/* ========================================================================== */
+/* Open                                                                       */
+/* ========================================================================== */
+
+/* True if [offset, offset + count * entry) lies inside total. */
+static int table_fits(uint64_t offset, uint64_t count, uint64_t entry,
+                      uint64_t total) {
+    if (offset > total || (offset & 7u) != 0) return 0;
+    return count <= (total - offset) / entry;
+}
+
+int xlstm_model_open(XlstmModel* model, const void* data, size_t size) {
+    const XlstmModelHeader* hdr = (const XlstmModelHeader*)data;
+    const XlstmModelLayer* layers;
+    const XlstmModelTensor* tensors;
+    uint64_t total;
+    uint32_t i;
+
+    if (!model || !data) return XLSTM_ERR_ARG;
+    if (((uintptr_t)data & (XLSTM_MODEL_ALIGN - 1)) != 0) return XLSTM_ERR_ARG;
+    if (size < sizeof(XlstmModelHeader)) return XLSTM_ERR_SIZE;
+    if (hdr->magic != XLSTM_MODEL_MAGIC) return XLSTM_ERR_FORMAT;
+    if (hdr->version != XLSTM_MODEL_VERSION) return XLSTM_ERR_FORMAT;
+
+    total = hdr->total_size;
+    if (total > size) return XLSTM_ERR_SIZE;
+    if (hdr->num_layers > XLSTM_MODEL_MAX_COUNT ||
+        hdr->num_tensors > XLSTM_MODEL_MAX_COUNT) {
+        return XLSTM_ERR_FORMAT;
+    }
+    if (!table_fits(hdr->layer_offset, hdr->num_layers,
+                    sizeof(XlstmModelLayer), total) ||
+        !table_fits(hdr->tensor_offset, hdr->num_tensors,
+                    sizeof(XlstmModelTensor), total)) {
+        return XLSTM_ERR_SIZE;
+    }
+
+    layers = (const XlstmModelLayer*)((const uint8_t*)data + hdr->layer_offset);
+    tensors = (const XlstmModelTensor*)((const uint8_t*)data + hdr->tensor_offset);
+
+    for (i = 0; i < hdr->num_tensors; ++i) {
+        const XlstmModelTensor* t = &tensors[i];
+        uint64_t esize = dtype_size(t->dtype);
+        if (esize == 0 || t->rows == 0 || t->cols == 0) return XLSTM_ERR_FORMAT;
+        if (t->nbytes != (uint64_t)t->rows * t->cols * esize) return XLSTM_ERR_FORMAT;
+        if ((t->offset & (XLSTM_MODEL_ALIGN - 1)) != 0) return XLSTM_ERR_FORMAT;
+        if (t->offset > total || t->nbytes > total - t->offset) return XLSTM_ERR_SIZE;
+    }
+    for (i = 0; i < hdr->num_layers; ++i) {
+        const XlstmModelLayer* l = &layers[i];
+        if (!known_kind(l->kind)) return XLSTM_ERR_FORMAT;
+        if ((uint64_t)l->first_tensor + l->num_tensors > hdr->num_tensors) {
+            return XLSTM_ERR_FORMAT;
+        }
+    }
+
+    model->data = (const uint8_t*)data;
+    model->size = (size_t)total;
+    model->layers = layers;
+    model->tensors = tensors;
+    model->num_layers = (int)hdr->num_layers;
+    model->num_tensors = (int)hdr->num_tensors;
+    return XLSTM_OK;
+}
+
+const XlstmModelTensor* xlstm_model_find(
+    const XlstmModel* model, int layer, XlstmTensorRole role) {
+    const XlstmModelLayer* l;
+    uint32_t i;
+
+    if (!model || layer < 0 || layer >= model->num_layers) return NULL;
+    l = &model->layers[layer];
+    for (i = 0; i < l->num_tensors; ++i) {
+        const XlstmModelTensor* t = &model->tensors[l->first_tensor + i];
+        if (t->role == (uint8_t)role) return t;
+    }
+    return NULL;
+}
+
+/* ========================================================================== */
+/* Bind                                                                       */
+/* ========================================================================== */
+
+/* Sticky-status lookup so the bind functions read as a list of tensors. */
+typedef struct {
+    const XlstmModel* model;
+    int layer;
+    int status;
+} Binder;
+
+/* Check layer l against kind and return its record with the first
+ * num_dims dims converted to int (all in 1..XLSTM_MODEL_MAX_DIM), or NULL
+ * with status set. */
+static const XlstmModelLayer* bind_layer(Binder* b, const XlstmModel* model,
+                                         int layer, XlstmKind kind,
+                                         int num_dims, int dims[4]) {
+    const XlstmModelLayer* l;
+    int d;
+
+    b->model = model;
+    b->layer = layer;
+    b->status = XLSTM_OK;
+    if (!model || layer < 0 || layer >= model->num_layers) {
+        b->status = XLSTM_ERR_ARG;
+        return NULL;
+    }
+    l = &model->layers[layer];
+    if (l->kind != (uint8_t)kind) {
+        b->status = XLSTM_ERR_FORMAT;
+        return NULL;
+    }
+    for (d = 0; d < num_dims; ++d) {
+        if (l->dims[d] == 0 || l->dims[d] > XLSTM_MODEL_MAX_DIM) {
+            b->status = XLSTM_ERR_SHAPE;
+            return NULL;
+        }
+        dims[d] = (int)l->dims[d];
+    }
+    return l;
+}
+
+/* Pointer to the tensor of the given role, checked for dtype and shape.
+ * Missing optional tensors yield NULL without an error. */
+static const void* bind_tensor(Binder* b, XlstmTensorRole role,
+                               XlstmDtype dtype, int rows, int cols,
+                               int required, float* scale) {
+    const XlstmModelTensor* t;
+
+    if (b->status != XLSTM_OK) return NULL;
+    t = xlstm_model_find(b->model, b->layer, role);
+    if (!t) {
+        if (required) b->status = XLSTM_ERR_FORMAT;
+        return NULL;
+    }
+    if (t->dtype != (uint8_t)dtype) {
+        b->status = XLSTM_ERR_FORMAT;
+        return NULL;
+    }
+    if (t->rows != (uint32_t)rows || t->cols != (uint32_t)cols) {
+        b->status = XLSTM_ERR_SHAPE;
+        return NULL;
+    }
+    if (scale) *scale = t->quant.scale;
+    return b->model->data + t->offset;
+}
+
+int xlstm_model_bind_stack_layer(
+    const XlstmModel* model, int layer, XlstmStackLayer* out) {
+    Binder b;
+    const XlstmModelLayer* l;
+    const float *W, *R = NULL, *bias;
+    XlstmKind kind;
+    int dims[4], I, H, gates;
+
+    if (!out) return XLSTM_ERR_ARG;
+    if (!model || layer < 0 || layer >= model->num_layers) return XLSTM_ERR_ARG;
+    kind = (XlstmKind)model->layers[layer].kind;
+    if (kind != XLSTM_KIND_SLSTM_F32 && kind != XLSTM_KIND_MLSTM_F32) {
+        return XLSTM_ERR_FORMAT;
+    }
+    l = bind_layer(&b, model, layer, kind, 2, dims);
+    if (!l) return b.status;
+    I = dims[0];
+    H = dims[1];
+    gates = (kind == XLSTM_KIND_SLSTM_F32) ? 4 * H : 4 * H + 2;
+
+    W = (const float*)bind_tensor(&b, XLSTM_ROLE_CELL_W, XLSTM_DTYPE_F32, gates, I, 1, NULL);
+    if (kind == XLSTM_KIND_SLSTM_F32) {
+        R = (const float*)bind_tensor(&b, XLSTM_ROLE_CELL_R, XLSTM_DTYPE_F32, gates, H, 1, NULL);
+    }
+    bias = (const float*)bind_tensor(&b, XLSTM_ROLE_CELL_B, XLSTM_DTYPE_F32, gates, 1, 1, NULL);
+    if (b.status != XLSTM_OK) return b.status;
+
+    out->kind = kind;
+    out->input_size = I;
+    out->hidden_size = H;
+    out->W = W;
+    out->R = R;
+    out->b = bias;
+    out->slstm_params.cell_clip = l->cell_clip;
+    out->mlstm_params.cell_clip = l->cell_clip;
+    out->slstm_params.flush_denormals = 0;
+    out->mlstm_params.flush_denormals = 0;
+    return XLSTM_OK;
+}
+
+int xlstm_model_bind_slstm_s8(
+    const XlstmModel* model, int layer,
+    const int8_t** W, const int8_t** R, const int32_t** b,
+    SlstmS8Params* params) {
+    Binder bd;
+    const XlstmModelLayer* l;
+    const int8_t *w, *r;
+    const int32_t* bias;
+    float W_scale = 0.0f, R_scale = 0.0f;
+    int dims[4], I, H;
+
+    if (!W || !R || !b || !params) return XLSTM_ERR_ARG;
+    l = bind_layer(&bd, model, layer, XLSTM_KIND_SLSTM_S8, 2, dims);
+    if (!l) return bd.status;
+    I = dims[0];
+    H = dims[1];
+
+    w = (const int8_t*)bind_tensor(&bd, XLSTM_ROLE_CELL_W, XLSTM_DTYPE_S8, 4 * H, I, 1, &W_scale);
+    r = (const int8_t*)bind_tensor(&bd, XLSTM_ROLE_CELL_R, XLSTM_DTYPE_S8, 4 * H, H, 1, &R_scale);
+    bias = (const int32_t*)bind_tensor(&bd, XLSTM_ROLE_CELL_B, XLSTM_DTYPE_S32, 4 * H, 1, 1, NULL);
+    if (bd.status != XLSTM_OK) return bd.status;
+
+    *W = w;
+    *R = r;
+    *b = bias;
+    params->cell_clip = l->cell_clip;
+    params->W_scale = W_scale;
+    params->R_scale = R_scale;
+    params->x_quant = l->x_quant;
+    params->y_quant = l->y_quant;
+    params->c_quant = l->c_quant;
+    params->n_quant = l->n_quant;
+    params->stats = NULL;
+    return XLSTM_OK;
+}
+
+int xlstm_model_bind_mlstm_s8(
+    const XlstmModel* model, int layer,
+    const int8_t** W, const int32_t** b,
+    MlstmS8Params* params) {
+    Binder bd;
+    const XlstmModelLayer* l;
+    const int8_t* w;
+    const int32_t* bias;
+    float W_scale = 0.0f;
+    int dims[4], I, H;
+
+    if (!W || !b || !params) return XLSTM_ERR_ARG;
+    l = bind_layer(&bd, model, layer, XLSTM_KIND_MLSTM_S8, 2, dims);
+    if (!l) return bd.status;
+    I = dims[0];
+    H = dims[1];
+
+    w = (const int8_t*)bind_tensor(&bd, XLSTM_ROLE_CELL_W, XLSTM_DTYPE_S8, 4 * H + 2, I, 1, &W_scale);
+    bias = (const int32_t*)bind_tensor(&bd, XLSTM_ROLE_CELL_B, XLSTM_DTYPE_S32, 4 * H + 2, 1, 1, NULL);
+    if (bd.status != XLSTM_OK) return bd.status;
+
+    *W = w;
+    *b = bias;
+    params->cell_clip = l->cell_clip;
+    params->W_scale = W_scale;
+    params->x_quant = l->x_quant;
+    params->y_quant = l->y_quant;
+    params->C_quant = l->c_quant;
+    params->n_quant = l->n_quant;
+    params->stats = NULL;
+    return XLSTM_OK;
+}
+
+/* Block dims: embed, inner|ffn, conv_kernel, num_heads. The heads must
+ * divide the GroupNorm width gn. */
+static int block_dims_ok(const int dims[4], int gn) {
+    return gn % dims[3] == 0;
+}
+
+int xlstm_model_bind_mlstm_block(
+    const XlstmModel* model, int layer, XlstmMlstmBlock* out) {
+    Binder b;
+    const XlstmModelLayer* l;
+    XlstmMlstmBlock blk;
+    int dims[4], D, H, K;
+
+    if (!out) return XLSTM_ERR_ARG;
+    l = bind_layer(&b, model, layer, XLSTM_KIND_MLSTM_BLOCK_F32, 4, dims);
+    if (!l) return b.status;
+    if (!block_dims_ok(dims, dims[1])) return XLSTM_ERR_SHAPE;
+    D = dims[0];
+    H = dims[1];
+    K = dims[2];
+
+    blk.embed_dim = D;
+    blk.inner_dim = H;
+    blk.conv_kernel = K;
+    blk.num_heads = dims[3];
+    blk.ln_w = (const float*)bind_tensor(&b, XLSTM_ROLE_LN_W, XLSTM_DTYPE_F32, D, 1, 1, NULL);
+    blk.ln_b = (const float*)bind_tensor(&b, XLSTM_ROLE_LN_B, XLSTM_DTYPE_F32, D, 1, 0, NULL);
+    blk.up_W = (const float*)bind_tensor(&b, XLSTM_ROLE_UP_W, XLSTM_DTYPE_F32, 2 * H, D, 1, NULL);
+    blk.up_b = (const float*)bind_tensor(&b, XLSTM_ROLE_UP_B, XLSTM_DTYPE_F32, 2 * H, 1, 0, NULL);
+    blk.conv_w = (const float*)bind_tensor(&b, XLSTM_ROLE_CONV_W, XLSTM_DTYPE_F32, H, K, 1, NULL);
+    blk.conv_b = (const float*)bind_tensor(&b, XLSTM_ROLE_CONV_B, XLSTM_DTYPE_F32, H, 1, 0, NULL);
+    blk.cell_W = (const float*)bind_tensor(&b, XLSTM_ROLE_CELL_W, XLSTM_DTYPE_F32, 4 * H + 2, 2 * H, 1, NULL);
+    blk.cell_b = (const float*)bind_tensor(&b, XLSTM_ROLE_CELL_B, XLSTM_DTYPE_F32, 4 * H + 2, 1, 1, NULL);
+    blk.gn_w = (const float*)bind_tensor(&b, XLSTM_ROLE_GN_W, XLSTM_DTYPE_F32, H, 1, 1, NULL);
+    blk.skip = (const float*)bind_tensor(&b, XLSTM_ROLE_SKIP, XLSTM_DTYPE_F32, H, 1, 1, NULL);
+    blk.down_W = (const float*)bind_tensor(&b, XLSTM_ROLE_DOWN_W, XLSTM_DTYPE_F32, D, H, 1, NULL);
+    blk.down_b = (const float*)bind_tensor(&b, XLSTM_ROLE_DOWN_B, XLSTM_DTYPE_F32, D, 1, 0, NULL);
+    blk.cell_params.cell_clip = l->cell_clip;
+    blk.cell_params.flush_denormals = 0;
+    if (b.status != XLSTM_OK) return b.status;
+
+    *out = blk;
+    return XLSTM_OK;
+}
+
+int xlstm_model_bind_slstm_block(
+    const XlstmModel* model, int layer, XlstmSlstmBlock* out) {
+    Binder b;
+    const XlstmModelLayer* l;
+    XlstmSlstmBlock blk;
+    int dims[4], D, F, K;
+
+    if (!out) return XLSTM_ERR_ARG;
+    l = bind_layer(&b, model, layer, XLSTM_KIND_SLSTM_BLOCK_F32, 4, dims);
+    if (!l) return b.status;
+    if (!block_dims_ok(dims, dims[0])) return XLSTM_ERR_SHAPE;
+    D = dims[0];
+    F = dims[1];
+    K = dims[2];
+
+    blk.embed_dim = D;
+    blk.ffn_dim = F;
+    blk.conv_kernel = K;
+    blk.num_heads = dims[3];
+    blk.ln_w = (const float*)bind_tensor(&b, XLSTM_ROLE_LN_W, XLSTM_DTYPE_F32, D, 1, 1, NULL);
+    blk.ln_b = (const float*)bind_tensor(&b, XLSTM_ROLE_LN_B, XLSTM_DTYPE_F32, D, 1, 0, NULL);
+    blk.conv_w = (const float*)bind_tensor(&b, XLSTM_ROLE_CONV_W, XLSTM_DTYPE_F32, D, K, 1, NULL);
+    blk.conv_b = (const float*)bind_tensor(&b, XLSTM_ROLE_CONV_B, XLSTM_DTYPE_F32, D, 1, 0, NULL);
+    blk.cell_W = (const float*)bind_tensor(&b, XLSTM_ROLE_CELL_W, XLSTM_DTYPE_F32, 4 * D, 2 * D, 1, NULL);
+    blk.cell_R = (const float*)bind_tensor(&b, XLSTM_ROLE_CELL_R, XLSTM_DTYPE_F32, 4 * D, D, 1, NULL);
+    blk.cell_b = (const float*)bind_tensor(&b, XLSTM_ROLE_CELL_B, XLSTM_DTYPE_F32, 4 * D, 1, 1, NULL);
+    blk.gn_w = (const float*)bind_tensor(&b, XLSTM_ROLE_GN_W, XLSTM_DTYPE_F32, D, 1, 1, NULL);
+    blk.ln2_w = (const float*)bind_tensor(&b, XLSTM_ROLE_LN2_W, XLSTM_DTYPE_F32, D, 1, 1, NULL);
+    blk.ln2_b = (const float*)bind_tensor(&b, XLSTM_ROLE_LN2_B, XLSTM_DTYPE_F32, D, 1, 0, NULL);
+    blk.up_W = (const float*)bind_tensor(&b, XLSTM_ROLE_UP_W, XLSTM_DTYPE_F32, 2 * F, D, 1, NULL);
+    blk.up_b = (const float*)bind_tensor(&b, XLSTM_ROLE_UP_B, XLSTM_DTYPE_F32, 2 * F, 1, 0, NULL);
+    blk.down_W = (const float*)bind_tensor(&b, XLSTM_ROLE_DOWN_W, XLSTM_DTYPE_F32, D, F, 1, NULL);
+    blk.down_b = (const float*)bind_tensor(&b, XLSTM_ROLE_DOWN_B, XLSTM_DTYPE_F32, D, 1, 0, NULL);
+    blk.cell_params.cell_clip = l->cell_clip;
+    blk.cell_params.flush_denormals = 0;
+    if (b.status != XLSTM_OK) return b.status;
+
+    *out = blk;
+    return XLSTM_OK;
+}
+
+int xlstm_model_bind_mlstm_block_q8(
+    const XlstmModel* model, int layer, XlstmMlstmBlockQ8* out) {
+    Binder b;
+    const XlstmModelLayer* l;
+    XlstmMlstmBlockQ8 blk;
+    int dims[4], D, H, K;
+
+    if (!out) return XLSTM_ERR_ARG;
+    l = bind_layer(&b, model, layer, XLSTM_KIND_MLSTM_BLOCK_Q8, 4, dims);
+    if (!l) return b.status;
+    if (!block_dims_ok(dims, dims[1])) return XLSTM_ERR_SHAPE;
+    D = dims[0];
+    H = dims[1];
+    K = dims[2];
+
+    blk.embed_dim = D;
+    blk.inner_dim = H;
+    blk.conv_kernel = K;
+    blk.num_heads = dims[3];
+    blk.up_scale = blk.down_scale = blk.cell_params.W_scale = 0.0f;
+    blk.ln_w = (const float*)bind_tensor(&b, XLSTM_ROLE_LN_W, XLSTM_DTYPE_F32, D, 1, 1, NULL);
+    blk.ln_b = (const float*)bind_tensor(&b, XLSTM_ROLE_LN_B, XLSTM_DTYPE_F32, D, 1, 0, NULL);
+    blk.up_W = (const int8_t*)bind_tensor(&b, XLSTM_ROLE_UP_W, XLSTM_DTYPE_S8, 2 * H, D, 1, &blk.up_scale);
+    blk.up_b = (const float*)bind_tensor(&b, XLSTM_ROLE_UP_B, XLSTM_DTYPE_F32, 2 * H, 1, 0, NULL);
+    blk.conv_w = (const float*)bind_tensor(&b, XLSTM_ROLE_CONV_W, XLSTM_DTYPE_F32, H, K, 1, NULL);
+    blk.conv_b = (const float*)bind_tensor(&b, XLSTM_ROLE_CONV_B, XLSTM_DTYPE_F32, H, 1, 0, NULL);
+    blk.cell_W = (const int8_t*)bind_tensor(&b, XLSTM_ROLE_CELL_W, XLSTM_DTYPE_S8, 4 * H + 2, 2 * H, 1,
+                                            &blk.cell_params.W_scale);
+    blk.cell_b = (const int32_t*)bind_tensor(&b, XLSTM_ROLE_CELL_B, XLSTM_DTYPE_S32, 4 * H + 2, 1, 1, NULL);
+    blk.gn_w = (const float*)bind_tensor(&b, XLSTM_ROLE_GN_W, XLSTM_DTYPE_F32, H, 1, 1, NULL);
+    blk.skip = (const float*)bind_tensor(&b, XLSTM_ROLE_SKIP, XLSTM_DTYPE_F32, H, 1, 1, NULL);
+    blk.down_W = (const int8_t*)bind_tensor(&b, XLSTM_ROLE_DOWN_W, XLSTM_DTYPE_S8, D, H, 1, &blk.down_scale);
+    blk.down_b = (const float*)bind_tensor(&b, XLSTM_ROLE_DOWN_B, XLSTM_DTYPE_F32, D, 1, 0, NULL);
+    if (b.status != XLSTM_OK) return b.status;
+
+    blk.cell_params.cell_clip = l->cell_clip;
+    blk.cell_params.x_quant = l->x_quant;
+    blk.cell_params.y_quant = l->y_quant;
+    blk.cell_params.C_quant = l->c_quant;
+    blk.cell_params.n_quant = l->n_quant;
+    blk.cell_params.stats = NULL;
+    *out = blk;
+    return XLSTM_OK;
+}
+
+int xlstm_model_bind_slstm_block_q8(
+    const XlstmModel* model, int layer, XlstmSlstmBlockQ8* out) {
+    Binder b;
+    const XlstmModelLayer* l;
+    XlstmSlstmBlockQ8 blk;
+    int dims[4], D, F, K;
+
+    if (!out) return XLSTM_ERR_ARG;
+    l = bind_layer(&b, model, layer, XLSTM_KIND_SLSTM_BLOCK_Q8, 4, dims);
+    if (!l) return b.status;
+    if (!block_dims_ok(dims, dims[0])) return XLSTM_ERR_SHAPE;
+    D = dims[0];
+    F = dims[1];
+    K = dims[2];
+
+    blk.embed_dim = D;
+    blk.ffn_dim = F;
+    blk.conv_kernel = K;
+    blk.num_heads = dims[3];
+    blk.up_scale = blk.down_scale = 0.0f;
+    blk.cell_params.W_scale = blk.cell_params.R_scale = 0.0f;
+    blk.ln_w = (const float*)bind_tensor(&b, XLSTM_ROLE_LN_W, XLSTM_DTYPE_F32, D, 1, 1, NULL);
+    blk.ln_b = (const float*)bind_tensor(&b, XLSTM_ROLE_LN_B, XLSTM_DTYPE_F32, D, 1, 0, NULL);
+    blk.conv_w = (const float*)bind_tensor(&b, XLSTM_ROLE_CONV_W, XLSTM_DTYPE_F32, D, K, 1, NULL);
+    blk.conv_b = (const float*)bind_tensor(&b, XLSTM_ROLE_CONV_B, XLSTM_DTYPE_F32, D, 1, 0, NULL);
+    blk.cell_W = (const int8_t*)bind_tensor(&b, XLSTM_ROLE_CELL_W, XLSTM_DTYPE_S8, 4 * D, 2 * D, 1,
+                                            &blk.cell_params.W_scale);
+    blk.cell_R = (const int8_t*)bind_tensor(&b, XLSTM_ROLE_CELL_R, XLSTM_DTYPE_S8, 4 * D, D, 1,
+                                            &blk.cell_params.R_scale);
+    blk.cell_b = (const int32_t*)bind_tensor(&b, XLSTM_ROLE_CELL_B, XLSTM_DTYPE_S32, 4 * D, 1, 1, NULL);
+    blk.gn_w = (const float*)bind_tensor(&b, XLSTM_ROLE_GN_W, XLSTM_DTYPE_F32, D, 1, 1, NULL);
+    blk.ln2_w = (const float*)bind_tensor(&b, XLSTM_ROLE_LN2_W, XLSTM_DTYPE_F32, D, 1, 1, NULL);
+    blk.ln2_b = (const float*)bind_tensor(&b, XLSTM_ROLE_LN2_B, XLSTM_DTYPE_F32, D, 1, 0, NULL);
+    blk.up_W = (const int8_t*)bind_tensor(&b, XLSTM_ROLE_UP_W, XLSTM_DTYPE_S8, 2 * F, D, 1, &blk.up_scale);
+    blk.up_b = (const float*)bind_tensor(&b, XLSTM_ROLE_UP_B, XLSTM_DTYPE_F32, 2 * F, 1, 0, NULL);
+    blk.down_W = (const int8_t*)bind_tensor(&b, XLSTM_ROLE_DOWN_W, XLSTM_DTYPE_S8, D, F, 1, &blk.down_scale);
+    blk.down_b = (const float*)bind_tensor(&b, XLSTM_ROLE_DOWN_B, XLSTM_DTYPE_F32, D, 1, 0, NULL);
+    if (b.status != XLSTM_OK) return b.status;
+
+    blk.cell_params.cell_clip = l->cell_clip;
+    blk.cell_params.x_quant = l->x_quant;
+    blk.cell_params.y_quant = l->y_quant;
+    blk.cell_params.c_quant = l->c_quant;
+    blk.cell_params.n_quant = l->n_quant;
+    blk.cell_params.stats = NULL;
+    *out = blk;
+    return XLSTM_OK;
+}
+
+/* ========================================================================== */
+/* Write                                                                      */
+/* ========================================================================== */
+
+size_t xlstm_model_write(
+    const XlstmModelLayerDesc* layers, int num_layers,
+    void* out, size_t out_size) {
+    uint8_t* base = (uint8_t*)out;
+    XlstmModelHeader hdr;
+    uint64_t layer_offset, tensor_offset, pos;
+    uint32_t num_tensors = 0, t_index = 0;
+    int l, i;
+
+    if (!layers || num_layers <= 0) return 0;
+    for (l = 0; l < num_layers; ++l) {
+        const XlstmModelLayerDesc* ld = &layers[l];
+        if (!known_kind(ld->layer.kind) || ld->num_tensors < 0) return 0;
+        if (ld->num_tensors > 0 && !ld->tensors) return 0;
+        for (i = 0; i < ld->num_tensors; ++i) {
+            const XlstmModelTensorDesc* td = &ld->tensors[i];
+            if (!td->data || td->rows <= 0 || td->cols <= 0 ||
+                dtype_size((uint32_t)td->dtype) == 0) {
+                return 0;
+            }
+        }
+        num_tensors += (uint32_t)ld->num_tensors;
+    }
+
+    /* Layout: header, layer table, tensor table, aligned tensor data */
+    layer_offset = sizeof(XlstmModelHeader);
+    tensor_offset = layer_offset + (uint64_t)num_layers * sizeof(XlstmModelLayer);
+    pos = tensor_offset + (uint64_t)num_tensors * sizeof(XlstmModelTensor);
+    for (l = 0; l < num_layers; ++l) {
+        for (i = 0; i < layers[l].num_tensors; ++i) {
+            const XlstmModelTensorDesc* td = &layers[l].tensors[i];
+            pos = align_up(pos) + (uint64_t)td->rows * (uint64_t)td->cols *
+                                  dtype_size((uint32_t)td->dtype);
+        }
+    }
+    pos = align_up(pos);
+    if ((uint64_t)(size_t)pos != pos) return 0;
+    if (!out || out_size < (size_t)pos) return (size_t)pos;
+
+    /* Zero everything first so padding bytes are deterministic */
+    {
+        size_t k;
+        for (k = 0; k < (size_t)pos; ++k) base[k] = 0;
+    }
+    for (i = 0; i < (int)sizeof(hdr); ++i) ((unsigned char*)&hdr)[i] = 0;
+    hdr.magic = XLSTM_MODEL_MAGIC;
+    hdr.version = XLSTM_MODEL_VERSION;
+    hdr.num_layers = (uint32_t)num_layers;
+    hdr.num_tensors = num_tensors;
+    hdr.total_size = pos;
+    hdr.layer_offset = layer_offset;
+    hdr.tensor_offset = tensor_offset;
+    memcpy(base, &hdr, sizeof(hdr));
+
+    pos = tensor_offset + (uint64_t)num_tensors * sizeof(XlstmModelTensor);
+    for (l = 0; l < num_layers; ++l) {
+        const XlstmModelLayerDesc* ld = &layers[l];
+        XlstmModelLayer rec = ld->layer;
+        rec.first_tensor = t_index;
+        rec.num_tensors = (uint32_t)ld->num_tensors;
+        memcpy(base + layer_offset + (uint64_t)l * sizeof(rec), &rec, sizeof(rec));
+
+        for (i = 0; i < ld->num_tensors; ++i, ++t_index) {
+            const XlstmModelTensorDesc* td = &ld->tensors[i];
+            XlstmModelTensor t;
+            int k;
+            for (k = 0; k < (int)sizeof(t); ++k) ((unsigned char*)&t)[k] = 0;
+            t.role = (uint8_t)td->role;
+            t.dtype = (uint8_t)td->dtype;
+            t.rows = (uint32_t)td->rows;
+            t.cols = (uint32_t)td->cols;
+            t.nbytes = (uint64_t)t.rows * t.cols * dtype_size(t.dtype);
+            t.offset = align_up(pos);
+            t.quant = td->quant;
+            pos = t.offset + t.nbytes;
+            memcpy(base + tensor_offset + (uint64_t)t_index * sizeof(t), &t, sizeof(t));
+            memcpy(base + t.offset, td->data, (size_t)t.nbytes);
+        }
+    }
+    return (size_t)hdr.total_size;
+}
@@ -0,0 +1,66 @@
+/* Copyright 2026 RAWS labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * =========================================================================
+ * Model file mapping — POSIX mmap. Kept out of xlstm_model.c so targets
+ * without a filesystem only compile the parser and embed the file image.
+ * ===========================================================================*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "xlstm_model.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+int xlstm_model_map(const char* path, XlstmModelMapping* mapping,
+                    XlstmModel* model) {
+    struct stat st;
+    void* addr;
+    int fd, status;
+
+    if (!path || !mapping || !model) return XLSTM_ERR_ARG;
+    mapping->addr = NULL;
+    mapping->size = 0;
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) return XLSTM_ERR_ARG;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return XLSTM_ERR_ARG;
+    }
+
+    /* Shared read-only mapping: pages come from the page cache on first
+     * touch and are shared by every process mapping the same file. */
+    addr = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) return XLSTM_ERR_ARG;
+
+    status = xlstm_model_open(model, addr, (size_t)st.st_size);
+    if (status != XLSTM_OK) {
+        munmap(addr, (size_t)st.st_size);
+        return status;
+    }
+    mapping->addr = addr;
+    mapping->size = (size_t)st.st_size;
+    return XLSTM_OK;
+}
+
+void xlstm_model_unmap(XlstmModelMapping* mapping) {
+    if (!mapping || !mapping->addr) return;
+    munmap(mapping->addr, mapping->size);
+    mapping->addr = NULL;
+    mapping->size = 0;
+}
@@ -0,0 +1,267 @@
+/* Copyright 2026 RAWS labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * =========================================================================
+ * Buffer size queries and static arena planning — C99.
+ * ===========================================================================*/
+
+#include "xlstm_plan.h"
+
+#include <stdint.h>
+
+static void clear_sizes(XlstmBufferSizes* out) {
+    int s;
+    for (s = 0; s < XLSTM_BUF_STATES; ++s) out->state[s] = 0;
+    out->scratch = 0;
+}
+
+/* ========================================================================== */
+/* Size queries                                                               */
+/* ========================================================================== */
+
+int xlstm_cell_sizes(XlstmKind kind, int batch_size, int hidden_size,
+                     XlstmBufferSizes* out) {
+    size_t B = (size_t)batch_size;
+    size_t H = (size_t)hidden_size;
+
+    if (!out || batch_size <= 0 || hidden_size <= 0) return XLSTM_ERR_ARG;
+    clear_sizes(out);
+
+    switch (kind) {
+        case XLSTM_KIND_SLSTM_F32:
+            out->state[XLSTM_BUF_Y] = B * H * sizeof(float);
+            out->state[XLSTM_BUF_C] = B * H * sizeof(float);
+            out->state[XLSTM_BUF_N] = B * H * sizeof(float);
+            out->state[XLSTM_BUF_M] = B * H * sizeof(float);
+            out->scratch = 4 * H * sizeof(float);
+            return XLSTM_OK;
+        case XLSTM_KIND_MLSTM_F32:
+            out->state[XLSTM_BUF_Y] = B * H * sizeof(float);
+            out->state[XLSTM_BUF_C] = B * H * H * sizeof(float);
+            out->state[XLSTM_BUF_N] = B * H * sizeof(float);
+            out->state[XLSTM_BUF_M] = B * sizeof(float);
+            out->scratch = (4 * H + 2) * sizeof(float);
+            return XLSTM_OK;
+        case XLSTM_KIND_SLSTM_S8:
+            out->state[XLSTM_BUF_Y] = B * H * sizeof(int8_t);
+            out->state[XLSTM_BUF_C] = B * H * sizeof(int16_t);
+            out->state[XLSTM_BUF_N] = B * H * sizeof(int16_t);
+            out->state[XLSTM_BUF_M] = B * H * sizeof(float);
+            out->scratch = 4 * H * sizeof(int32_t);
+            return XLSTM_OK;
+        case XLSTM_KIND_MLSTM_S8:
+            out->state[XLSTM_BUF_Y] = B * H * sizeof(int8_t);
+            out->state[XLSTM_BUF_C] = B * H * H * sizeof(int16_t);
+            out->state[XLSTM_BUF_N] = B * H * sizeof(int16_t);
+            out->state[XLSTM_BUF_M] = B * sizeof(float);
+            out->scratch = (4 * H + 2) * sizeof(int32_t);
+            return XLSTM_OK;
+        default:
+            break;
+    }
+    return XLSTM_ERR_FORMAT;
+}
+
+/* Conv history [B, K-1, channels] floats */
+static size_t conv_bytes(int B, int K, int channels) {
+    return (size_t)B * (size_t)(K - 1) * (size_t)channels * sizeof(float);
+}
+
+void xlstm_mlstm_block_sizes(const XlstmMlstmBlock* blk, int batch_size,
+                             XlstmBufferSizes* out) {
+    xlstm_cell_sizes(XLSTM_KIND_MLSTM_F32, batch_size, blk->inner_dim, out);
+    out->state[XLSTM_BUF_CONV] =
+        conv_bytes(batch_size, blk->conv_kernel, blk->inner_dim);
+    out->scratch = mlstm_block_scratch_size(blk) * sizeof(float);
+}
+
+void xlstm_slstm_block_sizes(const XlstmSlstmBlock* blk, int batch_size,
+                             XlstmBufferSizes* out) {
+    xlstm_cell_sizes(XLSTM_KIND_SLSTM_F32, batch_size, blk->embed_dim, out);
+    out->state[XLSTM_BUF_CONV] =
+        conv_bytes(batch_size, blk->conv_kernel, blk->embed_dim);
+    out->scratch = slstm_block_scratch_size(blk) * sizeof(float);
+}
+
+void xlstm_mlstm_block_q8_sizes(const XlstmMlstmBlockQ8* blk, int batch_size,
+                                XlstmBufferSizes* out) {
+    xlstm_cell_sizes(XLSTM_KIND_MLSTM_S8, batch_size, blk->inner_dim, out);
+    out->state[XLSTM_BUF_CONV] =
+        conv_bytes(batch_size, blk->conv_kernel, blk->inner_dim);
+    out->scratch = mlstm_block_q8_workspace_size(blk);
+}
+
+void xlstm_slstm_block_q8_sizes(const XlstmSlstmBlockQ8* blk, int batch_size,
+                                XlstmBufferSizes* out) {
+    xlstm_cell_sizes(XLSTM_KIND_SLSTM_S8, batch_size, blk->embed_dim, out);
+    out->state[XLSTM_BUF_CONV] =
+        conv_bytes(batch_size, blk->conv_kernel, blk->embed_dim);
+    out->scratch = slstm_block_q8_workspace_size(blk);
+}
+
+/* ========================================================================== */
+/* Planner                                                                    */
+/* ========================================================================== */
+
+static int lifetimes_overlap(const XlstmPlanBuffer* a, const XlstmPlanBuffer* b) {
+    return a->first_use <= b->last_use && b->first_use <= a->last_use;
+}
+
+size_t xlstm_plan(XlstmPlanBuffer* buffers, int num_buffers,
+                  size_t alignment, int* order) {
+    size_t arena = 0;
+    int i, j, k;
+
+    if (!buffers || !order || num_buffers <= 0) return 0;
+    if (alignment == 0) alignment = XLSTM_PLAN_ALIGN;
+    if ((alignment & (alignment - 1)) != 0) return 0;
+    for (i = 0; i < num_buffers; ++i) {
+        if (buffers[i].first_use > buffers[i].last_use) return 0;
+    }
+
+    /* Largest first (insertion sort, stable on ties) */
+    for (i = 0; i < num_buffers; ++i) {
+        int cur = i;
+        for (j = i; j > 0 && buffers[order[j - 1]].size < buffers[cur].size; --j) {
+            order[j] = order[j - 1];
+        }
+        order[j] = cur;
+    }
+
+    for (i = 0; i < num_buffers; ++i) {
+        XlstmPlanBuffer* buf = &buffers[order[i]];
+        size_t offset = 0;
+        int moved = 1;
+
+        buf->offset = 0;
+        if (buf->size == 0) continue;
+
+        /* Bump offset past every conflicting placed buffer until none
+         * overlaps; each pass either settles or moves strictly upward. */
+        while (moved) {
+            moved = 0;
+            for (k = 0; k < i; ++k) {
+                const XlstmPlanBuffer* other = &buffers[order[k]];
+                if (other->size == 0 || !lifetimes_overlap(buf, other)) continue;
+                if (offset < other->offset + other->size &&
+                    other->offset < offset + buf->size) {
+                    offset = (other->offset + other->size + alignment - 1) &
+                             ~(alignment - 1);
+                    moved = 1;
+                }
+            }
+        }
+        buf->offset = offset;
+        if (offset + buf->size > arena) arena = offset + buf->size;
+    }
+    return (arena + alignment - 1) & ~(alignment - 1);
+}
+
+/* ========================================================================== */
+/* Model planning                                                             */
+/* ========================================================================== */
+
+/* States, scratch and output bytes of layer l. */
+static int layer_sizes(const XlstmModel* model, int l, int B, int T,
+                       XlstmBufferSizes* sizes, size_t* output) {
+    const XlstmModelLayer* layer = &model->layers[l];
+    size_t BT = (size_t)B * (size_t)T;
+    int status;
+
+    switch ((XlstmKind)layer->kind) {
+        case XLSTM_KIND_SLSTM_F32:
+        case XLSTM_KIND_MLSTM_F32:
+        case XLSTM_KIND_SLSTM_S8:
+        case XLSTM_KIND_MLSTM_S8: {
+            int H = (int)layer->dims[1];
+            int s8 = layer->kind == XLSTM_KIND_SLSTM_S8 ||
+                     layer->kind == XLSTM_KIND_MLSTM_S8;
+            status = xlstm_cell_sizes((XlstmKind)layer->kind, B, H, sizes);
+            *output = BT * (size_t)H * (s8 ? sizeof(int8_t) : sizeof(float));
+            return status;
+        }
+        case XLSTM_KIND_MLSTM_BLOCK_F32: {
+            XlstmMlstmBlock blk;
+            status = xlstm_model_bind_mlstm_block(model, l, &blk);
+            if (status != XLSTM_OK) return status;
+            xlstm_mlstm_block_sizes(&blk, B, sizes);
+            *output = BT * (size_t)blk.embed_dim * sizeof(float);
+            return XLSTM_OK;
+        }
+        case XLSTM_KIND_SLSTM_BLOCK_F32: {
+            XlstmSlstmBlock blk;
+            status = xlstm_model_bind_slstm_block(model, l, &blk);
+            if (status != XLSTM_OK) return status;
+            xlstm_slstm_block_sizes(&blk, B, sizes);
+            *output = BT * (size_t)blk.embed_dim * sizeof(float);
+            return XLSTM_OK;
+        }
+        case XLSTM_KIND_MLSTM_BLOCK_Q8: {
+            XlstmMlstmBlockQ8 blk;
+            status = xlstm_model_bind_mlstm_block_q8(model, l, &blk);
+            if (status != XLSTM_OK) return status;
+            xlstm_mlstm_block_q8_sizes(&blk, B, sizes);
+            *output = BT * (size_t)blk.embed_dim * sizeof(float);
+            return XLSTM_OK;
+        }
+        case XLSTM_KIND_SLSTM_BLOCK_Q8: {
+            XlstmSlstmBlockQ8 blk;
+            status = xlstm_model_bind_slstm_block_q8(model, l, &blk);
+            if (status != XLSTM_OK) return status;
+            xlstm_slstm_block_q8_sizes(&blk, B, sizes);
+            *output = BT * (size_t)blk.embed_dim * sizeof(float);
+            return XLSTM_OK;
+        }
+    }
+    return XLSTM_ERR_FORMAT;
+}
+
+int xlstm_plan_model(const XlstmModel* model, int batch_size, int time_steps,
+                     XlstmPlanBuffer* buffers, int max_buffers, int* order,
+                     size_t* arena_size) {
+    int L, l, s, status;
+
+    if (!model || !buffers || !order || !arena_size ||
+        batch_size <= 0 || time_steps <= 0) {
+        return XLSTM_ERR_ARG;
+    }
+    L = model->num_layers;
+    if (L <= 0) return XLSTM_ERR_ARG;
+    if (max_buffers < L * XLSTM_PLAN_BUFS_PER_LAYER) return XLSTM_ERR_SIZE;
+
+    for (l = 0; l < L; ++l) {
+        XlstmPlanBuffer* buf = buffers + l * XLSTM_PLAN_BUFS_PER_LAYER;
+        XlstmBufferSizes sizes;
+        size_t output;
+
+        status = layer_sizes(model, l, batch_size, time_steps, &sizes, &output);
+        if (status != XLSTM_OK) return status;
+
+        for (s = 0; s < XLSTM_BUF_STATES; ++s) {
+            buf[s].size = sizes.state[s];
+            buf[s].first_use = 0;
+            buf[s].last_use = L - 1;
+        }
+        buf[XLSTM_PLAN_SCRATCH].size = sizes.scratch;
+        buf[XLSTM_PLAN_SCRATCH].first_use = l;
+        buf[XLSTM_PLAN_SCRATCH].last_use = l;
+        /* Written by layer l, read by layer l + 1 (or the caller) */
+        buf[XLSTM_PLAN_OUTPUT].size = output;
+        buf[XLSTM_PLAN_OUTPUT].first_use = l;
+        buf[XLSTM_PLAN_OUTPUT].last_use = l + 1;
+    }
+
+    *arena_size = xlstm_plan(buffers, L * XLSTM_PLAN_BUFS_PER_LAYER,
+                             XLSTM_PLAN_ALIGN, order);
+    return XLSTM_OK;
+}
@@ -0,0 +1,199 @@
+/* Copyright 2026 RAWS labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * =========================================================================
+ * Prefix state cache — pure C99, no allocation.
+ * ===========================================================================*/
+
+#include "xlstm_prefix_cache.h"
+
+#define FNV_PRIME 0x100000001b3ull
+
+int xlstm_prefix_cache_init(
+    XlstmPrefixCache* cache,
+    XlstmPrefixEntry* entries,
+    int capacity,
+    void* pool,
+    size_t pool_size,
+    size_t slot_size,
+    int chunk_steps,
+    size_t step_bytes)
+{
+    if (!cache || !entries || !pool || capacity <= 0 || chunk_steps <= 0 ||
+        step_bytes == 0 || slot_size == 0 || (slot_size & 15u) != 0 ||
+        ((uintptr_t)pool & 15u) != 0) {
+        return XLSTM_ERR_ARG;
+    }
+    if (pool_size / slot_size < (size_t)capacity) return XLSTM_ERR_SIZE;
+
+    cache->entries = entries;
+    cache->pool = (unsigned char*)pool;
+    cache->capacity = capacity;
+    cache->slot_size = slot_size;
+    cache->chunk_steps = chunk_steps;
+    cache->step_bytes = step_bytes;
+    xlstm_prefix_cache_clear(cache);
+    return XLSTM_OK;
+}
+
+void xlstm_prefix_cache_clear(XlstmPrefixCache* cache) {
+    int e;
+
+    for (e = 0; e < cache->capacity; ++e) {
+        cache->entries[e].key = 0;
+        cache->entries[e].prefix_len = 0;
+        cache->entries[e].last_used = 0;
+        cache->entries[e].ready = 0;
+    }
+    cache->clock = 0;
+}
+
+uint64_t xlstm_prefix_hash(uint64_t h, const void* data, size_t len) {
+    const unsigned char* p = (const unsigned char*)data;
+    size_t i;
+
+    for (i = 0; i < len; ++i) {
+        h ^= p[i];
+        h *= FNV_PRIME;
+    }
+    return h;
+}
+
+/* ========================================================================== */
+/* Internals                                                                  */
+/* ========================================================================== */
+
+static void touch(XlstmPrefixCache* cache, XlstmPrefixEntry* entry) {
+    int e;
+
+    /* On wrap-around, forget the recency history rather than invert it */
+    if (cache->clock == 0xffffffffu) {
+        for (e = 0; e < cache->capacity; ++e) {
+            if (cache->entries[e].prefix_len > 0) cache->entries[e].last_used = 1;
+        }
+        cache->clock = 1;
+    }
+    entry->last_used = ++cache->clock;
+}
+
+/* ready_only: skip entries reserved but not yet committed */
+static int find(const XlstmPrefixCache* cache, uint64_t key, int prefix_len,
+                int ready_only) {
+    int e;
+
+    for (e = 0; e < cache->capacity; ++e) {
+        const XlstmPrefixEntry* entry = &cache->entries[e];
+        if (entry->prefix_len == (uint32_t)prefix_len && entry->key == key &&
+            (entry->ready || !ready_only)) {
+            return e;
+        }
+    }
+    return -1;
+}
+
+/* ========================================================================== */
+/* Lookup / insert                                                            */
+/* ========================================================================== */
+
+int xlstm_prefix_cache_lookup(
+    XlstmPrefixCache* cache,
+    const void* input,
+    int time_steps,
+    const void** blob)
+{
+    const unsigned char* x = (const unsigned char*)input;
+    size_t chunk_bytes = (size_t)cache->chunk_steps * cache->step_bytes;
+    uint64_t h = XLSTM_PREFIX_HASH_INIT;
+    int best = -1, best_len = 0;
+    int len;
+
+    /* Hash incrementally and remember the longest boundary that hits */
+    for (len = cache->chunk_steps; len <= time_steps; len += cache->chunk_steps) {
+        int e;
+        h = xlstm_prefix_hash(h, x, chunk_bytes);
+        x += chunk_bytes;
+        e = find(cache, h, len, 1);
+        if (e >= 0) {
+            best = e;
+            best_len = len;
+        }
+    }
+
+    if (best < 0) {
+        if (blob) *blob = NULL;
+        return 0;
+    }
+    touch(cache, &cache->entries[best]);
+    if (blob) *blob = cache->pool + (size_t)best * cache->slot_size;
+    return best_len;
+}
+
+void* xlstm_prefix_cache_reserve(
+    XlstmPrefixCache* cache,
+    const void* input,
+    int prefix_len)
+{
+    uint64_t h;
+    int e, victim;
+
+    if (prefix_len <= 0 || prefix_len % cache->chunk_steps != 0) return NULL;
+
+    h = xlstm_prefix_hash(XLSTM_PREFIX_HASH_INIT, input,
+                          (size_t)prefix_len * cache->step_bytes);
+
+    victim = find(cache, h, prefix_len, 0);
+    if (victim < 0) {
+        /* Empty entries have last_used == 0, so they go first */
+        victim = 0;
+        for (e = 1; e < cache->capacity; ++e) {
+            if (cache->entries[e].last_used < cache->entries[victim].last_used) {
+                victim = e;
+            }
+        }
+        cache->entries[victim].key = h;
+        cache->entries[victim].prefix_len = (uint32_t)prefix_len;
+    }
+    /* The caller is about to overwrite the blob: hide it until commit */
+    cache->entries[victim].ready = 0;
+    touch(cache, &cache->entries[victim]);
+    return cache->pool + (size_t)victim * cache->slot_size;
+}
+
+int xlstm_prefix_cache_commit(
+    XlstmPrefixCache* cache,
+    const void* blob,
+    int status)
+{
+    uintptr_t base = (uintptr_t)cache->pool;
+    XlstmPrefixEntry* entry;
+    size_t offset;
+
+    if (!blob || (uintptr_t)blob < base) return XLSTM_ERR_ARG;
+    offset = (size_t)((uintptr_t)blob - base);
+    if (offset % cache->slot_size != 0 ||
+        offset / cache->slot_size >= (size_t)cache->capacity) {
+        return XLSTM_ERR_ARG;
+    }
+
+    entry = &cache->entries[offset / cache->slot_size];
+    if (entry->prefix_len == 0) return XLSTM_ERR_ARG;
+    if (status == XLSTM_OK) {
+        entry->ready = 1;
+    } else {
+        entry->key = 0;
+        entry->prefix_len = 0;
+        entry->last_used = 0;
+        entry->ready = 0;
+    }
+    return XLSTM_OK;
+}
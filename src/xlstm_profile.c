@@ -0,0 +1,122 @@
+/* Copyright 2026 RAWS labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * =========================================================================
+ * Per-phase kernel instrumentation — counters, callback, cycle source.
+ * ===========================================================================*/
+
+#include "xlstm_profile.h"
+
+#include <stddef.h>
+
+#if defined(XLSTM_PROFILE_CYCLES)
+uint64_t XLSTM_PROFILE_CYCLES(void);
+#elif !defined(__x86_64__) && !defined(__i386__) && !defined(__aarch64__) && \
+      !defined(__ARM_ARCH_7M__) && !defined(__ARM_ARCH_7EM__) && \
+      !defined(__ARM_ARCH_8M_MAIN__) && !defined(__ARM_ARCH_8_1M_MAIN__)
+#include <time.h>
+#endif
+
+/* Indexed by XlstmKind; only the four cell kinds are used */
+#define NUM_KINDS (XLSTM_KIND_MLSTM_S8 + 1)
+
+static XlstmProfileCounters g_total[NUM_KINDS];
+static uint64_t g_call[NUM_KINDS][XLSTM_PHASE_COUNT];
+static XlstmProfileCallback g_callback = NULL;
+static void* g_user = NULL;
+
+static int cell_kind(XlstmKind kind) {
+    return kind >= XLSTM_KIND_SLSTM_F32 && kind <= XLSTM_KIND_MLSTM_S8;
+}
+
+uint64_t xlstm_profile_cycles(void) {
+#if defined(XLSTM_PROFILE_CYCLES)
+    return XLSTM_PROFILE_CYCLES();
+#elif defined(__x86_64__) || defined(__i386__)
+    uint32_t lo, hi;
+    __asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+    return ((uint64_t)hi << 32) | lo;
+#elif defined(__aarch64__)
+    uint64_t v;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(v));
+    return v;
+#elif defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || \
+      defined(__ARM_ARCH_8M_MAIN__) || defined(__ARM_ARCH_8_1M_MAIN__)
+    return *(volatile uint32_t*)0xE0001004u;   /* DWT->CYCCNT */
+#else
+    return (uint64_t)clock();
+#endif
+}
+
+void xlstm_profile_phase(XlstmKind kind, XlstmPhase phase, uint64_t* t) {
+    uint64_t now = xlstm_profile_cycles();
+
+    if (cell_kind(kind) && (int)phase >= 0 && (int)phase < XLSTM_PHASE_COUNT) {
+        g_call[kind][phase] += now - *t;
+    }
+    *t = now;
+}
+
+void xlstm_profile_end(XlstmKind kind) {
+    int p;
+
+    if (!cell_kind(kind)) return;
+    g_total[kind].calls++;
+    for (p = 0; p < XLSTM_PHASE_COUNT; ++p) {
+        g_total[kind].cycles[p] += g_call[kind][p];
+    }
+    if (g_callback) g_callback(kind, g_call[kind], g_user);
+    for (p = 0; p < XLSTM_PHASE_COUNT; ++p) {
+        g_call[kind][p] = 0;
+    }
+}
+
+void xlstm_profile_set_callback(XlstmProfileCallback callback, void* user) {
+    g_callback = callback;
+    g_user = user;
+}
+
+void xlstm_profile_get(XlstmKind kind, XlstmProfileCounters* out) {
+    int p;
+
+    if (!out) return;
+    if (!cell_kind(kind)) {
+        out->calls = 0;
+        for (p = 0; p < XLSTM_PHASE_COUNT; ++p) out->cycles[p] = 0;
+        return;
+    }
+    *out = g_total[kind];
+}
+
+void xlstm_profile_reset(void) {
+    int k, p;
+
+    for (k = 0; k < NUM_KINDS; ++k) {
+        g_total[k].calls = 0;
+        for (p = 0; p < XLSTM_PHASE_COUNT; ++p) {
+            g_total[k].cycles[p] = 0;
+            g_call[k][p] = 0;
+        }
+    }
+}
+
+const char* xlstm_profile_phase_name(XlstmPhase phase) {
+    switch (phase) {
+        case XLSTM_PHASE_PROJECTION: return "projection";
+        case XLSTM_PHASE_GATES: return "gates";
+        case XLSTM_PHASE_STATE: return "state";
+        case XLSTM_PHASE_READOUT: return "readout";
+        default: break;
+    }
+    return "unknown";
+}
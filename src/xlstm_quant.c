@@ -19,6 +19,23 @@
 
 #include <math.h>
 
+static void stats_clear(XlstmQuantStats* s) {
+    s->count = 0;
+    s->saturated = 0;
+    s->max_abs = 0.0f;
+}
+
+void xlstm_q8_stats_reset(XlstmQ8Stats* stats) {
+    stats_clear(&stats->y);
+    stats_clear(&stats->c);
+    stats_clear(&stats->n);
+}
+
+float xlstm_quant_stats_scale(const XlstmQuantStats* stats, int qmax) {
+    if (stats->count == 0 || qmax <= 0) return 0.0f;
+    return stats->max_abs / (float)qmax;
+}
+
 void xlstm_quant_symmetric(const float* data, int len, XlstmQuantParam* out) {
     int i;
     float max_abs = 0.0f;
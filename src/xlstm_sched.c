@@ -0,0 +1,284 @@
+/* Copyright 2026 RAWS labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * =========================================================================
+ * Continuous-batching scheduler — pure C99, no allocation.
+ * ===========================================================================*/
+
+#include "xlstm_sched.h"
+
+/* ========================================================================== */
+/* Slot bookkeeping                                                           */
+/* ========================================================================== */
+
+void xlstm_sched_init(
+    XlstmScheduler* sched,
+    int capacity,
+    int32_t* stream_ids,
+    int* active,
+    uint8_t* fresh)
+{
+    int i;
+
+    sched->capacity = capacity;
+    sched->num_active = 0;
+    sched->stream_ids = stream_ids;
+    sched->active = active;
+    sched->fresh = fresh;
+
+    for (i = 0; i < capacity; ++i) {
+        stream_ids[i] = -1;
+        active[i] = -1;
+        fresh[i] = 0;
+    }
+}
+
+int xlstm_sched_slot(const XlstmScheduler* sched, int32_t stream_id) {
+    int i;
+
+    if (stream_id < 0) return -1;
+    for (i = 0; i < sched->capacity; ++i) {
+        if (sched->stream_ids[i] == stream_id) return i;
+    }
+    return -1;
+}
+
+int xlstm_sched_admit(XlstmScheduler* sched, int32_t stream_id, int init_state) {
+    int slot;
+
+    if (stream_id < 0 || xlstm_sched_slot(sched, stream_id) >= 0) return -1;
+
+    for (slot = 0; slot < sched->capacity; ++slot) {
+        if (sched->stream_ids[slot] < 0) break;
+    }
+    if (slot == sched->capacity) return -1;
+
+    sched->stream_ids[slot] = stream_id;
+    sched->active[sched->num_active] = slot;
+    sched->fresh[sched->num_active] = (uint8_t)(init_state != 0);
+    sched->num_active++;
+    return slot;
+}
+
+int xlstm_sched_retire(XlstmScheduler* sched, int32_t stream_id) {
+    int slot = xlstm_sched_slot(sched, stream_id);
+    int k, pos = -1;
+
+    if (slot < 0) return -1;
+
+    for (k = 0; k < sched->num_active; ++k) {
+        if (sched->active[k] == slot) {
+            pos = k;
+            break;
+        }
+    }
+
+    /* Shift the tail down so the remaining streams keep their order */
+    for (k = pos; k + 1 < sched->num_active; ++k) {
+        sched->active[k] = sched->active[k + 1];
+        sched->fresh[k] = sched->fresh[k + 1];
+    }
+    sched->num_active--;
+    sched->stream_ids[slot] = -1;
+    return slot;
+}
+
+/* ========================================================================== */
+/* Ticks                                                                      */
+/* ========================================================================== */
+
+void xlstm_sched_tick_slstm_f32(
+    XlstmScheduler* sched,
+    const float* x,
+    const float* W,
+    const float* R,
+    const float* b,
+    float* y,
+    float* c,
+    float* n,
+    float* m,
+    float* output,
+    float* scratch,
+    int input_size,
+    int hidden_size,
+    const SlstmParams* params)
+{
+    int H = hidden_size;
+    int k, i;
+
+    /* Zero the state of newly admitted streams */
+    for (k = 0; k < sched->num_active; ++k) {
+        if (sched->fresh[k]) {
+            int s = sched->active[k];
+            for (i = 0; i < H; ++i) {
+                y[s * H + i] = 0.0f;
+                c[s * H + i] = 0.0f;
+                n[s * H + i] = 0.0f;
+                m[s * H + i] = 0.0f;
+            }
+            sched->fresh[k] = 0;
+        }
+    }
+
+    slstm_step_batch_f32(
+        x, sched->active, sched->num_active,
+        W, R, b, y, c, n, m, scratch,
+        input_size, H, params);
+
+    for (k = 0; k < sched->num_active; ++k) {
+        int s = sched->active[k];
+        for (i = 0; i < H; ++i) {
+            output[k * H + i] = y[s * H + i];
+        }
+    }
+}
+
+void xlstm_sched_tick_mlstm_f32(
+    XlstmScheduler* sched,
+    const float* x,
+    const float* W,
+    const float* b,
+    float* y,
+    float* C,
+    float* n,
+    float* m,
+    float* output,
+    float* scratch,
+    int input_size,
+    int hidden_size,
+    const MlstmParams* params)
+{
+    int H = hidden_size;
+    int k, i;
+
+    /* Zero the state of newly admitted streams */
+    for (k = 0; k < sched->num_active; ++k) {
+        if (sched->fresh[k]) {
+            int s = sched->active[k];
+            for (i = 0; i < H * H; ++i) {
+                C[s * H * H + i] = 0.0f;
+            }
+            for (i = 0; i < H; ++i) {
+                y[s * H + i] = 0.0f;
+                n[s * H + i] = 0.0f;
+            }
+            m[s] = 0.0f;
+            sched->fresh[k] = 0;
+        }
+    }
+
+    mlstm_step_batch_f32(
+        x, sched->active, sched->num_active,
+        W, b, y, C, n, m, scratch,
+        input_size, H, params);
+
+    for (k = 0; k < sched->num_active; ++k) {
+        int s = sched->active[k];
+        for (i = 0; i < H; ++i) {
+            output[k * H + i] = y[s * H + i];
+        }
+    }
+}
+
+void xlstm_sched_tick_slstm_s8(
+    XlstmScheduler* sched,
+    const int8_t* x,
+    const int8_t* W_q,
+    const int8_t* R_q,
+    const int32_t* b_q,
+    int8_t* y,
+    int16_t* c,
+    int16_t* n,
+    float* m,
+    int8_t* output,
+    int32_t* scratch,
+    int input_size,
+    int hidden_size,
+    const SlstmS8Params* params)
+{
+    int H = hidden_size;
+    int k, i;
+
+    /* Zero the state of newly admitted streams (y at its zero point) */
+    for (k = 0; k < sched->num_active; ++k) {
+        if (sched->fresh[k]) {
+            int s = sched->active[k];
+            for (i = 0; i < H; ++i) {
+                y[s * H + i] = (int8_t)params->y_quant.zero_point;
+                c[s * H + i] = 0;
+                n[s * H + i] = 0;
+                m[s * H + i] = 0.0f;
+            }
+            sched->fresh[k] = 0;
+        }
+    }
+
+    slstm_step_batch_s8(
+        x, sched->active, sched->num_active,
+        W_q, R_q, b_q, y, c, n, m, scratch,
+        input_size, H, params);
+
+    for (k = 0; k < sched->num_active; ++k) {
+        int s = sched->active[k];
+        for (i = 0; i < H; ++i) {
+            output[k * H + i] = y[s * H + i];
+        }
+    }
+}
+
+void xlstm_sched_tick_mlstm_s8(
+    XlstmScheduler* sched,
+    const int8_t* x,
+    const int8_t* W_q,
+    const int32_t* b_q,
+    int8_t* y,
+    int16_t* C,
+    int16_t* n,
+    float* m,
+    int8_t* output,
+    int32_t* scratch,
+    int input_size,
+    int hidden_size,
+    const MlstmS8Params* params)
+{
+    int H = hidden_size;
+    int k, i;
+
+    /* Zero the state of newly admitted streams (y at its zero point) */
+    for (k = 0; k < sched->num_active; ++k) {
+        if (sched->fresh[k]) {
+            int s = sched->active[k];
+            for (i = 0; i < H * H; ++i) {
+                C[s * H * H + i] = 0;
+            }
+            for (i = 0; i < H; ++i) {
+                y[s * H + i] = (int8_t)params->y_quant.zero_point;
+                n[s * H + i] = 0;
+            }
+            m[s] = 0.0f;
+            sched->fresh[k] = 0;
+        }
+    }
+
+    mlstm_step_batch_s8(
+        x, sched->active, sched->num_active,
+        W_q, b_q, y, C, n, m, scratch,
+        input_size, H, params);
+
+    for (k = 0; k < sched->num_active; ++k) {
+        int s = sched->active[k];
+        for (i = 0; i < H; ++i) {
+            output[k * H + i] = y[s * H + i];
+        }
+    }
+}
@@ -0,0 +1,355 @@
+/* Copyright 2026 RAWS labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * =========================================================================
+ * Multi-layer stack runtime — pure C99, no allocation.
+ * Optional pthread driver with -DXLSTM_USE_PTHREADS.
+ * ===========================================================================*/
+
+#include "xlstm_stack.h"
+#include "xlstm_trace.h"
+
+#ifdef XLSTM_USE_PTHREADS
+#include <pthread.h>
+#endif
+
+/* ========================================================================== */
+/* Setup                                                                      */
+/* ========================================================================== */
+
+size_t xlstm_stack_ring_size(
+    const XlstmStackLayer* layers,
+    int num_layers,
+    int batch_size,
+    int chunk_steps)
+{
+    size_t total = 0;
+    int l;
+
+    for (l = 0; l + 1 < num_layers; ++l) {
+        total += 2 * (size_t)batch_size * (size_t)chunk_steps *
+                 (size_t)layers[l].hidden_size;
+    }
+    return total;
+}
+
+int xlstm_stack_init(
+    XlstmStack* stack,
+    XlstmStackLayer* layers,
+    int num_layers,
+    float* ring,
+    size_t ring_size,
+    int batch_size,
+    int chunk_steps)
+{
+    int l;
+
+    if (!stack || !layers || num_layers <= 0 || batch_size <= 0 ||
+        chunk_steps <= 0) {
+        return XLSTM_ERR_ARG;
+    }
+    for (l = 0; l < num_layers; ++l) {
+        const XlstmStackLayer* layer = &layers[l];
+        if (layer->kind != XLSTM_KIND_SLSTM_F32 &&
+            layer->kind != XLSTM_KIND_MLSTM_F32) {
+            return XLSTM_ERR_ARG;
+        }
+        if (l > 0 && layer->input_size != layers[l - 1].hidden_size) {
+            return XLSTM_ERR_SHAPE;
+        }
+    }
+    if (ring_size < xlstm_stack_ring_size(layers, num_layers, batch_size, chunk_steps)) {
+        return XLSTM_ERR_SIZE;
+    }
+    if (num_layers > 1 && !ring) return XLSTM_ERR_ARG;
+
+    stack->layers = layers;
+    stack->num_layers = num_layers;
+    stack->ring = ring;
+    stack->batch_size = batch_size;
+    stack->chunk_steps = chunk_steps;
+    stack->input = NULL;
+    stack->output = NULL;
+    stack->time_steps = 0;
+    stack->num_chunks = 0;
+    stack->pool = NULL;
+    return XLSTM_OK;
+}
+
+int xlstm_stack_begin(
+    XlstmStack* stack,
+    const float* input,
+    float* output,
+    int time_steps)
+{
+    stack->input = input;
+    stack->output = output;
+    stack->time_steps = time_steps;
+    stack->num_chunks = (time_steps + stack->chunk_steps - 1) / stack->chunk_steps;
+    if (stack->num_chunks == 0) return 0;
+    return stack->num_layers + stack->num_chunks - 1;
+}
+
+/* ========================================================================== */
+/* Wavefront                                                                  */
+/* ========================================================================== */
+
+/* Start of ring slot `slot` of the boundary after layer l */
+static float* ring_slot(const XlstmStack* stack, int l, int slot) {
+    size_t offset = 0;
+    size_t slot_size;
+    int i;
+
+    for (i = 0; i < l; ++i) {
+        offset += 2 * (size_t)stack->batch_size * (size_t)stack->chunk_steps *
+                  (size_t)stack->layers[i].hidden_size;
+    }
+    slot_size = (size_t)stack->batch_size * (size_t)stack->chunk_steps *
+                (size_t)stack->layers[l].hidden_size;
+    return stack->ring + offset + (size_t)slot * slot_size;
+}
+
+/* Work item (l, k): layer l over chunk k, one batch element at a time */
+static void run_item(XlstmStack* stack, int l, int k) {
+    XlstmStackLayer* layer = &stack->layers[l];
+    int B = stack->batch_size;
+    int T = stack->time_steps;
+    int chunk = stack->chunk_steps;
+    int I = layer->input_size;
+    int H = layer->hidden_size;
+    int t0 = k * chunk;
+    int steps = (T - t0 < chunk) ? T - t0 : chunk;
+    int last = (l == stack->num_layers - 1);
+    const float* src_ring = (l > 0) ? ring_slot(stack, l - 1, k % 2) : NULL;
+    float* dst_ring = last ? NULL : ring_slot(stack, l, k % 2);
+    int batch;
+    XLSTM_TRACE_BEGIN(trace_t);
+
+    for (batch = 0; batch < B; ++batch) {
+        const float* x = (l == 0)
+            ? stack->input + ((size_t)batch * T + t0) * I
+            : src_ring + (size_t)batch * chunk * I;
+        float* out = last
+            ? stack->output + ((size_t)batch * T + t0) * H
+            : dst_ring + (size_t)batch * chunk * H;
+
+        if (layer->kind == XLSTM_KIND_SLSTM_F32) {
+            slstm_eval_f32(
+                x, layer->W, layer->R, layer->b,
+                layer->y + batch * H, layer->c + batch * H,
+                layer->n + batch * H, layer->m + batch * H,
+                out, layer->scratch, 1, steps, I, H, &layer->slstm_params);
+        } else {
+            mlstm_eval_f32(
+                x, layer->W, layer->b,
+                layer->y + batch * H, layer->c + (size_t)batch * H * H,
+                layer->n + batch * H, layer->m + batch,
+                out, layer->scratch, 1, steps, I, H, &layer->mlstm_params);
+        }
+    }
+    XLSTM_TRACE_END("layer", l, k, trace_t);
+}
+
+void xlstm_stack_wave(XlstmStack* stack, int wave, int worker, int num_workers) {
+    int l_min = wave - stack->num_chunks + 1;
+    int l_max = wave;
+    int l;
+
+    if (l_min < 0) l_min = 0;
+    if (l_max > stack->num_layers - 1) l_max = stack->num_layers - 1;
+#ifdef XLSTM_TRACE
+    xlstm_trace_set_thread(worker);
+#endif
+
+    for (l = l_min + worker; l <= l_max; l += num_workers) {
+        run_item(stack, l, wave - l);
+    }
+}
+
+void xlstm_stack_eval(
+    XlstmStack* stack,
+    const float* input,
+    float* output,
+    int time_steps)
+{
+    int waves = xlstm_stack_begin(stack, input, output, time_steps);
+    int w;
+
+    for (w = 0; w < waves; ++w) {
+        xlstm_stack_wave(stack, w, 0, 1);
+    }
+}
+
+/* ========================================================================== */
+/* Optional pthread driver                                                    */
+/* ========================================================================== */
+
+#ifdef XLSTM_USE_PTHREADS
+
+typedef struct {
+    XlstmStack* stack;
+    int num_waves;
+    int num_workers;
+} StackJob;
+
+static void pool_barrier(XlstmStackPool* pool, int num_workers) {
+    unsigned gen;
+    XLSTM_TRACE_BEGIN(trace_t);
+
+    pthread_mutex_lock(&pool->lock);
+    gen = pool->generation;
+    if (++pool->waiting == num_workers) {
+        pool->waiting = 0;
+        pool->generation++;
+        pthread_cond_broadcast(&pool->barrier_cond);
+    } else {
+        while (gen == pool->generation) {
+            pthread_cond_wait(&pool->barrier_cond, &pool->lock);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+    XLSTM_TRACE_END("barrier", -1, -1, trace_t);
+}
+
+static void pool_run(XlstmStackPool* pool, const StackJob* job, int worker) {
+    int w;
+
+    for (w = 0; w < job->num_waves; ++w) {
+        xlstm_stack_wave(job->stack, w, worker, job->num_workers);
+        pool_barrier(pool, job->num_workers);
+    }
+}
+
+/* Workers copy each job under the lock, so the caller can post the next
+ * one while a worker is still leaving the previous job's last barrier. */
+static void* pool_thread(void* arg) {
+    XlstmStackWorker* self = (XlstmStackWorker*)arg;
+    XlstmStackPool* pool = self->pool;
+    unsigned seen = 0;
+    StackJob job;
+
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (pool->job == seen && !pool->shutdown) {
+            pthread_cond_wait(&pool->job_cond, &pool->lock);
+        }
+        if (pool->shutdown) break;
+        seen = pool->job;
+        job.stack = pool->stack;
+        job.num_waves = pool->num_waves;
+        job.num_workers = pool->num_workers;
+        pthread_mutex_unlock(&pool->lock);
+
+        /* Workers beyond this job's count sit it out */
+        if (self->worker < job.num_workers) pool_run(pool, &job, self->worker);
+        pthread_mutex_lock(&pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+int xlstm_stack_pool_init(XlstmStack* stack, XlstmStackPool* pool, int num_threads) {
+    int created = 0;
+    int i;
+
+    if (!stack || !pool || num_threads <= 0) return XLSTM_ERR_ARG;
+    if (num_threads > XLSTM_STACK_MAX_THREADS) num_threads = XLSTM_STACK_MAX_THREADS;
+    /* More workers than layers would only wait at the barrier */
+    if (num_threads > stack->num_layers) num_threads = stack->num_layers;
+
+    pool->stack = NULL;
+    pool->num_waves = 0;
+    pool->num_workers = 1;
+    pool->job = 0;
+    pool->shutdown = 0;
+    pool->waiting = 0;
+    pool->generation = 0;
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->job_cond, NULL);
+    pthread_cond_init(&pool->barrier_cond, NULL);
+
+    for (i = 1; i < num_threads; ++i) {
+        pool->workers[created].pool = pool;
+        pool->workers[created].worker = created + 1;
+        if (pthread_create(&pool->threads[created], NULL, pool_thread,
+                           &pool->workers[created]) != 0) {
+            break;
+        }
+        created++;
+    }
+    pool->num_threads = created + 1;
+    stack->pool = pool;
+    return XLSTM_OK;
+}
+
+void xlstm_stack_pool_destroy(XlstmStack* stack) {
+    XlstmStackPool* pool;
+    int i;
+
+    if (!stack || !stack->pool) return;
+    pool = stack->pool;
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = 1;
+    pthread_cond_broadcast(&pool->job_cond);
+    pthread_mutex_unlock(&pool->lock);
+    for (i = 0; i + 1 < pool->num_threads; ++i) {
+        pthread_join(pool->threads[i], NULL);
+    }
+    pthread_cond_destroy(&pool->barrier_cond);
+    pthread_cond_destroy(&pool->job_cond);
+    pthread_mutex_destroy(&pool->lock);
+    stack->pool = NULL;
+}
+
+int xlstm_stack_eval_parallel(
+    XlstmStack* stack,
+    const float* input,
+    float* output,
+    int time_steps,
+    int num_threads)
+{
+    XlstmStackPool* pool;
+    StackJob job;
+
+    if (!stack || num_threads <= 0) return XLSTM_ERR_ARG;
+    if (!stack->pool) {
+        /* No pool attached: a temporary one for this call only */
+        XlstmStackPool temp;
+        int status = xlstm_stack_pool_init(stack, &temp, num_threads);
+        if (status == XLSTM_OK) {
+            status = xlstm_stack_eval_parallel(stack, input, output, time_steps,
+                                               num_threads);
+            xlstm_stack_pool_destroy(stack);
+        }
+        return status;
+    }
+
+    pool = stack->pool;
+    job.stack = stack;
+    job.num_waves = xlstm_stack_begin(stack, input, output, time_steps);
+    job.num_workers = num_threads < pool->num_threads ? num_threads : pool->num_threads;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->stack = job.stack;
+    pool->num_waves = job.num_waves;
+    pool->num_workers = job.num_workers;
+    pool->job++;
+    pthread_cond_broadcast(&pool->job_cond);
+    pthread_mutex_unlock(&pool->lock);
+
+    /* The last barrier means every worker is done with this job */
+    pool_run(pool, &job, 0);
+    return XLSTM_OK;
+}
+
+#endif /* XLSTM_USE_PTHREADS */
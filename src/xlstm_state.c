@@ -0,0 +1,362 @@
+/* Copyright 2026 RAWS labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * =========================================================================
+ * Recurrent state snapshots — pure C99, only depends on libc (math.h,
+ * string.h)
+ * ===========================================================================*/
+
+#include "xlstm_state.h"
+
+#include <math.h>
+#include <string.h>
+
+typedef char xlstm_state_header_is_64_bytes[
+    (sizeof(XlstmStateHeader) == 64) ? 1 : -1];
+
+/* ========================================================================== */
+/* Layout                                                                     */
+/* ========================================================================== */
+
+static size_t align_up(size_t v) {
+    return (v + XLSTM_STATE_ALIGN - 1) & ~(size_t)(XLSTM_STATE_ALIGN - 1);
+}
+
+/* Byte size of the y, c|C, n, m sections. Returns 0 for an unknown kind. */
+static int section_sizes(XlstmKind kind, int B, int H, size_t size[4]) {
+    size_t BH = (size_t)B * (size_t)H;
+
+    switch (kind) {
+        case XLSTM_KIND_SLSTM_F32:
+            size[0] = BH * 4; size[1] = BH * 4;
+            size[2] = BH * 4; size[3] = BH * 4;
+            return 1;
+        case XLSTM_KIND_MLSTM_F32:
+            size[0] = BH * 4; size[1] = BH * (size_t)H * 4;
+            size[2] = BH * 4; size[3] = (size_t)B * 4;
+            return 1;
+        case XLSTM_KIND_SLSTM_S8:
+            size[0] = BH; size[1] = BH * 2;
+            size[2] = BH * 2; size[3] = BH * 4;
+            return 1;
+        case XLSTM_KIND_MLSTM_S8:
+            size[0] = BH; size[1] = BH * (size_t)H * 2;
+            size[2] = BH * 2; size[3] = (size_t)B * 4;
+            return 1;
+        default:
+            break;   /* block kinds have no single-cell snapshot */
+    }
+    return 0;
+}
+
+/* Fill section offsets; returns the total blob size (0 if invalid). */
+static size_t layout(XlstmKind kind, int B, int H,
+                     size_t offset[4], size_t size[4]) {
+    size_t pos = sizeof(XlstmStateHeader);
+    int s;
+
+    if (B <= 0 || H <= 0 || !section_sizes(kind, B, H, size)) return 0;
+    for (s = 0; s < 4; ++s) {
+        pos = align_up(pos);
+        offset[s] = pos;
+        pos += size[s];
+    }
+    return align_up(pos);
+}
+
+size_t xlstm_state_size(XlstmKind kind, int batch_size, int hidden_size) {
+    size_t offset[4], size[4];
+    return layout(kind, batch_size, hidden_size, offset, size);
+}
+
+/* ========================================================================== */
+/* Save / view                                                                */
+/* ========================================================================== */
+
+static int state_save(XlstmKind kind, int B, int H,
+                      const void* y, const void* c, const void* n, const float* m,
+                      const XlstmQuantParam* quant, /* [3] or NULL */
+                      void* blob, size_t blob_size) {
+    size_t offset[4], size[4];
+    const void* src[4];
+    XlstmStateHeader hdr;
+    size_t total;
+    int s;
+
+    if (!blob || !y || !c || !n || !m) return XLSTM_ERR_ARG;
+    total = layout(kind, B, H, offset, size);
+    if (total == 0) return XLSTM_ERR_ARG;
+    /* total_size and the offsets are stored as uint32 */
+    if ((uint64_t)total > UINT32_MAX) return XLSTM_ERR_SIZE;
+    if (blob_size < total) return XLSTM_ERR_SIZE;
+
+    /* Zero everything first so padding bytes are deterministic */
+    for (s = 0; s < (int)sizeof(hdr); ++s) ((unsigned char*)&hdr)[s] = 0;
+    {
+        unsigned char* b = (unsigned char*)blob;
+        size_t i;
+        for (i = 0; i < total; ++i) b[i] = 0;
+    }
+
+    hdr.magic = XLSTM_STATE_MAGIC;
+    hdr.version = XLSTM_STATE_VERSION;
+    hdr.kind = (uint8_t)kind;
+    hdr.batch_size = (uint32_t)B;
+    hdr.hidden_size = (uint32_t)H;
+    hdr.total_size = (uint32_t)total;
+    for (s = 0; s < 4; ++s) hdr.offset[s] = (uint32_t)offset[s];
+    if (quant) {
+        hdr.y_quant = quant[0];
+        hdr.c_quant = quant[1];
+        hdr.n_quant = quant[2];
+    }
+    memcpy(blob, &hdr, sizeof(hdr));
+
+    src[0] = y; src[1] = c; src[2] = n; src[3] = m;
+    for (s = 0; s < 4; ++s) {
+        memcpy((unsigned char*)blob + offset[s], src[s], size[s]);
+    }
+    return XLSTM_OK;
+}
+
+int xlstm_state_view(const void* blob, size_t blob_size, XlstmStateView* view) {
+    const XlstmStateHeader* hdr = (const XlstmStateHeader*)blob;
+    const unsigned char* base = (const unsigned char*)blob;
+    size_t offset[4], size[4];
+    size_t total;
+    int s;
+
+    if (!blob || !view || ((uintptr_t)blob & 3u) != 0) return XLSTM_ERR_ARG;
+    if (blob_size < sizeof(XlstmStateHeader)) return XLSTM_ERR_SIZE;
+    if (hdr->magic != XLSTM_STATE_MAGIC) return XLSTM_ERR_FORMAT;
+    if (hdr->version != XLSTM_STATE_VERSION) return XLSTM_ERR_FORMAT;
+    if (hdr->batch_size > 0x7fffffffu || hdr->hidden_size > 0x7fffffffu) {
+        return XLSTM_ERR_FORMAT;
+    }
+
+    total = layout((XlstmKind)hdr->kind, (int)hdr->batch_size,
+                   (int)hdr->hidden_size, offset, size);
+    if (total == 0) return XLSTM_ERR_FORMAT;
+    if (hdr->total_size != total) return XLSTM_ERR_FORMAT;
+    for (s = 0; s < 4; ++s) {
+        if (hdr->offset[s] != offset[s]) return XLSTM_ERR_FORMAT;
+    }
+    if (blob_size < total) return XLSTM_ERR_SIZE;
+
+    view->kind = (XlstmKind)hdr->kind;
+    view->batch_size = (int)hdr->batch_size;
+    view->hidden_size = (int)hdr->hidden_size;
+    view->y = base + offset[0];
+    view->c = base + offset[1];
+    view->n = base + offset[2];
+    view->m = (const float*)(base + offset[3]);
+    view->y_quant = hdr->y_quant;
+    view->c_quant = hdr->c_quant;
+    view->n_quant = hdr->n_quant;
+    return XLSTM_OK;
+}
+
+/* View + kind/shape check shared by all restore functions */
+static int state_open(const void* blob, size_t blob_size, XlstmKind kind,
+                      int B, int H, XlstmStateView* view) {
+    int status = xlstm_state_view(blob, blob_size, view);
+    if (status != XLSTM_OK) return status;
+    if (view->kind != kind) return XLSTM_ERR_FORMAT;
+    if (view->batch_size != B || view->hidden_size != H) return XLSTM_ERR_SHAPE;
+    return XLSTM_OK;
+}
+
+/* ========================================================================== */
+/* INT8 requantization on restore                                             */
+/* ========================================================================== */
+
+static int same_quant(const XlstmQuantParam* a, const XlstmQuantParam* b) {
+    return a->scale == b->scale && a->zero_point == b->zero_point;
+}
+
+static void requant_s8(const int8_t* src, const XlstmQuantParam* from,
+                       int8_t* dst, const XlstmQuantParam* to, size_t len) {
+    size_t i;
+    for (i = 0; i < len; ++i) {
+        float real = from->scale * ((float)src[i] - (float)from->zero_point);
+        float q = roundf(real / to->scale) + (float)to->zero_point;
+        dst[i] = (int8_t)fmaxf(-128.0f, fminf(127.0f, q));
+    }
+}
+
+static void requant_s16(const int16_t* src, const XlstmQuantParam* from,
+                        int16_t* dst, const XlstmQuantParam* to, size_t len) {
+    size_t i;
+    for (i = 0; i < len; ++i) {
+        float real = from->scale * ((float)src[i] - (float)from->zero_point);
+        float q = roundf(real / to->scale) + (float)to->zero_point;
+        dst[i] = (int16_t)fmaxf(-32768.0f, fminf(32767.0f, q));
+    }
+}
+
+static void restore_s8(const XlstmStateView* view,
+                       int8_t* y, int16_t* c, int16_t* n, float* m,
+                       size_t y_len, size_t c_len, size_t m_len,
+                       const XlstmQuantParam* y_to,
+                       const XlstmQuantParam* c_to,
+                       const XlstmQuantParam* n_to) {
+    if (same_quant(&view->y_quant, y_to)) {
+        memcpy(y, view->y, y_len);
+    } else {
+        requant_s8((const int8_t*)view->y, &view->y_quant, y, y_to, y_len);
+    }
+    if (same_quant(&view->c_quant, c_to)) {
+        memcpy(c, view->c, c_len * 2);
+    } else {
+        requant_s16((const int16_t*)view->c, &view->c_quant, c, c_to, c_len);
+    }
+    if (same_quant(&view->n_quant, n_to)) {
+        memcpy(n, view->n, y_len * 2);
+    } else {
+        requant_s16((const int16_t*)view->n, &view->n_quant, n, n_to, y_len);
+    }
+    memcpy(m, view->m, m_len * 4);
+}
+
+/* ========================================================================== */
+/* Per-kernel entry points                                                    */
+/* ========================================================================== */
+
+int xlstm_state_save_slstm_f32(
+    const float* y, const float* c, const float* n, const float* m,
+    int batch_size, int hidden_size,
+    void* blob, size_t blob_size)
+{
+    return state_save(XLSTM_KIND_SLSTM_F32, batch_size, hidden_size,
+                      y, c, n, m, NULL, blob, blob_size);
+}
+
+int xlstm_state_restore_slstm_f32(
+    const void* blob, size_t blob_size,
+    float* y, float* c, float* n, float* m,
+    int batch_size, int hidden_size)
+{
+    XlstmStateView view;
+    size_t BH = (size_t)batch_size * (size_t)hidden_size;
+    int status;
+
+    if (!y || !c || !n || !m) return XLSTM_ERR_ARG;
+    status = state_open(blob, blob_size, XLSTM_KIND_SLSTM_F32,
+                        batch_size, hidden_size, &view);
+    if (status != XLSTM_OK) return status;
+
+    memcpy(y, view.y, BH * 4);
+    memcpy(c, view.c, BH * 4);
+    memcpy(n, view.n, BH * 4);
+    memcpy(m, view.m, BH * 4);
+    return XLSTM_OK;
+}
+
+int xlstm_state_save_mlstm_f32(
+    const float* y, const float* C, const float* n, const float* m,
+    int batch_size, int hidden_size,
+    void* blob, size_t blob_size)
+{
+    return state_save(XLSTM_KIND_MLSTM_F32, batch_size, hidden_size,
+                      y, C, n, m, NULL, blob, blob_size);
+}
+
+int xlstm_state_restore_mlstm_f32(
+    const void* blob, size_t blob_size,
+    float* y, float* C, float* n, float* m,
+    int batch_size, int hidden_size)
+{
+    XlstmStateView view;
+    size_t BH = (size_t)batch_size * (size_t)hidden_size;
+    int status;
+
+    if (!y || !C || !n || !m) return XLSTM_ERR_ARG;
+    status = state_open(blob, blob_size, XLSTM_KIND_MLSTM_F32,
+                        batch_size, hidden_size, &view);
+    if (status != XLSTM_OK) return status;
+
+    memcpy(y, view.y, BH * 4);
+    memcpy(C, view.c, BH * (size_t)hidden_size * 4);
+    memcpy(n, view.n, BH * 4);
+    memcpy(m, view.m, (size_t)batch_size * 4);
+    return XLSTM_OK;
+}
+
+int xlstm_state_save_slstm_s8(
+    const int8_t* y, const int16_t* c, const int16_t* n, const float* m,
+    int batch_size, int hidden_size, const SlstmS8Params* params,
+    void* blob, size_t blob_size)
+{
+    XlstmQuantParam quant[3];
+
+    if (!params) return XLSTM_ERR_ARG;
+    quant[0] = params->y_quant;
+    quant[1] = params->c_quant;
+    quant[2] = params->n_quant;
+    return state_save(XLSTM_KIND_SLSTM_S8, batch_size, hidden_size,
+                      y, c, n, m, quant, blob, blob_size);
+}
+
+int xlstm_state_restore_slstm_s8(
+    const void* blob, size_t blob_size,
+    int8_t* y, int16_t* c, int16_t* n, float* m,
+    int batch_size, int hidden_size, const SlstmS8Params* params)
+{
+    XlstmStateView view;
+    size_t BH = (size_t)batch_size * (size_t)hidden_size;
+    int status;
+
+    if (!params || !y || !c || !n || !m) return XLSTM_ERR_ARG;
+    status = state_open(blob, blob_size, XLSTM_KIND_SLSTM_S8,
+                        batch_size, hidden_size, &view);
+    if (status != XLSTM_OK) return status;
+
+    restore_s8(&view, y, c, n, m, BH, BH, BH,
+               &params->y_quant, &params->c_quant, &params->n_quant);
+    return XLSTM_OK;
+}
+
+int xlstm_state_save_mlstm_s8(
+    const int8_t* y, const int16_t* C, const int16_t* n, const float* m,
+    int batch_size, int hidden_size, const MlstmS8Params* params,
+    void* blob, size_t blob_size)
+{
+    XlstmQuantParam quant[3];
+
+    if (!params) return XLSTM_ERR_ARG;
+    quant[0] = params->y_quant;
+    quant[1] = params->C_quant;
+    quant[2] = params->n_quant;
+    return state_save(XLSTM_KIND_MLSTM_S8, batch_size, hidden_size,
+                      y, C, n, m, quant, blob, blob_size);
+}
+
+int xlstm_state_restore_mlstm_s8(
+    const void* blob, size_t blob_size,
+    int8_t* y, int16_t* C, int16_t* n, float* m,
+    int batch_size, int hidden_size, const MlstmS8Params* params)
+{
+    XlstmStateView view;
+    size_t BH = (size_t)batch_size * (size_t)hidden_size;
+    int status;
+
+    if (!params || !y || !C || !n || !m) return XLSTM_ERR_ARG;
+    status = state_open(blob, blob_size, XLSTM_KIND_MLSTM_S8,
+                        batch_size, hidden_size, &view);
+    if (status != XLSTM_OK) return status;
+
+    restore_s8(&view, y, C, n, m, BH, BH * (size_t)hidden_size,
+               (size_t)batch_size,
+               &params->y_quant, &params->C_quant, &params->n_quant);
+    return XLSTM_OK;
+}
@@ -0,0 +1,226 @@
+/* Copyright 2026 RAWS labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * =========================================================================
+ * Timeline tracing — event recording and Chrome trace JSON export.
+ * ===========================================================================*/
+
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(XLSTM_TRACE_CLOCK)
+#define _POSIX_C_SOURCE 200809L
+#define XLSTM_TRACE_POSIX_CLOCK 1
+#endif
+
+#include "xlstm_trace.h"
+
+#if defined(XLSTM_TRACE_CLOCK)
+uint64_t XLSTM_TRACE_CLOCK(void);
+#else
+#include <time.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define TRACE_THREAD_LOCAL __thread
+#else
+#define TRACE_THREAD_LOCAL
+#endif
+
+static XlstmTrace* volatile g_trace = NULL;
+static TRACE_THREAD_LOCAL int g_tid = 0;
+
+static uint64_t now_ns(void) {
+#if defined(XLSTM_TRACE_CLOCK)
+    return XLSTM_TRACE_CLOCK();
+#elif defined(XLSTM_TRACE_POSIX_CLOCK)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#else
+    return (uint64_t)clock() * (1000000000u / CLOCKS_PER_SEC);
+#endif
+}
+
+/* Reserve the next event slot */
+static uint32_t reserve(XlstmTrace* trace) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __atomic_fetch_add(&trace->count, 1u, __ATOMIC_RELAXED);
+#else
+    return trace->count++;
+#endif
+}
+
+/* ========================================================================== */
+/* Recording                                                                  */
+/* ========================================================================== */
+
+void xlstm_trace_init(XlstmTrace* trace, XlstmTraceEvent* events, int capacity) {
+    trace->events = events;
+    trace->capacity = (events && capacity > 0) ? (uint32_t)capacity : 0;
+    trace->count = 0;
+    trace->origin_ns = 0;
+}
+
+void xlstm_trace_start(XlstmTrace* trace) {
+    if (trace) trace->origin_ns = now_ns();
+    g_trace = trace;
+}
+
+void xlstm_trace_stop(void) {
+    g_trace = NULL;
+}
+
+int xlstm_trace_count(const XlstmTrace* trace) {
+    return (int)(trace->count < trace->capacity ? trace->count : trace->capacity);
+}
+
+int xlstm_trace_dropped(const XlstmTrace* trace) {
+    return (int)(trace->count > trace->capacity ? trace->count - trace->capacity : 0);
+}
+
+void xlstm_trace_set_thread(int tid) {
+    g_tid = tid;
+}
+
+uint64_t xlstm_trace_begin(void) {
+    return g_trace ? now_ns() : 0;
+}
+
+void xlstm_trace_end(const char* name, int layer, int chunk, uint64_t begin) {
+    XlstmTrace* trace = g_trace;
+    XlstmTraceEvent* ev;
+    uint32_t slot;
+
+    if (!trace || begin == 0) return;
+    slot = reserve(trace);
+    if (slot >= trace->capacity) return;
+
+    ev = &trace->events[slot];
+    ev->name = name;
+    ev->layer = layer;
+    ev->chunk = chunk;
+    ev->tid = g_tid;
+    ev->reserved = 0;
+    ev->begin_ns = begin;
+    ev->end_ns = now_ns();
+}
+
+/* ========================================================================== */
+/* JSON export                                                                */
+/* ========================================================================== */
+
+/* Appends to out while it fits; pos always counts the full length. */
+typedef struct {
+    char* out;
+    size_t size;
+    size_t pos;
+} Writer;
+
+static void put_char(Writer* w, char c) {
+    if (w->out && w->pos < w->size) w->out[w->pos] = c;
+    w->pos++;
+}
+
+static void put_str(Writer* w, const char* s) {
+    while (*s) put_char(w, *s++);
+}
+
+/* JSON string body: quotes, backslashes and control characters escaped */
+static void put_escaped(Writer* w, const char* s) {
+    static const char hex[] = "0123456789abcdef";
+    for (; *s; ++s) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\') {
+            put_char(w, '\\');
+            put_char(w, (char)c);
+        } else if (c < 0x20) {
+            put_str(w, "\\u00");
+            put_char(w, hex[c >> 4]);
+            put_char(w, hex[c & 15]);
+        } else {
+            put_char(w, (char)c);
+        }
+    }
+}
+
+static void put_u64(Writer* w, uint64_t v) {
+    char buf[20];
+    int n = 0;
+    do {
+        buf[n++] = (char)('0' + v % 10);
+        v /= 10;
+    } while (v);
+    while (n) put_char(w, buf[--n]);
+}
+
+static void put_int(Writer* w, int v) {
+    if (v < 0) {
+        put_char(w, '-');
+        put_u64(w, (uint64_t)(-(int64_t)v));
+    } else {
+        put_u64(w, (uint64_t)v);
+    }
+}
+
+/* Nanoseconds as microseconds with three decimals */
+static void put_us(Writer* w, uint64_t ns) {
+    uint64_t frac = ns % 1000;
+    put_u64(w, ns / 1000);
+    put_char(w, '.');
+    put_char(w, (char)('0' + frac / 100));
+    put_char(w, (char)('0' + frac / 10 % 10));
+    put_char(w, (char)('0' + frac % 10));
+}
+
+size_t xlstm_trace_write_json(const XlstmTrace* trace, char* out, size_t out_size) {
+    Writer w;
+    int n = xlstm_trace_count(trace);
+    int i;
+
+    /* Measure first so out is only touched when everything fits */
+    w.out = NULL;
+    w.size = 0;
+    w.pos = 0;
+    for (;;) {
+        put_str(&w, "{\"traceEvents\":[");
+        for (i = 0; i < n; ++i) {
+            const XlstmTraceEvent* ev = &trace->events[i];
+            uint64_t begin = ev->begin_ns > trace->origin_ns
+                ? ev->begin_ns - trace->origin_ns : 0;
+            uint64_t dur = ev->end_ns > ev->begin_ns ? ev->end_ns - ev->begin_ns : 0;
+
+            if (i) put_char(&w, ',');
+            put_str(&w, "\n{\"name\":\"");
+            put_escaped(&w, ev->name ? ev->name : "");
+            put_str(&w, "\",\"cat\":\"xlstm\",\"ph\":\"X\",\"ts\":");
+            put_us(&w, begin);
+            put_str(&w, ",\"dur\":");
+            put_us(&w, dur);
+            put_str(&w, ",\"pid\":0,\"tid\":");
+            put_int(&w, ev->tid);
+            if (ev->layer >= 0 || ev->chunk >= 0) {
+                put_str(&w, ",\"args\":{\"layer\":");
+                put_int(&w, ev->layer);
+                put_str(&w, ",\"chunk\":");
+                put_int(&w, ev->chunk);
+                put_char(&w, '}');
+            }
+            put_char(&w, '}');
+        }
+        put_str(&w, "\n],\"displayTimeUnit\":\"ns\"}\n");
+
+        if (w.out || !out || w.pos > out_size) break;
+        w.out = out;
+        w.size = out_size;
+        w.pos = 0;
+    }
+    return w.pos;
+}
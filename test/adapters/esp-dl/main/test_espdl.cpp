@@ -1,6 +1,6 @@
 /* ESP-DL integration test — exercises sLSTM/mLSTM Module subclasses.
  *
- * Tests constructor, get_output_shape(), and init_states()/free_states()
+ * Tests constructor, get_output_shape(), and the state session
  * lifecycle against the real ESP-DL framework on emulated hardware (QEMU).
  *
  * Note: Full forward() test requires constructing ModelContext + TensorBase
@@ -1,9 +1,12 @@
 #!/usr/bin/env python3
 """ONNX Runtime integration test for sLSTM + mLSTM custom ops.
 
-Builds ONNX graphs with custom op nodes (com.raws.xlstm::SLSTM / MLSTM),
-loads the shared library via register_custom_ops_library(), runs inference,
-and validates outputs against reference data.
+Builds ONNX graphs with custom op nodes (com.raws.xlstm::SLSTM / MLSTM and
+the INT8 QLinearSLSTM / QLinearMLSTM), loads the shared library via
+register_custom_ops_library(), runs inference, and validates outputs against
+reference data. The INT8 ops get the reference inputs quantized the same way
+as the C tests and are checked against the float expectations with a
+quantization tolerance.
 """
 
 import json
@@ -13,8 +16,13 @@ import sys
 import numpy as np
 import onnx
 from onnx import TensorProto, helper
+import onnx.numpy_helper
 import onnxruntime as ort
 
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                                "..", "..", "..", "adapters", "onnxruntime"))
+from xlstm_ort_rewrite import use_preact_slstm  # noqa: E402
+
 
 SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
 ROOT_DIR = os.path.join(SCRIPT_DIR, "..", "..", "..")
@@ -23,6 +31,8 @@ LIB_PATH = os.path.join(ROOT_DIR, "libxlstm_ort.so")
 
 CUSTOM_DOMAIN = "com.raws.xlstm"
 ATOL = 1e-5
+Q8_ATOL = 0.10      # absolute, or Q8_RTOL of the tensor's range if larger
+Q8_RTOL = 0.05
 
 
 def make_slstm_model(B, T, I, H):
@@ -102,13 +112,112 @@ def make_mlstm_model(B, T, I, H):
     return model
 
 
-def run_ort_session(model, feeds):
-    """Run an ORT inference session with the custom ops library."""
+def make_qlinear_model(op, inputs, outputs):
+    """Build an ONNX model with a single INT8 custom op node.
+
+    inputs/outputs are (name, elem_type, shape) triples in op order.
+    """
+    graph = helper.make_graph(
+        [helper.make_node(op, [i[0] for i in inputs], [o[0] for o in outputs],
+                          domain=CUSTOM_DOMAIN)],
+        op.lower() + "_test",
+        [helper.make_tensor_value_info(*i) for i in inputs],
+        [helper.make_tensor_value_info(*o) for o in outputs],
+    )
+    opset = [
+        helper.make_opsetid("", 17),
+        helper.make_opsetid(CUSTOM_DOMAIN, 1),
+    ]
+    return helper.make_model(graph, opset_imports=opset)
+
+
+def make_qlinear_slstm_model(B, T, I, H):
+    """QLinearSLSTM: INT8 X/W/R/y, INT32 b, INT16 c/n, float m."""
+    F, I8, I16, I32 = TensorProto.FLOAT, TensorProto.INT8, TensorProto.INT16, TensorProto.INT32
+    inputs = [
+        ("X", I8, [B, T, I]), ("x_scale", F, []), ("x_zero_point", I8, []),
+        ("W", I8, [4*H, I]), ("W_scale", F, []),
+        ("R", I8, [4*H, H]), ("R_scale", F, []),
+        ("b", I32, [4*H]),
+        ("y_scale", F, []), ("y_zero_point", I8, []),
+        ("c_scale", F, []), ("n_scale", F, []),
+        ("y_init", I8, [B, H]), ("c_init", I16, [B, H]),
+        ("n_init", I16, [B, H]), ("m_init", F, [B, H]),
+    ]
+    outputs = [
+        ("output", I8, [B, T, H]), ("y", I8, [B, H]), ("c", I16, [B, H]),
+        ("n", I16, [B, H]), ("m", F, [B, H]),
+    ]
+    return make_qlinear_model("QLinearSLSTM", inputs, outputs)
+
+
+def make_qlinear_mlstm_model(B, T, I, H):
+    """QLinearMLSTM: INT8 X/W/y, INT32 b, INT16 C/n, float m."""
+    F, I8, I16, I32 = TensorProto.FLOAT, TensorProto.INT8, TensorProto.INT16, TensorProto.INT32
+    inputs = [
+        ("X", I8, [B, T, I]), ("x_scale", F, []), ("x_zero_point", I8, []),
+        ("W", I8, [4*H+2, I]), ("W_scale", F, []),
+        ("b", I32, [4*H+2]),
+        ("y_scale", F, []), ("y_zero_point", I8, []),
+        ("C_scale", F, []), ("n_scale", F, []),
+        ("y_init", I8, [B, H]), ("C_init", I16, [B, H*H]),
+        ("n_init", I16, [B, H]), ("m_init", F, [B, 1]),
+    ]
+    outputs = [
+        ("output", I8, [B, T, H]), ("y", I8, [B, H]), ("C", I16, [B, H*H]),
+        ("n", I16, [B, H]), ("m", F, [B, 1]),
+    ]
+    return make_qlinear_model("QLinearMLSTM", inputs, outputs)
+
+
+def quant_symmetric(x):
+    """Same as xlstm_quant_symmetric: (scale, zero_point 0)."""
+    max_abs = float(np.max(np.abs(x)))
+    return np.float32(max_abs / 127.0 if max_abs > 0.0 else 1.0), 0
+
+
+def quant_asymmetric(x):
+    """Same as xlstm_quant_asymmetric: range widened to include zero."""
+    lo, hi = min(float(np.min(x)), 0.0), max(float(np.max(x)), 0.0)
+    if hi - lo < 1e-10:
+        return np.float32(1.0 / 255.0), 0
+    scale = np.float32((hi - lo) / 255.0)
+    zp = int(np.clip(np.round(-128.0 - lo / scale), -128, 127))
+    return scale, zp
+
+
+def quantize(x, scale, zp, dtype):
+    info = np.iinfo(dtype)
+    q = np.round(np.asarray(x, dtype=np.float32) / scale) + zp
+    return np.clip(q, info.min, info.max).astype(dtype)
+
+
+def state_scale(values, qmax):
+    """Calibrate a state scale from the float reference, with headroom."""
+    max_abs = float(np.max(np.abs(values)))
+    return np.float32(1.25 * max_abs / qmax if max_abs > 0.0 else 1.0 / qmax)
+
+
+def q8_close(label, got, want):
+    tol = max(Q8_ATOL, Q8_RTOL * float(np.max(np.abs(want))))
+    if not np.allclose(got, want, atol=tol):
+        print(f"  FAIL {label}: got {got}, expected {want} (atol {tol:g})")
+        return False
+    return True
+
+
+def make_session(model, threads=0):
+    """Create an ORT inference session with the custom ops library."""
     model_bytes = model.SerializeToString()
     opts = ort.SessionOptions()
+    opts.intra_op_num_threads = threads
     opts.register_custom_ops_library(LIB_PATH)
-    sess = ort.InferenceSession(model_bytes, opts, providers=["CPUExecutionProvider"])
-    return sess.run(None, feeds)
+    return ort.InferenceSession(model_bytes, opts, providers=["CPUExecutionProvider"])
+
+
+def run_ort_session(model, feeds):
+    """Run an ORT inference session with the custom ops library."""
+    return make_session(model).run(None, feeds)
 
 
 def test_slstm(name, tc):
@@ -200,6 +309,240 @@ def test_mlstm(name, tc):
     return ok
 
 
+def test_mlstm_streaming(name, tc):
+    """Stream one token per run, each state output bound to its input.
+
+    The state OrtValues are shared between *_init and the matching output,
+    so the op updates them in place and no state is copied between runs.
+    """
+    B, T, I, H = tc["B"], tc["T"], tc["I"], tc["H"]
+    sess = make_session(make_mlstm_model(B, 1, I, H))
+
+    x = np.array(tc["input"], dtype=np.float32).reshape(B, T, I)
+    W = np.array(tc["W"], dtype=np.float32).reshape(4*H+2, I)
+    b = np.array(tc["b"], dtype=np.float32).reshape(4*H+2)
+    states = {
+        key: ort.OrtValue.ortvalue_from_numpy(np.zeros(shape, dtype=np.float32))
+        for key, shape in [("y", (B, H)), ("C", (B, H*H)), ("n", (B, H)), ("m", (B, 1))]
+    }
+    output = np.zeros((B, T, H), dtype=np.float32)
+
+    for t in range(T):
+        io = sess.io_binding()
+        io.bind_cpu_input("X", np.ascontiguousarray(x[:, t:t+1, :]))
+        io.bind_cpu_input("W", W)
+        io.bind_cpu_input("b", b)
+        io.bind_output("output")
+        for key, value in states.items():
+            io.bind_ortvalue_input(key + "_init", value)
+            io.bind_ortvalue_output(key, value)
+        sess.run_with_iobinding(io)
+        output[:, t, :] = io.copy_outputs_to_cpu()[0][:, 0, :]
+
+    ok = True
+    for label, got, want in [
+        ("y", states["y"].numpy().flatten(), tc["expected_y"]),
+        ("C", states["C"].numpy().flatten(), tc["expected_C"]),
+        ("n", states["n"].numpy().flatten(), tc["expected_n"]),
+        ("m", states["m"].numpy().flatten(), tc["expected_m"]),
+        ("output", output.flatten(), tc.get("expected_output", output.flatten())),
+    ]:
+        want = np.array(want, dtype=np.float32)
+        if not np.allclose(got, want, atol=ATOL):
+            print(f"  FAIL {label}: got {got}, expected {want}")
+            ok = False
+
+    status = "OK" if ok else "FAILED"
+    print(f"[{status}] mLSTM {name} streamed with bound states")
+    return ok
+
+
+def test_batch_threads(cell):
+    """Batched run on a 4-thread intra-op pool vs one stream per run.
+
+    Streams are split across ORT's thread pool; each must see exactly the
+    result of running it alone.
+    """
+    B, T, I, H = 5, 4, 3, 6
+    rng = np.random.default_rng(7)
+    rand = lambda *shape: rng.uniform(-0.5, 0.5, shape).astype(np.float32)
+    if cell == "sLSTM":
+        model, single = make_slstm_model(B, T, I, H), make_slstm_model(1, T, I, H)
+        weights = {"W": rand(4*H, I), "R": rand(4*H, H), "b": rand(4*H)}
+        states = {"y_init": (H,), "c_init": (H,), "n_init": (H,), "m_init": (H,)}
+    else:
+        model, single = make_mlstm_model(B, T, I, H), make_mlstm_model(1, T, I, H)
+        weights = {"W": rand(4*H+2, I), "b": rand(4*H+2)}
+        states = {"y_init": (H,), "C_init": (H*H,), "n_init": (H,), "m_init": (1,)}
+
+    feeds = dict(weights, X=rand(B, T, I))
+    for key, shape in states.items():
+        feeds[key] = np.zeros((B,) + shape, dtype=np.float32)
+    batched = make_session(model, threads=4).run(None, feeds)
+
+    sess = make_session(single, threads=1)
+    ok = True
+    for bt in range(B):
+        one = {k: (v[bt:bt+1] if k == "X" or k in states else v) for k, v in feeds.items()}
+        for i, got in enumerate(sess.run(None, one)):
+            if not np.array_equal(batched[i][bt:bt+1], got):
+                print(f"  FAIL stream {bt} output {i}: batched result differs")
+                ok = False
+
+    status = "OK" if ok else "FAILED"
+    print(f"[{status}] {cell} B={B} on 4 intra-op threads")
+    return ok
+
+
+def test_slstm_preact_rewrite(name, tc):
+    """SLSTM with initializer weights vs the MatMul + Add + SLSTMPreact rewrite."""
+    B, T, I, H = tc["B"], tc["T"], tc["I"], tc["H"]
+    model = make_slstm_model(B, T, I, H)
+    weights = {
+        "W": np.array(tc["W"], dtype=np.float32).reshape(4*H, I),
+        "R": np.array(tc["R"], dtype=np.float32).reshape(4*H, H),
+        "b": np.array(tc["b"], dtype=np.float32).reshape(4*H),
+    }
+    graph = model.graph
+    for key, value in weights.items():
+        graph.initializer.append(onnx.numpy_helper.from_array(value, key))
+    kept = [i for i in graph.input if i.name not in weights]
+    del graph.input[:]
+    graph.input.extend(kept)
+
+    feeds = {
+        "X":      np.array(tc["input"], dtype=np.float32).reshape(B, T, I),
+        "y_init": np.zeros((B, H), dtype=np.float32),
+        "c_init": np.zeros((B, H), dtype=np.float32),
+        "n_init": np.zeros((B, H), dtype=np.float32),
+        "m_init": np.zeros((B, H), dtype=np.float32),
+    }
+    fused = run_ort_session(model, feeds)
+
+    ok = use_preact_slstm(model) == 1
+    ok &= [n.op_type for n in model.graph.node] == ["MatMul", "Add", "SLSTMPreact"]
+    ok &= "W" not in {t.name for t in model.graph.initializer}
+    split = run_ort_session(model, feeds)
+    for label, got, want in zip(["output", "y", "c", "n", "m"], split, fused):
+        if not np.allclose(got, want, atol=ATOL):
+            print(f"  FAIL {label}: got {got.flatten()}, expected {want.flatten()}")
+            ok = False
+
+    # W still exposed as a graph output must survive the rewrite
+    shared = make_slstm_model(B, T, I, H)
+    for key, value in weights.items():
+        shared.graph.initializer.append(onnx.numpy_helper.from_array(value, key))
+    kept = [i for i in shared.graph.input if i.name not in weights]
+    del shared.graph.input[:]
+    shared.graph.input.extend(kept)
+    shared.graph.output.append(
+        helper.make_tensor_value_info("W", TensorProto.FLOAT, [4*H, I]))
+    ok &= use_preact_slstm(shared) == 1
+    ok &= "W" in {t.name for t in shared.graph.initializer}
+
+    status = "OK" if ok else "FAILED"
+    print(f"[{status}] sLSTM {name} as MatMul + Add + SLSTMPreact")
+    return ok
+
+
+def quantize_inputs(tc, gates, recurrent):
+    """INT8 inputs, weights and INT32 bias as in the C INT8 kernel tests."""
+    B, T, I, H = tc["B"], tc["T"], tc["I"], tc["H"]
+    x = np.array(tc["input"], dtype=np.float32).reshape(B, T, I)
+    W = np.array(tc["W"], dtype=np.float32).reshape(gates, I)
+    b = np.array(tc["b"], dtype=np.float32).reshape(gates)
+    x_scale, x_zp = quant_asymmetric(x)
+    W_scale, _ = quant_symmetric(W)
+    feeds = {
+        "X": quantize(x, x_scale, x_zp, np.int8),
+        "x_scale": np.array(x_scale, dtype=np.float32),
+        "x_zero_point": np.array(x_zp, dtype=np.int8),
+        "W": quantize(W, W_scale, 0, np.int8),
+        "W_scale": np.array(W_scale, dtype=np.float32),
+        "b": quantize(b, np.float32(W_scale * x_scale), 0, np.int32),
+    }
+    if recurrent:
+        R = np.array(tc["R"], dtype=np.float32).reshape(gates, H)
+        R_scale, _ = quant_symmetric(R)
+        feeds["R"] = quantize(R, R_scale, 0, np.int8)
+        feeds["R_scale"] = np.array(R_scale, dtype=np.float32)
+    return feeds
+
+
+def test_qlinear_slstm(name, tc):
+    """Run one sLSTM test case through QLinearSLSTM."""
+    B, T, I, H = tc["B"], tc["T"], tc["I"], tc["H"]
+    want_y = np.array(tc["expected_y"], dtype=np.float32)
+    want_c = np.array(tc["expected_c"], dtype=np.float32)
+    want_n = np.array(tc["expected_n"], dtype=np.float32)
+    want_out = np.array(tc.get("expected_output", tc["expected_y"]), dtype=np.float32)
+
+    y_scale = state_scale(want_out, 127)
+    c_scale = state_scale(want_c, 32767)
+    n_scale = state_scale(want_n, 32767)
+    feeds = quantize_inputs(tc, 4*H, recurrent=True)
+    feeds.update({
+        "y_scale": np.array(y_scale, dtype=np.float32),
+        "y_zero_point": np.array(0, dtype=np.int8),
+        "c_scale": np.array(c_scale, dtype=np.float32),
+        "n_scale": np.array(n_scale, dtype=np.float32),
+        "y_init": np.zeros((B, H), dtype=np.int8),
+        "c_init": np.zeros((B, H), dtype=np.int16),
+        "n_init": np.zeros((B, H), dtype=np.int16),
+        "m_init": np.zeros((B, H), dtype=np.float32),
+    })
+
+    output, y, c, n, m = run_ort_session(make_qlinear_slstm_model(B, T, I, H), feeds)
+
+    ok = output.dtype == np.int8 and c.dtype == np.int16 and m.dtype == np.float32
+    ok &= q8_close("y", y.flatten() * y_scale, want_y)
+    ok &= q8_close("output", output.flatten()[-want_out.size:] * y_scale, want_out)
+    ok &= q8_close("c", c.flatten() * c_scale, want_c)
+    ok &= q8_close("n", n.flatten() * n_scale, want_n)
+    ok &= q8_close("m", m.flatten(), np.array(tc["expected_m"], dtype=np.float32))
+
+    status = "OK" if ok else "FAILED"
+    print(f"[{status}] QLinearSLSTM {name}")
+    return ok
+
+
+def test_qlinear_mlstm(name, tc):
+    """Run one mLSTM test case through QLinearMLSTM."""
+    B, T, I, H = tc["B"], tc["T"], tc["I"], tc["H"]
+    want_y = np.array(tc["expected_y"], dtype=np.float32)
+    want_C = np.array(tc["expected_C"], dtype=np.float32)
+    want_n = np.array(tc["expected_n"], dtype=np.float32)
+    want_out = np.array(tc.get("expected_output", tc["expected_y"]), dtype=np.float32)
+
+    y_scale = state_scale(want_out, 127)
+    C_scale = state_scale(want_C, 32767)
+    n_scale = state_scale(want_n, 32767)
+    feeds = quantize_inputs(tc, 4*H+2, recurrent=False)
+    feeds.update({
+        "y_scale": np.array(y_scale, dtype=np.float32),
+        "y_zero_point": np.array(0, dtype=np.int8),
+        "C_scale": np.array(C_scale, dtype=np.float32),
+        "n_scale": np.array(n_scale, dtype=np.float32),
+        "y_init": np.zeros((B, H), dtype=np.int8),
+        "C_init": np.zeros((B, H*H), dtype=np.int16),
+        "n_init": np.zeros((B, H), dtype=np.int16),
+        "m_init": np.zeros((B, 1), dtype=np.float32),
+    })
+
+    output, y, C, n, m = run_ort_session(make_qlinear_mlstm_model(B, T, I, H), feeds)
+
+    ok = output.dtype == np.int8 and C.dtype == np.int16 and m.dtype == np.float32
+    ok &= q8_close("y", y.flatten() * y_scale, want_y)
+    ok &= q8_close("output", output.flatten()[-want_out.size:] * y_scale, want_out)
+    ok &= q8_close("C", C.flatten() * C_scale, want_C)
+    ok &= q8_close("n", n.flatten() * n_scale, want_n)
+    ok &= q8_close("m", m.flatten(), np.array(tc["expected_m"], dtype=np.float32))
+
+    status = "OK" if ok else "FAILED"
+    print(f"[{status}] QLinearMLSTM {name}")
+    return ok
+
+
 def main():
     with open(REF_PATH) as f:
         ref = json.load(f)
@@ -215,6 +558,26 @@ def main():
         if not test_mlstm(name, tc):
             all_ok = False
 
+    for name, tc in ref["mlstm"].items():
+        if not test_mlstm_streaming(name, tc):
+            all_ok = False
+
+    for name, tc in ref["slstm"].items():
+        if not test_slstm_preact_rewrite(name, tc):
+            all_ok = False
+
+    for cell in ("sLSTM", "mLSTM"):
+        if not test_batch_threads(cell):
+            all_ok = False
+
+    for name, tc in ref["slstm"].items():
+        if not test_qlinear_slstm(name, tc):
+            all_ok = False
+
+    for name, tc in ref["mlstm"].items():
+        if not test_qlinear_mlstm(name, tc):
+            all_ok = False
+
     print()
     if all_ok:
         print("All tests passed.")
@@ -4,11 +4,24 @@
 Outputs C header files with model byte arrays, matching the pattern used by
 tflite-micro upstream tests.
 
-These models contain no weights — all tensors are inputs/outputs. The custom
-op registration in the test binary provides the kernel implementation.
+Except for the *_q8_const models these contain no weights — all tensors are
+inputs/outputs. The custom op registration in the test binary provides the kernel implementation.
+
+The INT8 variants carry per-tensor quantization (scale, zero point) on every
+quantized tensor; their headers also hold the reference inputs quantized
+with those parameters. The *_q8_const models store the same quantized
+weights and bias in the model as constant tensors.
+
+The *_stream and *_q8_stream models run one timestep per Invoke with the
+states as variable tensors (is_variable), which the interpreter keeps between
+calls.
 
 Usage: python3 generate_model.py
-Writes: slstm_model_data.h, mlstm_model_data.h
+Writes: slstm_model_data.h, mlstm_model_data.h,
+        slstm_q8_model_data.h, mlstm_q8_model_data.h,
+        slstm_q8_const_model_data.h, mlstm_q8_const_model_data.h,
+        slstm_stream_model_data.h, mlstm_stream_model_data.h,
+        slstm_q8_stream_model_data.h, mlstm_q8_stream_model_data.h
 """
 
 import json
@@ -29,6 +42,9 @@ REF_PATH = os.path.join(ROOT_DIR, "test", "reference_data.json")
 
 class TensorType:
     FLOAT32 = 0
+    INT32 = 2
+    INT16 = 7
+    INT8 = 9
 
 class BuiltinOperator:
     CUSTOM = 32
@@ -40,25 +56,32 @@ class BuiltinOptions:
     NONE = 0
 
 
-def build_tflite_model(op_name, tensor_specs, input_indices, output_indices):
+def build_tflite_model(op_name, tensor_specs, input_indices, output_indices,
+                       constants=None, variables=()):
     """Build a minimal .tflite FlatBuffer with a single custom op.
 
     Args:
         op_name: Custom op name string (e.g. "SLSTM")
-        tensor_specs: list of (name, shape, type) tuples
+        tensor_specs: list of (name, shape, type) or
+            (name, shape, type, (scale, zero_point)) tuples
         input_indices: list of tensor indices that are op inputs
         output_indices: list of tensor indices that are op outputs
+        constants: optional {tensor index: numpy array} stored in the model;
+            these stay op inputs but are not subgraph inputs
+        variables: tensor indices marked is_variable (interpreter-owned
+            state); these too stay op inputs but are not subgraph inputs
 
     Returns:
         bytes: Serialized .tflite FlatBuffer
     """
+    constants = constants or {}
     builder = flatbuffers.Builder(1024)
 
     # --- Strings ---
     op_name_off = builder.CreateString(op_name)
     tensor_name_offs = []
-    for name, _, _ in tensor_specs:
-        tensor_name_offs.append(builder.CreateString(name))
+    for spec in tensor_specs:
+        tensor_name_offs.append(builder.CreateString(spec[0]))
 
     # --- OperatorCodes ---
     # Table OperatorCode { deprecated_builtin_code:byte, custom_code:string,
@@ -77,13 +100,35 @@ def build_tflite_model(op_name, tensor_specs, input_indices, output_indices):
     # --- Tensors ---
     tensor_offs = []
     shape_vecs = []
-    for name, shape, ttype in tensor_specs:
+    quant_offs = []
+    for spec in tensor_specs:
+        shape = spec[1]
         builder.StartVector(4, len(shape), 4)
         for dim in reversed(shape):
             builder.PrependInt32(dim)
         shape_vecs.append(builder.EndVector())
 
-    for i, (name, shape, ttype) in enumerate(tensor_specs):
+    for spec in tensor_specs:
+        if len(spec) < 4:
+            quant_offs.append(None)
+            continue
+        scale, zero_point = spec[3]
+        builder.StartVector(4, 1, 4)
+        builder.PrependFloat32(scale)
+        scale_vec = builder.EndVector()
+        builder.StartVector(8, 1, 8)
+        builder.PrependInt64(zero_point)
+        zp_vec = builder.EndVector()
+        # Table QuantizationParameters { min:[float], max:[float],
+        #     scale:[float], zero_point:[long], details_type, details,
+        #     quantized_dimension:int }
+        builder.StartObject(7)
+        builder.PrependUOffsetTRelativeSlot(2, scale_vec, 0)
+        builder.PrependUOffsetTRelativeSlot(3, zp_vec, 0)
+        quant_offs.append(builder.EndObject())
+
+    for i, spec in enumerate(tensor_specs):
+        ttype = spec[2]
         # Table Tensor { shape:[int], type:TensorType, buffer:uint,
         #                name:string, quantization:QuantizationParameters,
         #                is_variable:bool }
@@ -92,8 +137,9 @@ def build_tflite_model(op_name, tensor_specs, input_indices, output_indices):
         builder.PrependInt8Slot(1, ttype, 0)  # type
         builder.PrependUint32Slot(2, i + 1, 0)  # buffer index (0 = sentinel)
         builder.PrependUOffsetTRelativeSlot(3, tensor_name_offs[i], 0)  # name
-        # quantization: slot 4, skip (default 0)
-        builder.PrependBoolSlot(5, False, False)  # is_variable
+        if quant_offs[i] is not None:
+            builder.PrependUOffsetTRelativeSlot(4, quant_offs[i], 0)  # quantization
+        builder.PrependBoolSlot(5, i in variables, False)  # is_variable
         tensor_offs.append(builder.EndObject())
 
     builder.StartVector(4, len(tensor_offs), 4)
@@ -131,8 +177,10 @@ def build_tflite_model(op_name, tensor_specs, input_indices, output_indices):
 
     # --- SubGraph ---
     # SubGraph inputs/outputs
-    builder.StartVector(4, len(input_indices), 4)
-    for idx in reversed(input_indices):
+    sg_input_indices = [i for i in input_indices
+                        if i not in constants and i not in variables]
+    builder.StartVector(4, len(sg_input_indices), 4)
+    for idx in reversed(sg_input_indices):
         builder.PrependInt32(idx)
     sg_inputs = builder.EndVector()
 
@@ -157,11 +205,21 @@ def build_tflite_model(op_name, tensor_specs, input_indices, output_indices):
     builder.PrependUOffsetTRelative(subgraph_off)
     subgraphs_vec = builder.EndVector()
 
-    # --- Buffers (empty — all data provided at runtime) ---
+    # --- Buffers (empty — data provided at runtime — unless constant) ---
+    data_vecs = {}
+    for idx, values in constants.items():
+        data = np.ascontiguousarray(values).astype(values.dtype.newbyteorder("<")).tobytes()
+        builder.StartVector(1, len(data), 16)
+        for byte in reversed(data):
+            builder.PrependUint8(byte)
+        data_vecs[idx + 1] = builder.EndVector()
+
     buffer_offs = []
     # Buffer 0: sentinel empty buffer
-    for _ in range(len(tensor_specs) + 1):
+    for i in range(len(tensor_specs) + 1):
         builder.StartObject(1)  # Table Buffer { data:[ubyte] }
+        if i in data_vecs:
+            builder.PrependUOffsetTRelativeSlot(0, data_vecs[i], 0)
         buffer_offs.append(builder.EndObject())
 
     builder.StartVector(4, len(buffer_offs), 4)
@@ -187,12 +245,18 @@ def build_tflite_model(op_name, tensor_specs, input_indices, output_indices):
     return bytes(builder.Output())
 
 
-def model_to_c_header(model_bytes, var_name, header_guard):
-    """Convert model bytes to a C header with an aligned byte array."""
+def model_to_c_header(model_bytes, var_name, header_guard, arrays=()):
+    """Convert model bytes to a C header with an aligned byte array.
+
+    arrays: optional (c_type, name, values) data arrays appended after the
+    model (e.g. quantized reference inputs).
+    """
     lines = []
     lines.append(f"/* Auto-generated — do not edit. */\n")
     lines.append(f"#ifndef {header_guard}")
     lines.append(f"#define {header_guard}\n")
+    if arrays:
+        lines.append("#include <cstdint>\n")
     lines.append(f"alignas(16) const unsigned char {var_name}[] = {{")
 
     for i in range(0, len(model_bytes), 12):
@@ -202,12 +266,47 @@ def model_to_c_header(model_bytes, var_name, header_guard):
 
     lines.append(f"}};")
     lines.append(f"const unsigned int {var_name}_len = {len(model_bytes)};\n")
+    for c_type, name, values in arrays:
+        vals = ", ".join(str(int(v)) for v in np.asarray(values).flatten())
+        lines.append(f"const {c_type} {name}[] = {{{vals}}};")
+    if arrays:
+        lines.append("")
     lines.append(f"#endif  /* {header_guard} */\n")
     return "\n".join(lines)
 
 
-def generate_slstm_model(B, T, I, H):
-    """Generate .tflite model for sLSTM custom op."""
+# ---------------------------------------------------------------------------
+# INT8 quantization — mirrors xlstm_quant.c and the C INT8 kernel tests
+# ---------------------------------------------------------------------------
+
+Y_SCALE = 1.0 / 128.0       # int8 y / output, zero point 0
+STATE_SCALE = 1.0 / 1024.0  # int16 c|C and n (symmetric)
+
+
+def quant_symmetric(x):
+    max_abs = float(np.max(np.abs(x)))
+    return (max_abs / 127.0 if max_abs > 0.0 else 1.0), 0
+
+
+def quant_asymmetric(x):
+    lo, hi = min(float(np.min(x)), 0.0), max(float(np.max(x)), 0.0)
+    if hi - lo < 1e-10:
+        return 1.0 / 255.0, 0
+    scale = (hi - lo) / 255.0
+    return scale, int(np.clip(np.round(-128.0 - lo / scale), -128, 127))
+
+
+def quantize(x, qp, dtype):
+    scale, zero_point = qp
+    info = np.iinfo(dtype)
+    q = np.round(np.asarray(x, dtype=np.float64) / np.float32(scale)) + zero_point
+    return np.clip(q, info.min, info.max).astype(dtype)
+
+
+def generate_slstm_model(B, T, I, H, variable_states=False):
+    """Generate .tflite model for sLSTM custom op.
+
+    variable_states makes y/c/n/m variable tensors instead of inputs."""
     tensors = [
         ("input",  [B, T, I],  TensorType.FLOAT32),  # 0
         ("W",      [4*H, I],   TensorType.FLOAT32),  # 1
@@ -221,11 +320,15 @@ def generate_slstm_model(B, T, I, H):
     ]
     input_indices = list(range(8))
     output_indices = [8]
-    return build_tflite_model("SLSTM", tensors, input_indices, output_indices)
+    variables = range(4, 8) if variable_states else ()
+    return build_tflite_model("SLSTM", tensors, input_indices, output_indices,
+                              variables=variables)
+
 
+def generate_mlstm_model(B, T, I, H, variable_states=False):
+    """Generate .tflite model for mLSTM custom op.
 
-def generate_mlstm_model(B, T, I, H):
-    """Generate .tflite model for mLSTM custom op."""
+    variable_states makes y/C/n/m variable tensors instead of inputs."""
     tensors = [
         ("input",  [B, T, I],    TensorType.FLOAT32),  # 0
         ("W",      [4*H+2, I],   TensorType.FLOAT32),  # 1
@@ -238,7 +341,91 @@ def generate_mlstm_model(B, T, I, H):
     ]
     input_indices = list(range(7))
     output_indices = [7]
-    return build_tflite_model("MLSTM", tensors, input_indices, output_indices)
+    variables = range(3, 7) if variable_states else ()
+    return build_tflite_model("MLSTM", tensors, input_indices, output_indices,
+                              variables=variables)
+
+
+def generate_slstm_q8_model(tc, const_weights=False, stream=False):
+    """INT8 sLSTM model and quantized inputs for one reference case.
+
+    const_weights stores W, R and b in the model (constant tensors).
+    stream builds a T=1 model with y/c/n/m as variable tensors; the whole
+    reference input is still quantized (one timestep per Invoke)."""
+    B, I, H = tc["B"], tc["I"], tc["H"]
+    T = 1 if stream else tc["T"]
+    x_qp = quant_asymmetric(np.array(tc["input"]))
+    W_qp = quant_symmetric(np.array(tc["W"]))
+    R_qp = quant_symmetric(np.array(tc["R"]))
+    b_qp = (np.float32(W_qp[0]) * np.float32(x_qp[0]), 0)
+    y_qp, state_qp = (Y_SCALE, 0), (STATE_SCALE, 0)
+    tensors = [
+        ("input",  [B, T, I],  TensorType.INT8,    x_qp),      # 0
+        ("W",      [4*H, I],   TensorType.INT8,    W_qp),      # 1
+        ("R",      [4*H, H],   TensorType.INT8,    R_qp),      # 2
+        ("b",      [4*H],      TensorType.INT32,   b_qp),      # 3
+        ("y",      [B, H],     TensorType.INT8,    y_qp),      # 4
+        ("c",      [B, H],     TensorType.INT16,   state_qp),  # 5
+        ("n",      [B, H],     TensorType.INT16,   state_qp),  # 6
+        ("m",      [B, H],     TensorType.FLOAT32),            # 7
+        ("output", [B, T, H],  TensorType.INT8,    y_qp),      # 8
+    ]
+    W = quantize(tc["W"], W_qp, np.int8)
+    R = quantize(tc["R"], R_qp, np.int8)
+    b = quantize(tc["b"], b_qp, np.int32)
+    if const_weights:
+        model = build_tflite_model("SLSTM", tensors, list(range(8)), [8],
+                                   constants={1: W, 2: R, 3: b})
+        return model, []
+    prefix = "slstm_q8_stream" if stream else "slstm_q8"
+    model = build_tflite_model("SLSTM", tensors, list(range(8)), [8],
+                               variables=range(4, 8) if stream else ())
+    arrays = [
+        ("int8_t", f"{prefix}_input", quantize(tc["input"], x_qp, np.int8)),
+        ("int8_t", f"{prefix}_W", W),
+        ("int8_t", f"{prefix}_R", R),
+        ("int32_t", f"{prefix}_b", b),
+    ]
+    return model, arrays
+
+
+def generate_mlstm_q8_model(tc, const_weights=False, stream=False):
+    """INT8 mLSTM model and quantized inputs for one reference case.
+
+    const_weights stores W and b in the model (constant tensors).
+    stream builds a T=1 model with y/C/n/m as variable tensors; the whole
+    reference input is still quantized (one timestep per Invoke)."""
+    B, I, H = tc["B"], tc["I"], tc["H"]
+    T = 1 if stream else tc["T"]
+    x_qp = quant_asymmetric(np.array(tc["input"]))
+    W_qp = quant_symmetric(np.array(tc["W"]))
+    b_qp = (np.float32(W_qp[0]) * np.float32(x_qp[0]), 0)
+    y_qp, state_qp = (Y_SCALE, 0), (STATE_SCALE, 0)
+    tensors = [
+        ("input",  [B, T, I],    TensorType.INT8,    x_qp),      # 0
+        ("W",      [4*H+2, I],   TensorType.INT8,    W_qp),      # 1
+        ("b",      [4*H+2],      TensorType.INT32,   b_qp),      # 2
+        ("y",      [B, H],       TensorType.INT8,    y_qp),      # 3
+        ("C",      [B, H*H],     TensorType.INT16,   state_qp),  # 4
+        ("n",      [B, H],       TensorType.INT16,   state_qp),  # 5
+        ("m",      [B, 1],       TensorType.FLOAT32),            # 6
+        ("output", [B, T, H],    TensorType.INT8,    y_qp),      # 7
+    ]
+    W = quantize(tc["W"], W_qp, np.int8)
+    b = quantize(tc["b"], b_qp, np.int32)
+    if const_weights:
+        model = build_tflite_model("MLSTM", tensors, list(range(7)), [7],
+                                   constants={1: W, 2: b})
+        return model, []
+    prefix = "mlstm_q8_stream" if stream else "mlstm_q8"
+    model = build_tflite_model("MLSTM", tensors, list(range(7)), [7],
+                               variables=range(3, 7) if stream else ())
+    arrays = [
+        ("int8_t", f"{prefix}_input", quantize(tc["input"], x_qp, np.int8)),
+        ("int8_t", f"{prefix}_W", W),
+        ("int32_t", f"{prefix}_b", b),
+    ]
+    return model, arrays
 
 
 def main():
@@ -262,6 +449,30 @@ def main():
         f.write(header)
     print(f"Wrote {path} ({len(mlstm_bytes)} bytes)")
 
+    # Streaming: Test 2 shapes, one timestep per Invoke, states as variables
+    st2, mt2 = ref["slstm"]["test2"], ref["mlstm"]["test2"]
+    slstm_stream = generate_slstm_model(st2["B"], 1, st2["I"], st2["H"],
+                                        variable_states=True)
+    mlstm_stream = generate_mlstm_model(mt2["B"], 1, mt2["I"], mt2["H"],
+                                        variable_states=True)
+
+    for name, (model, arrays) in [
+        ("slstm_q8", generate_slstm_q8_model(st1)),
+        ("mlstm_q8", generate_mlstm_q8_model(mt1)),
+        ("slstm_q8_const", generate_slstm_q8_model(st1, const_weights=True)),
+        ("mlstm_q8_const", generate_mlstm_q8_model(mt1, const_weights=True)),
+        ("slstm_stream", (slstm_stream, [])),
+        ("mlstm_stream", (mlstm_stream, [])),
+        ("slstm_q8_stream", generate_slstm_q8_model(st2, stream=True)),
+        ("mlstm_q8_stream", generate_mlstm_q8_model(mt2, stream=True)),
+    ]:
+        header = model_to_c_header(model, f"{name}_model_data",
+                                   f"{name.upper()}_MODEL_DATA_H_", arrays)
+        path = os.path.join(SCRIPT_DIR, f"{name}_model_data.h")
+        with open(path, "w") as f:
+            f.write(header)
+        print(f"Wrote {path} ({len(model)} bytes)")
+
 
 if __name__ == "__main__":
     main()
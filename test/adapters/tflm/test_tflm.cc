@@ -18,6 +18,14 @@
 
 #include "slstm_model_data.h"
 #include "mlstm_model_data.h"
+#include "slstm_q8_model_data.h"
+#include "mlstm_q8_model_data.h"
+#include "slstm_q8_const_model_data.h"
+#include "mlstm_q8_const_model_data.h"
+#include "slstm_stream_model_data.h"
+#include "mlstm_stream_model_data.h"
+#include "slstm_q8_stream_model_data.h"
+#include "mlstm_q8_stream_model_data.h"
 #include "reference_data.h"
 
 namespace {
@@ -49,6 +57,36 @@ void ZeroTensor(TfLiteTensor* tensor, int count) {
     std::memset(tensor->data.f, 0, count * sizeof(float));
 }
 
+// INT8 models: raw fill, real zero (the tensor's zero point) and dequantize
+// with the tensor's own per-tensor quantization.
+void FillRaw(TfLiteTensor* tensor, const void* data, size_t bytes) {
+    std::memcpy(tensor->data.raw, data, bytes);
+}
+
+void ZeroQuantized(TfLiteTensor* tensor, int count) {
+    for (int i = 0; i < count; i++) {
+        if (tensor->type == kTfLiteInt8) {
+            tensor->data.int8[i] = (int8_t)tensor->params.zero_point;
+        } else if (tensor->type == kTfLiteInt16) {
+            tensor->data.i16[i] = (int16_t)tensor->params.zero_point;
+        } else {
+            tensor->data.f[i] = 0.0f;
+        }
+    }
+}
+
+void Dequantize(const TfLiteTensor* tensor, float* out, int count) {
+    for (int i = 0; i < count; i++) {
+        int32_t q = tensor->type == kTfLiteInt8 ? tensor->data.int8[i]
+                                                : tensor->data.i16[i];
+        out[i] = tensor->params.scale * (float)(q - tensor->params.zero_point);
+    }
+}
+
+// INT8 outputs are checked against the float reference: quantization of
+// x, W, R and y (1/128 steps) bounds the error well below this.
+constexpr float kInt8Tolerance = 0.05f;
+
 // ---------------------------------------------------------------------------
 // sLSTM test: single timestep, zero initial state (Test 1)
 // ---------------------------------------------------------------------------
@@ -150,6 +188,414 @@ bool TestMLstmSingleTimestep() {
     return ok;
 }
 
+// ---------------------------------------------------------------------------
+// INT8 sLSTM: Test 1 quantized — int8 x/W/R/y, int32 b, int16 c/n, float m
+// ---------------------------------------------------------------------------
+bool TestSLstmInt8SingleTimestep() {
+    const tflite::Model* model = tflite::GetModel(slstm_q8_model_data);
+    tflite::MicroMutableOpResolver<1> resolver;
+    TFLMRegistration slstm_reg = tflite::Register_SLSTM();
+    resolver.AddCustom("SLSTM", &slstm_reg);
+
+    tflite::MicroInterpreter interpreter(model, resolver, arena, kArenaSize);
+    if (interpreter.AllocateTensors() != kTfLiteOk) {
+        printf("  AllocateTensors failed\n");
+        return false;
+    }
+
+    const int H = 2;
+    bool ok = interpreter.input(0)->type == kTfLiteInt8 &&
+              interpreter.input(3)->type == kTfLiteInt32 &&
+              interpreter.input(5)->type == kTfLiteInt16 &&
+              interpreter.output(0)->type == kTfLiteInt8;
+    if (!ok) printf("  unexpected tensor types\n");
+
+    FillRaw(interpreter.input(0), slstm_q8_input, sizeof(slstm_q8_input));
+    FillRaw(interpreter.input(1), slstm_q8_W, sizeof(slstm_q8_W));
+    FillRaw(interpreter.input(2), slstm_q8_R, sizeof(slstm_q8_R));
+    FillRaw(interpreter.input(3), slstm_q8_b, sizeof(slstm_q8_b));
+    for (int i = 4; i < 8; i++) ZeroQuantized(interpreter.input(i), H);
+
+    if (interpreter.Invoke() != kTfLiteOk) {
+        printf("  Invoke failed\n");
+        return false;
+    }
+
+    float output[H], y[H], c[H], n[H];
+    Dequantize(interpreter.output(0), output, H);
+    Dequantize(interpreter.input(4), y, H);
+    Dequantize(interpreter.input(5), c, H);
+    Dequantize(interpreter.input(6), n, H);
+    ok &= ExpectNear("output", kTest1_expected_y, output, H, kInt8Tolerance);
+    ok &= ExpectNear("y", kTest1_expected_y, y, H, kInt8Tolerance);
+    ok &= ExpectNear("c", kTest1_expected_c, c, H, kInt8Tolerance);
+    ok &= ExpectNear("n", kTest1_expected_n, n, H, kInt8Tolerance);
+    ok &= ExpectNear("m", kTest1_expected_m, interpreter.input(7)->data.f, H,
+                     kInt8Tolerance);
+    return ok;
+}
+
+// ---------------------------------------------------------------------------
+// INT8 mLSTM: Test 1 quantized — int8 x/W/y, int32 b, int16 C/n, float m
+// ---------------------------------------------------------------------------
+bool TestMLstmInt8SingleTimestep() {
+    const tflite::Model* model = tflite::GetModel(mlstm_q8_model_data);
+    tflite::MicroMutableOpResolver<1> resolver;
+    TFLMRegistration mlstm_reg = tflite::Register_MLSTM();
+    resolver.AddCustom("MLSTM", &mlstm_reg);
+
+    tflite::MicroInterpreter interpreter(model, resolver, arena, kArenaSize);
+    if (interpreter.AllocateTensors() != kTfLiteOk) {
+        printf("  AllocateTensors failed\n");
+        return false;
+    }
+
+    const int H = 2;
+    bool ok = interpreter.input(0)->type == kTfLiteInt8 &&
+              interpreter.input(2)->type == kTfLiteInt32 &&
+              interpreter.input(4)->type == kTfLiteInt16 &&
+              interpreter.output(0)->type == kTfLiteInt8;
+    if (!ok) printf("  unexpected tensor types\n");
+
+    FillRaw(interpreter.input(0), mlstm_q8_input, sizeof(mlstm_q8_input));
+    FillRaw(interpreter.input(1), mlstm_q8_W, sizeof(mlstm_q8_W));
+    FillRaw(interpreter.input(2), mlstm_q8_b, sizeof(mlstm_q8_b));
+    ZeroQuantized(interpreter.input(3), H);
+    ZeroQuantized(interpreter.input(4), H * H);
+    ZeroQuantized(interpreter.input(5), H);
+    ZeroQuantized(interpreter.input(6), 1);
+
+    if (interpreter.Invoke() != kTfLiteOk) {
+        printf("  Invoke failed\n");
+        return false;
+    }
+
+    float output[H], y[H], C[H * H], n[H];
+    Dequantize(interpreter.output(0), output, H);
+    Dequantize(interpreter.input(3), y, H);
+    Dequantize(interpreter.input(4), C, H * H);
+    Dequantize(interpreter.input(5), n, H);
+    ok &= ExpectNear("output", kMTest1_expected_y, output, H, kInt8Tolerance);
+    ok &= ExpectNear("y", kMTest1_expected_y, y, H, kInt8Tolerance);
+    ok &= ExpectNear("C", kMTest1_expected_C, C, H * H, kInt8Tolerance);
+    ok &= ExpectNear("n", kMTest1_expected_n, n, H, kInt8Tolerance);
+    ok &= ExpectNear("m", kMTest1_expected_m, interpreter.input(6)->data.f, 1,
+                     kInt8Tolerance);
+    return ok;
+}
+
+// ---------------------------------------------------------------------------
+// INT8 with constant weights: W/R/b live in the model, so they are not
+// interpreter inputs. With XLSTM_TFLM_PACK_WEIGHTS they are packed in Prepare;
+// either way the result must match the runtime-weight model bit for bit.
+// ---------------------------------------------------------------------------
+bool TestSLstmInt8ConstWeights() {
+    TFLMRegistration slstm_reg = tflite::Register_SLSTM();
+    const int H = 2;
+    int8_t expected_y[H];
+    int16_t expected_c[H];
+    {
+        const tflite::Model* model = tflite::GetModel(slstm_q8_model_data);
+        tflite::MicroMutableOpResolver<1> resolver;
+        resolver.AddCustom("SLSTM", &slstm_reg);
+        tflite::MicroInterpreter interpreter(model, resolver, arena, kArenaSize);
+        if (interpreter.AllocateTensors() != kTfLiteOk) return false;
+        FillRaw(interpreter.input(0), slstm_q8_input, sizeof(slstm_q8_input));
+        FillRaw(interpreter.input(1), slstm_q8_W, sizeof(slstm_q8_W));
+        FillRaw(interpreter.input(2), slstm_q8_R, sizeof(slstm_q8_R));
+        FillRaw(interpreter.input(3), slstm_q8_b, sizeof(slstm_q8_b));
+        for (int i = 4; i < 8; i++) ZeroQuantized(interpreter.input(i), H);
+        if (interpreter.Invoke() != kTfLiteOk) return false;
+        memcpy(expected_y, interpreter.output(0)->data.int8, sizeof(expected_y));
+        memcpy(expected_c, interpreter.input(5)->data.i16, sizeof(expected_c));
+    }
+
+    const tflite::Model* model = tflite::GetModel(slstm_q8_const_model_data);
+    tflite::MicroMutableOpResolver<1> resolver;
+    resolver.AddCustom("SLSTM", &slstm_reg);
+    tflite::MicroInterpreter interpreter(model, resolver, arena, kArenaSize);
+    if (interpreter.AllocateTensors() != kTfLiteOk) {
+        printf("  AllocateTensors failed\n");
+        return false;
+    }
+    if (interpreter.inputs_size() != 5) {
+        printf("  expected 5 runtime inputs, got %d\n", (int)interpreter.inputs_size());
+        return false;
+    }
+
+    /* inputs: x, y, c, n, m */
+    FillRaw(interpreter.input(0), slstm_q8_input, sizeof(slstm_q8_input));
+    for (int i = 1; i < 5; i++) ZeroQuantized(interpreter.input(i), H);
+    if (interpreter.Invoke() != kTfLiteOk) {
+        printf("  Invoke failed\n");
+        return false;
+    }
+
+    bool ok = memcmp(expected_y, interpreter.output(0)->data.int8, sizeof(expected_y)) == 0 &&
+              memcmp(expected_c, interpreter.input(2)->data.i16, sizeof(expected_c)) == 0;
+    if (!ok) printf("  constant-weight output differs from runtime weights\n");
+    return ok;
+}
+
+bool TestMLstmInt8ConstWeights() {
+    TFLMRegistration mlstm_reg = tflite::Register_MLSTM();
+    const int H = 2;
+    int8_t expected_y[H];
+    int16_t expected_C[H * H];
+    {
+        const tflite::Model* model = tflite::GetModel(mlstm_q8_model_data);
+        tflite::MicroMutableOpResolver<1> resolver;
+        resolver.AddCustom("MLSTM", &mlstm_reg);
+        tflite::MicroInterpreter interpreter(model, resolver, arena, kArenaSize);
+        if (interpreter.AllocateTensors() != kTfLiteOk) return false;
+        FillRaw(interpreter.input(0), mlstm_q8_input, sizeof(mlstm_q8_input));
+        FillRaw(interpreter.input(1), mlstm_q8_W, sizeof(mlstm_q8_W));
+        FillRaw(interpreter.input(2), mlstm_q8_b, sizeof(mlstm_q8_b));
+        ZeroQuantized(interpreter.input(3), H);
+        ZeroQuantized(interpreter.input(4), H * H);
+        ZeroQuantized(interpreter.input(5), H);
+        ZeroQuantized(interpreter.input(6), 1);
+        if (interpreter.Invoke() != kTfLiteOk) return false;
+        memcpy(expected_y, interpreter.output(0)->data.int8, sizeof(expected_y));
+        memcpy(expected_C, interpreter.input(4)->data.i16, sizeof(expected_C));
+    }
+
+    const tflite::Model* model = tflite::GetModel(mlstm_q8_const_model_data);
+    tflite::MicroMutableOpResolver<1> resolver;
+    resolver.AddCustom("MLSTM", &mlstm_reg);
+    tflite::MicroInterpreter interpreter(model, resolver, arena, kArenaSize);
+    if (interpreter.AllocateTensors() != kTfLiteOk) {
+        printf("  AllocateTensors failed\n");
+        return false;
+    }
+    if (interpreter.inputs_size() != 5) {
+        printf("  expected 5 runtime inputs, got %d\n", (int)interpreter.inputs_size());
+        return false;
+    }
+
+    /* inputs: x, y, C, n, m */
+    FillRaw(interpreter.input(0), mlstm_q8_input, sizeof(mlstm_q8_input));
+    ZeroQuantized(interpreter.input(1), H);
+    ZeroQuantized(interpreter.input(2), H * H);
+    ZeroQuantized(interpreter.input(3), H);
+    ZeroQuantized(interpreter.input(4), 1);
+    if (interpreter.Invoke() != kTfLiteOk) {
+        printf("  Invoke failed\n");
+        return false;
+    }
+
+    bool ok = memcmp(expected_y, interpreter.output(0)->data.int8, sizeof(expected_y)) == 0 &&
+              memcmp(expected_C, interpreter.input(2)->data.i16, sizeof(expected_C)) == 0;
+    if (!ok) printf("  constant-weight output differs from runtime weights\n");
+    return ok;
+}
+
+// ---------------------------------------------------------------------------
+// Streaming: Test 2 fed one timestep per Invoke. The states are variable
+// tensors, so the application never touches them; the per-call outputs must
+// match the T=3 reference sequence, and ResetVariableTensors() restarts it.
+// ---------------------------------------------------------------------------
+bool TestSLstmStreamingVariableState() {
+    const tflite::Model* model = tflite::GetModel(slstm_stream_model_data);
+    tflite::MicroMutableOpResolver<1> resolver;
+    TFLMRegistration slstm_reg = tflite::Register_SLSTM();
+    resolver.AddCustom("SLSTM", &slstm_reg);
+
+    tflite::MicroInterpreter interpreter(model, resolver, arena, kArenaSize);
+    if (interpreter.AllocateTensors() != kTfLiteOk) {
+        printf("  AllocateTensors failed\n");
+        return false;
+    }
+    if (interpreter.inputs_size() != 4) {
+        printf("  expected 4 graph inputs (x, W, R, b), got %d\n",
+               (int)interpreter.inputs_size());
+        return false;
+    }
+
+    const int I = 2, H = 2, T = 3;
+    FillTensor(interpreter.input(1), kTest1_W, 4 * H * I);
+    FillTensor(interpreter.input(2), kTest1_R, 4 * H * H);
+    FillTensor(interpreter.input(3), kTest1_b, 4 * H);
+    interpreter.ResetVariableTensors();
+
+    bool ok = true;
+    for (int pass = 0; pass < 2; pass++) {
+        for (int t = 0; t < T; t++) {
+            FillTensor(interpreter.input(0), kTest2_input + t * I, I);
+            if (interpreter.Invoke() != kTfLiteOk) {
+                printf("  Invoke failed\n");
+                return false;
+            }
+            ok &= ExpectNear("output", kTest2_expected_output + t * H,
+                             interpreter.output(0)->data.f, H, 1e-5f);
+        }
+        interpreter.ResetVariableTensors();
+    }
+    return ok;
+}
+
+bool TestMLstmStreamingVariableState() {
+    const tflite::Model* model = tflite::GetModel(mlstm_stream_model_data);
+    tflite::MicroMutableOpResolver<1> resolver;
+    TFLMRegistration mlstm_reg = tflite::Register_MLSTM();
+    resolver.AddCustom("MLSTM", &mlstm_reg);
+
+    tflite::MicroInterpreter interpreter(model, resolver, arena, kArenaSize);
+    if (interpreter.AllocateTensors() != kTfLiteOk) {
+        printf("  AllocateTensors failed\n");
+        return false;
+    }
+    if (interpreter.inputs_size() != 3) {
+        printf("  expected 3 graph inputs (x, W, b), got %d\n",
+               (int)interpreter.inputs_size());
+        return false;
+    }
+
+    const int I = 3, H = 2, T = 3;
+    FillTensor(interpreter.input(1), kMTest1_W, (4 * H + 2) * I);
+    FillTensor(interpreter.input(2), kMTest1_b, 4 * H + 2);
+    interpreter.ResetVariableTensors();
+
+    bool ok = true;
+    for (int pass = 0; pass < 2; pass++) {
+        for (int t = 0; t < T; t++) {
+            FillTensor(interpreter.input(0), kMTest2_input + t * I, I);
+            if (interpreter.Invoke() != kTfLiteOk) {
+                printf("  Invoke failed\n");
+                return false;
+            }
+            ok &= ExpectNear("output", kMTest2_expected_output + t * H,
+                             interpreter.output(0)->data.f, H, 1e-5f);
+        }
+        interpreter.ResetVariableTensors();
+    }
+    return ok;
+}
+
+// ---------------------------------------------------------------------------
+// INT8 streaming: the same with int8 y, int16 c|C/n and float m as variable
+// tensors. Every step must track the float reference, ResetVariableTensors()
+// must put y back to its zero point (real 0) and c/n/m to 0, and the replay
+// after it must repeat the first pass bit for bit.
+// ---------------------------------------------------------------------------
+bool ExpectResetState(tflite::MicroInterpreter* interpreter, int first,
+                      int8_t y_zero_point, const int* counts) {
+    const TfLiteEvalTensor* y = interpreter->GetTensor(first);
+    bool ok = true;
+    for (int i = 0; i < counts[0]; i++) ok &= y->data.int8[i] == y_zero_point;
+    for (int k = 1; k <= 2; k++) {
+        const TfLiteEvalTensor* state = interpreter->GetTensor(first + k);
+        for (int i = 0; i < counts[k]; i++) ok &= state->data.i16[i] == 0;
+    }
+    const TfLiteEvalTensor* m = interpreter->GetTensor(first + 3);
+    for (int i = 0; i < counts[3]; i++) ok &= m->data.f[i] == 0.0f;
+    if (!ok) printf("  state not reset to real zero\n");
+    return ok;
+}
+
+bool TestSLstmInt8StreamingVariableState() {
+    const tflite::Model* model = tflite::GetModel(slstm_q8_stream_model_data);
+    tflite::MicroMutableOpResolver<1> resolver;
+    TFLMRegistration slstm_reg = tflite::Register_SLSTM();
+    resolver.AddCustom("SLSTM", &slstm_reg);
+
+    tflite::MicroInterpreter interpreter(model, resolver, arena, kArenaSize);
+    if (interpreter.AllocateTensors() != kTfLiteOk) {
+        printf("  AllocateTensors failed\n");
+        return false;
+    }
+    if (interpreter.inputs_size() != 4) {
+        printf("  expected 4 graph inputs (x, W, R, b), got %d\n",
+               (int)interpreter.inputs_size());
+        return false;
+    }
+
+    const int I = 2, H = 2, T = 3;
+    const int counts[4] = {H, H, H, H};
+    const int8_t y_zp = (int8_t)interpreter.output(0)->params.zero_point;
+    FillRaw(interpreter.input(1), slstm_q8_stream_W, sizeof(slstm_q8_stream_W));
+    FillRaw(interpreter.input(2), slstm_q8_stream_R, sizeof(slstm_q8_stream_R));
+    FillRaw(interpreter.input(3), slstm_q8_stream_b, sizeof(slstm_q8_stream_b));
+    interpreter.ResetVariableTensors();
+
+    bool ok = true;
+    int8_t first_pass[T * H];
+    for (int pass = 0; pass < 2; pass++) {
+        for (int t = 0; t < T; t++) {
+            FillRaw(interpreter.input(0), slstm_q8_stream_input + t * I, I);
+            if (interpreter.Invoke() != kTfLiteOk) {
+                printf("  Invoke failed\n");
+                return false;
+            }
+            float output[H];
+            Dequantize(interpreter.output(0), output, H);
+            ok &= ExpectNear("output", kTest2_expected_output + t * H,
+                             output, H, kInt8Tolerance);
+            if (pass == 0) {
+                memcpy(first_pass + t * H, interpreter.output(0)->data.int8, H);
+            } else if (memcmp(first_pass + t * H,
+                              interpreter.output(0)->data.int8, H) != 0) {
+                printf("  replay after reset differs at t=%d\n", t);
+                ok = false;
+            }
+        }
+        interpreter.ResetVariableTensors();
+        ok &= ExpectResetState(&interpreter, 4, y_zp, counts);
+    }
+    return ok;
+}
+
+bool TestMLstmInt8StreamingVariableState() {
+    const tflite::Model* model = tflite::GetModel(mlstm_q8_stream_model_data);
+    tflite::MicroMutableOpResolver<1> resolver;
+    TFLMRegistration mlstm_reg = tflite::Register_MLSTM();
+    resolver.AddCustom("MLSTM", &mlstm_reg);
+
+    tflite::MicroInterpreter interpreter(model, resolver, arena, kArenaSize);
+    if (interpreter.AllocateTensors() != kTfLiteOk) {
+        printf("  AllocateTensors failed\n");
+        return false;
+    }
+    if (interpreter.inputs_size() != 3) {
+        printf("  expected 3 graph inputs (x, W, b), got %d\n",
+               (int)interpreter.inputs_size());
+        return false;
+    }
+
+    const int I = 3, H = 2, T = 3;
+    const int counts[4] = {H, H * H, H, 1};
+    const int8_t y_zp = (int8_t)interpreter.output(0)->params.zero_point;
+    FillRaw(interpreter.input(1), mlstm_q8_stream_W, sizeof(mlstm_q8_stream_W));
+    FillRaw(interpreter.input(2), mlstm_q8_stream_b, sizeof(mlstm_q8_stream_b));
+    interpreter.ResetVariableTensors();
+
+    bool ok = true;
+    int8_t first_pass[T * H];
+    for (int pass = 0; pass < 2; pass++) {
+        for (int t = 0; t < T; t++) {
+            FillRaw(interpreter.input(0), mlstm_q8_stream_input + t * I, I);
+            if (interpreter.Invoke() != kTfLiteOk) {
+                printf("  Invoke failed\n");
+                return false;
+            }
+            float output[H];
+            Dequantize(interpreter.output(0), output, H);
+            ok &= ExpectNear("output", kMTest2_expected_output + t * H,
+                             output, H, kInt8Tolerance);
+            if (pass == 0) {
+                memcpy(first_pass + t * H, interpreter.output(0)->data.int8, H);
+            } else if (memcmp(first_pass + t * H,
+                              interpreter.output(0)->data.int8, H) != 0) {
+                printf("  replay after reset differs at t=%d\n", t);
+                ok = false;
+            }
+        }
+        interpreter.ResetVariableTensors();
+        ok &= ExpectResetState(&interpreter, 3, y_zp, counts);
+    }
+    return ok;
+}
+
 }  // namespace
 
 #define RUN_TEST(fn)                                      \
@@ -169,6 +615,14 @@ int main() {
 
     RUN_TEST(TestSLstmSingleTimestep);
     RUN_TEST(TestMLstmSingleTimestep);
+    RUN_TEST(TestSLstmInt8SingleTimestep);
+    RUN_TEST(TestMLstmInt8SingleTimestep);
+    RUN_TEST(TestSLstmInt8ConstWeights);
+    RUN_TEST(TestMLstmInt8ConstWeights);
+    RUN_TEST(TestSLstmStreamingVariableState);
+    RUN_TEST(TestMLstmStreamingVariableState);
+    RUN_TEST(TestSLstmInt8StreamingVariableState);
+    RUN_TEST(TestMLstmInt8StreamingVariableState);
 
     printf("\n%d/%d tests passed.\n", g_tests_passed, g_tests_run);
     return (g_tests_passed == g_tests_run) ? 0 : 1;
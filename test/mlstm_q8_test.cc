@@ -13,6 +13,7 @@
 #include "test_util.h"
 
 #include <cstring>
+#include <vector>
 
 // ============================================================================
 // Reference test data — same golden values as f32 tests
@@ -27,7 +28,7 @@
 struct MlstmS8Setup {
     int8_t W_q[(4 * 2 + 2) * 3]; /* max [(4*H+2), I] = [10, 3] */
     int32_t b_q[4 * 2 + 2];      /* max [4*H+2] = [10] */
-    int8_t input_q[3 * 3];       /* max [T, I] = [3, 3] */
+    int8_t input_q[4 * 3];       /* max [T, I] = [4, 3] */
     MlstmS8Params params;
 };
 
@@ -62,6 +63,7 @@ static void PrepareMlstmS8(const float* W, const float* b,
     s->params.C_quant.zero_point = 0;
     s->params.n_quant.scale = n_scale;
     s->params.n_quant.zero_point = 0;
+    s->params.stats = nullptr;
 }
 
 // ============================================================================
@@ -227,6 +229,174 @@ bool TestMlstmS8QuantizationBound() {
     return true;
 }
 
+bool TestMlstmS8EvalResetPackedEpisodes() {
+    /* Packed run with resets must match separate runs from a zero state. */
+    const int T = 4, I = 3, H = 2;
+
+    float input[T * I];
+    std::memcpy(input, kMTest2_input, 3 * I * sizeof(float));
+    std::memcpy(input + 3 * I, kMTest1_input, I * sizeof(float));
+
+    MlstmS8Setup s;
+    PrepareMlstmS8(kMTest1_W, kMTest1_b, input, T, I, H,
+                   0.01f, 0.01f, 0.01f, &s);
+
+    /* Reference: two separate calls, each from a zero state */
+    int8_t ref_out[T * H] = {0};
+    int32_t scratch[4 * H + 2] = {0};
+    {
+        int8_t y[H] = {0};
+        int16_t C[H * H] = {0}, n_state[H] = {0};
+        float m_state[1] = {0};
+        mlstm_eval_s8(s.input_q, s.W_q, s.b_q,
+                      y, C, n_state, m_state, ref_out, scratch,
+                      1, 3, I, H, &s.params);
+    }
+    int8_t y_ref[H] = {0};
+    int16_t C_ref[H * H] = {0}, n_ref[H] = {0};
+    float m_ref[1] = {0};
+    mlstm_eval_s8(s.input_q + 3 * I, s.W_q, s.b_q,
+                  y_ref, C_ref, n_ref, m_ref, ref_out + 3 * H, scratch,
+                  1, 1, I, H, &s.params);
+
+    /* Packed: garbage initial state, reset at both episode starts */
+    const uint8_t reset[T] = {1, 0, 0, 1};
+    int8_t y[H] = {7, 7};
+    int16_t C[H * H] = {99, 99, 99, 99}, n_state[H] = {99, 99};
+    float m_state[1] = {5};
+    int8_t output[T * H] = {0};
+    mlstm_eval_reset_s8(s.input_q, reset, s.W_q, s.b_q,
+                        y, C, n_state, m_state, output, scratch,
+                        1, T, I, H, &s.params);
+
+    bool ok = std::memcmp(output, ref_out, sizeof(output)) == 0;
+    ok &= std::memcmp(y, y_ref, sizeof(y)) == 0;
+    ok &= std::memcmp(C, C_ref, sizeof(C)) == 0;
+    ok &= std::memcmp(n_state, n_ref, sizeof(n_state)) == 0;
+    ok &= ExpectNear("m", m_ref, m_state, 1, 0.0f);
+    if (!ok) std::printf("  FAIL: packed run differs from separate runs\n");
+    return ok;
+}
+
+bool TestMlstmS8StepBatchMatchesStep() {
+    /* Two streams stepped together (slots in reverse order) must match
+     * stepping each one on its own. */
+    const int T = 3, I = 3, H = 2;
+
+    MlstmS8Setup s;
+    PrepareMlstmS8(kMTest1_W, kMTest1_b, kMTest2_input, T, I, H,
+                   0.01f, 0.01f, 0.01f, &s);
+
+    const int slots[2] = {1, 0};
+    int8_t y[2 * H] = {0};
+    int16_t C[2 * H * H] = {0}, n_state[2 * H] = {0};
+    float m_state[2] = {0};
+    int32_t scratch[2 * (4 * H + 2)] = {0};
+
+    int8_t y_ref[2 * H] = {0};
+    int16_t C_ref[2 * H * H] = {0}, n_ref[2 * H] = {0};
+    float m_ref[2] = {0};
+
+    /* Stream k reads input row (t + k) */
+    for (int t = 0; t < 2; ++t) {
+        int8_t x[2 * I];
+        for (int k = 0; k < 2; ++k) {
+            std::memcpy(x + k * I, s.input_q + (t + k) * I, I);
+            int sl = slots[k];
+            mlstm_step_s8(s.input_q + (t + k) * I, s.W_q, s.b_q,
+                          y_ref + sl * H, C_ref + sl * H * H, n_ref + sl * H,
+                          m_ref + sl, scratch, I, H, &s.params);
+        }
+        mlstm_step_batch_s8(x, slots, 2, s.W_q, s.b_q,
+                            y, C, n_state, m_state, scratch, I, H, &s.params);
+    }
+
+    bool ok = std::memcmp(y, y_ref, sizeof(y)) == 0;
+    ok &= std::memcmp(C, C_ref, sizeof(C)) == 0;
+    ok &= std::memcmp(n_state, n_ref, sizeof(n_state)) == 0;
+    ok &= ExpectNear("m", m_ref, m_state, 2, 0.0f);
+    if (!ok) std::printf("  FAIL: batched step differs from per-stream step\n");
+    return ok;
+}
+
+bool TestMlstmS8SaturationStats() {
+    /* A C scale far too small clamps the matrix memory; the scale suggested
+     * by the observed range must not. Every C element is counted per step. */
+    const int T = 3, I = 3, H = 2;
+
+    MlstmS8Setup s;
+    PrepareMlstmS8(kMTest1_W, kMTest1_b, kMTest2_input, T, I, H,
+                   0.01f, 1e-9f, 0.01f, &s);
+
+    XlstmQ8Stats stats;
+    xlstm_q8_stats_reset(&stats);
+    s.params.stats = &stats;
+
+    int8_t y[H] = {0}, output[T * H] = {0};
+    int16_t C[H * H] = {0}, n_state[H] = {0};
+    float m_state[1] = {0};
+    int32_t scratch[4 * H + 2] = {0};
+
+    mlstm_eval_s8(s.input_q, s.W_q, s.b_q, y, C, n_state, m_state, output,
+                  scratch, 1, T, I, H, &s.params);
+
+    bool ok = stats.c.count == (uint64_t)(T * H * H);
+    ok &= stats.n.count == (uint64_t)(T * H) && stats.y.count == (uint64_t)(T * H);
+    ok &= stats.c.saturated > 0 && stats.c.max_abs > 0.0f;
+    if (!ok) std::printf("  FAIL: small C scale: %llu/%llu saturated\n",
+                         (unsigned long long)stats.c.saturated,
+                         (unsigned long long)stats.c.count);
+
+    float C_scale = xlstm_quant_stats_scale(&stats.c, 32767);
+    PrepareMlstmS8(kMTest1_W, kMTest1_b, kMTest2_input, T, I, H,
+                   0.01f, C_scale, 0.01f, &s);
+    xlstm_q8_stats_reset(&stats);
+    s.params.stats = &stats;
+    std::memset(y, 0, sizeof(y));
+    std::memset(C, 0, sizeof(C));
+    std::memset(n_state, 0, sizeof(n_state));
+    m_state[0] = 0.0f;
+    mlstm_eval_s8(s.input_q, s.W_q, s.b_q, y, C, n_state, m_state, output,
+                  scratch, 1, T, I, H, &s.params);
+    ok &= stats.c.count == (uint64_t)(T * H * H) && stats.c.saturated == 0;
+    if (!ok) std::printf("  FAIL: recalibrated C scale %g\n", C_scale);
+    return ok;
+}
+
+bool TestMlstmS8PackedMatchesEval() {
+    /* Packed weights (zero point folded into row corrections) must give
+     * bit-identical outputs and states for a non-zero x zero point */
+    const int B = 2, T = 5, I = 7, H = 5;
+    std::vector<int8_t> in(B * T * I), W((4 * H + 2) * I);
+    std::vector<int32_t> b(4 * H + 2), scratch(4 * H + 2);
+    for (size_t i = 0; i < in.size(); ++i) in[i] = (int8_t)((i * 53 + 7) % 255 - 127);
+    for (size_t i = 0; i < W.size(); ++i) W[i] = (int8_t)((i * 37 + 3) % 201 - 100);
+    for (size_t i = 0; i < b.size(); ++i) b[i] = (int32_t)(i * 97 % 400) - 200;
+
+    MlstmS8Params p = {0.0f, 0.004f, {0.02f, -11}, {1.0f / 128, 2},
+                       {1.0f / 1024, 0}, {1.0f / 1024, 0}, nullptr};
+    std::vector<int32_t> buf((mlstm_pack_s8_size(I, H) + 3) / 4);
+    MlstmS8Packed packed;
+    mlstm_pack_s8(W.data(), I, H, &p, buf.data(), &packed);
+
+    std::vector<int8_t> y(B * H, 2), y2 = y, out(B * T * H), out2(B * T * H);
+    std::vector<int16_t> C(B * H * H, 0), C2 = C, n(B * H, 0), n2 = n;
+    std::vector<float> m(B, 0.0f), m2 = m;
+    mlstm_eval_s8(in.data(), W.data(), b.data(), y.data(), C.data(), n.data(),
+                  m.data(), out.data(), scratch.data(), B, T, I, H, &p);
+    mlstm_eval_packed_s8(in.data(), &packed, b.data(), y2.data(), C2.data(), n2.data(),
+                         m2.data(), out2.data(), scratch.data(), B, T, I, H, &p);
+
+    bool ok = mlstm_pack_s8_size(I, H) == (size_t)((4 * H + 2) * 4);
+    ok &= packed.W_q == W.data();
+    ok &= std::memcmp(out.data(), out2.data(), out.size()) == 0;
+    ok &= std::memcmp(C.data(), C2.data(), C.size() * sizeof(int16_t)) == 0;
+    ok &= std::memcmp(n.data(), n2.data(), n.size() * sizeof(int16_t)) == 0;
+    ok &= std::memcmp(m.data(), m2.data(), m.size() * sizeof(float)) == 0;
+    if (!ok) std::printf("  FAIL: packed eval differs from mlstm_eval_s8\n");
+    return ok;
+}
+
 // ============================================================================
 // Main
 // ============================================================================
@@ -238,6 +408,10 @@ int main() {
     RUN_TEST(TestMlstmS8MultipleTimesteps);
     RUN_TEST(TestMlstmS8OverflowPrevention);
     RUN_TEST(TestMlstmS8QuantizationBound);
+    RUN_TEST(TestMlstmS8EvalResetPackedEpisodes);
+    RUN_TEST(TestMlstmS8StepBatchMatchesStep);
+    RUN_TEST(TestMlstmS8SaturationStats);
+    RUN_TEST(TestMlstmS8PackedMatchesEval);
 
     std::printf("[==========] %d/%d tests passed\n", g_tests_passed, g_tests_run);
     return g_tests_passed == g_tests_run ? 0 : 1;
@@ -8,8 +8,11 @@
  * =========================================================================*/
 
 #include "mlstm.h"
+#include "xlstm_fpenv.h"
 #include "test_util.h"
 
+#include <cstring>
+
 // ============================================================================
 // Reference test data — generated from NX-AI/xlstm reference
 // Regenerate: make reference
@@ -32,7 +35,7 @@ bool TestMlstmSingleTimestepZeroState() {
     float m_state[1] = {0};
     float output[T * H] = {0};
     float scratch[4 * H + 2] = {0};
-    MlstmParams params = {0.0f};
+    MlstmParams params = {0.0f, 0};
 
     mlstm_eval_f32(kMTest1_input, kMTest1_W, kMTest1_b,
                    y, C, n, m_state, output, scratch, B, T, I, H, &params);
@@ -55,7 +58,7 @@ bool TestMlstmMultipleTimesteps() {
     float m_state[1] = {0};
     float output[T * H] = {0};
     float scratch[4 * H + 2] = {0};
-    MlstmParams params = {0.0f};
+    MlstmParams params = {0.0f, 0};
 
     mlstm_eval_f32(kMTest2_input, kMTest1_W, kMTest1_b,
                    y, C, n, m_state, output, scratch, B, T, I, H, &params);
@@ -78,7 +81,7 @@ bool TestMlstmOverflowPrevention() {
     float m_state[1] = {0};
     float output[T * H] = {0};
     float scratch[4 * H + 2] = {0};
-    MlstmParams params = {0.0f};
+    MlstmParams params = {0.0f, 0};
 
     mlstm_eval_f32(kMTest3_input, kMTest3_W, kMTest3_b,
                    y, C, n, m_state, output, scratch, B, T, I, H, &params);
@@ -96,6 +99,166 @@ bool TestMlstmOverflowPrevention() {
     return ok;
 }
 
+bool TestMlstmEvalResetPackedEpisodes() {
+    /* Two episodes packed into one buffer: Test 2 (3 steps), then Test 1.
+     * The initial state is garbage — the reset at t=0 must clear it. */
+    const int B = 1, T = 4, I = 3, H = 2;
+
+    float input[T * I];
+    std::memcpy(input, kMTest2_input, 3 * I * sizeof(float));
+    std::memcpy(input + 3 * I, kMTest1_input, I * sizeof(float));
+    const uint8_t reset[B * T] = {1, 0, 0, 1};
+
+    float y[H] = {5, 5};
+    float C[H * H] = {5, 5, 5, 5};
+    float n[H] = {5, 5};
+    float m_state[1] = {5};
+    float output[T * H] = {0};
+    float scratch[4 * H + 2] = {0};
+    MlstmParams params = {0.0f, 0};
+
+    mlstm_eval_reset_f32(input, reset, kMTest1_W, kMTest1_b,
+                         y, C, n, m_state, output, scratch, B, T, I, H, &params);
+
+    bool ok = true;
+    ok &= ExpectNear("output_ep1", kMTest2_expected_output, output, 3 * H, kTolerance);
+    ok &= ExpectNear("output_ep2", kMTest1_expected_y, output + 3 * H, H, kTolerance);
+    ok &= ExpectNear("C", kMTest1_expected_C, C, H * H, kTolerance);
+    ok &= ExpectNear("n", kMTest1_expected_n, n, H, kTolerance);
+    ok &= ExpectNear("m", kMTest1_expected_m, m_state, 1, kTolerance);
+    return ok;
+}
+
+bool TestMlstmStepTiledMatchesStep() {
+    /* One-row tiles written to separate buffers must match the in-place
+     * untiled step exactly, and leave the source tiles untouched. */
+    const int I = 3, H = 2;
+    MlstmParams params = {0.0f, 0};
+
+    float y[H] = {0}, C[H * H] = {0}, n[H] = {0}, m_state[1] = {0};
+    float scratch[4 * H + 2];
+    for (int t = 0; t < 3; ++t) {
+        mlstm_step_f32(kMTest2_input + t * I, kMTest1_W, kMTest1_b,
+                       y, C, n, m_state, scratch, I, H, &params);
+    }
+
+    float y_t[H] = {0}, m_t[1] = {0};
+    float src[H * H] = {0}, dst[H * H], n_a[H] = {0}, n_b[H];
+    for (int t = 0; t < 3; ++t) {
+        const float* C_src[2] = {src, src + H};
+        float* C_dst[2] = {dst, dst + H};
+        mlstm_step_tiled_f32(kMTest2_input + t * I, kMTest1_W, kMTest1_b,
+                             y_t, C_src, C_dst, 1, n_a, n_b, m_t,
+                             scratch, I, H, &params);
+        if (t == 0) {
+            for (int i = 0; i < H * H; ++i) {
+                if (src[i] != 0.0f) return false;
+            }
+        }
+        std::memcpy(src, dst, sizeof(src));
+        std::memcpy(n_a, n_b, sizeof(n_a));
+    }
+
+    bool ok = true;
+    ok &= std::memcmp(y, y_t, sizeof(y)) == 0;
+    ok &= std::memcmp(C, dst, sizeof(C)) == 0;
+    ok &= std::memcmp(n, n_b, sizeof(n)) == 0;
+    ok &= m_state[0] == m_t[0];
+    if (!ok) std::printf("  FAIL: tiled step differs from mlstm_step_f32\n");
+    return ok;
+}
+
+bool TestMlstmEvalSpecCommitRollsBack() {
+    /* Same drafts in both batch elements; element 0 accepts all 3 steps,
+     * element 1 only the first. The deferred rank-1 readout and commit must
+     * match the step-by-step reference. */
+    const int B = 2, T = 3, I = 3, H = 2;
+    float input[B * T * I];
+    std::memcpy(input, kMTest2_input, T * I * sizeof(float));
+    std::memcpy(input + T * I, kMTest2_input, T * I * sizeof(float));
+
+    float y[B * H] = {0}, C[B * H * H] = {0}, n[B * H] = {0}, m_state[B] = {0};
+    float output[B * T * H], ckpt[B * T * (4 * H + 3)];
+    float scratch[4 * H + 2 + T];
+    MlstmParams params = {0.0f, 0};
+
+    mlstm_eval_spec_f32(input, kMTest1_W, kMTest1_b, C, n, m_state,
+                        output, ckpt, scratch, B, T, I, H, &params);
+
+    bool ok = true;
+    ok &= ExpectNear("output_0", kMTest2_expected_output, output, T * H, kTolerance);
+    ok &= ExpectNear("output_1", kMTest2_expected_output, output + T * H, T * H, kTolerance);
+
+    /* Out-of-range counts are rejected before any state is touched */
+    const int too_many[B] = {T + 1, 0}, negative[B] = {0, -1};
+    ok &= mlstm_spec_commit_f32(ckpt, too_many, y, C, n, m_state, B, T, H, &params) ==
+          XLSTM_ERR_ARG;
+    ok &= mlstm_spec_commit_f32(ckpt, negative, y, C, n, m_state, B, T, H, &params) ==
+          XLSTM_ERR_ARG;
+    for (int i = 0; i < B * H * H; ++i) ok &= C[i] == 0.0f;
+
+    const int accepted[B] = {3, 1};
+    ok &= mlstm_spec_commit_f32(ckpt, accepted, y, C, n, m_state, B, T, H, &params) ==
+          XLSTM_OK;
+    ok &= ExpectNear("y_0", kMTest2_expected_y, y, H, kTolerance);
+    ok &= ExpectNear("C_0", kMTest2_expected_C, C, H * H, kTolerance);
+    ok &= ExpectNear("n_0", kMTest2_expected_n, n, H, kTolerance);
+    ok &= ExpectNear("m_0", kMTest2_expected_m, m_state, 1, kTolerance);
+    ok &= ExpectNear("y_1", kMTest1_expected_y, y + H, H, kTolerance);
+    ok &= ExpectNear("C_1", kMTest1_expected_C, C + H * H, H * H, kTolerance);
+    ok &= ExpectNear("m_1", kMTest1_expected_m, m_state + 1, 1, kTolerance);
+
+    /* Speculating again from a non-zero C: element 1 re-runs steps 2-3 */
+    float out_rest[2 * H], ckpt_rest[2 * (4 * H + 3)];
+    const int all[1] = {2};
+    mlstm_eval_spec_f32(kMTest2_input + I, kMTest1_W, kMTest1_b,
+                        C + H * H, n + H, m_state + 1,
+                        out_rest, ckpt_rest, scratch, 1, 2, I, H, &params);
+    ok &= mlstm_spec_commit_f32(ckpt_rest, all, y + H, C + H * H, n + H, m_state + 1,
+                                1, 2, H, &params) == XLSTM_OK;
+    ok &= ExpectNear("resumed", kMTest2_expected_output + H, out_rest, 2 * H, kTolerance);
+    ok &= ExpectNear("C_resumed", kMTest2_expected_C, C + H * H, H * H, kTolerance);
+    return ok;
+}
+
+bool TestMlstmFlushDenormals() {
+    /* Zero weights: f = 0.5, k = v = 0, so C only decays. A subnormal C stays
+     * subnormal by default and is flushed with flush_denormals; normal
+     * results are unchanged and the caller's FP mode is restored. */
+    const int I = 3, H = 2;
+    const float tiny = 1e-39f;
+
+    float W[(4 * H + 2) * I] = {0}, b[4 * H + 2] = {0}, x[I] = {0};
+    float y[H] = {0}, n[H] = {0}, m_state[1] = {0};
+    float output[H] = {0}, scratch[4 * H + 2] = {0};
+    MlstmParams params = {0.0f, 0};
+
+    float C[H * H] = {tiny, tiny, tiny, tiny};
+    mlstm_eval_f32(x, W, b, y, C, n, m_state, output, scratch, 1, 1, I, H, &params);
+    bool ok = C[0] > 0.0f && C[0] < tiny;
+
+    XlstmFpEnv env;
+    bool supported = xlstm_fpenv_flush_begin(&env) != 0;
+    xlstm_fpenv_flush_end(&env);
+
+    params.flush_denormals = 1;
+    float C2[H * H] = {tiny, tiny, tiny, tiny};
+    m_state[0] = 0.0f;
+    mlstm_eval_f32(x, W, b, y, C2, n, m_state, output, scratch, 1, 1, I, H, &params);
+    if (supported) ok &= C2[0] == 0.0f && C2[3] == 0.0f;
+
+    volatile float sub = tiny;
+    ok &= sub * 0.5f > 0.0f;
+    if (!ok) std::printf("  FAIL: C %g (default) %g (flush)\n", C[0], C2[0]);
+
+    float y1[H] = {0}, C1[H * H] = {0}, n1[H] = {0}, m1[1] = {0};
+    mlstm_eval_f32(kMTest1_input, kMTest1_W, kMTest1_b,
+                   y1, C1, n1, m1, output, scratch, 1, 1, I, H, &params);
+    ok &= ExpectNear("y", kMTest1_expected_y, y1, H, kTolerance);
+    ok &= ExpectNear("C", kMTest1_expected_C, C1, H * H, kTolerance);
+    return ok;
+}
+
 // ============================================================================
 // Main
 // ============================================================================
@@ -106,6 +269,10 @@ int main() {
     RUN_TEST(TestMlstmSingleTimestepZeroState);
     RUN_TEST(TestMlstmMultipleTimesteps);
     RUN_TEST(TestMlstmOverflowPrevention);
+    RUN_TEST(TestMlstmEvalResetPackedEpisodes);
+    RUN_TEST(TestMlstmStepTiledMatchesStep);
+    RUN_TEST(TestMlstmEvalSpecCommitRollsBack);
+    RUN_TEST(TestMlstmFlushDenormals);
 
     std::printf("[==========] %d/%d tests passed\n", g_tests_passed, g_tests_run);
     return g_tests_passed == g_tests_run ? 0 : 1;
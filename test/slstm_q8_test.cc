@@ -9,10 +9,12 @@
  * =========================================================================*/
 
 #include "slstm_q8.h"
+#include "xlstm_q8_dot.h"
 #include "xlstm_quant.h"
 #include "test_util.h"
 
 #include <cstring>
+#include <vector>
 
 // ============================================================================
 // Reference test data — same golden values as f32 tests
@@ -28,7 +30,7 @@ struct SlstmS8Setup {
     int8_t W_q[4 * 2 * 2];       /* max [4*H, I] = [8, 2] */
     int8_t R_q[4 * 2 * 2];       /* max [4*H, H] = [8, 2] */
     int32_t b_q[4 * 2];          /* max [4*H] = [8] */
-    int8_t input_q[3 * 2];       /* max [T, I] = [3, 2] */
+    int8_t input_q[4 * 2];       /* max [T, I] = [4, 2] */
     SlstmS8Params params;
 };
 
@@ -66,6 +68,7 @@ static void PrepareS8(const float* W, const float* R, const float* b,
     s->params.c_quant.zero_point = 0;
     s->params.n_quant.scale = n_scale;
     s->params.n_quant.zero_point = 0;
+    s->params.stats = nullptr;
 }
 
 // ============================================================================
@@ -229,6 +232,211 @@ bool TestS8QuantizationBound() {
     return true;
 }
 
+bool TestS8EvalResetPackedEpisodes() {
+    /* Packed run with resets must match separate runs from a zero state. */
+    const int T = 4, I = 2, H = 2;
+
+    float input[T * I];
+    std::memcpy(input, kTest2_input, 3 * I * sizeof(float));
+    std::memcpy(input + 3 * I, kTest1_input, I * sizeof(float));
+
+    SlstmS8Setup s;
+    PrepareS8(kTest1_W, kTest1_R, kTest1_b, input, T, I, H,
+              0.01f, 0.01f, 0.01f, &s);
+
+    /* Reference: two separate calls, each from a zero state */
+    int8_t ref_out[T * H] = {0};
+    int32_t scratch[4 * H] = {0};
+    {
+        int8_t y[H] = {0};
+        int16_t c[H] = {0}, n_state[H] = {0};
+        float m_state[H] = {0};
+        slstm_eval_s8(s.input_q, s.W_q, s.R_q, s.b_q,
+                      y, c, n_state, m_state, ref_out, scratch,
+                      1, 3, I, H, &s.params);
+    }
+    int8_t y_ref[H] = {0};
+    int16_t c_ref[H] = {0}, n_ref[H] = {0};
+    float m_ref[H] = {0};
+    slstm_eval_s8(s.input_q + 3 * I, s.W_q, s.R_q, s.b_q,
+                  y_ref, c_ref, n_ref, m_ref, ref_out + 3 * H, scratch,
+                  1, 1, I, H, &s.params);
+
+    /* Packed: garbage initial state, reset at both episode starts */
+    const uint8_t reset[T] = {1, 0, 0, 1};
+    int8_t y[H] = {7, 7};
+    int16_t c[H] = {99, 99}, n_state[H] = {99, 99};
+    float m_state[H] = {5, 5};
+    int8_t output[T * H] = {0};
+    slstm_eval_reset_s8(s.input_q, reset, s.W_q, s.R_q, s.b_q,
+                        y, c, n_state, m_state, output, scratch,
+                        1, T, I, H, &s.params);
+
+    bool ok = std::memcmp(output, ref_out, sizeof(output)) == 0;
+    ok &= std::memcmp(y, y_ref, sizeof(y)) == 0;
+    ok &= std::memcmp(c, c_ref, sizeof(c)) == 0;
+    ok &= std::memcmp(n_state, n_ref, sizeof(n_state)) == 0;
+    ok &= ExpectNear("m", m_ref, m_state, H, 0.0f);
+    if (!ok) std::printf("  FAIL: packed run differs from separate runs\n");
+    return ok;
+}
+
+bool TestS8StepBatchMatchesStep() {
+    /* Two streams stepped together (slots in reverse order) must match
+     * stepping each one on its own. */
+    const int T = 3, I = 2, H = 2;
+
+    SlstmS8Setup s;
+    PrepareS8(kTest1_W, kTest1_R, kTest1_b, kTest2_input, T, I, H,
+              0.01f, 0.01f, 0.01f, &s);
+
+    const int slots[2] = {1, 0};
+    int8_t y[2 * H] = {0};
+    int16_t c[2 * H] = {0}, n_state[2 * H] = {0};
+    float m_state[2 * H] = {0};
+    int32_t scratch[2 * 4 * H] = {0};
+
+    int8_t y_ref[2 * H] = {0};
+    int16_t c_ref[2 * H] = {0}, n_ref[2 * H] = {0};
+    float m_ref[2 * H] = {0};
+
+    /* Stream k reads input row (t + k) */
+    for (int t = 0; t < 2; ++t) {
+        int8_t x[2 * I];
+        for (int k = 0; k < 2; ++k) {
+            std::memcpy(x + k * I, s.input_q + (t + k) * I, I);
+            int sl = slots[k];
+            slstm_step_s8(s.input_q + (t + k) * I, s.W_q, s.R_q, s.b_q,
+                          y_ref + sl * H, c_ref + sl * H, n_ref + sl * H,
+                          m_ref + sl * H, scratch, I, H, &s.params);
+        }
+        slstm_step_batch_s8(x, slots, 2, s.W_q, s.R_q, s.b_q,
+                            y, c, n_state, m_state, scratch, I, H, &s.params);
+    }
+
+    bool ok = std::memcmp(y, y_ref, sizeof(y)) == 0;
+    ok &= std::memcmp(c, c_ref, sizeof(c)) == 0;
+    ok &= std::memcmp(n_state, n_ref, sizeof(n_state)) == 0;
+    ok &= ExpectNear("m", m_ref, m_state, 2 * H, 0.0f);
+    if (!ok) std::printf("  FAIL: batched step differs from per-stream step\n");
+    return ok;
+}
+
+bool TestS8SaturationStats() {
+    /* The same run with a c scale too small to hold the cell state and with
+     * a fitting one: both must count every value, only the first may report
+     * clamped c values, and the results must not depend on stats being on. */
+    const int T = 3, I = 2, H = 2;
+
+    SlstmS8Setup s;
+    PrepareS8(kTest1_W, kTest1_R, kTest1_b, kTest2_input, T, I, H,
+              0.01f, 1e-6f, 0.01f, &s);
+
+    int8_t y[H] = {0}, output[T * H] = {0}, ref_out[T * H] = {0};
+    int16_t c[H] = {0}, n_state[H] = {0};
+    float m_state[H] = {0};
+    int32_t scratch[4 * H] = {0};
+
+    slstm_eval_s8(s.input_q, s.W_q, s.R_q, s.b_q, y, c, n_state, m_state,
+                  ref_out, scratch, 1, T, I, H, &s.params);
+
+    XlstmQ8Stats stats;
+    xlstm_q8_stats_reset(&stats);
+    s.params.stats = &stats;
+    std::memset(y, 0, sizeof(y));
+    std::memset(c, 0, sizeof(c));
+    std::memset(n_state, 0, sizeof(n_state));
+    std::memset(m_state, 0, sizeof(m_state));
+    slstm_eval_s8(s.input_q, s.W_q, s.R_q, s.b_q, y, c, n_state, m_state,
+                  output, scratch, 1, T, I, H, &s.params);
+
+    bool ok = std::memcmp(output, ref_out, sizeof(output)) == 0;
+    ok &= stats.c.count == (uint64_t)(T * H) && stats.n.count == (uint64_t)(T * H);
+    ok &= stats.y.count == (uint64_t)(T * H);
+    ok &= stats.c.saturated > 0 && stats.c.max_abs > 0.0f;
+    ok &= stats.n.saturated == 0 && stats.y.saturated == 0;
+    ok &= stats.y.max_abs > 0.0f && stats.y.max_abs <= 1.0f;
+    if (!ok) std::printf("  FAIL: small c scale: %llu/%llu saturated\n",
+                         (unsigned long long)stats.c.saturated,
+                         (unsigned long long)stats.c.count);
+
+    /* Recalibrate c from the observed range: no more saturation */
+    float c_scale = xlstm_quant_stats_scale(&stats.c, 32767);
+    ok &= c_scale > 1e-6f;
+    PrepareS8(kTest1_W, kTest1_R, kTest1_b, kTest2_input, T, I, H,
+              0.01f, c_scale, 0.01f, &s);
+    xlstm_q8_stats_reset(&stats);
+    s.params.stats = &stats;
+    std::memset(y, 0, sizeof(y));
+    std::memset(c, 0, sizeof(c));
+    std::memset(n_state, 0, sizeof(n_state));
+    std::memset(m_state, 0, sizeof(m_state));
+    slstm_eval_s8(s.input_q, s.W_q, s.R_q, s.b_q, y, c, n_state, m_state,
+                  output, scratch, 1, T, I, H, &s.params);
+    ok &= stats.c.count == (uint64_t)(T * H) && stats.c.saturated == 0;
+    if (!ok) std::printf("  FAIL: recalibrated c scale %g\n", c_scale);
+    return ok;
+}
+
+bool TestS8PackedMatchesEval() {
+    /* Packed weights (zero points folded into row corrections) must give
+     * bit-identical outputs and states, including non-zero x/y zero points */
+    const int B = 2, T = 5, I = 7, H = 5;
+    std::vector<int8_t> in(B * T * I), W(4 * H * I), R(4 * H * H);
+    std::vector<int32_t> b(4 * H), scratch(4 * H);
+    for (size_t i = 0; i < in.size(); ++i) in[i] = (int8_t)((i * 53 + 7) % 255 - 127);
+    for (size_t i = 0; i < W.size(); ++i) W[i] = (int8_t)((i * 37 + 3) % 201 - 100);
+    for (size_t i = 0; i < R.size(); ++i) R[i] = (int8_t)((i * 29 + 5) % 181 - 90);
+    for (size_t i = 0; i < b.size(); ++i) b[i] = (int32_t)(i * 97 % 400) - 200;
+
+    SlstmS8Params p = {0.0f, 0.004f, 0.006f, {0.02f, 9}, {1.0f / 128, -5},
+                       {1.0f / 1024, 0}, {1.0f / 1024, 0}, nullptr};
+    std::vector<int32_t> buf((slstm_pack_s8_size(I, H) + 3) / 4);
+    SlstmS8Packed packed;
+    slstm_pack_s8(W.data(), R.data(), I, H, &p, buf.data(), &packed);
+
+    std::vector<int8_t> y(B * H, -5), y2 = y, out(B * T * H), out2(B * T * H);
+    std::vector<int16_t> c(B * H, 0), c2 = c, n(B * H, 0), n2 = n;
+    std::vector<float> m(B * H, 0.0f), m2 = m;
+    slstm_eval_s8(in.data(), W.data(), R.data(), b.data(), y.data(), c.data(), n.data(),
+                  m.data(), out.data(), scratch.data(), B, T, I, H, &p);
+    slstm_eval_packed_s8(in.data(), &packed, b.data(), y2.data(), c2.data(), n2.data(),
+                         m2.data(), out2.data(), scratch.data(), B, T, I, H, &p);
+
+    bool ok = slstm_pack_s8_size(I, H) == (size_t)(4 * H * 8);
+    ok &= packed.W_q == W.data() && packed.R_q == R.data();
+    ok &= std::memcmp(out.data(), out2.data(), out.size()) == 0;
+    ok &= std::memcmp(c.data(), c2.data(), c.size() * sizeof(int16_t)) == 0;
+    ok &= std::memcmp(n.data(), n2.data(), n.size() * sizeof(int16_t)) == 0;
+    ok &= std::memcmp(m.data(), m2.data(), m.size() * sizeof(float)) == 0;
+    if (!ok) std::printf("  FAIL: packed eval differs from slstm_eval_s8\n");
+    return ok;
+}
+
+bool TestS8DotMatchesScalar() {
+    /* Every length around the 4- and 8-wide backend blocks, extreme values
+     * and zero points: the backend must reproduce the scalar sum exactly */
+    int8_t w[40], x[40];
+    const int32_t zps[] = {-128, -3, 0, 77, 127};
+    bool ok = true;
+
+    for (int j = 0; j < 40; ++j) {
+        w[j] = (int8_t)(j % 3 == 0 ? -128 : (j * 37) % 255 - 127);
+        x[j] = (int8_t)(j % 4 == 1 ? 127 : (j * 53) % 255 - 128);
+    }
+    for (int32_t zp : zps) {
+        for (int len = 0; len <= 40; ++len) {
+            int32_t want = 0;
+            for (int j = 0; j < len; ++j) want += (int32_t)w[j] * ((int32_t)x[j] - zp);
+            if (xlstm_dot_s8(w, x, zp, len) != want) {
+                std::printf("  FAIL: %s dot, len %d zp %d\n", XLSTM_Q8_BACKEND, len, (int)zp);
+                ok = false;
+            }
+        }
+    }
+    return ok;
+}
+
 // ============================================================================
 // Main
 // ============================================================================
@@ -240,6 +448,11 @@ int main() {
     RUN_TEST(TestS8MultipleTimesteps);
     RUN_TEST(TestS8OverflowPrevention);
     RUN_TEST(TestS8QuantizationBound);
+    RUN_TEST(TestS8EvalResetPackedEpisodes);
+    RUN_TEST(TestS8StepBatchMatchesStep);
+    RUN_TEST(TestS8SaturationStats);
+    RUN_TEST(TestS8PackedMatchesEval);
+    RUN_TEST(TestS8DotMatchesScalar);
 
     std::printf("[==========] %d/%d tests passed\n", g_tests_passed, g_tests_run);
     return g_tests_passed == g_tests_run ? 0 : 1;
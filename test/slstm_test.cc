@@ -8,8 +8,11 @@
  * =========================================================================*/
 
 #include "slstm.h"
+#include "xlstm_fpenv.h"
 #include "test_util.h"
 
+#include <cstring>
+
 // ============================================================================
 // Reference test data — generated from NX-AI/xlstm reference (vanilla backend)
 // Regenerate: make reference
@@ -29,7 +32,7 @@ bool TestSingleTimestepZeroState() {
     float y[H] = {0}, c[H] = {0}, n[H] = {0}, m_state[H] = {0};
     float output[T * H] = {0};
     float scratch[4 * H] = {0};
-    SlstmParams params = {0.0f};
+    SlstmParams params = {0.0f, 0};
 
     slstm_eval_f32(kTest1_input, kTest1_W, kTest1_R, kTest1_b,
                    y, c, n, m_state, output, scratch, B, T, I, H, &params);
@@ -49,7 +52,7 @@ bool TestMultipleTimesteps() {
     float y[H] = {0}, c[H] = {0}, n[H] = {0}, m_state[H] = {0};
     float output[T * H] = {0};
     float scratch[4 * H] = {0};
-    SlstmParams params = {0.0f};
+    SlstmParams params = {0.0f, 0};
 
     slstm_eval_f32(kTest2_input, kTest1_W, kTest1_R, kTest1_b,
                    y, c, n, m_state, output, scratch, B, T, I, H, &params);
@@ -69,7 +72,7 @@ bool TestOverflowPrevention() {
     float y[H] = {0}, c[H] = {0}, n[H] = {0}, m_state[H] = {0};
     float output[T * H] = {0};
     float scratch[4 * H] = {0};
-    SlstmParams params = {0.0f};
+    SlstmParams params = {0.0f, 0};
 
     slstm_eval_f32(kTest3_input, kTest3_W, kTest3_R, kTest3_b,
                    y, c, n, m_state, output, scratch, B, T, I, H, &params);
@@ -87,6 +90,151 @@ bool TestOverflowPrevention() {
     return ok;
 }
 
+bool TestEvalResetPackedEpisodes() {
+    /* Two episodes packed into one buffer: Test 2 (3 steps), then Test 1.
+     * The initial state is garbage — the reset at t=0 must clear it. */
+    const int B = 1, T = 4, I = 2, H = 2;
+
+    float input[T * I];
+    std::memcpy(input, kTest2_input, 3 * I * sizeof(float));
+    std::memcpy(input + 3 * I, kTest1_input, I * sizeof(float));
+    const uint8_t reset[B * T] = {1, 0, 0, 1};
+
+    float y[H] = {5, 5}, c[H] = {5, 5}, n[H] = {5, 5}, m_state[H] = {5, 5};
+    float output[T * H] = {0};
+    float scratch[4 * H] = {0};
+    SlstmParams params = {0.0f, 0};
+
+    slstm_eval_reset_f32(input, reset, kTest1_W, kTest1_R, kTest1_b,
+                         y, c, n, m_state, output, scratch, B, T, I, H, &params);
+
+    bool ok = true;
+    ok &= ExpectNear("output_ep1", kTest2_expected_output, output, 3 * H, kTolerance);
+    ok &= ExpectNear("output_ep2", kTest1_expected_y, output + 3 * H, H, kTolerance);
+    ok &= ExpectNear("c", kTest1_expected_c, c, H, kTolerance);
+    ok &= ExpectNear("n", kTest1_expected_n, n, H, kTolerance);
+    ok &= ExpectNear("m", kTest1_expected_m, m_state, H, kTolerance);
+    return ok;
+}
+
+bool TestEvalSpecCommitRollsBack() {
+    /* Two copies of the Test 2 sequence as drafts: element 0 accepts all
+     * 3 steps, element 1 only the first one, then re-runs the rejected
+     * steps and must land on the reference again. */
+    const int B = 2, T = 3, I = 2, H = 2;
+    float input[B * T * I];
+    std::memcpy(input, kTest2_input, T * I * sizeof(float));
+    std::memcpy(input + T * I, kTest2_input, T * I * sizeof(float));
+
+    float y[B * H] = {0}, c[B * H] = {0}, n[B * H] = {0}, m[B * H] = {0};
+    float output[B * T * H], ckpt[B * T * 4 * H], scratch[4 * H];
+    SlstmParams params = {0.0f, 0};
+
+    slstm_eval_spec_f32(input, kTest1_W, kTest1_R, kTest1_b,
+                        y, c, n, m, output, ckpt, scratch, B, T, I, H, &params);
+
+    bool ok = true;
+    ok &= ExpectNear("output_0", kTest2_expected_output, output, T * H, kTolerance);
+    ok &= ExpectNear("output_1", kTest2_expected_output, output + T * H, T * H, kTolerance);
+    for (int i = 0; i < B * H; ++i) ok &= (y[i] == 0.0f && c[i] == 0.0f);
+    if (!ok) std::printf("  FAIL: live state modified during speculation\n");
+
+    /* Out-of-range counts are rejected before any state is touched */
+    const int too_many[B] = {0, T + 1}, negative[B] = {-1, 0};
+    ok &= slstm_spec_commit_f32(ckpt, too_many, y, c, n, m, B, T, H) == XLSTM_ERR_ARG;
+    ok &= slstm_spec_commit_f32(ckpt, negative, y, c, n, m, B, T, H) == XLSTM_ERR_ARG;
+    for (int i = 0; i < B * H; ++i) ok &= (y[i] == 0.0f && c[i] == 0.0f);
+
+    const int accepted[B] = {3, 1};
+    ok &= slstm_spec_commit_f32(ckpt, accepted, y, c, n, m, B, T, H) == XLSTM_OK;
+    ok &= ExpectNear("y_0", kTest2_expected_y, y, H, kTolerance);
+    ok &= ExpectNear("c_0", kTest2_expected_c, c, H, kTolerance);
+    ok &= ExpectNear("y_1", kTest1_expected_y, y + H, H, kTolerance);
+    ok &= ExpectNear("c_1", kTest1_expected_c, c + H, H, kTolerance);
+
+    /* Element 1 resumes from its accepted prefix */
+    float out_rest[2 * H];
+    slstm_eval_f32(kTest2_input + I, kTest1_W, kTest1_R, kTest1_b,
+                   y + H, c + H, n + H, m + H, out_rest, scratch, 1, 2, I, H, &params);
+    ok &= ExpectNear("resumed", kTest2_expected_output + H, out_rest, 2 * H, kTolerance);
+
+    /* Nothing accepted: state stays put */
+    const int none[B] = {0, 0};
+    float y_before[B * H];
+    std::memcpy(y_before, y, sizeof(y));
+    ok &= slstm_spec_commit_f32(ckpt, none, y, c, n, m, B, T, H) == XLSTM_OK;
+    ok &= std::memcmp(y, y_before, sizeof(y)) == 0;
+    return ok;
+}
+
+bool TestFlushDenormals() {
+    /* Zero weights: f = 0.5, z = 0, so c only decays. A subnormal c stays
+     * subnormal by default and is flushed with flush_denormals; normal
+     * results are unchanged and the caller's FP mode is restored. */
+    const int I = 2, H = 2;
+    const float tiny = 1e-39f;
+
+    float W[4 * H * I] = {0}, R[4 * H * H] = {0}, b[4 * H] = {0}, x[I] = {0};
+    float y[H] = {0}, m_state[H] = {0};
+    float output[H] = {0}, scratch[4 * H] = {0};
+    SlstmParams params = {0.0f, 0};
+
+    float c[H] = {tiny, tiny}, n[H] = {1.0f, 1.0f};
+    slstm_eval_f32(x, W, R, b, y, c, n, m_state, output, scratch, 1, 1, I, H, &params);
+    bool ok = c[0] > 0.0f && c[0] < tiny;
+
+    XlstmFpEnv env;
+    bool supported = xlstm_fpenv_flush_begin(&env) != 0;
+    xlstm_fpenv_flush_end(&env);
+
+    params.flush_denormals = 1;
+    float c2[H] = {tiny, tiny}, n2[H] = {1.0f, 1.0f};
+    m_state[0] = m_state[1] = 0.0f;
+    slstm_eval_f32(x, W, R, b, y, c2, n2, m_state, output, scratch, 1, 1, I, H, &params);
+    if (supported) ok &= c2[0] == 0.0f && c2[1] == 0.0f;
+
+    volatile float sub = tiny;
+    ok &= sub * 0.5f > 0.0f;
+    if (!ok) std::printf("  FAIL: c %g (default) %g (flush)\n", c[0], c2[0]);
+
+    float y1[H] = {0}, c1[H] = {0}, n1[H] = {0}, m1[H] = {0};
+    slstm_eval_f32(kTest1_input, kTest1_W, kTest1_R, kTest1_b,
+                   y1, c1, n1, m1, output, scratch, 1, 1, I, H, &params);
+    ok &= ExpectNear("y", kTest1_expected_y, y1, H, kTolerance);
+    ok &= ExpectNear("c", kTest1_expected_c, c1, H, kTolerance);
+    return ok;
+}
+
+bool TestEvalPreactMatchesEval() {
+    /* Input projections computed up front (as one GEMM would) and fed to
+     * the recurrence-only eval must reproduce the golden values. */
+    const int B = 1, T = 3, I = 2, H = 2;
+
+    float preact[T * 4 * H];
+    for (int t = 0; t < T; ++t) {
+        for (int i = 0; i < 4 * H; ++i) {
+            float acc = kTest1_b[i];
+            for (int j = 0; j < I; ++j) acc += kTest1_W[i * I + j] * kTest2_input[t * I + j];
+            preact[t * 4 * H + i] = acc;
+        }
+    }
+
+    float y[H] = {0}, c[H] = {0}, n[H] = {0}, m_state[H] = {0};
+    float output[T * H] = {0};
+    float scratch[4 * H] = {0};
+    SlstmParams params = {0.0f, 0};
+
+    slstm_eval_preact_f32(preact, kTest1_R, y, c, n, m_state, output, scratch,
+                          B, T, H, &params);
+
+    bool ok = true;
+    ok &= ExpectNear("output", kTest2_expected_output, output, T * H, kTolerance);
+    ok &= ExpectNear("c", kTest2_expected_c, c, H, kTolerance);
+    ok &= ExpectNear("n", kTest2_expected_n, n, H, kTolerance);
+    ok &= ExpectNear("m", kTest2_expected_m, m_state, H, kTolerance);
+    return ok;
+}
+
 // ============================================================================
 // Main
 // ============================================================================
@@ -97,6 +245,10 @@ int main() {
     RUN_TEST(TestSingleTimestepZeroState);
     RUN_TEST(TestMultipleTimesteps);
     RUN_TEST(TestOverflowPrevention);
+    RUN_TEST(TestEvalResetPackedEpisodes);
+    RUN_TEST(TestEvalSpecCommitRollsBack);
+    RUN_TEST(TestFlushDenormals);
+    RUN_TEST(TestEvalPreactMatchesEval);
 
     std::printf("[==========] %d/%d tests passed\n", g_tests_passed, g_tests_run);
     return g_tests_passed == g_tests_run ? 0 : 1;
@@ -0,0 +1,259 @@
+#!/usr/bin/env python3
+"""Checkpoint converter tests (tools/xlstm_convert.py).
+
+Builds random NX-AI-style state dicts, converts them and checks that the
+packed block tensors reproduce the NX-AI block computation, that the file
+round-trips through the serializer, and that --q8 calibrates its ranges
+and stays close to f32.
+
+Requires: pip install numpy
+Usage:    make test-convert
+"""
+
+import os
+import struct
+import sys
+import tempfile
+
+import numpy as np
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+sys.path.insert(0, os.path.join(SCRIPT_DIR, "..", "tools"))
+
+import xlstm_convert as xc  # noqa: E402
+# Block math shared with the converter's calibration forward
+from xlstm_convert import (  # noqa: E402
+    causal_conv, gelu, group_norm, layer_norm, mlstm_update, silu,
+    slstm_update,
+)
+
+ATOL = 1e-5
+
+
+# ============================================================================
+# Random NX-AI checkpoints
+# ============================================================================
+
+def rand(rng, *shape, scale=0.4):
+    return (rng.standard_normal(shape) * scale).astype(np.float32)
+
+
+def nxai_mlstm_block(rng, D, H, K, bs):
+    nh = H // bs
+    return {
+        "xlstm_norm.weight": rand(rng, D, scale=0.1),
+        "xlstm.proj_up.weight": rand(rng, 2 * H, D),
+        "xlstm.q_proj.weight": rand(rng, nh, bs, bs),
+        "xlstm.k_proj.weight": rand(rng, nh, bs, bs),
+        "xlstm.v_proj.weight": rand(rng, nh, bs, bs),
+        "xlstm.conv1d.conv.weight": rand(rng, H, 1, K),
+        "xlstm.conv1d.conv.bias": rand(rng, H, scale=0.1),
+        "xlstm.mlstm_cell.igate.weight": rand(rng, 1, 3 * H),
+        "xlstm.mlstm_cell.igate.bias": rand(rng, 1),
+        "xlstm.mlstm_cell.fgate.weight": rand(rng, 1, 3 * H),
+        "xlstm.mlstm_cell.fgate.bias": np.array([3.0], np.float32),
+        "xlstm.mlstm_cell.outnorm.weight": rand(rng, H, scale=0.1),
+        "xlstm.learnable_skip": rand(rng, H) + 1.0,
+        "xlstm.proj_down.weight": rand(rng, D, H),
+    }
+
+
+def nxai_slstm_block(rng, D, NH, K, F):
+    DH = D // NH
+    sd = {
+        "xlstm_norm.weight": rand(rng, D, scale=0.1),
+        "xlstm.igate.weight": rand(rng, NH, DH, DH),
+        "xlstm.fgate.weight": rand(rng, NH, DH, DH),
+        "xlstm.zgate.weight": rand(rng, NH, DH, DH),
+        "xlstm.ogate.weight": rand(rng, NH, DH, DH),
+        "xlstm.slstm_cell._recurrent_kernel_": rand(rng, NH, DH, 4 * DH),
+        "xlstm.slstm_cell._bias_": rand(rng, NH, 4 * DH, scale=0.1),
+        "xlstm.group_norm.weight": rand(rng, D, scale=0.1),
+        "ffn_norm.weight": rand(rng, D, scale=0.1),
+        "ffn.proj_up.weight": rand(rng, 2 * F, D),
+        "ffn.proj_down.weight": rand(rng, D, F),
+    }
+    if K > 0:
+        sd["xlstm.conv1d.conv.weight"] = rand(rng, D, 1, K)
+        sd["xlstm.conv1d.conv.bias"] = rand(rng, D, scale=0.1)
+    return sd
+
+
+def headwise(w, x):
+    nh, dout, din = w.shape
+    return np.einsum("hod,hd->ho", w, x.reshape(nh, din)).reshape(-1)
+
+
+# ============================================================================
+# NX-AI block semantics — compared against the converter's packed forward
+# ============================================================================
+
+def nxai_mlstm_forward(sd, xs):
+    H = sd["xlstm.proj_up.weight"].shape[0] // 2
+    conv_w = sd["xlstm.conv1d.conv.weight"][:, 0, :]
+    state = (np.zeros((H, H)), np.zeros(H), 0.0)
+    hist, outs = [], []
+    for x in xs:
+        xn = layer_norm(x, 1.0 + sd["xlstm_norm.weight"])
+        xm, z = np.split(sd["xlstm.proj_up.weight"] @ xn, 2)
+        xc = silu(causal_conv(hist, xm, conv_w, sd["xlstm.conv1d.conv.bias"]))
+        hist.append(xm)
+        q = headwise(sd["xlstm.q_proj.weight"], xc)
+        k = headwise(sd["xlstm.k_proj.weight"], xc)
+        v = headwise(sd["xlstm.v_proj.weight"], xm)
+        qkv = np.concatenate([q, k, v])
+        ig = sd["xlstm.mlstm_cell.igate.weight"][0] @ qkv + sd["xlstm.mlstm_cell.igate.bias"][0]
+        fg = sd["xlstm.mlstm_cell.fgate.weight"][0] @ qkv + sd["xlstm.mlstm_cell.fgate.bias"][0]
+        h, state = mlstm_update(state, q, k, v, ig, fg)
+        h = group_norm(h, 1.0 + sd["xlstm.mlstm_cell.outnorm.weight"], 1)
+        h = (h + sd["xlstm.learnable_skip"] * xc) * silu(z)
+        outs.append(x + sd["xlstm.proj_down.weight"] @ h)
+    return np.array(outs)
+
+
+def nxai_slstm_forward(sd, xs):
+    D = sd["xlstm_norm.weight"].shape[0]
+    NH = sd["xlstm.zgate.weight"].shape[0]
+    DH = D // NH
+    rk = sd["xlstm.slstm_cell._recurrent_kernel_"].reshape(NH, 4, DH, DH)
+    bias = sd["xlstm.slstm_cell._bias_"].reshape(NH, 4, DH)
+    has_conv = "xlstm.conv1d.conv.weight" in sd
+    state = (np.zeros(D), np.zeros(D), np.zeros(D), np.zeros(D))
+    hist, outs = [], []
+    for x in xs:
+        xn = layer_norm(x, 1.0 + sd["xlstm_norm.weight"])
+        xc = xn
+        if has_conv:
+            xc = silu(causal_conv(hist, xn, sd["xlstm.conv1d.conv.weight"][:, 0, :],
+                                  sd["xlstm.conv1d.conv.bias"]))
+        hist.append(xn)
+        gates = [headwise(sd["xlstm.igate.weight"], xc),
+                 headwise(sd["xlstm.fgate.weight"], xc),
+                 headwise(sd["xlstm.zgate.weight"], xn),
+                 headwise(sd["xlstm.ogate.weight"], xn)]
+        y_heads = state[0].reshape(NH, DH)
+        for g in range(4):
+            gates[g] = gates[g] + np.concatenate(
+                [rk[h, g] @ y_heads[h] + bias[h, g] for h in range(NH)])
+        y, state = slstm_update(state, np.concatenate(gates))
+        r = x + group_norm(y, 1.0 + sd["xlstm.group_norm.weight"], NH)
+        u, g = np.split(sd["ffn.proj_up.weight"] @ layer_norm(r, 1.0 + sd["ffn_norm.weight"]), 2)
+        outs.append(r + sd["ffn.proj_down.weight"] @ (gelu(u) * g))
+    return np.array(outs)
+
+
+# ============================================================================
+# Test cases
+# ============================================================================
+
+def check(name, cond):
+    print(f"[ {'OK' if cond else 'FAILED':>6} ] {name}")
+    return bool(cond)
+
+
+def test_mlstm_block_matches_nxai(rng):
+    sd = {f"xlstm_block_stack.blocks.0.{k}": v
+          for k, v in nxai_mlstm_block(rng, D=6, H=8, K=4, bs=4).items()}
+    layers, skipped = xc.convert(sd)
+    layer = layers[0]
+    xs = rand(rng, 5, 6, scale=1.0)
+    err = np.max(np.abs(nxai_mlstm_forward(xc.split_blocks(sd)[0][0], xs)
+                        - xc.mlstm_block_forward(layer["tensors"], layer["dims"], xs)))
+    return check(f"mLSTM block matches NX-AI (max err {err:.2e})",
+                 layer["kind"] == xc.KIND_MLSTM_BLOCK_F32 and
+                 layer["dims"] == (6, 8, 4, 1) and not skipped and err < ATOL)
+
+
+def test_slstm_block_matches_nxai(rng):
+    ok = True
+    for K in (4, 0):
+        sd = {f"blocks.0.{k}": v
+              for k, v in nxai_slstm_block(rng, D=8, NH=2, K=K, F=12).items()}
+        layer = xc.convert(sd)[0][0]
+        xs = rand(rng, 5, 8, scale=1.0)
+        err = np.max(np.abs(nxai_slstm_forward(xc.split_blocks(sd)[0][0], xs)
+                            - xc.slstm_block_forward(layer["tensors"], layer["dims"], xs)))
+        ok &= check(f"sLSTM block K={K} matches NX-AI (max err {err:.2e})",
+                    layer["dims"] == (8, 12, max(K, 1), 2) and err < ATOL)
+    return ok
+
+
+def test_file_roundtrip(rng):
+    sd = {f"blocks.0.{k}": v for k, v in nxai_mlstm_block(rng, 6, 8, 4, 4).items()}
+    sd.update({f"blocks.1.{k}": v for k, v in nxai_slstm_block(rng, 6, 2, 4, 10).items()})
+    sd["post_blocks_norm.weight"] = rand(rng, 6)
+    layers, skipped = xc.convert(sd)
+    data = xc.serialize(layers)
+
+    ok = check("skips keys without a layer kind", skipped == ["post_blocks_norm.weight"])
+    magic, _, _, num_layers, num_tensors, total = struct.unpack_from("<IHHIIQ", data)
+    ok &= check("header", magic == xc.MODEL_MAGIC and num_layers == 2 and
+                total == len(data) and total % xc.MODEL_ALIGN == 0)
+
+    parsed = xc.read_model(data)
+    same = True
+    for layer, (kind, dims, _, named) in zip(layers, parsed):
+        present = {k: v for k, v in layer["tensors"].items() if v is not None}
+        same &= kind == layer["kind"] and tuple(dims) == layer["dims"]
+        same &= set(named) == set(present)
+        for name, arr in present.items():
+            same &= np.array_equal(named[name][0].reshape(arr.shape), arr)
+    ok &= check("tensors round-trip", same and
+                num_tensors == sum(len(p[3]) for p in parsed))
+
+    with tempfile.TemporaryDirectory() as tmp:
+        path = os.path.join(tmp, "m.xlsm")
+        with open(path, "wb") as f:
+            f.write(data)
+        ok &= check("file write", os.path.getsize(path) == len(data))
+    return ok
+
+
+def test_q8_close_to_f32(rng):
+    sd = {f"blocks.0.{k}": v for k, v in nxai_slstm_block(rng, 8, 2, 4, 12).items()}
+    f32 = xc.convert(sd)[0][0]
+    xs = rand(rng, 32, 8, scale=1.0)
+    q8 = xc.convert(sd, q8=True, calib=xs, ranges={"x": 4.0})[0][0]
+    t = q8["tensors"]
+    ok = check("q8 kind and dtypes", q8["kind"] == xc.KIND_SLSTM_BLOCK_Q8 and
+               t["cell_W"].dtype == np.int8 and t["cell_R"].dtype == np.int8 and
+               t["up_W"].dtype == np.int8 and t["cell_b"].dtype == np.int32 and
+               t["ln_w"].dtype == np.float32)
+    err = 0.0
+    for name in xc.Q8_WEIGHTS:
+        err = max(err, np.max(np.abs(t[name] * q8["scales"][name] - f32["tensors"][name])))
+    b_scale = q8["scales"]["cell_W"] * q8["quant"]["x"][0]
+    err_b = np.max(np.abs(t["cell_b"] * b_scale - f32["tensors"]["cell_b"]))
+    ok &= check(f"q8 weights dequantize (max err {err:.2e})", err < 0.01 and err_b < b_scale)
+    stats = {}
+    xc.slstm_block_forward(f32["tensors"], f32["dims"], xs, stats)
+    ok &= check("q8 ranges calibrated", q8["quant"]["y"][0] > stats["y"] / 127 and
+                q8["quant"]["n"][0] > stats["n"] / 32767)
+    parsed = xc.read_model(xc.serialize([q8]))[0]
+    ok &= check("q8 quant params stored", parsed[2]["x"][0] == np.float32(4.0 / 127) and
+                parsed[3]["cell_R"][1] == np.float32(q8["scales"]["cell_R"]))
+    return ok
+
+
+def test_rejects_multihead_mlstm(rng):
+    sd = {f"blocks.0.{k}": v for k, v in nxai_mlstm_block(rng, 6, 8, 4, 4).items()}
+    sd["blocks.0.xlstm.mlstm_cell.igate.weight"] = rand(rng, 2, 24)
+    try:
+        xc.convert(sd)
+    except ValueError:
+        return check("rejects multi-head mLSTM", True)
+    return check("rejects multi-head mLSTM", False)
+
+
+def main():
+    print("[==========] Running checkpoint converter tests")
+    rng = np.random.default_rng(0)
+    tests = [test_mlstm_block_matches_nxai, test_slstm_block_matches_nxai,
+             test_file_roundtrip, test_q8_close_to_f32, test_rejects_multihead_mlstm]
+    passed = sum(1 for test in tests if test(rng))
+    print(f"[==========] {passed}/{len(tests)} tests passed")
+    return 0 if passed == len(tests) else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -10,8 +10,8 @@
 static int g_tests_run = 0;
 static int g_tests_passed = 0;
 
-static bool ExpectNear(const char* name, const float* expected,
-                       const float* actual, int len, float tol) {
+static inline bool ExpectNear(const char* name, const float* expected,
+                              const float* actual, int len, float tol) {
     for (int i = 0; i < len; ++i) {
         float diff = std::abs(expected[i] - actual[i]);
         if (diff > tol) {
@@ -23,7 +23,7 @@ static bool ExpectNear(const char* name, const float* expected,
     return true;
 }
 
-static bool ExpectFinite(const char* name, const float* vals, int len) {
+static inline bool ExpectFinite(const char* name, const float* vals, int len) {
     for (int i = 0; i < len; ++i) {
         if (!std::isfinite(vals[i])) {
             std::printf("  FAIL %s[%d]: not finite (%.8f)\n", name, i, vals[i]);
@@ -0,0 +1,421 @@
+/* xLSTM block unit tests
+ *
+ * Checks the fused f32 blocks against a plain step-by-step reference, that
+ * chunked evaluation carries the conv history, and that the INT8 blocks
+ * track the f32 blocks.
+ *
+ * Build:
+ *   make test
+ * =========================================================================*/
+
+#include "xlstm_block.h"
+#include "xlstm_block_q8.h"
+#include "xlstm_quant.h"
+#include "test_util.h"
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+// ============================================================================
+// Test model
+// ============================================================================
+
+namespace {
+
+constexpr int kB = 2, kT = 5, kD = 4, kH = 4, kF = 6, kK = 3, kHeads = 2;
+constexpr float kTolerance = 1e-5f;
+
+/* Deterministic pseudo-random fill in [-scale, scale] */
+std::vector<float> Fill(int len, float seed, float scale) {
+    std::vector<float> v(len);
+    for (int i = 0; i < len; ++i) v[i] = scale * std::sin(seed + 1.7f * i);
+    return v;
+}
+
+struct MlstmWeights {
+    std::vector<float> ln_w = Fill(kD, 0.1f, 0.3f), ln_b = Fill(kD, 0.2f, 0.1f);
+    std::vector<float> up_W = Fill(2 * kH * kD, 0.3f, 0.6f);
+    std::vector<float> conv_w = Fill(kH * kK, 0.4f, 0.5f), conv_b = Fill(kH, 0.5f, 0.1f);
+    std::vector<float> cell_W = Fill((4 * kH + 2) * 2 * kH, 0.6f, 0.5f);
+    std::vector<float> cell_b = Fill(4 * kH + 2, 0.7f, 0.1f);
+    std::vector<float> gn_w = Fill(kH, 0.8f, 0.3f), skip = Fill(kH, 0.9f, 0.5f);
+    std::vector<float> down_W = Fill(kD * kH, 1.0f, 0.6f), down_b = Fill(kD, 1.1f, 0.1f);
+
+    MlstmWeights() {
+        for (float& w : ln_w) w += 1.0f;
+        for (float& w : gn_w) w += 1.0f;
+    }
+
+    XlstmMlstmBlock Block() const {
+        XlstmMlstmBlock blk;
+        std::memset(&blk, 0, sizeof(blk));
+        blk.embed_dim = kD; blk.inner_dim = kH; blk.conv_kernel = kK; blk.num_heads = kHeads;
+        blk.ln_w = ln_w.data(); blk.ln_b = ln_b.data();
+        blk.up_W = up_W.data();
+        blk.conv_w = conv_w.data(); blk.conv_b = conv_b.data();
+        blk.cell_W = cell_W.data(); blk.cell_b = cell_b.data();
+        blk.gn_w = gn_w.data(); blk.skip = skip.data();
+        blk.down_W = down_W.data(); blk.down_b = down_b.data();
+        return blk;
+    }
+};
+
+struct SlstmWeights {
+    std::vector<float> ln_w = Fill(kD, 1.2f, 0.3f), ln_b = Fill(kD, 1.3f, 0.1f);
+    std::vector<float> conv_w = Fill(kD * kK, 1.4f, 0.5f);
+    std::vector<float> cell_W = Fill(4 * kD * 2 * kD, 1.5f, 0.5f);
+    std::vector<float> cell_R = Fill(4 * kD * kD, 1.6f, 0.4f);
+    std::vector<float> cell_b = Fill(4 * kD, 1.7f, 0.1f);
+    std::vector<float> gn_w = Fill(kD, 1.8f, 0.3f);
+    std::vector<float> ln2_w = Fill(kD, 1.9f, 0.3f);
+    std::vector<float> up_W = Fill(2 * kF * kD, 2.0f, 0.6f), up_b = Fill(2 * kF, 2.1f, 0.1f);
+    std::vector<float> down_W = Fill(kD * kF, 2.2f, 0.6f);
+
+    SlstmWeights() {
+        for (float& w : ln_w) w += 1.0f;
+        for (float& w : gn_w) w += 1.0f;
+        for (float& w : ln2_w) w += 1.0f;
+    }
+
+    XlstmSlstmBlock Block() const {
+        XlstmSlstmBlock blk;
+        std::memset(&blk, 0, sizeof(blk));
+        blk.embed_dim = kD; blk.ffn_dim = kF; blk.conv_kernel = kK; blk.num_heads = kHeads;
+        blk.ln_w = ln_w.data(); blk.ln_b = ln_b.data();
+        blk.conv_w = conv_w.data();
+        blk.cell_W = cell_W.data(); blk.cell_R = cell_R.data(); blk.cell_b = cell_b.data();
+        blk.gn_w = gn_w.data();
+        blk.ln2_w = ln2_w.data();
+        blk.up_W = up_W.data(); blk.up_b = up_b.data();
+        blk.down_W = down_W.data();
+        return blk;
+    }
+};
+
+/* Zero-initialized state storage for either block type */
+struct StateF32 {
+    std::vector<float> y, c, n, m, conv;
+    StateF32(int H, int c_len, int m_len, int channels)
+        : y(kB * H), c(kB * c_len), n(kB * H), m(kB * m_len), conv(kB * (kK - 1) * channels) {}
+    XlstmBlockState View() {
+        return {y.data(), c.data(), n.data(), m.data(), conv.data()};
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Plain reference: one stage at a time, whole-sequence buffers
+// ----------------------------------------------------------------------------
+
+void RefLayerNorm(const float* x, const float* w, const float* b, float* out, int len) {
+    double mean = 0, var = 0;
+    for (int i = 0; i < len; ++i) mean += x[i];
+    mean /= len;
+    for (int i = 0; i < len; ++i) var += (x[i] - mean) * (x[i] - mean);
+    var /= len;
+    for (int i = 0; i < len; ++i) {
+        out[i] = (float)((x[i] - mean) / std::sqrt(var + 1e-5)) * w[i] + (b ? b[i] : 0.0f);
+    }
+}
+
+void RefGroupNorm(float* x, const float* w, int len, int groups) {
+    int g_len = len / groups;
+    for (int g = 0; g < groups; ++g) {
+        RefLayerNorm(x + g * g_len, w + g * g_len, nullptr, x + g * g_len, g_len);
+    }
+}
+
+float RefSwish(float x) { return x / (1.0f + std::exp(-x)); }
+
+/* Causal depthwise conv over a whole [T, C] sequence */
+void RefConv(const float* x, const float* w, const float* b, float* out, int T, int C) {
+    for (int t = 0; t < T; ++t) {
+        for (int ch = 0; ch < C; ++ch) {
+            float acc = b ? b[ch] : 0.0f;
+            for (int k = 0; k < kK; ++k) {
+                int src = t - (kK - 1) + k;
+                if (src >= 0) acc += w[ch * kK + k] * x[src * C + ch];
+            }
+            out[t * C + ch] = acc;
+        }
+    }
+}
+
+void RefMlstmBlock(const MlstmWeights& w, const float* input, float* output) {
+    for (int b = 0; b < kB; ++b) {
+        const float* x = input + b * kT * kD;
+        std::vector<float> xm(kT * kH), z(kT * kH), xc(kT * kH);
+        for (int t = 0; t < kT; ++t) {
+            float xn[kD];
+            RefLayerNorm(x + t * kD, w.ln_w.data(), w.ln_b.data(), xn, kD);
+            for (int i = 0; i < 2 * kH; ++i) {
+                float acc = 0.0f;
+                for (int j = 0; j < kD; ++j) acc += w.up_W[i * kD + j] * xn[j];
+                (i < kH ? xm[t * kH + i] : z[t * kH + i - kH]) = acc;
+            }
+        }
+        RefConv(xm.data(), w.conv_w.data(), w.conv_b.data(), xc.data(), kT, kH);
+        for (float& v : xc) v = RefSwish(v);
+
+        float y[kH] = {0}, C[kH * kH] = {0}, n[kH] = {0}, m[1] = {0};
+        float scratch[4 * kH + 2];
+        MlstmParams params = {0.0f, 0};
+        for (int t = 0; t < kT; ++t) {
+            float cat[2 * kH], h[kH];
+            std::memcpy(cat, &xc[t * kH], sizeof(float) * kH);
+            std::memcpy(cat + kH, &xm[t * kH], sizeof(float) * kH);
+            mlstm_step_f32(cat, w.cell_W.data(), w.cell_b.data(), y, C, n, m,
+                           scratch, 2 * kH, kH, &params);
+            std::memcpy(h, y, sizeof(h));
+            RefGroupNorm(h, w.gn_w.data(), kH, kHeads);
+            for (int i = 0; i < kH; ++i) {
+                h[i] = (h[i] + w.skip[i] * xc[t * kH + i]) * RefSwish(z[t * kH + i]);
+            }
+            for (int i = 0; i < kD; ++i) {
+                float acc = w.down_b[i];
+                for (int j = 0; j < kH; ++j) acc += w.down_W[i * kH + j] * h[j];
+                output[(b * kT + t) * kD + i] = x[t * kD + i] + acc;
+            }
+        }
+    }
+}
+
+void RefSlstmBlock(const SlstmWeights& w, const float* input, float* output) {
+    for (int b = 0; b < kB; ++b) {
+        const float* x = input + b * kT * kD;
+        std::vector<float> xn(kT * kD), xc(kT * kD);
+        for (int t = 0; t < kT; ++t) {
+            RefLayerNorm(x + t * kD, w.ln_w.data(), w.ln_b.data(), &xn[t * kD], kD);
+        }
+        RefConv(xn.data(), w.conv_w.data(), nullptr, xc.data(), kT, kD);
+        for (float& v : xc) v = RefSwish(v);
+
+        float y[kD] = {0}, c[kD] = {0}, n[kD] = {0}, m[kD] = {0};
+        float scratch[4 * kD];
+        SlstmParams params = {0.0f, 0};
+        for (int t = 0; t < kT; ++t) {
+            float cat[2 * kD], r[kD], rn[kD], u[2 * kF];
+            std::memcpy(cat, &xc[t * kD], sizeof(float) * kD);
+            std::memcpy(cat + kD, &xn[t * kD], sizeof(float) * kD);
+            slstm_step_f32(cat, w.cell_W.data(), w.cell_R.data(), w.cell_b.data(),
+                           y, c, n, m, scratch, 2 * kD, kD, &params);
+            std::memcpy(r, y, sizeof(r));
+            RefGroupNorm(r, w.gn_w.data(), kD, kHeads);
+            for (int i = 0; i < kD; ++i) r[i] += x[t * kD + i];
+            RefLayerNorm(r, w.ln2_w.data(), nullptr, rn, kD);
+            for (int i = 0; i < 2 * kF; ++i) {
+                float acc = w.up_b[i];
+                for (int j = 0; j < kD; ++j) acc += w.up_W[i * kD + j] * rn[j];
+                u[i] = acc;
+            }
+            for (int i = 0; i < kF; ++i) {
+                u[i] = 0.5f * u[i] * (1.0f + std::erf(u[i] / std::sqrt(2.0f))) * u[kF + i];
+            }
+            for (int i = 0; i < kD; ++i) {
+                float acc = 0.0f;
+                for (int j = 0; j < kF; ++j) acc += w.down_W[i * kF + j] * u[j];
+                output[(b * kT + t) * kD + i] = r[i] + acc;
+            }
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// INT8 weights derived from the f32 weights
+// ----------------------------------------------------------------------------
+
+struct QuantMatrix {
+    std::vector<int8_t> q;
+    float scale;
+    explicit QuantMatrix(const std::vector<float>& w) : q(w.size()) {
+        XlstmQuantParam qp;
+        xlstm_quant_symmetric(w.data(), (int)w.size(), &qp);
+        xlstm_quantize_f32_to_s8(w.data(), q.data(), (int)w.size(), &qp);
+        scale = qp.scale;
+    }
+};
+
+/* Cell input in [-4, 4], y in [-2.5, 2.5], INT16 states in [-32, 32] */
+template <typename P>
+void SetCellQuant(P* p, float W_scale) {
+    p->cell_clip = 0.0f;
+    p->W_scale = W_scale;
+    p->x_quant = {8.0f / 255.0f, 0};
+    p->y_quant = {2.5f / 127.0f, 0};
+    p->n_quant = {32.0f / 32767.0f, 0};
+}
+
+std::vector<int32_t> QuantBias(const std::vector<float>& b, float scale) {
+    std::vector<int32_t> q(b.size());
+    XlstmQuantParam qp = {scale, 0};
+    xlstm_quantize_f32_to_s32(b.data(), q.data(), (int)b.size(), &qp);
+    return q;
+}
+
+float MaxAbsDiff(const float* a, const float* b, int len) {
+    float max_err = 0.0f;
+    for (int i = 0; i < len; ++i) max_err = std::fmax(max_err, std::fabs(a[i] - b[i]));
+    return max_err;
+}
+
+}  // namespace
+
+// ============================================================================
+// Test cases
+// ============================================================================
+
+bool TestMlstmBlockMatchesReference() {
+    MlstmWeights w;
+    XlstmMlstmBlock blk = w.Block();
+    std::vector<float> input = Fill(kB * kT * kD, 3.1f, 1.5f);
+    std::vector<float> expected(kB * kT * kD), output(kB * kT * kD);
+    RefMlstmBlock(w, input.data(), expected.data());
+
+    StateF32 st(kH, kH * kH, 1, kH);
+    XlstmBlockState state = st.View();
+    std::vector<float> scratch(mlstm_block_scratch_size(&blk));
+    mlstm_block_eval_f32(&blk, input.data(), output.data(), &state, scratch.data(), kB, kT);
+
+    return ExpectNear("output", expected.data(), output.data(), kB * kT * kD, kTolerance);
+}
+
+bool TestSlstmBlockMatchesReference() {
+    SlstmWeights w;
+    XlstmSlstmBlock blk = w.Block();
+    std::vector<float> input = Fill(kB * kT * kD, 4.3f, 1.5f);
+    std::vector<float> expected(kB * kT * kD), output(kB * kT * kD);
+    RefSlstmBlock(w, input.data(), expected.data());
+
+    StateF32 st(kD, kD, kD, kD);
+    XlstmBlockState state = st.View();
+    std::vector<float> scratch(slstm_block_scratch_size(&blk));
+    slstm_block_eval_f32(&blk, input.data(), output.data(), &state, scratch.data(), kB, kT);
+
+    return ExpectNear("output", expected.data(), output.data(), kB * kT * kD, kTolerance);
+}
+
+bool TestMlstmBlockStreamingCarriesConv() {
+    /* T steps in one call vs. one step per call, in place */
+    MlstmWeights w;
+    XlstmMlstmBlock blk = w.Block();
+    std::vector<float> input = Fill(kT * kD, 5.7f, 1.5f);
+    std::vector<float> whole(kT * kD);
+    std::vector<float> scratch(mlstm_block_scratch_size(&blk));
+
+    StateF32 a(kH, kH * kH, 1, kH), b(kH, kH * kH, 1, kH);
+    XlstmBlockState sa = a.View(), sb = b.View();
+    mlstm_block_eval_f32(&blk, input.data(), whole.data(), &sa, scratch.data(), 1, kT);
+
+    std::vector<float> stream = input;
+    for (int t = 0; t < kT; ++t) {
+        mlstm_block_step_f32(&blk, &stream[t * kD], &stream[t * kD], &sb, 0, scratch.data());
+    }
+    bool ok = std::memcmp(whole.data(), stream.data(), sizeof(float) * kT * kD) == 0;
+    ok &= a.conv == b.conv && a.c == b.c;
+    if (!ok) std::printf("  FAIL: streamed steps differ from one eval call\n");
+    return ok;
+}
+
+bool TestMlstmBlockQ8TracksF32() {
+    /* One norm group: GroupNorm over two channels turns the rounding noise
+     * of near-zero cell outputs into O(1) differences */
+    MlstmWeights w;
+    XlstmMlstmBlock blk = w.Block();
+    blk.num_heads = 1;
+    std::vector<float> input = Fill(kB * kT * kD, 3.1f, 1.5f);
+    std::vector<float> ref(kB * kT * kD), output(kB * kT * kD);
+
+    StateF32 st(kH, kH * kH, 1, kH);
+    XlstmBlockState state = st.View();
+    std::vector<float> scratch(mlstm_block_scratch_size(&blk));
+    mlstm_block_eval_f32(&blk, input.data(), ref.data(), &state, scratch.data(), kB, kT);
+
+    QuantMatrix up(w.up_W), cell(w.cell_W), down(w.down_W);
+    XlstmMlstmBlockQ8 q;
+    std::memset(&q, 0, sizeof(q));
+    q.embed_dim = kD; q.inner_dim = kH; q.conv_kernel = kK; q.num_heads = 1;
+    q.ln_w = w.ln_w.data(); q.ln_b = w.ln_b.data();
+    q.up_W = up.q.data(); q.up_scale = up.scale;
+    q.conv_w = w.conv_w.data(); q.conv_b = w.conv_b.data();
+    q.cell_W = cell.q.data();
+    q.gn_w = w.gn_w.data(); q.skip = w.skip.data();
+    q.down_W = down.q.data(); q.down_scale = down.scale; q.down_b = w.down_b.data();
+    SetCellQuant(&q.cell_params, cell.scale);
+    /* mLSTM outputs and states are an order of magnitude smaller here */
+    q.cell_params.y_quant = {0.25f / 127.0f, 0};
+    q.cell_params.C_quant = {1.0f / 32767.0f, 0};
+    q.cell_params.n_quant = {1.0f / 32767.0f, 0};
+    std::vector<int32_t> cell_b = QuantBias(w.cell_b, cell.scale * q.cell_params.x_quant.scale);
+    q.cell_b = cell_b.data();
+
+    std::vector<int8_t> y(kB * kH, 0);
+    std::vector<int16_t> C(kB * kH * kH, 0), n(kB * kH, 0);
+    std::vector<float> m(kB, 0.0f), conv(kB * (kK - 1) * kH, 0.0f);
+    XlstmBlockStateQ8 sq = {y.data(), C.data(), n.data(), m.data(), conv.data()};
+    std::vector<float> ws(mlstm_block_q8_workspace_size(&q) / sizeof(float) + 1);
+    mlstm_block_eval_q8(&q, input.data(), output.data(), &sq, ws.data(), kB, kT);
+
+    float err = MaxAbsDiff(ref.data(), output.data(), kB * kT * kD);
+    std::printf("  max absolute error vs f32: %f\n", err);
+    bool ok = ExpectFinite("output", output.data(), kB * kT * kD);
+    ok &= err < 0.1f;
+    return ok;
+}
+
+bool TestSlstmBlockQ8TracksF32() {
+    SlstmWeights w;
+    XlstmSlstmBlock blk = w.Block();
+    std::vector<float> input = Fill(kB * kT * kD, 4.3f, 1.5f);
+    std::vector<float> ref(kB * kT * kD), output(kB * kT * kD);
+
+    StateF32 st(kD, kD, kD, kD);
+    XlstmBlockState state = st.View();
+    std::vector<float> scratch(slstm_block_scratch_size(&blk));
+    slstm_block_eval_f32(&blk, input.data(), ref.data(), &state, scratch.data(), kB, kT);
+
+    QuantMatrix cell(w.cell_W), rec(w.cell_R), up(w.up_W), down(w.down_W);
+    XlstmSlstmBlockQ8 q;
+    std::memset(&q, 0, sizeof(q));
+    q.embed_dim = kD; q.ffn_dim = kF; q.conv_kernel = kK; q.num_heads = kHeads;
+    q.ln_w = w.ln_w.data(); q.ln_b = w.ln_b.data();
+    q.conv_w = w.conv_w.data();
+    q.cell_W = cell.q.data(); q.cell_R = rec.q.data();
+    q.gn_w = w.gn_w.data(); q.ln2_w = w.ln2_w.data();
+    q.up_W = up.q.data(); q.up_scale = up.scale; q.up_b = w.up_b.data();
+    q.down_W = down.q.data(); q.down_scale = down.scale;
+    SetCellQuant(&q.cell_params, cell.scale);
+    q.cell_params.R_scale = rec.scale;
+    q.cell_params.c_quant = {32.0f / 32767.0f, 0};
+    std::vector<int32_t> cell_b = QuantBias(w.cell_b, cell.scale * q.cell_params.x_quant.scale);
+    q.cell_b = cell_b.data();
+
+    std::vector<int8_t> y(kB * kD, 0);
+    std::vector<int16_t> c(kB * kD, 0), n(kB * kD, 0);
+    std::vector<float> m(kB * kD, 0.0f), conv(kB * (kK - 1) * kD, 0.0f);
+    XlstmBlockStateQ8 sq = {y.data(), c.data(), n.data(), m.data(), conv.data()};
+    std::vector<float> ws(slstm_block_q8_workspace_size(&q) / sizeof(float) + 1);
+    slstm_block_eval_q8(&q, input.data(), output.data(), &sq, ws.data(), kB, kT);
+
+    float err = MaxAbsDiff(ref.data(), output.data(), kB * kT * kD);
+    std::printf("  max absolute error vs f32: %f\n", err);
+    bool ok = ExpectFinite("output", output.data(), kB * kT * kD);
+    ok &= err < 0.1f;
+    return ok;
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main() {
+    std::printf("[==========] Running xLSTM block tests\n");
+
+    RUN_TEST(TestMlstmBlockMatchesReference);
+    RUN_TEST(TestSlstmBlockMatchesReference);
+    RUN_TEST(TestMlstmBlockStreamingCarriesConv);
+    RUN_TEST(TestMlstmBlockQ8TracksF32);
+    RUN_TEST(TestSlstmBlockQ8TracksF32);
+
+    std::printf("[==========] %d/%d tests passed\n", g_tests_passed, g_tests_run);
+    return g_tests_passed == g_tests_run ? 0 : 1;
+}
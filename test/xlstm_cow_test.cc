@@ -0,0 +1,176 @@
+/* Copy-on-write state handle unit tests
+ *
+ * Forked branches must evolve exactly like independent copies while sharing
+ * C/n blocks until they step.
+ *
+ * Build:
+ *   make test
+ * =========================================================================*/
+
+#include "xlstm_cow.h"
+#include "test_util.h"
+
+// ============================================================================
+// Reference test data — same golden values as the kernel tests
+// ============================================================================
+
+#include "reference_data.h"
+
+// ============================================================================
+// Test cases
+// ============================================================================
+
+constexpr float kTolerance = 1e-5f;
+
+namespace {
+
+constexpr int kI = 3, kH = 2, kTileRows = 1;
+constexpr int kPerState = kH / kTileRows;
+constexpr int kBlocks = 3 * kPerState, kNBlocks = 3;
+
+struct CowFixture {
+    float blocks[kBlocks * kTileRows * kH];
+    int32_t refcount[kBlocks];
+    int32_t free_list[kBlocks];
+    float n_blocks[kNBlocks * kH];
+    int32_t n_refcount[kNBlocks];
+    int32_t n_free_list[kNBlocks];
+    const float* tile_src[kH];
+    float* tile_dst[kH];
+    XlstmCowPool pool;
+
+    CowFixture() {
+        xlstm_cow_init(&pool, blocks, refcount, free_list, kBlocks,
+                       n_blocks, n_refcount, n_free_list, kNBlocks,
+                       tile_src, tile_dst, kH, kTileRows);
+    }
+};
+
+}  // namespace
+
+bool TestCowForkSharesUntilStep() {
+    CowFixture f;
+    MlstmParams params = {0.0f, 0};
+    float scratch[4 * kH + 2];
+    int32_t ids_a[kPerState], ids_b[kPerState];
+    float y_a[kH], y_b[kH];
+    XlstmCowState a, b;
+
+    bool ok = true;
+    ok &= xlstm_cow_blocks_per_state(kH, kTileRows) == kPerState;
+    ok &= xlstm_cow_state_init(&f.pool, &a, ids_a, y_a) == XLSTM_OK;
+    ok &= xlstm_cow_step_mlstm_f32(&f.pool, &a, kMTest2_input, kMTest1_W, kMTest1_b,
+                                   scratch, kI, &params) == XLSTM_OK;
+
+    /* Fork: no new blocks */
+    xlstm_cow_fork(&f.pool, &b, ids_b, y_b, &a);
+    ok &= f.pool.tiles.num_free == kBlocks - kPerState && f.pool.n.num_free == kNBlocks - 1;
+    ok &= xlstm_cow_tile(&f.pool, &a, 0) == xlstm_cow_tile(&f.pool, &b, 0);
+    ok &= xlstm_cow_n(&f.pool, &a) == xlstm_cow_n(&f.pool, &b);
+
+    /* Both branches run the rest of the sequence; b steps first so a reads
+     * the blocks b just left behind */
+    float out_a[2 * kH], out_b[2 * kH];
+    for (int t = 1; t < 3; ++t) {
+        xlstm_cow_step_mlstm_f32(&f.pool, &b, kMTest2_input + t * kI,
+                                 kMTest1_W, kMTest1_b, scratch, kI, &params);
+        xlstm_cow_step_mlstm_f32(&f.pool, &a, kMTest2_input + t * kI,
+                                 kMTest1_W, kMTest1_b, scratch, kI, &params);
+        for (int j = 0; j < kH; ++j) {
+            out_a[(t - 1) * kH + j] = a.y[j];
+            out_b[(t - 1) * kH + j] = b.y[j];
+        }
+    }
+    ok &= f.pool.tiles.num_free == kBlocks - 2 * kPerState && f.pool.n.num_free == kNBlocks - 2;
+    ok &= xlstm_cow_tile(&f.pool, &a, 0) != xlstm_cow_tile(&f.pool, &b, 0);
+    ok &= xlstm_cow_n(&f.pool, &a) != xlstm_cow_n(&f.pool, &b);
+    if (!ok) std::printf("  FAIL: block accounting\n");
+
+    float C_a[kH * kH];
+    for (int t = 0; t < kH; ++t) {
+        for (int j = 0; j < kH; ++j) C_a[t * kH + j] = xlstm_cow_tile(&f.pool, &a, t)[j];
+    }
+    ok &= ExpectNear("out_a", kMTest2_expected_output + kH, out_a, 2 * kH, kTolerance);
+    ok &= ExpectNear("out_b", kMTest2_expected_output + kH, out_b, 2 * kH, kTolerance);
+    ok &= ExpectNear("C_a", kMTest2_expected_C, C_a, kH * kH, kTolerance);
+    ok &= ExpectNear("n_a", kMTest2_expected_n, xlstm_cow_n(&f.pool, &a), kH, kTolerance);
+    ok &= ExpectNear("m_a", kMTest2_expected_m, &a.m, 1, kTolerance);
+
+    xlstm_cow_release(&f.pool, &a);
+    xlstm_cow_release(&f.pool, &b);
+    ok &= f.pool.tiles.num_free == kBlocks && f.pool.n.num_free == kNBlocks;
+    return ok;
+}
+
+bool TestCowDivergedBranchLeavesParent() {
+    CowFixture f;
+    MlstmParams params = {0.0f, 0};
+    float scratch[4 * kH + 2];
+    int32_t ids_a[kPerState], ids_b[kPerState];
+    float y_a[kH], y_b[kH];
+    XlstmCowState a, b;
+
+    xlstm_cow_state_init(&f.pool, &a, ids_a, y_a);
+    xlstm_cow_step_mlstm_f32(&f.pool, &a, kMTest1_input, kMTest1_W, kMTest1_b,
+                             scratch, kI, &params);
+    xlstm_cow_fork(&f.pool, &b, ids_b, y_b, &a);
+
+    /* The branch takes a different input; the parent must not change */
+    const float other[kI] = {-1.0f, 2.0f, 0.5f};
+    xlstm_cow_step_mlstm_f32(&f.pool, &b, other, kMTest1_W, kMTest1_b,
+                             scratch, kI, &params);
+
+    float C_a[kH * kH];
+    for (int t = 0; t < kH; ++t) {
+        for (int j = 0; j < kH; ++j) C_a[t * kH + j] = xlstm_cow_tile(&f.pool, &a, t)[j];
+    }
+    bool ok = true;
+    ok &= ExpectNear("y_a", kMTest1_expected_y, a.y, kH, kTolerance);
+    ok &= ExpectNear("C_a", kMTest1_expected_C, C_a, kH * kH, kTolerance);
+    ok &= ExpectNear("n_a", kMTest1_expected_n, xlstm_cow_n(&f.pool, &a), kH, kTolerance);
+    return ok;
+}
+
+bool TestCowPoolExhaustion() {
+    CowFixture f;
+    MlstmParams params = {0.0f, 0};
+    float scratch[4 * kH + 2];
+    int32_t ids[4][kPerState];
+    float y[4][kH];
+    XlstmCowState s[4];
+
+    bool ok = true;
+    ok &= xlstm_cow_state_init(&f.pool, &s[0], ids[0], y[0]) == XLSTM_OK;
+    ok &= xlstm_cow_state_init(&f.pool, &s[1], ids[1], y[1]) == XLSTM_OK;
+    xlstm_cow_fork(&f.pool, &s[2], ids[2], y[2], &s[0]);
+    xlstm_cow_fork(&f.pool, &s[3], ids[3], y[3], &s[0]);
+
+    /* One free state's worth of blocks: the first branch to diverge gets
+     * it, the next one fails cleanly until something is released */
+    ok &= xlstm_cow_step_mlstm_f32(&f.pool, &s[2], kMTest1_input, kMTest1_W,
+                                   kMTest1_b, scratch, kI, &params) == XLSTM_OK;
+    ok &= xlstm_cow_step_mlstm_f32(&f.pool, &s[3], kMTest1_input, kMTest1_W,
+                                   kMTest1_b, scratch, kI, &params) == XLSTM_ERR_SIZE;
+    ok &= s[3].m == 0.0f;
+    xlstm_cow_release(&f.pool, &s[1]);
+    ok &= xlstm_cow_step_mlstm_f32(&f.pool, &s[3], kMTest1_input, kMTest1_W,
+                                   kMTest1_b, scratch, kI, &params) == XLSTM_OK;
+    ok &= ExpectNear("y", kMTest1_expected_y, s[3].y, kH, kTolerance);
+    if (!ok) std::printf("  FAIL: exhaustion handling\n");
+    return ok;
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main() {
+    std::printf("[==========] Running copy-on-write state tests\n");
+
+    RUN_TEST(TestCowForkSharesUntilStep);
+    RUN_TEST(TestCowDivergedBranchLeavesParent);
+    RUN_TEST(TestCowPoolExhaustion);
+
+    std::printf("[==========] %d/%d tests passed\n", g_tests_passed, g_tests_run);
+    return g_tests_passed == g_tests_run ? 0 : 1;
+}
@@ -0,0 +1,140 @@
+/* Fixed-dimension kernel unit tests
+ *
+ * Instantiates the macro kernels for the reference shapes and for odd
+ * sizes: results must match the golden values and be bit-identical to the
+ * generic step/eval kernels, including cell clipping and batched evals.
+ *
+ * Build:
+ *   make test
+ * =========================================================================*/
+
+#include "xlstm_fixed.h"
+#include "test_util.h"
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+// ============================================================================
+// Reference test data — same golden values as the kernel tests
+// ============================================================================
+
+#include "reference_data.h"
+
+static const float kTolerance = 1e-5f;
+
+// ============================================================================
+// Instantiations
+// ============================================================================
+
+XLSTM_DEFINE_SLSTM_F32(ref_s, 2, 2)
+XLSTM_DEFINE_MLSTM_F32(ref_m, 3, 2)
+XLSTM_DEFINE_SLSTM_F32(odd_s, 5, 7)
+XLSTM_DEFINE_MLSTM_F32(odd_m, 6, 9)
+
+static std::vector<float> Wave(int len, float seed, float scale) {
+    std::vector<float> v(len);
+    for (int i = 0; i < len; ++i) v[i] = scale * std::sin(seed + 0.91f * i);
+    return v;
+}
+
+// ============================================================================
+// Test cases
+// ============================================================================
+
+bool TestFixedMatchesReference() {
+    const int T = 3;
+    bool ok = true;
+
+    float y[2] = {0}, c[2] = {0}, n[2] = {0}, m[2] = {0}, out[T * 2];
+    SlstmParams sp = {0.0f, 0};
+    ref_s_eval_f32(kTest2_input, kTest1_W, kTest1_R, kTest1_b,
+                   y, c, n, m, out, 1, T, &sp);
+    ok &= ExpectNear("slstm output", kTest2_expected_output, out, T * 2, kTolerance);
+
+    float my[2] = {0}, C[4] = {0}, mn[2] = {0}, mm[1] = {0};
+    MlstmParams mp = {0.0f, 0};
+    ref_m_step_f32(kMTest1_input, kMTest1_W, kMTest1_b, my, C, mn, mm, &mp);
+    ok &= ExpectNear("mlstm y", kMTest1_expected_y, my, 2, kTolerance);
+    ok &= ExpectNear("mlstm C", kMTest1_expected_C, C, 4, kTolerance);
+    ok &= ExpectNear("mlstm m", kMTest1_expected_m, mm, 1, kTolerance);
+    return ok;
+}
+
+bool TestFixedSlstmBitExact() {
+    const int B = 2, T = 6, I = 5, H = 7;
+    std::vector<float> input = Wave(B * T * I, 0.2f, 1.5f);
+    std::vector<float> W = Wave(4 * H * I, 0.5f, 0.6f), R = Wave(4 * H * H, 0.9f, 0.4f);
+    std::vector<float> b = Wave(4 * H, 1.3f, 0.3f), scratch(4 * H);
+    bool ok = true;
+
+    for (float clip : {0.0f, 0.4f}) {
+        SlstmParams sp = {clip, 0};
+        std::vector<float> y(B * H, 0.0f), c(B * H, 0.0f), n(B * H, 0.0f), m(B * H, 0.0f);
+        std::vector<float> fy = y, fc = c, fn = n, fm = m, out(B * T * H), fout(B * T * H);
+
+        slstm_eval_f32(input.data(), W.data(), R.data(), b.data(), y.data(), c.data(),
+                       n.data(), m.data(), out.data(), scratch.data(), B, T, I, H, &sp);
+        odd_s_eval_f32(input.data(), W.data(), R.data(), b.data(), fy.data(), fc.data(),
+                       fn.data(), fm.data(), fout.data(), B, T, &sp);
+        ok &= std::memcmp(out.data(), fout.data(), out.size() * sizeof(float)) == 0;
+        ok &= std::memcmp(c.data(), fc.data(), c.size() * sizeof(float)) == 0;
+        ok &= std::memcmp(n.data(), fn.data(), n.size() * sizeof(float)) == 0;
+        ok &= std::memcmp(m.data(), fm.data(), m.size() * sizeof(float)) == 0;
+
+        /* One more step through the step entry point */
+        slstm_step_f32(input.data(), W.data(), R.data(), b.data(), y.data(), c.data(),
+                       n.data(), m.data(), scratch.data(), I, H, &sp);
+        odd_s_step_f32(input.data(), W.data(), R.data(), b.data(), fy.data(), fc.data(),
+                       fn.data(), fm.data(), &sp);
+        ok &= std::memcmp(y.data(), fy.data(), H * sizeof(float)) == 0;
+        if (!ok) std::printf("  FAIL: sLSTM differs (clip %g)\n", clip);
+    }
+    return ok;
+}
+
+bool TestFixedMlstmBitExact() {
+    const int B = 2, T = 5, I = 6, H = 9;
+    std::vector<float> input = Wave(B * T * I, 0.3f, 1.5f);
+    std::vector<float> W = Wave((4 * H + 2) * I, 0.7f, 0.6f), b = Wave(4 * H + 2, 1.1f, 0.3f);
+    std::vector<float> scratch(4 * H + 2);
+    bool ok = true;
+
+    for (float clip : {0.0f, 0.05f}) {
+        MlstmParams mp = {clip, 0};
+        std::vector<float> y(B * H, 0.0f), C(B * H * H, 0.0f), n(B * H, 0.0f), m(B, 0.0f);
+        std::vector<float> fy = y, fC = C, fn = n, fm = m, out(B * T * H), fout(B * T * H);
+
+        mlstm_eval_f32(input.data(), W.data(), b.data(), y.data(), C.data(), n.data(),
+                       m.data(), out.data(), scratch.data(), B, T, I, H, &mp);
+        odd_m_eval_f32(input.data(), W.data(), b.data(), fy.data(), fC.data(), fn.data(),
+                       fm.data(), fout.data(), B, T, &mp);
+        ok &= std::memcmp(out.data(), fout.data(), out.size() * sizeof(float)) == 0;
+        ok &= std::memcmp(C.data(), fC.data(), C.size() * sizeof(float)) == 0;
+        ok &= std::memcmp(n.data(), fn.data(), n.size() * sizeof(float)) == 0;
+        ok &= std::memcmp(m.data(), fm.data(), m.size() * sizeof(float)) == 0;
+
+        mlstm_step_f32(input.data(), W.data(), b.data(), y.data(), C.data(), n.data(),
+                       m.data(), scratch.data(), I, H, &mp);
+        odd_m_step_f32(input.data(), W.data(), b.data(), fy.data(), fC.data(), fn.data(),
+                       fm.data(), &mp);
+        ok &= std::memcmp(y.data(), fy.data(), H * sizeof(float)) == 0;
+        if (!ok) std::printf("  FAIL: mLSTM differs (clip %g)\n", clip);
+    }
+    return ok;
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main() {
+    std::printf("[==========] Running fixed-dimension kernel tests\n");
+
+    RUN_TEST(TestFixedMatchesReference);
+    RUN_TEST(TestFixedSlstmBitExact);
+    RUN_TEST(TestFixedMlstmBitExact);
+
+    std::printf("[==========] %d/%d tests passed\n", g_tests_passed, g_tests_run);
+    return g_tests_passed == g_tests_run ? 0 : 1;
+}
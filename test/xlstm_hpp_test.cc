@@ -0,0 +1,170 @@
+/* C++ wrapper (xlstm.hpp) unit tests
+ *
+ * Sessions must reproduce the golden values and the direct kernel calls
+ * bit for bit, carry state across eval calls, and reject mis-sized spans
+ * with status codes instead of touching memory.
+ *
+ * Build:
+ *   make test
+ * =========================================================================*/
+
+#include "xlstm.hpp"
+#include "test_util.h"
+
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+// ============================================================================
+// Reference test data — same golden values as the kernel tests
+// ============================================================================
+
+#include "reference_data.h"
+
+static const float kTolerance = 1e-5f;
+
+static_assert(!std::is_copy_constructible_v<xlstm::SlstmSession<float>>,
+              "sessions own their state and must not be copied");
+static_assert(std::is_nothrow_move_constructible_v<xlstm::MlstmSession<int8_t>>,
+              "sessions are movable");
+
+template <typename T>
+static std::vector<T> Ramp(int len, int mod, int offset) {
+    std::vector<T> v(len);
+    for (int i = 0; i < len; ++i) v[i] = (T)((i * 7 + 3) % mod - offset);
+    return v;
+}
+
+// ============================================================================
+// Test cases
+// ============================================================================
+
+bool TestSessionMatchesReference() {
+    const int T = 3;
+    bool ok = true;
+
+    /* sLSTM: one call of T steps, then the same stream split 1 + 2 */
+    xlstm::SlstmSession<float> s(2, 2, 1);
+    xlstm::SlstmWeights<float> sw{{kTest1_W, 4 * 2 * 2}, {kTest1_R, 4 * 2 * 2}, {kTest1_b, 4 * 2}};
+    float out[T * 2], split[T * 2];
+    ok &= s.valid();
+    ok &= s.eval(sw, {kTest2_input, T * 2}, out, T) == XLSTM_OK;
+    ok &= ExpectNear("slstm output", kTest2_expected_output, out, T * 2, kTolerance);
+    ok &= ExpectNear("slstm c", kTest2_expected_c, s.c().data(), 2, kTolerance);
+    ok &= ExpectNear("slstm m", kTest2_expected_m, s.m().data(), 2, kTolerance);
+
+    s.reset();
+    ok &= s.eval(sw, {kTest2_input, 2}, {split, 2}, 1) == XLSTM_OK;
+    ok &= s.eval(sw, {kTest2_input + 2, 4}, {split + 2, 4}, 2) == XLSTM_OK;
+    ok &= std::memcmp(out, split, sizeof(out)) == 0;
+
+    /* mLSTM: C [H*H] and scalar m per stream */
+    xlstm::MlstmSession<float> m(3, 2, 1);
+    xlstm::MlstmWeights<float> mw{{kMTest1_W, (4 * 2 + 2) * 3}, {}, {kMTest1_b, 4 * 2 + 2}};
+    float mout[T * 2];
+    ok &= m.c().size() == 4 && m.m().size() == 1;
+    ok &= m.eval(mw, {kMTest2_input, T * 3}, mout, T) == XLSTM_OK;
+    ok &= ExpectNear("mlstm y", kMTest2_expected_y, m.y().data(), 2, kTolerance);
+    ok &= ExpectNear("mlstm C", kMTest2_expected_C, m.c().data(), 4, kTolerance);
+    ok &= ExpectNear("mlstm n", kMTest2_expected_n, m.n().data(), 2, kTolerance);
+    ok &= ExpectNear("mlstm last output", kMTest2_expected_y, mout + 4, 2, kTolerance);
+    return ok;
+}
+
+bool TestSessionChecks() {
+    const int B = 2, T = 3, I = 3, H = 2;
+    std::vector<float> W(4 * H * I, 0.1f), R(4 * H * H, 0.1f), b(4 * H, 0.0f);
+    std::vector<float> in(B * T * I, 0.5f), out(B * T * H);
+    std::vector<uint8_t> reset(B * T, 0);
+    xlstm::SlstmSession<float> s(I, H, B);
+    xlstm::SlstmWeights<float> w{W, R, b};
+    bool ok = true;
+
+    ok &= s.eval(w, in, out, T, reset) == XLSTM_OK;
+    ok &= s.eval(w, in, out, 0) == XLSTM_OK;
+    ok &= s.eval(w, in, out, -1) == XLSTM_ERR_ARG;
+    ok &= s.eval({{W.data(), W.size() - 1}, R, b}, in, out, T) == XLSTM_ERR_SHAPE;
+    ok &= s.eval({W, {}, b}, in, out, T) == XLSTM_ERR_SHAPE;
+    ok &= s.eval(w, {in.data(), in.size() - 1}, out, T) == XLSTM_ERR_SIZE;
+    ok &= s.eval(w, in, {out.data(), out.size() - 1}, T) == XLSTM_ERR_SIZE;
+    ok &= s.eval(w, in, out, T, {reset.data(), reset.size() - 1}) == XLSTM_ERR_SIZE;
+
+    /* mLSTM has no recurrent weights */
+    std::vector<float> mW((4 * H + 2) * I, 0.1f), mb(4 * H + 2, 0.0f);
+    xlstm::MlstmSession<float> m(I, H, B);
+    ok &= m.eval({mW, {}, mb}, in, out, T) == XLSTM_OK;
+    ok &= m.eval({mW, R, mb}, in, out, T) == XLSTM_ERR_SHAPE;
+
+    xlstm::SlstmSession<float> bad(I, 0, B);
+    ok &= !bad.valid() && bad.y().empty();
+    ok &= bad.eval(w, in, out, T) == XLSTM_ERR_ARG;
+
+    /* Moves carry the state; the moved-from session is unusable */
+    std::vector<float> y(s.y().begin(), s.y().end());
+    xlstm::SlstmSession<float> moved(std::move(s));
+    ok &= moved.valid() && !s.valid();
+    ok &= std::memcmp(y.data(), moved.y().data(), y.size() * sizeof(float)) == 0;
+    ok &= s.eval(w, in, out, T) == XLSTM_ERR_ARG;
+    ok &= moved.eval(w, in, out, T) == XLSTM_OK;
+    if (!ok) std::printf("  FAIL: status checks\n");
+    return ok;
+}
+
+bool TestSessionS8MatchesKernels() {
+    const int B = 2, T = 4, I = 3, H = 4;
+    std::vector<int8_t> in = Ramp<int8_t>(B * T * I, 61, 30);
+    std::vector<int8_t> out(B * T * H), ref_out(B * T * H);
+    bool ok = true;
+
+    SlstmS8Params sp = {0.0f, 0.01f, 0.01f, {0.02f, 3}, {1.0f / 128, -5},
+                        {1.0f / 1024, 0}, {1.0f / 1024, 0}, nullptr};
+    std::vector<int8_t> W = Ramp<int8_t>(4 * H * I, 101, 50), R = Ramp<int8_t>(4 * H * H, 89, 44);
+    std::vector<int32_t> b = Ramp<int32_t>(4 * H, 400, 200), scratch(4 * H);
+    std::vector<int8_t> y(B * H, -5);
+    std::vector<int16_t> c(B * H, 0), n(B * H, 0);
+    std::vector<float> m(B * H, 0.0f);
+
+    xlstm::SlstmSession<int8_t> s(I, H, B, sp);
+    ok &= s.y()[0] == -5;
+    ok &= s.eval({W, R, b}, in, out, T) == XLSTM_OK;
+    slstm_eval_s8(in.data(), W.data(), R.data(), b.data(), y.data(), c.data(), n.data(),
+                  m.data(), ref_out.data(), scratch.data(), B, T, I, H, &sp);
+    ok &= std::memcmp(out.data(), ref_out.data(), out.size()) == 0;
+    ok &= std::memcmp(c.data(), s.c().data(), c.size() * sizeof(int16_t)) == 0;
+    s.reset();
+    ok &= s.y()[H] == -5 && s.c()[0] == 0 && s.m()[0] == 0.0f;
+
+    MlstmS8Params mp = {0.0f, 0.01f, {0.02f, 3}, {1.0f / 128, 2},
+                        {1.0f / 1024, 0}, {1.0f / 1024, 0}, nullptr};
+    std::vector<int8_t> mW = Ramp<int8_t>((4 * H + 2) * I, 101, 50);
+    std::vector<int32_t> mb = Ramp<int32_t>(4 * H + 2, 400, 200), mscratch(4 * H + 2);
+    std::vector<int8_t> my(B * H, 2);
+    std::vector<int16_t> C(B * H * H, 0), mn(B * H, 0);
+    std::vector<float> mm(B, 0.0f);
+
+    xlstm::MlstmSession<int8_t> ms(I, H, B, mp);
+    ok &= ms.eval({mW, {}, mb}, in, out, T) == XLSTM_OK;
+    mlstm_eval_s8(in.data(), mW.data(), mb.data(), my.data(), C.data(), mn.data(),
+                  mm.data(), ref_out.data(), mscratch.data(), B, T, I, H, &mp);
+    ok &= std::memcmp(out.data(), ref_out.data(), out.size()) == 0;
+    ok &= std::memcmp(C.data(), ms.c().data(), C.size() * sizeof(int16_t)) == 0;
+    ok &= std::memcmp(mm.data(), ms.m().data(), mm.size() * sizeof(float)) == 0;
+    if (!ok) std::printf("  FAIL: INT8 session differs from the kernels\n");
+    return ok;
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main() {
+    std::printf("[==========] Running C++ wrapper tests\n");
+
+    RUN_TEST(TestSessionMatchesReference);
+    RUN_TEST(TestSessionChecks);
+    RUN_TEST(TestSessionS8MatchesKernels);
+
+    std::printf("[==========] %d/%d tests passed\n", g_tests_passed, g_tests_run);
+    return g_tests_passed == g_tests_run ? 0 : 1;
+}
@@ -0,0 +1,281 @@
+/* Model weight file unit tests
+ *
+ * A model written with xlstm_model_write must bind back to pointers into
+ * the file image (no copies) that reproduce the reference outputs, both
+ * from memory and through an mmap of the file on disk.
+ *
+ * Build:
+ *   make test
+ * =========================================================================*/
+
+#include "xlstm_model.h"
+#include "slstm.h"
+#include "mlstm.h"
+#include "test_util.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// ============================================================================
+// Reference test data — same golden values as the kernel tests
+// ============================================================================
+
+#include "reference_data.h"
+
+// ============================================================================
+// Test cases
+// ============================================================================
+
+constexpr float kTolerance = 1e-5f;
+
+/* Layer 0: sLSTM (Test 1 weights, I=2, H=2).
+ * Layer 1: mLSTM (MTest 1 weights, I=3, H=2). */
+static XlstmModelLayer CellLayer(XlstmKind kind, int I, int H) {
+    XlstmModelLayer l;
+    std::memset(&l, 0, sizeof(l));
+    l.kind = (uint8_t)kind;
+    l.dims[0] = (uint32_t)I;
+    l.dims[1] = (uint32_t)H;
+    return l;
+}
+
+static const XlstmModelTensorDesc kSlstmTensors[] = {
+    {XLSTM_ROLE_CELL_W, XLSTM_DTYPE_F32, 8, 2, kTest1_W, {0.0f, 0}},
+    {XLSTM_ROLE_CELL_R, XLSTM_DTYPE_F32, 8, 2, kTest1_R, {0.0f, 0}},
+    {XLSTM_ROLE_CELL_B, XLSTM_DTYPE_F32, 8, 1, kTest1_b, {0.0f, 0}},
+};
+
+static const XlstmModelTensorDesc kMlstmTensors[] = {
+    {XLSTM_ROLE_CELL_W, XLSTM_DTYPE_F32, 10, 3, kMTest1_W, {0.0f, 0}},
+    {XLSTM_ROLE_CELL_B, XLSTM_DTYPE_F32, 10, 1, kMTest1_b, {0.0f, 0}},
+};
+
+static size_t WriteCellModel(std::vector<unsigned char>* file, size_t* offset) {
+    XlstmModelLayerDesc layers[2] = {
+        {CellLayer(XLSTM_KIND_SLSTM_F32, 2, 2), kSlstmTensors, 3},
+        {CellLayer(XLSTM_KIND_MLSTM_F32, 3, 2), kMlstmTensors, 2},
+    };
+    size_t size = xlstm_model_write(layers, 2, nullptr, 0);
+    /* Over-allocate and hand out a 64-byte aligned window */
+    file->assign(size + XLSTM_MODEL_ALIGN, 0);
+    uintptr_t p = (uintptr_t)file->data();
+    *offset = (size_t)((XLSTM_MODEL_ALIGN - (p % XLSTM_MODEL_ALIGN)) % XLSTM_MODEL_ALIGN);
+    return xlstm_model_write(layers, 2, file->data() + *offset, size);
+}
+
+static bool Inside(const void* p, const XlstmModel& model) {
+    const unsigned char* c = (const unsigned char*)p;
+    return c >= model.data && c < model.data + model.size &&
+           ((uintptr_t)c % XLSTM_MODEL_ALIGN) == 0;
+}
+
+static bool RunBoundCells(const XlstmModel& model) {
+    bool ok = true;
+    XlstmStackLayer s, m;
+    ok &= xlstm_model_bind_stack_layer(&model, 0, &s) == XLSTM_OK;
+    ok &= xlstm_model_bind_stack_layer(&model, 1, &m) == XLSTM_OK;
+    if (!ok) {
+        std::printf("  FAIL: bind\n");
+        return false;
+    }
+    ok &= s.kind == XLSTM_KIND_SLSTM_F32 && s.input_size == 2 && s.hidden_size == 2;
+    ok &= m.kind == XLSTM_KIND_MLSTM_F32 && m.input_size == 3 && m.R == nullptr;
+    ok &= Inside(s.W, model) && Inside(s.R, model) && Inside(s.b, model);
+    ok &= Inside(m.W, model) && Inside(m.b, model);
+    if (!ok) std::printf("  FAIL: bound layer not zero-copy\n");
+
+    const int H = 2;
+    float y[H] = {0}, c[H] = {0}, n[H] = {0}, st[H] = {0}, out[H];
+    float scratch[4 * H + 2];
+    slstm_eval_f32(kTest1_input, s.W, s.R, s.b, y, c, n, st, out, scratch,
+                   1, 1, s.input_size, s.hidden_size, &s.slstm_params);
+    ok &= ExpectNear("slstm_y", kTest1_expected_y, y, H, kTolerance);
+
+    float my[H] = {0}, C[H * H] = {0}, mn[H] = {0}, mm[1] = {0};
+    mlstm_eval_f32(kMTest1_input, m.W, m.b, my, C, mn, mm, out, scratch,
+                   1, 1, m.input_size, m.hidden_size, &m.mlstm_params);
+    ok &= ExpectNear("mlstm_y", kMTest1_expected_y, my, H, kTolerance);
+    ok &= ExpectNear("mlstm_C", kMTest1_expected_C, C, H * H, kTolerance);
+    return ok;
+}
+
+bool TestModelBindCells() {
+    std::vector<unsigned char> file;
+    size_t offset;
+    size_t size = WriteCellModel(&file, &offset);
+
+    XlstmModel model;
+    bool ok = size > 0;
+    ok &= xlstm_model_open(&model, file.data() + offset, size) == XLSTM_OK;
+    ok &= model.num_layers == 2 && model.num_tensors == 5;
+    if (!ok) {
+        std::printf("  FAIL: open\n");
+        return false;
+    }
+    ok &= xlstm_model_find(&model, 1, XLSTM_ROLE_CELL_R) == nullptr;
+    ok &= RunBoundCells(model);
+    return ok;
+}
+
+bool TestModelBindBlockQ8() {
+    const int D = 4, F = 6, K = 3;
+    std::vector<float> vecD(D, 0.5f), conv(D * K, 0.25f);
+    std::vector<int8_t> cell_W(4 * D * 2 * D, 3), cell_R(4 * D * D, -2);
+    std::vector<int8_t> up_W(2 * F * D, 1), down_W(D * F, -1);
+    std::vector<int32_t> cell_b(4 * D, 7);
+    const XlstmQuantParam none = {0.0f, 0};
+
+    /* ln_b, conv_b, ln2_b, up_b and down_b are optional and omitted */
+    XlstmModelTensorDesc tensors[] = {
+        {XLSTM_ROLE_LN_W, XLSTM_DTYPE_F32, D, 1, vecD.data(), none},
+        {XLSTM_ROLE_CONV_W, XLSTM_DTYPE_F32, D, K, conv.data(), none},
+        {XLSTM_ROLE_CELL_W, XLSTM_DTYPE_S8, 4 * D, 2 * D, cell_W.data(), {0.01f, 0}},
+        {XLSTM_ROLE_CELL_R, XLSTM_DTYPE_S8, 4 * D, D, cell_R.data(), {0.02f, 0}},
+        {XLSTM_ROLE_CELL_B, XLSTM_DTYPE_S32, 4 * D, 1, cell_b.data(), none},
+        {XLSTM_ROLE_GN_W, XLSTM_DTYPE_F32, D, 1, vecD.data(), none},
+        {XLSTM_ROLE_LN2_W, XLSTM_DTYPE_F32, D, 1, vecD.data(), none},
+        {XLSTM_ROLE_UP_W, XLSTM_DTYPE_S8, 2 * F, D, up_W.data(), {0.03f, 0}},
+        {XLSTM_ROLE_DOWN_W, XLSTM_DTYPE_S8, D, F, down_W.data(), {0.04f, 0}},
+    };
+    XlstmModelLayerDesc layer;
+    std::memset(&layer, 0, sizeof(layer));
+    layer.layer.kind = XLSTM_KIND_SLSTM_BLOCK_Q8;
+    layer.layer.dims[0] = D;
+    layer.layer.dims[1] = F;
+    layer.layer.dims[2] = K;
+    layer.layer.dims[3] = 2;
+    layer.layer.cell_clip = 3.0f;
+    layer.layer.y_quant = {1.0f / 127, 0};
+    layer.layer.c_quant = {1.0f / 4096, 0};
+    layer.tensors = tensors;
+    layer.num_tensors = (int)(sizeof(tensors) / sizeof(tensors[0]));
+
+    alignas(XLSTM_MODEL_ALIGN) static unsigned char file[4096];
+    size_t size = xlstm_model_write(&layer, 1, file, sizeof(file));
+
+    XlstmModel model;
+    XlstmSlstmBlockQ8 blk;
+    bool ok = size > 0 && size <= sizeof(file);
+    ok &= xlstm_model_open(&model, file, size) == XLSTM_OK;
+    ok &= xlstm_model_bind_slstm_block_q8(&model, 0, &blk) == XLSTM_OK;
+    if (!ok) {
+        std::printf("  FAIL: open/bind\n");
+        return false;
+    }
+    ok &= blk.embed_dim == D && blk.ffn_dim == F && blk.conv_kernel == K && blk.num_heads == 2;
+    ok &= blk.ln_b == nullptr && blk.conv_b == nullptr && blk.ln2_b == nullptr;
+    ok &= blk.up_b == nullptr && blk.down_b == nullptr;
+    ok &= blk.cell_params.W_scale == 0.01f && blk.cell_params.R_scale == 0.02f;
+    ok &= blk.up_scale == 0.03f && blk.down_scale == 0.04f;
+    ok &= blk.cell_params.cell_clip == 3.0f && blk.cell_params.c_quant.scale == 1.0f / 4096;
+    ok &= Inside(blk.cell_R, model) && blk.cell_R[0] == -2 && blk.cell_b[4 * D - 1] == 7;
+    if (!ok) std::printf("  FAIL: bound block fields\n");
+
+    /* Wrong kind for the f32 binder */
+    XlstmSlstmBlock f32;
+    ok &= xlstm_model_bind_slstm_block(&model, 0, &f32) == XLSTM_ERR_FORMAT;
+    return ok;
+}
+
+bool TestModelRejectsBadFiles() {
+    std::vector<unsigned char> file;
+    size_t offset;
+    size_t size = WriteCellModel(&file, &offset);
+    unsigned char* base = file.data() + offset;
+    XlstmModel model;
+    bool ok = true;
+
+    ok &= xlstm_model_open(&model, base, size - 1) == XLSTM_ERR_SIZE;
+    ok &= xlstm_model_open(&model, base, 32) == XLSTM_ERR_SIZE;
+
+    base[0] ^= 0xFF;
+    ok &= xlstm_model_open(&model, base, size) == XLSTM_ERR_FORMAT;
+    base[0] ^= 0xFF;
+
+    /* Tensor data offset pointing past the end */
+    XlstmModelHeader hdr;
+    std::memcpy(&hdr, base, sizeof(hdr));
+    XlstmModelTensor* t0 = (XlstmModelTensor*)(base + hdr.tensor_offset);
+    uint64_t saved = t0->offset;
+    t0->offset = hdr.total_size;
+    ok &= xlstm_model_open(&model, base, size) == XLSTM_ERR_SIZE;
+    t0->offset = saved + 4;
+    ok &= xlstm_model_open(&model, base, size) == XLSTM_ERR_FORMAT;
+    t0->offset = saved;
+
+    /* Layer dims that disagree with the stored W */
+    XlstmModelLayer* l0 = (XlstmModelLayer*)(base + hdr.layer_offset);
+    ok &= xlstm_model_open(&model, base, size) == XLSTM_OK;
+    l0->dims[0] = 3;
+    XlstmStackLayer s;
+    ok &= xlstm_model_bind_stack_layer(&model, 0, &s) == XLSTM_ERR_SHAPE;
+    ok &= xlstm_model_bind_stack_layer(&model, 2, &s) == XLSTM_ERR_ARG;
+    l0->dims[0] = 2;
+
+    /* Hidden size whose 4 * H + 2 gate rows would overflow int */
+    uint32_t saved_h = l0->dims[1];
+    l0->dims[1] = 0x20000000u;
+    ok &= xlstm_model_bind_stack_layer(&model, 0, &s) == XLSTM_ERR_SHAPE;
+    l0->dims[1] = 0xFFFFFFFFu;
+    ok &= xlstm_model_bind_stack_layer(&model, 0, &s) == XLSTM_ERR_SHAPE;
+    l0->dims[1] = saved_h;
+    ok &= xlstm_model_bind_stack_layer(&model, 0, &s) == XLSTM_OK;
+
+    const int8_t* W;
+    const int32_t* b;
+    MlstmS8Params p;
+    ok &= xlstm_model_bind_mlstm_s8(&model, 1, &W, &b, &p) == XLSTM_ERR_FORMAT;
+
+    /* Misaligned image */
+    ok &= xlstm_model_open(&model, base + 4, size) == XLSTM_ERR_ARG;
+    if (!ok) std::printf("  FAIL: bad file accepted or wrong status\n");
+    return ok;
+}
+
+bool TestModelMapFile() {
+    std::vector<unsigned char> file;
+    size_t offset;
+    size_t size = WriteCellModel(&file, &offset);
+
+    char path[] = "/tmp/xlstm_model_test.bin";
+    FILE* f = std::fopen(path, "wb");
+    if (!f) {
+        std::printf("  FAIL: cannot create %s\n", path);
+        return false;
+    }
+    std::fwrite(file.data() + offset, 1, size, f);
+    std::fclose(f);
+
+    XlstmModelMapping mapping;
+    XlstmModel model;
+    bool ok = xlstm_model_map(path, &mapping, &model) == XLSTM_OK;
+    if (ok) {
+        ok &= model.data == mapping.addr;
+        ok &= RunBoundCells(model);
+        xlstm_model_unmap(&mapping);
+        ok &= mapping.addr == nullptr;
+    } else {
+        std::printf("  FAIL: map\n");
+    }
+    std::remove(path);
+
+    ok &= xlstm_model_map("/nonexistent/xlstm.bin", &mapping, &model) == XLSTM_ERR_ARG;
+    return ok;
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main() {
+    std::printf("[==========] Running model file tests\n");
+
+    RUN_TEST(TestModelBindCells);
+    RUN_TEST(TestModelBindBlockQ8);
+    RUN_TEST(TestModelRejectsBadFiles);
+    RUN_TEST(TestModelMapFile);
+
+    std::printf("[==========] %d/%d tests passed\n", g_tests_passed, g_tests_run);
+    return g_tests_passed == g_tests_run ? 0 : 1;
+}
@@ -0,0 +1,238 @@
+/* Arena planner unit tests
+ *
+ * Size queries must match the buffer sizes documented by the kernels, the
+ * planner must never overlap buffers with overlapping lifetimes while
+ * reusing the rest, and a model run entirely out of a planned arena must
+ * match the same model run with separately allocated buffers.
+ *
+ * Build:
+ *   make test
+ * =========================================================================*/
+
+#include "xlstm_plan.h"
+#include "slstm.h"
+#include "test_util.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// ============================================================================
+// Reference test data — same golden values as the kernel tests
+// ============================================================================
+
+#include "reference_data.h"
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+/* True if no two buffers with overlapping lifetimes share bytes and every
+ * buffer is aligned and inside the arena. */
+static bool ValidPlan(const XlstmPlanBuffer* bufs, int n, size_t arena,
+                      size_t alignment) {
+    for (int i = 0; i < n; ++i) {
+        if (bufs[i].size == 0) continue;
+        if (bufs[i].offset % alignment != 0 || bufs[i].offset + bufs[i].size > arena) {
+            std::printf("  FAIL: buffer %d misplaced\n", i);
+            return false;
+        }
+        for (int j = i + 1; j < n; ++j) {
+            if (bufs[j].size == 0) continue;
+            bool live = bufs[i].first_use <= bufs[j].last_use &&
+                        bufs[j].first_use <= bufs[i].last_use;
+            bool mem = bufs[i].offset < bufs[j].offset + bufs[j].size &&
+                       bufs[j].offset < bufs[i].offset + bufs[i].size;
+            if (live && mem) {
+                std::printf("  FAIL: buffers %d and %d overlap\n", i, j);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+// Test cases
+// ============================================================================
+
+bool TestPlanSizes() {
+    const int B = 3, H = 5;
+    XlstmBufferSizes s;
+    bool ok = true;
+
+    ok &= xlstm_cell_sizes(XLSTM_KIND_SLSTM_F32, B, H, &s) == XLSTM_OK;
+    ok &= s.state[XLSTM_BUF_Y] == B * H * 4 && s.state[XLSTM_BUF_C] == B * H * 4;
+    ok &= s.state[XLSTM_BUF_M] == B * H * 4 && s.state[XLSTM_BUF_CONV] == 0;
+    ok &= s.scratch == 4 * H * 4;
+
+    ok &= xlstm_cell_sizes(XLSTM_KIND_MLSTM_F32, B, H, &s) == XLSTM_OK;
+    ok &= s.state[XLSTM_BUF_C] == B * H * H * 4 && s.state[XLSTM_BUF_M] == B * 4;
+    ok &= s.scratch == (4 * H + 2) * 4;
+
+    ok &= xlstm_cell_sizes(XLSTM_KIND_SLSTM_S8, B, H, &s) == XLSTM_OK;
+    ok &= s.state[XLSTM_BUF_Y] == B * H && s.state[XLSTM_BUF_C] == B * H * 2;
+    ok &= s.state[XLSTM_BUF_N] == B * H * 2 && s.scratch == 4 * H * 4;
+
+    ok &= xlstm_cell_sizes(XLSTM_KIND_MLSTM_S8, B, H, &s) == XLSTM_OK;
+    ok &= s.state[XLSTM_BUF_C] == B * H * H * 2 && s.scratch == (4 * H + 2) * 4;
+
+    ok &= xlstm_cell_sizes(XLSTM_KIND_MLSTM_BLOCK_F32, B, H, &s) == XLSTM_ERR_FORMAT;
+    ok &= xlstm_cell_sizes(XLSTM_KIND_SLSTM_F32, 0, H, &s) == XLSTM_ERR_ARG;
+    if (!ok) std::printf("  FAIL: cell sizes\n");
+
+    XlstmSlstmBlockQ8 sq;
+    std::memset(&sq, 0, sizeof(sq));
+    sq.embed_dim = 4;
+    sq.ffn_dim = 6;
+    sq.conv_kernel = 3;
+    xlstm_slstm_block_q8_sizes(&sq, B, &s);
+    ok &= s.state[XLSTM_BUF_Y] == B * 4 && s.state[XLSTM_BUF_CONV] == B * 2 * 4 * 4;
+    ok &= s.scratch == slstm_block_q8_workspace_size(&sq);
+
+    XlstmMlstmBlock mb;
+    std::memset(&mb, 0, sizeof(mb));
+    mb.embed_dim = 4;
+    mb.inner_dim = 8;
+    mb.conv_kernel = 1;
+    xlstm_mlstm_block_sizes(&mb, B, &s);
+    ok &= s.state[XLSTM_BUF_C] == B * 8 * 8 * 4 && s.state[XLSTM_BUF_CONV] == 0;
+    ok &= s.scratch == mlstm_block_scratch_size(&mb) * sizeof(float);
+    if (!ok) std::printf("  FAIL: block sizes\n");
+    return ok;
+}
+
+bool TestPlanReuse() {
+    /* Three disjoint activations share one slot; the persistent buffer and
+     * the two overlapping ones get their own. */
+    XlstmPlanBuffer bufs[] = {
+        {100, 0, 0, 0},
+        {300, 1, 1, 0},
+        {200, 2, 2, 0},
+        {10, 0, 2, 0},     /* persistent */
+        {50, 1, 2, 0},     /* overlaps steps 1 and 2 */
+        {0, 0, 2, 0},      /* unused */
+    };
+    const int n = (int)(sizeof(bufs) / sizeof(bufs[0]));
+    int order[n];
+    bool ok = true;
+
+    size_t arena = xlstm_plan(bufs, n, 64, order);
+    ok &= ValidPlan(bufs, n, arena, 64);
+    ok &= bufs[0].offset == 0 && bufs[1].offset == 0 && bufs[2].offset == 0;
+    /* 300 -> 320, then 64 each for the two long-lived buffers; flat is 660 */
+    ok &= arena == 448;
+    if (!ok) std::printf("  FAIL: arena %zu\n", arena);
+
+    ok &= xlstm_plan(bufs, n, 48, order) == 0;
+    bufs[0].first_use = 1;
+    bufs[0].last_use = 0;
+    ok &= xlstm_plan(bufs, n, 64, order) == 0;
+    return ok;
+}
+
+/* Three sLSTM layers (Test 1 weights, I = H = 2) */
+static const XlstmModelTensorDesc kSlstmTensors[] = {
+    {XLSTM_ROLE_CELL_W, XLSTM_DTYPE_F32, 8, 2, kTest1_W, {0.0f, 0}},
+    {XLSTM_ROLE_CELL_R, XLSTM_DTYPE_F32, 8, 2, kTest1_R, {0.0f, 0}},
+    {XLSTM_ROLE_CELL_B, XLSTM_DTYPE_F32, 8, 1, kTest1_b, {0.0f, 0}},
+};
+
+bool TestPlanModelArena() {
+    const int L = 3, B = 2, T = 4, H = 2;
+    XlstmModelLayerDesc layers[L];
+    for (int l = 0; l < L; ++l) {
+        std::memset(&layers[l], 0, sizeof(layers[l]));
+        layers[l].layer.kind = XLSTM_KIND_SLSTM_F32;
+        layers[l].layer.dims[0] = H;
+        layers[l].layer.dims[1] = H;
+        layers[l].tensors = kSlstmTensors;
+        layers[l].num_tensors = 3;
+    }
+    alignas(XLSTM_MODEL_ALIGN) static unsigned char file[4096];
+    size_t size = xlstm_model_write(layers, L, file, sizeof(file));
+    XlstmModel model;
+    bool ok = size > 0 && size <= sizeof(file);
+    ok &= xlstm_model_open(&model, file, size) == XLSTM_OK;
+
+    XlstmPlanBuffer bufs[L * XLSTM_PLAN_BUFS_PER_LAYER];
+    int order[L * XLSTM_PLAN_BUFS_PER_LAYER];
+    size_t arena_size = 0;
+    ok &= xlstm_plan_model(&model, B, T, bufs, L * XLSTM_PLAN_BUFS_PER_LAYER - 1,
+                           order, &arena_size) == XLSTM_ERR_SIZE;
+    ok &= xlstm_plan_model(&model, B, T, bufs, L * XLSTM_PLAN_BUFS_PER_LAYER,
+                           order, &arena_size) == XLSTM_OK;
+    if (!ok) {
+        std::printf("  FAIL: plan model\n");
+        return false;
+    }
+    ok &= ValidPlan(bufs, L * XLSTM_PLAN_BUFS_PER_LAYER, arena_size, XLSTM_PLAN_ALIGN);
+
+    size_t flat = 0;
+    for (const XlstmPlanBuffer& b : bufs) flat += b.size;
+    ok &= bufs[XLSTM_PLAN_OUTPUT].size == (size_t)(B * T * H) * sizeof(float);
+    /* Layer 2 reuses the output slot of layer 0 */
+    ok &= bufs[2 * XLSTM_PLAN_BUFS_PER_LAYER + XLSTM_PLAN_OUTPUT].offset ==
+          bufs[XLSTM_PLAN_OUTPUT].offset;
+    ok &= arena_size < flat + L * XLSTM_PLAN_BUFS_PER_LAYER * XLSTM_PLAN_ALIGN;
+
+    std::vector<float> input(B * T * H);
+    for (int i = 0; i < B * T * H; ++i) input[i] = 0.1f * (float)(i % 7) - 0.3f;
+
+    /* Reference: separate buffers per layer */
+    SlstmParams params = {0.0f, 0};
+    std::vector<float> ref_in = input, ref_out(B * T * H), scratch(4 * H);
+    std::vector<std::vector<float>> ref_state(L * 4, std::vector<float>(B * H, 0.0f));
+    for (int l = 0; l < L; ++l) {
+        slstm_eval_f32(ref_in.data(), kTest1_W, kTest1_R, kTest1_b,
+                       ref_state[l * 4 + 0].data(), ref_state[l * 4 + 1].data(),
+                       ref_state[l * 4 + 2].data(), ref_state[l * 4 + 3].data(),
+                       ref_out.data(), scratch.data(), B, T, H, H, &params);
+        ref_in = ref_out;
+    }
+
+    /* Everything out of one arena */
+    std::vector<unsigned char> storage(arena_size + XLSTM_PLAN_ALIGN, 0);
+    uintptr_t p = (uintptr_t)storage.data();
+    unsigned char* arena = storage.data() +
+        (XLSTM_PLAN_ALIGN - p % XLSTM_PLAN_ALIGN) % XLSTM_PLAN_ALIGN;
+    const float* in = input.data();
+    float* out = nullptr;
+    for (int l = 0; l < L; ++l) {
+        const XlstmPlanBuffer* b = bufs + l * XLSTM_PLAN_BUFS_PER_LAYER;
+        XlstmStackLayer sl;
+        ok &= xlstm_model_bind_stack_layer(&model, l, &sl) == XLSTM_OK;
+        out = (float*)(arena + b[XLSTM_PLAN_OUTPUT].offset);
+        slstm_eval_f32(in, sl.W, sl.R, sl.b,
+                       (float*)(arena + b[XLSTM_BUF_Y].offset),
+                       (float*)(arena + b[XLSTM_BUF_C].offset),
+                       (float*)(arena + b[XLSTM_BUF_N].offset),
+                       (float*)(arena + b[XLSTM_BUF_M].offset),
+                       out, (float*)(arena + b[XLSTM_PLAN_SCRATCH].offset),
+                       B, T, H, H, &params);
+        in = out;
+    }
+    ok &= ExpectNear("output", ref_out.data(), out, B * T * H, 1e-6f);
+    for (int l = 0; l < L; ++l) {
+        const XlstmPlanBuffer* b = bufs + l * XLSTM_PLAN_BUFS_PER_LAYER;
+        ok &= ExpectNear("c", ref_state[l * 4 + 1].data(),
+                         (const float*)(arena + b[XLSTM_BUF_C].offset), B * H, 1e-6f);
+    }
+    return ok;
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main() {
+    std::printf("[==========] Running arena planner tests\n");
+
+    RUN_TEST(TestPlanSizes);
+    RUN_TEST(TestPlanReuse);
+    RUN_TEST(TestPlanModelArena);
+
+    std::printf("[==========] %d/%d tests passed\n", g_tests_passed, g_tests_run);
+    return g_tests_passed == g_tests_run ? 0 : 1;
+}
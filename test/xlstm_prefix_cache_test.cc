@@ -0,0 +1,180 @@
+/* Prefix state cache unit tests
+ *
+ * A stream resumed from a cached prefix state must produce the same
+ * outputs as one that ran prefill from scratch.
+ *
+ * Build:
+ *   make test
+ * =========================================================================*/
+
+#include "xlstm_prefix_cache.h"
+#include "xlstm_state.h"
+#include "slstm.h"
+#include "test_util.h"
+
+// ============================================================================
+// Reference test data — same golden values as the kernel tests
+// ============================================================================
+
+#include "reference_data.h"
+
+// ============================================================================
+// Test cases
+// ============================================================================
+
+constexpr float kTolerance = 1e-5f;
+
+bool TestPrefixCacheResume() {
+    const int B = 1, I = 2, H = 2;
+    const int kCapacity = 4;
+    const size_t kSlot = 128;
+    SlstmParams params = {0.0f, 0};
+
+    XlstmPrefixEntry entries[kCapacity];
+    alignas(16) unsigned char pool[kCapacity * kSlot];
+    XlstmPrefixCache cache;
+    bool ok = true;
+    ok &= xlstm_state_size(XLSTM_KIND_SLSTM_F32, B, H) <= kSlot;
+    ok &= xlstm_prefix_cache_init(&cache, entries, kCapacity, pool, sizeof(pool),
+                                  kSlot, 1, I * sizeof(float)) == XLSTM_OK;
+
+    /* First request: prefill the 2-step prompt and cache its state */
+    float y[H] = {0}, c[H] = {0}, n[H] = {0}, m[H] = {0};
+    float output[3 * H], scratch[4 * H];
+    slstm_eval_f32(kTest2_input, kTest1_W, kTest1_R, kTest1_b,
+                   y, c, n, m, output, scratch, B, 2, I, H, &params);
+    void* slot = xlstm_prefix_cache_reserve(&cache, kTest2_input, 2);
+    ok &= slot != nullptr;
+    ok &= xlstm_prefix_cache_commit(
+              &cache, slot,
+              xlstm_state_save_slstm_f32(y, c, n, m, B, H, slot, kSlot)) == XLSTM_OK;
+
+    /* Second request: same prompt plus one new step. Only that step runs. */
+    const void* blob = nullptr;
+    int hit = xlstm_prefix_cache_lookup(&cache, kTest2_input, 3, &blob);
+    ok &= hit == 2 && blob == slot;
+    if (!ok) std::printf("  FAIL: lookup returned %d\n", hit);
+
+    float y2[H], c2[H], n2[H], m2[H], out2[H];
+    ok &= xlstm_state_restore_slstm_f32(blob, kSlot, y2, c2, n2, m2, B, H) == XLSTM_OK;
+    slstm_eval_f32(kTest2_input + hit * I, kTest1_W, kTest1_R, kTest1_b,
+                   y2, c2, n2, m2, out2, scratch, B, 3 - hit, I, H, &params);
+
+    ok &= ExpectNear("output", kTest2_expected_output + 2 * H, out2, H, kTolerance);
+    ok &= ExpectNear("c", kTest2_expected_c, c2, H, kTolerance);
+    return ok;
+}
+
+bool TestPrefixCacheLongestMatch() {
+    const int kCapacity = 4, kChunk = 2;
+    const size_t kSlot = 16;
+    XlstmPrefixEntry entries[kCapacity];
+    alignas(16) unsigned char pool[kCapacity * kSlot];
+    XlstmPrefixCache cache;
+    xlstm_prefix_cache_init(&cache, entries, kCapacity, pool, sizeof(pool),
+                            kSlot, kChunk, 1);
+
+    const uint8_t prompt[7] = {1, 2, 3, 4, 5, 6, 7};
+    const uint8_t other[7] = {1, 2, 3, 9, 5, 6, 7};
+    unsigned char* p2 = (unsigned char*)xlstm_prefix_cache_reserve(&cache, prompt, 2);
+    unsigned char* p4 = (unsigned char*)xlstm_prefix_cache_reserve(&cache, prompt, 4);
+
+    const void* blob = nullptr;
+    bool ok = true;
+    ok &= xlstm_prefix_cache_commit(&cache, p2, XLSTM_OK) == XLSTM_OK;
+    ok &= xlstm_prefix_cache_commit(&cache, p4, XLSTM_OK) == XLSTM_OK;
+    ok &= xlstm_prefix_cache_reserve(&cache, prompt, 3) == nullptr;  /* not a chunk boundary */
+    ok &= xlstm_prefix_cache_lookup(&cache, prompt, 7, &blob) == 4 && blob == p4;
+    ok &= xlstm_prefix_cache_lookup(&cache, prompt, 3, &blob) == 2 && blob == p2;
+    ok &= xlstm_prefix_cache_lookup(&cache, other, 7, &blob) == 2 && blob == p2;
+    ok &= xlstm_prefix_cache_lookup(&cache, other + 1, 6, &blob) == 0 && blob == nullptr;
+    ok &= xlstm_prefix_cache_reserve(&cache, prompt, 4) == p4;       /* re-reserve reuses */
+    if (!ok) std::printf("  FAIL: longest-prefix lookup\n");
+    return ok;
+}
+
+bool TestPrefixCacheLruEviction() {
+    const int kCapacity = 2;
+    const size_t kSlot = 16;
+    XlstmPrefixEntry entries[kCapacity];
+    alignas(16) unsigned char pool[kCapacity * kSlot];
+    XlstmPrefixCache cache;
+    bool ok = true;
+    ok &= xlstm_prefix_cache_init(&cache, entries, kCapacity, pool, kSlot,
+                                  kSlot, 1, 1) == XLSTM_ERR_SIZE;
+    xlstm_prefix_cache_init(&cache, entries, kCapacity, pool, sizeof(pool),
+                            kSlot, 1, 1);
+
+    const uint8_t a[1] = {10}, b[1] = {20}, c[1] = {30};
+    void* slot_a = xlstm_prefix_cache_reserve(&cache, a, 1);
+    void* slot_b = xlstm_prefix_cache_reserve(&cache, b, 1);
+    ok &= slot_a != slot_b;
+    xlstm_prefix_cache_commit(&cache, slot_a, XLSTM_OK);
+    xlstm_prefix_cache_commit(&cache, slot_b, XLSTM_OK);
+
+    /* Touch a, so b is the least recently used and c evicts it */
+    ok &= xlstm_prefix_cache_lookup(&cache, a, 1, nullptr) == 1;
+    ok &= xlstm_prefix_cache_reserve(&cache, c, 1) == slot_b;
+    xlstm_prefix_cache_commit(&cache, slot_b, XLSTM_OK);
+    ok &= xlstm_prefix_cache_lookup(&cache, b, 1, nullptr) == 0;
+    ok &= xlstm_prefix_cache_lookup(&cache, a, 1, nullptr) == 1;
+    ok &= xlstm_prefix_cache_lookup(&cache, c, 1, nullptr) == 1;
+
+    xlstm_prefix_cache_clear(&cache);
+    ok &= xlstm_prefix_cache_lookup(&cache, a, 1, nullptr) == 0;
+    if (!ok) std::printf("  FAIL: LRU eviction\n");
+    return ok;
+}
+
+bool TestPrefixCacheReserveCommit() {
+    const int kCapacity = 2;
+    const size_t kSlot = 16;
+    XlstmPrefixEntry entries[kCapacity];
+    alignas(16) unsigned char pool[kCapacity * kSlot];
+    XlstmPrefixCache cache;
+    xlstm_prefix_cache_init(&cache, entries, kCapacity, pool, sizeof(pool),
+                            kSlot, 1, 1);
+
+    const uint8_t a[1] = {10}, b[1] = {20};
+    bool ok = true;
+
+    /* Reserved but not committed: not a hit */
+    void* slot_a = xlstm_prefix_cache_reserve(&cache, a, 1);
+    ok &= xlstm_prefix_cache_lookup(&cache, a, 1, nullptr) == 0;
+    ok &= xlstm_prefix_cache_commit(&cache, slot_a, XLSTM_OK) == XLSTM_OK;
+    ok &= xlstm_prefix_cache_lookup(&cache, a, 1, nullptr) == 1;
+
+    /* Re-reserving hides the old blob while it is rewritten */
+    ok &= xlstm_prefix_cache_reserve(&cache, a, 1) == slot_a;
+    ok &= xlstm_prefix_cache_lookup(&cache, a, 1, nullptr) == 0;
+
+    /* A failed save drops the entry and frees its slot first */
+    ok &= xlstm_prefix_cache_commit(&cache, slot_a, XLSTM_ERR_SIZE) == XLSTM_OK;
+    ok &= xlstm_prefix_cache_lookup(&cache, a, 1, nullptr) == 0;
+    ok &= entries[0].prefix_len == 0 && entries[1].prefix_len == 0;
+    void* slot_b = xlstm_prefix_cache_reserve(&cache, b, 1);
+    ok &= slot_b == slot_a;
+
+    /* Only slots of this pool are accepted */
+    ok &= xlstm_prefix_cache_commit(&cache, pool + 1, XLSTM_OK) == XLSTM_ERR_ARG;
+    ok &= xlstm_prefix_cache_commit(&cache, pool + kSlot, XLSTM_OK) == XLSTM_ERR_ARG;
+    ok &= xlstm_prefix_cache_commit(&cache, nullptr, XLSTM_OK) == XLSTM_ERR_ARG;
+    if (!ok) std::printf("  FAIL: reserve/commit\n");
+    return ok;
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main() {
+    std::printf("[==========] Running prefix cache tests\n");
+
+    RUN_TEST(TestPrefixCacheResume);
+    RUN_TEST(TestPrefixCacheLongestMatch);
+    RUN_TEST(TestPrefixCacheLruEviction);
+    RUN_TEST(TestPrefixCacheReserveCommit);
+
+    std::printf("[==========] %d/%d tests passed\n", g_tests_passed, g_tests_run);
+    return g_tests_passed == g_tests_run ? 0 : 1;
+}
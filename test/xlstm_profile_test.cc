@@ -0,0 +1,200 @@
+/* Per-phase instrumentation unit tests
+ *
+ * Links the kernels built with -DXLSTM_PROFILE: results must be unchanged,
+ * every step call of every cell must be counted once under its kind, and
+ * the per-call callback must see exactly the cycles that end up in the
+ * accumulated counters.
+ *
+ * Build:
+ *   make test
+ * =========================================================================*/
+
+#include "xlstm_profile.h"
+#include "slstm.h"
+#include "mlstm.h"
+#include "slstm_q8.h"
+#include "mlstm_q8.h"
+#include "test_util.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// ============================================================================
+// Reference test data — same golden values as the kernel tests
+// ============================================================================
+
+#include "reference_data.h"
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static std::vector<float> Ramp(int len, float scale) {
+    std::vector<float> v(len);
+    for (int i = 0; i < len; ++i) v[i] = scale * (float)((i * 37) % 19 - 9);
+    return v;
+}
+
+struct CallbackSums {
+    uint64_t calls[XLSTM_KIND_MLSTM_S8 + 1];
+    uint64_t cycles[XLSTM_KIND_MLSTM_S8 + 1][XLSTM_PHASE_COUNT];
+};
+
+static void SumCallback(XlstmKind kind, const uint64_t cycles[XLSTM_PHASE_COUNT],
+                        void* user) {
+    CallbackSums* sums = (CallbackSums*)user;
+    sums->calls[kind]++;
+    for (int p = 0; p < XLSTM_PHASE_COUNT; ++p) sums->cycles[kind][p] += cycles[p];
+}
+
+// ============================================================================
+// Test cases
+// ============================================================================
+
+bool TestProfileKernelsUnchanged() {
+    xlstm_profile_reset();
+    bool ok = true;
+
+    float y[2] = {0}, c[2] = {0}, n[2] = {0}, m[2] = {0}, scratch[8];
+    SlstmParams sp = {0.0f, 0};
+    slstm_step_f32(kTest1_input, kTest1_W, kTest1_R, kTest1_b,
+                   y, c, n, m, scratch, 2, 2, &sp);
+    ok &= ExpectNear("slstm y", kTest1_expected_y, y, 2, 1e-5f);
+
+    float my[2] = {0}, C[4] = {0}, mn[2] = {0}, mm[1] = {0}, mscratch[10];
+    MlstmParams mp = {0.0f, 0};
+    mlstm_step_f32(kMTest1_input, kMTest1_W, kMTest1_b,
+                   my, C, mn, mm, mscratch, 3, 2, &mp);
+    ok &= ExpectNear("mlstm y", kMTest1_expected_y, my, 2, 1e-5f);
+    ok &= ExpectNear("mlstm C", kMTest1_expected_C, C, 4, 1e-5f);
+
+    XlstmProfileCounters s, ml;
+    xlstm_profile_get(XLSTM_KIND_SLSTM_F32, &s);
+    xlstm_profile_get(XLSTM_KIND_MLSTM_F32, &ml);
+    ok &= s.calls == 1 && ml.calls == 1;
+    if (!ok) std::printf("  FAIL: calls %llu %llu\n",
+                         (unsigned long long)s.calls, (unsigned long long)ml.calls);
+    return ok;
+}
+
+bool TestProfilePhases() {
+    const int B = 2, T = 5, I = 16, H = 32;
+    xlstm_profile_reset();
+    bool ok = true;
+
+    std::vector<float> input = Ramp(B * T * I, 0.05f), output(B * T * H);
+    std::vector<float> W = Ramp((4 * H + 2) * I, 0.02f), b(4 * H + 2, 0.1f);
+    std::vector<float> y(B * H, 0.0f), C(B * H * H, 0.0f), n(B * H, 0.0f), m(B, 0.0f);
+    std::vector<float> scratch(4 * H + 2);
+    MlstmParams mp = {0.0f, 0};
+    mlstm_eval_f32(input.data(), W.data(), b.data(), y.data(), C.data(), n.data(),
+                   m.data(), output.data(), scratch.data(), B, T, I, H, &mp);
+
+    XlstmProfileCounters ml;
+    xlstm_profile_get(XLSTM_KIND_MLSTM_F32, &ml);
+    ok &= ml.calls == (uint64_t)(B * T);
+    for (int p = 0; p < XLSTM_PHASE_COUNT; ++p) {
+        if (ml.cycles[p] == 0) {
+            std::printf("  FAIL: mLSTM %s has no cycles\n",
+                        xlstm_profile_phase_name((XlstmPhase)p));
+            ok = false;
+        }
+    }
+
+    /* sLSTM: batched step, pointwise update charged to gates */
+    std::vector<float> R = Ramp(4 * H * H, 0.01f), sy(3 * H, 0.0f), sc(3 * H, 0.0f);
+    std::vector<float> sn(3 * H, 0.0f), sm(3 * H, 0.0f), sscratch(2 * 4 * H);
+    const int slots[2] = {2, 0};
+    SlstmParams sp = {0.0f, 0};
+    slstm_step_batch_f32(input.data(), slots, 2, W.data(), R.data(), b.data(),
+                         sy.data(), sc.data(), sn.data(), sm.data(),
+                         sscratch.data(), I, H, &sp);
+
+    XlstmProfileCounters s;
+    xlstm_profile_get(XLSTM_KIND_SLSTM_F32, &s);
+    ok &= s.calls == 1;
+    ok &= s.cycles[XLSTM_PHASE_PROJECTION] > 0 && s.cycles[XLSTM_PHASE_GATES] > 0;
+    ok &= s.cycles[XLSTM_PHASE_STATE] == 0 && s.cycles[XLSTM_PHASE_READOUT] == 0;
+    if (!ok) std::printf("  FAIL: sLSTM counters\n");
+
+    xlstm_profile_reset();
+    xlstm_profile_get(XLSTM_KIND_MLSTM_F32, &ml);
+    ok &= ml.calls == 0 && ml.cycles[XLSTM_PHASE_STATE] == 0;
+    return ok;
+}
+
+bool TestProfileCallback() {
+    const int I = 8, H = 16, T = 3;
+    static CallbackSums sums;
+    std::memset(&sums, 0, sizeof(sums));
+    xlstm_profile_reset();
+    xlstm_profile_set_callback(SumCallback, &sums);
+    bool ok = true;
+
+    std::vector<int8_t> x(T * I), W((4 * H + 2) * I), R(4 * H * H);
+    for (size_t i = 0; i < x.size(); ++i) x[i] = (int8_t)((int)(i * 7) % 41 - 20);
+    for (size_t i = 0; i < W.size(); ++i) W[i] = (int8_t)((int)(i * 13) % 51 - 25);
+    for (size_t i = 0; i < R.size(); ++i) R[i] = (int8_t)((int)(i * 11) % 31 - 15);
+    std::vector<int32_t> b(4 * H + 2, 0), scratch(4 * H + 2);
+
+    SlstmS8Params sp;
+    std::memset(&sp, 0, sizeof(sp));
+    sp.W_scale = sp.R_scale = 0.01f;
+    sp.x_quant.scale = 0.05f;
+    sp.y_quant.scale = 1.0f / 127;
+    sp.c_quant.scale = sp.n_quant.scale = 1.0f / 1024;
+    std::vector<int8_t> y(H, 0), out(T * H);
+    std::vector<int16_t> c(H, 0), n(H, 0), C(H * H, 0);
+    std::vector<float> m(H, 0.0f);
+    slstm_eval_s8(x.data(), W.data(), R.data(), b.data(), y.data(), c.data(), n.data(),
+                  m.data(), out.data(), scratch.data(), 1, T, I, H, &sp);
+
+    MlstmS8Params mp;
+    std::memset(&mp, 0, sizeof(mp));
+    mp.W_scale = 0.01f;
+    mp.x_quant.scale = 0.05f;
+    mp.y_quant.scale = 1.0f / 127;
+    mp.C_quant.scale = mp.n_quant.scale = 1.0f / 1024;
+    std::fill(y.begin(), y.end(), 0);
+    float mm = 0.0f;
+    for (int t = 0; t < T; ++t) {
+        mlstm_step_s8(x.data() + t * I, W.data(), b.data(), y.data(), C.data(), n.data(),
+                      &mm, scratch.data(), I, H, &mp);
+    }
+    xlstm_profile_set_callback(nullptr, nullptr);
+
+    const XlstmKind kinds[] = {XLSTM_KIND_SLSTM_S8, XLSTM_KIND_MLSTM_S8};
+    for (XlstmKind kind : kinds) {
+        XlstmProfileCounters total;
+        xlstm_profile_get(kind, &total);
+        ok &= total.calls == (uint64_t)T && sums.calls[kind] == (uint64_t)T;
+        for (int p = 0; p < XLSTM_PHASE_COUNT; ++p) {
+            ok &= total.cycles[p] == sums.cycles[kind][p];
+        }
+        ok &= total.cycles[XLSTM_PHASE_PROJECTION] > 0;
+    }
+    ok &= sums.calls[XLSTM_KIND_SLSTM_F32] == 0 && sums.calls[XLSTM_KIND_MLSTM_F32] == 0;
+    if (!ok) std::printf("  FAIL: callback sums\n");
+
+    XlstmProfileCounters none;
+    xlstm_profile_get(XLSTM_KIND_MLSTM_BLOCK_F32, &none);
+    ok &= none.calls == 0;
+    return ok;
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main() {
+    std::printf("[==========] Running instrumentation tests\n");
+
+    RUN_TEST(TestProfileKernelsUnchanged);
+    RUN_TEST(TestProfilePhases);
+    RUN_TEST(TestProfileCallback);
+
+    std::printf("[==========] %d/%d tests passed\n", g_tests_passed, g_tests_run);
+    return g_tests_passed == g_tests_run ? 0 : 1;
+}
@@ -0,0 +1,167 @@
+/* Continuous-batching scheduler unit tests
+ *
+ * Streams are admitted and retired at different ticks; every stream's
+ * outputs must match the reference values of running it on its own.
+ *
+ * Build:
+ *   make test
+ * =========================================================================*/
+
+#include "xlstm_sched.h"
+#include "test_util.h"
+
+// ============================================================================
+// Reference test data — same golden values as the kernel tests
+// ============================================================================
+
+#include "reference_data.h"
+
+// ============================================================================
+// Test cases
+// ============================================================================
+
+constexpr float kTolerance = 1e-5f;
+
+bool TestSchedAdmitRetire() {
+    const int kCapacity = 2;
+    int32_t stream_ids[kCapacity];
+    int active[kCapacity];
+    uint8_t fresh[kCapacity];
+    XlstmScheduler sched;
+    xlstm_sched_init(&sched, kCapacity, stream_ids, active, fresh);
+
+    bool ok = true;
+    ok &= xlstm_sched_admit(&sched, 1, 1) == 0;
+    ok &= xlstm_sched_admit(&sched, 1, 1) == -1;   /* duplicate */
+    ok &= xlstm_sched_admit(&sched, 2, 1) == 1;
+    ok &= xlstm_sched_admit(&sched, 3, 1) == -1;   /* full */
+    ok &= xlstm_sched_retire(&sched, 1) == 0;
+    ok &= xlstm_sched_retire(&sched, 1) == -1;     /* already retired */
+    ok &= sched.num_active == 1 && sched.active[0] == 1;
+    ok &= xlstm_sched_admit(&sched, 3, 1) == 0;    /* slot reused */
+    ok &= sched.num_active == 2 && sched.active[1] == 0;
+    ok &= xlstm_sched_slot(&sched, 3) == 0;
+    ok &= xlstm_sched_slot(&sched, 7) == -1;
+    if (!ok) std::printf("  FAIL: slot bookkeeping\n");
+    return ok;
+}
+
+bool TestSchedSlstmStaggeredStreams() {
+    /* A and B both run the Test 2 sequence, B one tick behind. C joins after
+     * A retires and reuses A's (dirty) slot with the Test 1 input. */
+    const int I = 2, H = 2, kCapacity = 2;
+    int32_t stream_ids[kCapacity];
+    int active[kCapacity];
+    uint8_t fresh[kCapacity];
+    XlstmScheduler sched;
+    xlstm_sched_init(&sched, kCapacity, stream_ids, active, fresh);
+
+    float y[kCapacity * H], c[kCapacity * H], n[kCapacity * H], m[kCapacity * H];
+    float x[kCapacity * I], out[kCapacity * H];
+    float scratch[kCapacity * 4 * H];
+    float out_a[3 * H], out_b[3 * H], out_c[H];
+    SlstmParams params = {0.0f, 0};
+
+    const int kA = 10, kB = 20, kC = 30;
+    xlstm_sched_admit(&sched, kA, 1);
+
+    for (int tick = 0; tick < 4; ++tick) {
+        if (tick == 1) xlstm_sched_admit(&sched, kB, 1);
+        if (tick == 3) {
+            xlstm_sched_retire(&sched, kA);
+            xlstm_sched_admit(&sched, kC, 1);
+        }
+
+        /* Gather one input row per active stream, in scheduler order */
+        for (int k = 0; k < sched.num_active; ++k) {
+            int32_t id = sched.stream_ids[sched.active[k]];
+            const float* src = (id == kA) ? kTest2_input + tick * I
+                             : (id == kB) ? kTest2_input + (tick - 1) * I
+                             : kTest1_input;
+            for (int j = 0; j < I; ++j) x[k * I + j] = src[j];
+        }
+
+        xlstm_sched_tick_slstm_f32(&sched, x, kTest1_W, kTest1_R, kTest1_b,
+                                   y, c, n, m, out, scratch, I, H, &params);
+
+        for (int k = 0; k < sched.num_active; ++k) {
+            int32_t id = sched.stream_ids[sched.active[k]];
+            float* dst = (id == kA) ? out_a + tick * H
+                       : (id == kB) ? out_b + (tick - 1) * H
+                       : out_c;
+            for (int j = 0; j < H; ++j) dst[j] = out[k * H + j];
+        }
+    }
+
+    bool ok = true;
+    ok &= ExpectNear("stream_a", kTest2_expected_output, out_a, 3 * H, kTolerance);
+    ok &= ExpectNear("stream_b", kTest2_expected_output, out_b, 3 * H, kTolerance);
+    ok &= ExpectNear("stream_c", kTest1_expected_y, out_c, H, kTolerance);
+    return ok;
+}
+
+bool TestSchedMlstmStaggeredStreams() {
+    const int I = 3, H = 2, kCapacity = 2;
+    int32_t stream_ids[kCapacity];
+    int active[kCapacity];
+    uint8_t fresh[kCapacity];
+    XlstmScheduler sched;
+    xlstm_sched_init(&sched, kCapacity, stream_ids, active, fresh);
+
+    float y[kCapacity * H], C[kCapacity * H * H], n[kCapacity * H], m[kCapacity];
+    float x[kCapacity * I], out[kCapacity * H];
+    float scratch[kCapacity * (4 * H + 2)];
+    float out_a[3 * H], out_b[3 * H], out_c[H];
+    MlstmParams params = {0.0f, 0};
+
+    const int kA = 10, kB = 20, kC = 30;
+    xlstm_sched_admit(&sched, kA, 1);
+
+    for (int tick = 0; tick < 4; ++tick) {
+        if (tick == 1) xlstm_sched_admit(&sched, kB, 1);
+        if (tick == 3) {
+            xlstm_sched_retire(&sched, kA);
+            xlstm_sched_admit(&sched, kC, 1);
+        }
+
+        for (int k = 0; k < sched.num_active; ++k) {
+            int32_t id = sched.stream_ids[sched.active[k]];
+            const float* src = (id == kA) ? kMTest2_input + tick * I
+                             : (id == kB) ? kMTest2_input + (tick - 1) * I
+                             : kMTest1_input;
+            for (int j = 0; j < I; ++j) x[k * I + j] = src[j];
+        }
+
+        xlstm_sched_tick_mlstm_f32(&sched, x, kMTest1_W, kMTest1_b,
+                                   y, C, n, m, out, scratch, I, H, &params);
+
+        for (int k = 0; k < sched.num_active; ++k) {
+            int32_t id = sched.stream_ids[sched.active[k]];
+            float* dst = (id == kA) ? out_a + tick * H
+                       : (id == kB) ? out_b + (tick - 1) * H
+                       : out_c;
+            for (int j = 0; j < H; ++j) dst[j] = out[k * H + j];
+        }
+    }
+
+    bool ok = true;
+    ok &= ExpectNear("stream_a", kMTest2_expected_output, out_a, 3 * H, kTolerance);
+    ok &= ExpectNear("stream_b", kMTest2_expected_output, out_b, 3 * H, kTolerance);
+    ok &= ExpectNear("stream_c", kMTest1_expected_y, out_c, H, kTolerance);
+    return ok;
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main() {
+    std::printf("[==========] Running scheduler tests\n");
+
+    RUN_TEST(TestSchedAdmitRetire);
+    RUN_TEST(TestSchedSlstmStaggeredStreams);
+    RUN_TEST(TestSchedMlstmStaggeredStreams);
+
+    std::printf("[==========] %d/%d tests passed\n", g_tests_passed, g_tests_run);
+    return g_tests_passed == g_tests_run ? 0 : 1;
+}
@@ -0,0 +1,227 @@
+/* Layer-stack runtime unit tests
+ *
+ * The wavefront schedule (serial and threaded) must produce bit-identical
+ * outputs and final states to chaining the single-layer eval calls.
+ *
+ * Build:
+ *   make test
+ * =========================================================================*/
+
+#include "xlstm_stack.h"
+#include "test_util.h"
+
+#include <cmath>
+#include <cstring>
+
+// ============================================================================
+// Test model: sLSTM(3->4) -> mLSTM(4->3) -> sLSTM(3->2)
+// ============================================================================
+
+namespace {
+
+constexpr int kB = 2, kT = 7, kChunk = 3;
+constexpr int kI0 = 3, kH0 = 4, kH1 = 3, kH2 = 2;
+
+/* Deterministic pseudo-random fill in [-scale, scale] */
+void Fill(float* dst, int len, float seed, float scale) {
+    for (int i = 0; i < len; ++i) dst[i] = scale * std::sin(seed + 1.7f * i);
+}
+
+struct Model {
+    float W0[4 * kH0 * kI0], R0[4 * kH0 * kH0], b0[4 * kH0];
+    float W1[(4 * kH1 + 2) * kH0], b1[4 * kH1 + 2];
+    float W2[4 * kH2 * kH1], R2[4 * kH2 * kH2], b2[4 * kH2];
+
+    Model() {
+        Fill(W0, 4 * kH0 * kI0, 0.1f, 0.8f);
+        Fill(R0, 4 * kH0 * kH0, 0.2f, 0.5f);
+        Fill(b0, 4 * kH0, 0.3f, 0.1f);
+        Fill(W1, (4 * kH1 + 2) * kH0, 0.4f, 0.8f);
+        Fill(b1, 4 * kH1 + 2, 0.5f, 0.1f);
+        Fill(W2, 4 * kH2 * kH1, 0.6f, 0.8f);
+        Fill(R2, 4 * kH2 * kH2, 0.7f, 0.5f);
+        Fill(b2, 4 * kH2, 0.8f, 0.1f);
+    }
+};
+
+struct States {
+    float y0[kB * kH0], c0[kB * kH0], n0[kB * kH0], m0[kB * kH0];
+    float y1[kB * kH1], C1[kB * kH1 * kH1], n1[kB * kH1], m1[kB];
+    float y2[kB * kH2], c2[kB * kH2], n2[kB * kH2], m2[kB * kH2];
+    float s0[4 * kH0], s1[4 * kH1 + 2], s2[4 * kH2];
+
+    States() { std::memset(this, 0, sizeof(*this)); }
+};
+
+void Reference(const Model& w, const float* input, float* output, States* s) {
+    float h0[kB * kT * kH0], h1[kB * kT * kH1];
+    SlstmParams sp = {0.0f, 0};
+    MlstmParams mp = {0.0f, 0};
+    slstm_eval_f32(input, w.W0, w.R0, w.b0, s->y0, s->c0, s->n0, s->m0,
+                   h0, s->s0, kB, kT, kI0, kH0, &sp);
+    mlstm_eval_f32(h0, w.W1, w.b1, s->y1, s->C1, s->n1, s->m1,
+                   h1, s->s1, kB, kT, kH0, kH1, &mp);
+    slstm_eval_f32(h1, w.W2, w.R2, w.b2, s->y2, s->c2, s->n2, s->m2,
+                   output, s->s2, kB, kT, kH1, kH2, &sp);
+}
+
+void BuildLayers(const Model& w, States* s, XlstmStackLayer* layers) {
+    std::memset(layers, 0, 3 * sizeof(XlstmStackLayer));
+    layers[0] = {XLSTM_KIND_SLSTM_F32, kI0, kH0, w.W0, w.R0, w.b0,
+                 s->y0, s->c0, s->n0, s->m0, s->s0, {0.0f, 0}, {0.0f, 0}};
+    layers[1] = {XLSTM_KIND_MLSTM_F32, kH0, kH1, w.W1, nullptr, w.b1,
+                 s->y1, s->C1, s->n1, s->m1, s->s1, {0.0f, 0}, {0.0f, 0}};
+    layers[2] = {XLSTM_KIND_SLSTM_F32, kH1, kH2, w.W2, w.R2, w.b2,
+                 s->y2, s->c2, s->n2, s->m2, s->s2, {0.0f, 0}, {0.0f, 0}};
+}
+
+bool SameStates(const States& a, const States& b) {
+    bool ok = true;
+    ok &= std::memcmp(a.y0, b.y0, sizeof(a.y0)) == 0 && std::memcmp(a.c0, b.c0, sizeof(a.c0)) == 0;
+    ok &= std::memcmp(a.C1, b.C1, sizeof(a.C1)) == 0 && std::memcmp(a.m1, b.m1, sizeof(a.m1)) == 0;
+    ok &= std::memcmp(a.y2, b.y2, sizeof(a.y2)) == 0 && std::memcmp(a.n2, b.n2, sizeof(a.n2)) == 0;
+    return ok;
+}
+
+}  // namespace
+
+// ============================================================================
+// Test cases
+// ============================================================================
+
+bool TestStackSetupErrors() {
+    Model w;
+    States s;
+    XlstmStackLayer layers[3];
+    BuildLayers(w, &s, layers);
+    XlstmStack stack;
+    float ring[64];
+
+    size_t need = xlstm_stack_ring_size(layers, 3, kB, kChunk);
+    bool ok = true;
+    ok &= need == 2u * kB * kChunk * (kH0 + kH1);
+    ok &= xlstm_stack_init(&stack, layers, 3, ring, need - 1, kB, kChunk) == XLSTM_ERR_SIZE;
+    layers[1].input_size = kH0 + 1;
+    ok &= xlstm_stack_init(&stack, layers, 3, ring, need, kB, kChunk) == XLSTM_ERR_SHAPE;
+    layers[1].input_size = kH0;
+    layers[1].kind = XLSTM_KIND_MLSTM_S8;
+    ok &= xlstm_stack_init(&stack, layers, 3, ring, need, kB, kChunk) == XLSTM_ERR_ARG;
+    if (!ok) std::printf("  FAIL: init validation\n");
+    return ok;
+}
+
+bool TestStackWavefrontMatchesChained() {
+    Model w;
+    float input[kB * kT * kI0];
+    Fill(input, kB * kT * kI0, 1.3f, 1.0f);
+
+    States ref;
+    float expected[kB * kT * kH2];
+    Reference(w, input, expected, &ref);
+
+    States s;
+    XlstmStackLayer layers[3];
+    BuildLayers(w, &s, layers);
+    XlstmStack stack;
+    float ring[2 * kB * kChunk * (kH0 + kH1)];
+    float output[kB * kT * kH2];
+
+    bool ok = true;
+    ok &= xlstm_stack_init(&stack, layers, 3, ring, sizeof(ring) / sizeof(float),
+                           kB, kChunk) == XLSTM_OK;
+    /* 3 chunks (3 + 3 + 1 steps) x 3 layers -> 5 waves */
+    ok &= xlstm_stack_begin(&stack, input, output, kT) == 5;
+    xlstm_stack_eval(&stack, input, output, kT);
+
+    ok &= std::memcmp(expected, output, sizeof(output)) == 0;
+    ok &= SameStates(ref, s);
+    if (!ok) std::printf("  FAIL: serial wavefront differs from chained eval\n");
+    return ok;
+}
+
+#ifdef XLSTM_USE_PTHREADS
+bool TestStackParallelMatchesChained() {
+    Model w;
+    float input[kB * kT * kI0];
+    Fill(input, kB * kT * kI0, 2.9f, 1.0f);
+
+    States ref;
+    float expected[kB * kT * kH2];
+    Reference(w, input, expected, &ref);
+
+    States s;
+    XlstmStackLayer layers[3];
+    BuildLayers(w, &s, layers);
+    XlstmStack stack;
+    float ring[2 * kB * kChunk * (kH0 + kH1)];
+    float output[kB * kT * kH2];
+    xlstm_stack_init(&stack, layers, 3, ring, sizeof(ring) / sizeof(float), kB, kChunk);
+
+    bool ok = xlstm_stack_eval_parallel(&stack, input, output, kT, 4) == XLSTM_OK;
+    ok &= std::memcmp(expected, output, sizeof(output)) == 0;
+    ok &= SameStates(ref, s);
+    if (!ok) std::printf("  FAIL: threaded wavefront differs from chained eval\n");
+    return ok;
+}
+
+bool TestStackPoolStreaming() {
+    /* One pool serves many short calls; streaming 2 steps per call must
+     * match one chained eval over the whole sequence */
+    Model w;
+    float input[kB * kT * kI0];
+    Fill(input, kB * kT * kI0, 4.1f, 1.0f);
+
+    States ref;
+    float expected[kB * kT * kH2];
+    Reference(w, input, expected, &ref);
+
+    States s;
+    XlstmStackLayer layers[3];
+    BuildLayers(w, &s, layers);
+    XlstmStack stack;
+    XlstmStackPool pool;
+    float ring[2 * kB * kChunk * (kH0 + kH1)];
+    xlstm_stack_init(&stack, layers, 3, ring, sizeof(ring) / sizeof(float), kB, kChunk);
+
+    bool ok = xlstm_stack_pool_init(&stack, &pool, 8) == XLSTM_OK;
+    ok &= stack.pool == &pool;
+    for (int t0 = 0; t0 < kT; t0 += 2) {
+        const int steps = (kT - t0 < 2) ? kT - t0 : 2;
+        float x[kB * 2 * kI0], y[kB * 2 * kH2];
+        for (int b = 0; b < kB; ++b) {
+            std::memcpy(x + b * steps * kI0, input + (b * kT + t0) * kI0,
+                        steps * kI0 * sizeof(float));
+        }
+        ok &= xlstm_stack_eval_parallel(&stack, x, y, steps, 3) == XLSTM_OK;
+        for (int b = 0; b < kB; ++b) {
+            ok &= std::memcmp(y + b * steps * kH2, expected + (b * kT + t0) * kH2,
+                              steps * kH2 * sizeof(float)) == 0;
+        }
+    }
+    ok &= SameStates(ref, s);
+    xlstm_stack_pool_destroy(&stack);
+    ok &= stack.pool == nullptr;
+    ok &= xlstm_stack_eval_parallel(nullptr, input, expected, kT, 2) == XLSTM_ERR_ARG;
+    ok &= xlstm_stack_pool_init(&stack, nullptr, 2) == XLSTM_ERR_ARG;
+    if (!ok) std::printf("  FAIL: pooled streaming differs from chained eval\n");
+    return ok;
+}
+#endif
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main() {
+    std::printf("[==========] Running layer stack tests\n");
+
+    RUN_TEST(TestStackSetupErrors);
+    RUN_TEST(TestStackWavefrontMatchesChained);
+#ifdef XLSTM_USE_PTHREADS
+    RUN_TEST(TestStackParallelMatchesChained);
+    RUN_TEST(TestStackPoolStreaming);
+#endif
+
+    std::printf("[==========] %d/%d tests passed\n", g_tests_passed, g_tests_run);
+    return g_tests_passed == g_tests_run ? 0 : 1;
+}
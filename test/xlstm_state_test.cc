@@ -0,0 +1,176 @@
+/* State snapshot unit tests
+ *
+ * Saving after part of a sequence and resuming from the restored blob must
+ * reproduce the reference outputs of running the sequence in one go.
+ *
+ * Build:
+ *   make test
+ * =========================================================================*/
+
+#include "xlstm_state.h"
+#include "slstm.h"
+#include "mlstm.h"
+#include "test_util.h"
+
+#include <cstring>
+
+// ============================================================================
+// Reference test data — same golden values as the kernel tests
+// ============================================================================
+
+#include "reference_data.h"
+
+// ============================================================================
+// Test cases
+// ============================================================================
+
+constexpr float kTolerance = 1e-5f;
+
+bool TestStateSlstmResume() {
+    /* Run step 1 of the Test 2 sequence, snapshot, restore into fresh
+     * buffers and run steps 2-3 from there. */
+    const int B = 1, I = 2, H = 2;
+    SlstmParams params = {0.0f, 0};
+    float y[H] = {0}, c[H] = {0}, n[H] = {0}, m[H] = {0};
+    float output[3 * H], scratch[4 * H];
+
+    slstm_eval_f32(kTest2_input, kTest1_W, kTest1_R, kTest1_b,
+                   y, c, n, m, output, scratch, B, 1, I, H, &params);
+
+    alignas(16) unsigned char blob[256];
+    size_t size = xlstm_state_size(XLSTM_KIND_SLSTM_F32, B, H);
+    bool ok = true;
+    ok &= size <= sizeof(blob);
+    ok &= xlstm_state_save_slstm_f32(y, c, n, m, B, H, blob, size) == XLSTM_OK;
+
+    float y2[H], c2[H], n2[H], m2[H];
+    ok &= xlstm_state_restore_slstm_f32(blob, size, y2, c2, n2, m2, B, H) == XLSTM_OK;
+    slstm_eval_f32(kTest2_input + I, kTest1_W, kTest1_R, kTest1_b,
+                   y2, c2, n2, m2, output + H, scratch, B, 2, I, H, &params);
+
+    ok &= ExpectNear("output", kTest2_expected_output, output, 3 * H, kTolerance);
+    ok &= ExpectNear("c", kTest2_expected_c, c2, H, kTolerance);
+    ok &= ExpectNear("m", kTest2_expected_m, m2, H, kTolerance);
+    return ok;
+}
+
+bool TestStateMlstmResume() {
+    const int B = 1, I = 3, H = 2;
+    MlstmParams params = {0.0f, 0};
+    float y[H] = {0}, C[H * H] = {0}, n[H] = {0}, m[1] = {0};
+    float output[3 * H], scratch[4 * H + 2];
+
+    mlstm_eval_f32(kMTest2_input, kMTest1_W, kMTest1_b,
+                   y, C, n, m, output, scratch, B, 1, I, H, &params);
+
+    alignas(16) unsigned char blob[256];
+    size_t size = xlstm_state_size(XLSTM_KIND_MLSTM_F32, B, H);
+    bool ok = true;
+    ok &= size <= sizeof(blob);
+    ok &= xlstm_state_save_mlstm_f32(y, C, n, m, B, H, blob, size) == XLSTM_OK;
+
+    float y2[H], C2[H * H], n2[H], m2[1];
+    ok &= xlstm_state_restore_mlstm_f32(blob, size, y2, C2, n2, m2, B, H) == XLSTM_OK;
+    mlstm_eval_f32(kMTest2_input + I, kMTest1_W, kMTest1_b,
+                   y2, C2, n2, m2, output + H, scratch, B, 2, I, H, &params);
+
+    ok &= ExpectNear("output", kMTest2_expected_output, output, 3 * H, kTolerance);
+    ok &= ExpectNear("C", kMTest2_expected_C, C2, H * H, kTolerance);
+    ok &= ExpectNear("m", kMTest2_expected_m, m2, 1, kTolerance);
+    return ok;
+}
+
+bool TestStateViewAndErrors() {
+    const int B = 2, H = 3;
+    float y[B * H], C[B * H * H], n[B * H], m[B];
+    for (int i = 0; i < B * H; ++i) { y[i] = 0.5f * i; n[i] = -1.0f * i; }
+    for (int i = 0; i < B * H * H; ++i) C[i] = 0.25f * i;
+    m[0] = 1.5f; m[1] = -2.5f;
+
+    alignas(16) unsigned char blob[512];
+    size_t size = xlstm_state_size(XLSTM_KIND_MLSTM_F32, B, H);
+    bool ok = true;
+    ok &= size % XLSTM_STATE_ALIGN == 0 && size <= sizeof(blob);
+    ok &= xlstm_state_save_mlstm_f32(y, C, n, m, B, H, blob, size - 1) == XLSTM_ERR_SIZE;
+    ok &= xlstm_state_save_mlstm_f32(y, C, n, m, B, H, blob, size) == XLSTM_OK;
+
+    /* Zero-copy view aliases the blob and sees the saved values */
+    XlstmStateView view;
+    ok &= xlstm_state_view(blob, size, &view) == XLSTM_OK;
+    ok &= view.kind == XLSTM_KIND_MLSTM_F32;
+    ok &= view.batch_size == B && view.hidden_size == H;
+    ok &= ((uintptr_t)view.c - (uintptr_t)blob) % XLSTM_STATE_ALIGN == 0;
+    ok &= std::memcmp(view.c, C, sizeof(C)) == 0;
+    ok &= view.m[1] == -2.5f;
+    if (!ok) std::printf("  FAIL: view\n");
+
+    float y2[B * H], C2[B * H * H], n2[B * H], m2[B];
+    bool err = true;
+    err &= xlstm_state_view(blob, size - 1, &view) == XLSTM_ERR_SIZE;
+    err &= xlstm_state_restore_slstm_f32(blob, size, y2, C2, n2, m2, B, H) == XLSTM_ERR_FORMAT;
+    err &= xlstm_state_restore_mlstm_f32(blob, size, y2, C2, n2, m2, B, H + 1) == XLSTM_ERR_SHAPE;
+    err &= xlstm_state_restore_mlstm_f32(blob, size, y2, nullptr, n2, m2, B, H) == XLSTM_ERR_ARG;
+    err &= xlstm_state_restore_mlstm_f32(blob, size, y2, C2, n2, nullptr, B, H) == XLSTM_ERR_ARG;
+    /* C alone is 4 GiB here: rejected before anything is written */
+    if (sizeof(size_t) > 4) {
+        err &= xlstm_state_save_mlstm_f32(y, C, n, m, 1024, 1024, blob, SIZE_MAX) == XLSTM_ERR_SIZE;
+    }
+    blob[0] ^= 0xff;
+    err &= xlstm_state_view(blob, size, &view) == XLSTM_ERR_FORMAT;
+    if (!err) std::printf("  FAIL: error codes\n");
+    return ok && err;
+}
+
+bool TestStateS8Requantize() {
+    const int B = 1, H = 2;
+    MlstmS8Params saved = {};
+    saved.y_quant = {0.02f, 3};
+    saved.C_quant = {0.01f, 0};
+    saved.n_quant = {0.01f, 0};
+
+    int8_t y[H] = {13, -37};
+    int16_t C[H * H] = {100, -200, 300, -32000};
+    int16_t n[H] = {50, -50};
+    float m[1] = {0.75f};
+
+    alignas(16) unsigned char blob[256];
+    size_t size = xlstm_state_size(XLSTM_KIND_MLSTM_S8, B, H);
+    bool ok = true;
+    ok &= xlstm_state_save_mlstm_s8(y, C, n, m, B, H, &saved, blob, size) == XLSTM_OK;
+
+    /* Same params: bit-exact copy */
+    int8_t y2[H];
+    int16_t C2[H * H], n2[H];
+    float m2[1];
+    ok &= xlstm_state_restore_mlstm_s8(blob, size, y2, C2, n2, m2, B, H, &saved) == XLSTM_OK;
+    ok &= std::memcmp(y, y2, sizeof(y)) == 0 && std::memcmp(C, C2, sizeof(C)) == 0;
+    ok &= std::memcmp(n, n2, sizeof(n)) == 0 && m2[0] == m[0];
+    if (!ok) std::printf("  FAIL: exact restore\n");
+
+    /* Different params: requantized, saturating at the int16 range */
+    MlstmS8Params target = saved;
+    target.y_quant = {0.04f, 0};
+    target.C_quant = {0.005f, 0};
+    ok &= xlstm_state_restore_mlstm_s8(blob, size, y2, C2, n2, m2, B, H, &target) == XLSTM_OK;
+    ok &= y2[0] == 5 && y2[1] == -20;
+    ok &= C2[0] == 200 && C2[1] == -400 && C2[2] == 600 && C2[3] == -32768;
+    ok &= n2[0] == 50 && n2[1] == -50;
+    if (!ok) std::printf("  FAIL: requantized restore\n");
+    return ok;
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main() {
+    std::printf("[==========] Running state snapshot tests\n");
+
+    RUN_TEST(TestStateSlstmResume);
+    RUN_TEST(TestStateMlstmResume);
+    RUN_TEST(TestStateViewAndErrors);
+    RUN_TEST(TestStateS8Requantize);
+
+    std::printf("[==========] %d/%d tests passed\n", g_tests_passed, g_tests_run);
+    return g_tests_passed == g_tests_run ? 0 : 1;
+}
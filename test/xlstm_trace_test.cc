@@ -0,0 +1,215 @@
+/* Timeline tracing unit tests
+ *
+ * Links the cells and the pthread stack driver built with -DXLSTM_TRACE:
+ * every stack work item and eval call must produce one span with the right
+ * layer, chunk and worker thread, eval spans must nest in their work item,
+ * and the JSON export must hold exactly the recorded events.
+ *
+ * Build:
+ *   make test
+ * =========================================================================*/
+
+#include "xlstm_trace.h"
+#include "xlstm_stack.h"
+#include "test_util.h"
+
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// Test model: sLSTM(3->4) -> mLSTM(4->3)
+// ============================================================================
+
+namespace {
+
+constexpr int kB = 2, kT = 7, kChunk = 3, kL = 2;
+constexpr int kI0 = 3, kH0 = 4, kH1 = 3;
+constexpr int kChunks = (kT + kChunk - 1) / kChunk;
+
+void Fill(float* dst, int len, float seed, float scale) {
+    for (int i = 0; i < len; ++i) dst[i] = scale * std::sin(seed + 1.7f * i);
+}
+
+struct Model {
+    float W0[4 * kH0 * kI0], R0[4 * kH0 * kH0], b0[4 * kH0];
+    float W1[(4 * kH1 + 2) * kH0], b1[4 * kH1 + 2];
+    float y0[kB * kH0], c0[kB * kH0], n0[kB * kH0], m0[kB * kH0];
+    float y1[kB * kH1], C1[kB * kH1 * kH1], n1[kB * kH1], m1[kB];
+    float s0[4 * kH0], s1[4 * kH1 + 2];
+    float ring[2 * kB * kChunk * kH0];
+    float input[kB * kT * kI0], output[kB * kT * kH1];
+    XlstmStackLayer layers[kL];
+    XlstmStack stack;
+
+    Model() {
+        std::memset(this, 0, sizeof(*this));
+        Fill(W0, 4 * kH0 * kI0, 0.1f, 0.8f);
+        Fill(R0, 4 * kH0 * kH0, 0.2f, 0.5f);
+        Fill(b0, 4 * kH0, 0.3f, 0.1f);
+        Fill(W1, (4 * kH1 + 2) * kH0, 0.4f, 0.8f);
+        Fill(b1, 4 * kH1 + 2, 0.5f, 0.1f);
+        Fill(input, kB * kT * kI0, 0.9f, 1.0f);
+        layers[0] = {XLSTM_KIND_SLSTM_F32, kI0, kH0, W0, R0, b0,
+                     y0, c0, n0, m0, s0, {0.0f, 0}, {0.0f, 0}};
+        layers[1] = {XLSTM_KIND_MLSTM_F32, kH0, kH1, W1, nullptr, b1,
+                     y1, C1, n1, m1, s1, {0.0f, 0}, {0.0f, 0}};
+        xlstm_stack_init(&stack, layers, kL, ring, sizeof(ring) / sizeof(float),
+                         kB, kChunk);
+    }
+};
+
+int CountNamed(const XlstmTrace& trace, const char* name) {
+    int n = 0;
+    for (int i = 0; i < xlstm_trace_count(&trace); ++i) {
+        n += std::strcmp(trace.events[i].name, name) == 0;
+    }
+    return n;
+}
+
+/* Every eval span lies inside a layer span of the same thread */
+bool EvalsNested(const XlstmTrace& trace) {
+    int n = xlstm_trace_count(&trace);
+    for (int i = 0; i < n; ++i) {
+        const XlstmTraceEvent& e = trace.events[i];
+        if (std::strstr(e.name, "_eval_") == nullptr) continue;
+        bool inside = false;
+        for (int j = 0; j < n && !inside; ++j) {
+            const XlstmTraceEvent& p = trace.events[j];
+            inside = std::strcmp(p.name, "layer") == 0 && p.tid == e.tid &&
+                     p.begin_ns <= e.begin_ns && e.end_ns <= p.end_ns;
+        }
+        if (!inside) {
+            std::printf("  FAIL: %s span %d not nested\n", e.name, i);
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+// ============================================================================
+// Test cases
+// ============================================================================
+
+bool TestTraceSerialStack() {
+    static Model model;
+    static XlstmTraceEvent events[256];
+    XlstmTrace trace;
+    xlstm_trace_init(&trace, events, 256);
+    xlstm_trace_start(&trace);
+    xlstm_stack_eval(&model.stack, model.input, model.output, kT);
+    xlstm_trace_stop();
+
+    bool ok = true;
+    ok &= CountNamed(trace, "layer") == kL * kChunks;
+    ok &= CountNamed(trace, "slstm_eval_f32") == kB * kChunks;
+    ok &= CountNamed(trace, "mlstm_eval_f32") == kB * kChunks;
+    ok &= xlstm_trace_count(&trace) == kL * kChunks * (1 + kB);
+    ok &= xlstm_trace_dropped(&trace) == 0;
+
+    /* Each (layer, chunk) item exactly once, on worker 0 */
+    int seen[kL][kChunks] = {};
+    for (int i = 0; i < xlstm_trace_count(&trace); ++i) {
+        const XlstmTraceEvent& e = events[i];
+        ok &= e.tid == 0 && e.end_ns >= e.begin_ns && e.begin_ns >= trace.origin_ns;
+        if (std::strcmp(e.name, "layer") == 0) {
+            ok &= e.layer >= 0 && e.layer < kL && e.chunk >= 0 && e.chunk < kChunks;
+            if (ok) seen[e.layer][e.chunk]++;
+        } else {
+            ok &= e.layer == -1 && e.chunk == -1;
+        }
+    }
+    for (int l = 0; l < kL; ++l) {
+        for (int k = 0; k < kChunks; ++k) ok &= seen[l][k] == 1;
+    }
+    ok &= EvalsNested(trace);
+    if (!ok) std::printf("  FAIL: serial spans\n");
+
+    /* Stopped: nothing more is recorded */
+    xlstm_stack_eval(&model.stack, model.input, model.output, kT);
+    ok &= xlstm_trace_count(&trace) == kL * kChunks * (1 + kB);
+    return ok;
+}
+
+bool TestTraceParallelStack() {
+    static Model model;
+    static XlstmTraceEvent events[256];
+    XlstmTrace trace;
+    xlstm_trace_init(&trace, events, 256);
+    xlstm_trace_start(&trace);
+    bool ok = xlstm_stack_eval_parallel(&model.stack, model.input, model.output,
+                                        kT, 2) == XLSTM_OK;
+    xlstm_trace_stop();
+
+    const int waves = kL + kChunks - 1;
+    ok &= CountNamed(trace, "layer") == kL * kChunks;
+    ok &= CountNamed(trace, "barrier") == 2 * waves;
+    ok &= CountNamed(trace, "slstm_eval_f32") + CountNamed(trace, "mlstm_eval_f32") ==
+          kL * kB * kChunks;
+
+    int per_tid[2] = {0, 0};
+    for (int i = 0; i < xlstm_trace_count(&trace); ++i) {
+        const XlstmTraceEvent& e = events[i];
+        ok &= e.tid == 0 || e.tid == 1;
+        if (ok && std::strcmp(e.name, "barrier") == 0) per_tid[e.tid]++;
+    }
+    ok &= per_tid[0] == waves && per_tid[1] == waves;
+    ok &= EvalsNested(trace);
+    if (!ok) std::printf("  FAIL: parallel spans\n");
+    return ok;
+}
+
+bool TestTraceJsonAndOverflow() {
+    static Model model;
+    static XlstmTraceEvent events[4];
+    XlstmTrace trace;
+    xlstm_trace_init(&trace, events, 4);
+    xlstm_trace_start(&trace);
+    xlstm_stack_eval(&model.stack, model.input, model.output, kT);
+    xlstm_trace_stop();
+
+    bool ok = xlstm_trace_count(&trace) == 4;
+    ok &= xlstm_trace_dropped(&trace) == kL * kChunks * (1 + kB) - 4;
+
+    size_t size = xlstm_trace_write_json(&trace, nullptr, 0);
+    std::vector<char> small(size - 1, 'x');
+    ok &= xlstm_trace_write_json(&trace, small.data(), small.size()) == size;
+    ok &= small[0] == 'x';   /* untouched when too small */
+
+    std::vector<char> buf(size);
+    ok &= xlstm_trace_write_json(&trace, buf.data(), buf.size()) == size;
+    std::string json(buf.begin(), buf.end());
+    ok &= json.rfind("{\"traceEvents\":[", 0) == 0;
+    ok &= json.find("\"displayTimeUnit\":\"ns\"}") != std::string::npos;
+
+    int complete = 0, depth = 0, min_depth = 0;
+    for (size_t pos = 0; (pos = json.find("\"ph\":\"X\"", pos)) != std::string::npos; ++pos) {
+        complete++;
+    }
+    for (char c : json) {
+        depth += (c == '{' || c == '[') - (c == '}' || c == ']');
+        if (depth < min_depth) min_depth = depth;
+    }
+    ok &= complete == 4 && depth == 0 && min_depth == 0;
+    ok &= json.find("\"args\":{\"layer\":") != std::string::npos;
+    if (!ok) std::printf("  FAIL: json (%d events)\n%s\n", complete, json.c_str());
+    return ok;
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main() {
+    std::printf("[==========] Running timeline trace tests\n");
+
+    RUN_TEST(TestTraceSerialStack);
+    RUN_TEST(TestTraceParallelStack);
+    RUN_TEST(TestTraceJsonAndOverflow);
+
+    std::printf("[==========] %d/%d tests passed\n", g_tests_passed, g_tests_run);
+    return g_tests_passed == g_tests_run ? 0 : 1;
+}
@@ -0,0 +1,619 @@
+#!/usr/bin/env python3
+"""Convert NX-AI/xlstm checkpoints to the xlstm.c model file format.
+
+Reads an xLSTMBlockStack / xLSTMLMModel state dict (safetensors or torch
+.pt/.pth/.bin), maps every mLSTM and sLSTM block onto the fused block
+layouts of include/xlstm_block.h and writes a file that xlstm_model_open /
+xlstm_model_map (include/xlstm_model.h) can bind without copies.
+https://github.com/NX-AI/xlstm
+
+Requires: pip install numpy  (plus torch for .pt checkpoints)
+Usage:    python3 tools/xlstm_convert.py model.safetensors model.xlsm
+          python3 tools/xlstm_convert.py model.pt model_q8.xlsm --q8 \
+              --calib embeddings.npy
+
+Mapping (see xlstm_block.h for the pipelines):
+  - Headwise q/k/v and i/f/z/o projections are expanded to dense
+    block-diagonal matrices and packed into the cell W/R/b layouts of
+    slstm.h and mlstm.h, with each gate reading its branch of the
+    [conv | unconvolved] cell input.
+  - mLSTM i/f gates are linear in q, k, v; their weights are folded through
+    the q/k/v projections. The cell's own output gate is pinned open
+    (zero weights, large bias) because the NX-AI block gates with swish(z).
+  - Norm weights are stored as (1 + w), the NX-AI residual weight proxy.
+  - --q8 quantizes weights symmetrically per tensor and picks per-layer
+    cell activation/state ranges by running calibration inputs through the
+    f32 blocks (pass real embedded inputs with --calib).
+  - The token embedding, lm_head and post_blocks_norm have no layer kind
+    and are skipped.
+
+Limitation: the mLSTM kernel has a single matrix memory, so mLSTM blocks
+must have num_heads == 1. NX-AI's default mLSTM config uses 4 heads, so
+stock pretrained checkpoints are rejected; only models trained with
+mlstm_block.mlstm.num_heads=1 convert. sLSTM blocks may use any number of
+heads.
+"""
+
+import argparse
+import json
+import os
+import re
+import struct
+import sys
+
+import numpy as np
+
+
+# ============================================================================
+# File format constants — mirror include/xlstm_model.h and xlstm_types.h
+# ============================================================================
+
+MODEL_MAGIC = 0x4D534C58  # "XLSM"
+MODEL_VERSION = 1
+MODEL_ALIGN = 64
+
+KIND_MLSTM_BLOCK_F32 = 5
+KIND_SLSTM_BLOCK_F32 = 6
+KIND_MLSTM_BLOCK_Q8 = 7
+KIND_SLSTM_BLOCK_Q8 = 8
+
+DTYPE_F32, DTYPE_S8, DTYPE_S16, DTYPE_S32 = 1, 2, 3, 4
+DTYPE_OF = {
+    np.dtype(np.float32): DTYPE_F32,
+    np.dtype(np.int8): DTYPE_S8,
+    np.dtype(np.int16): DTYPE_S16,
+    np.dtype(np.int32): DTYPE_S32,
+}
+
+ROLE = {
+    "cell_W": 1, "cell_R": 2, "cell_b": 3, "ln_w": 4, "ln_b": 5,
+    "up_W": 6, "up_b": 7, "conv_w": 8, "conv_b": 9, "gn_w": 10,
+    "skip": 11, "down_W": 12, "down_b": 13, "ln2_w": 14, "ln2_b": 15,
+}
+
+HEADER = struct.Struct("<IHHIIQQQ24x")          # XlstmModelHeader, 64 bytes
+LAYER = struct.Struct("<B3x4IIIf" + "fi" * 4)   # XlstmModelLayer, 64 bytes
+TENSOR = struct.Struct("<BBHIII QQ fi 8x")      # XlstmModelTensor, 48 bytes
+
+# sigmoid(OGATE_OPEN) rounds to 1.0f: keeps the mLSTM cell output gate open
+OGATE_OPEN = 30.0
+
+# Symmetric activation/state ranges for --q8: cell input x, output y, c|C, n
+RANGE_NAMES = ("x", "y", "c", "n")
+
+# Weights quantized to INT8 in the Q8 block kinds (xlstm_block_q8.h)
+Q8_WEIGHTS = ("up_W", "down_W", "cell_W", "cell_R")
+
+
+# ============================================================================
+# Checkpoint loading
+# ============================================================================
+
+def _bf16_to_f32(raw):
+    return (raw.astype(np.uint32) << 16).view(np.float32)
+
+
+def load_safetensors(path):
+    """Load a .safetensors file as {name: float32 ndarray} (memory-mapped)."""
+    with open(path, "rb") as f:
+        (header_len,) = struct.unpack("<Q", f.read(8))
+        header = json.loads(f.read(header_len))
+    data = np.memmap(path, dtype=np.uint8, mode="r", offset=8 + header_len)
+    dtypes = {"F32": np.float32, "F16": np.float16, "F64": np.float64,
+              "BF16": np.uint16}
+    tensors = {}
+    for name, info in header.items():
+        if name == "__metadata__":
+            continue
+        if info["dtype"] not in dtypes:
+            raise ValueError(f"{name}: unsupported dtype {info['dtype']}")
+        begin, end = info["data_offsets"]
+        arr = data[begin:end].view(dtypes[info["dtype"]])
+        if info["dtype"] == "BF16":
+            arr = _bf16_to_f32(arr)
+        tensors[name] = arr.astype(np.float32).reshape(info["shape"])
+    return tensors
+
+
+def load_torch(path):
+    """Load a torch checkpoint as {name: float32 ndarray}."""
+    import torch  # only needed for .pt checkpoints
+
+    obj = torch.load(path, map_location="cpu", weights_only=True)
+    for key in ("state_dict", "model"):
+        if isinstance(obj, dict) and isinstance(obj.get(key), dict):
+            obj = obj[key]
+    return {k: v.detach().float().numpy() for k, v in obj.items()
+            if hasattr(v, "detach")}
+
+
+def load_checkpoint(path):
+    if path.endswith(".safetensors"):
+        return load_safetensors(path)
+    return load_torch(path)
+
+
+# ============================================================================
+# Block mapping
+# ============================================================================
+
+def headwise_dense(w):
+    """LinearHeadwiseExpand weight [NH, out, in] -> dense [NH*out, NH*in]."""
+    nh, dout, din = w.shape
+    dense = np.zeros((nh * dout, nh * din), dtype=np.float32)
+    for h in range(nh):
+        dense[h * dout:(h + 1) * dout, h * din:(h + 1) * din] = w[h]
+    return dense
+
+
+def norm_weight(w, residual):
+    return (1.0 + w if residual else w).astype(np.float32)
+
+
+def _opt(sd, key):
+    return sd[key].astype(np.float32) if key in sd else None
+
+
+def split_blocks(state_dict):
+    """Group keys as {block index: {suffix: tensor}}; report skipped keys."""
+    blocks, skipped = {}, []
+    pattern = re.compile(r"(?:^|\.)blocks\.(\d+)\.(.+)$")
+    for name, tensor in state_dict.items():
+        match = pattern.search(name)
+        if match:
+            blocks.setdefault(int(match.group(1)), {})[match.group(2)] = tensor
+        else:
+            skipped.append(name)
+    return [blocks[i] for i in sorted(blocks)], skipped
+
+
+def conv_tensors(sd, channels):
+    """Causal conv [C, 1, K] -> (conv_w [C, K], conv_b or None, K, present)."""
+    if "xlstm.conv1d.conv.weight" not in sd:
+        return np.zeros((channels, 1), np.float32), None, 1, False
+    w = sd["xlstm.conv1d.conv.weight"]
+    w = w.reshape(w.shape[0], w.shape[-1]).astype(np.float32)
+    return w, _opt(sd, "xlstm.conv1d.conv.bias"), w.shape[1], True
+
+
+def map_mlstm_block(sd, residual_norm=True):
+    """NX-AI mLSTMBlock -> XlstmMlstmBlock tensors and dims."""
+    up_W = sd["xlstm.proj_up.weight"].astype(np.float32)
+    D = up_W.shape[1]
+    H = up_W.shape[0] // 2
+    ig_w = sd["xlstm.mlstm_cell.igate.weight"]
+    if ig_w.shape[0] != 1:
+        raise ValueError(
+            f"mLSTM block has num_heads={ig_w.shape[0]}; the mLSTM kernel "
+            "keeps a single matrix memory, so only checkpoints trained with "
+            "mlstm_block.mlstm.num_heads=1 can be converted (headwise mLSTM "
+            "is not supported)")
+
+    Wq = headwise_dense(sd["xlstm.q_proj.weight"])
+    Wk = headwise_dense(sd["xlstm.k_proj.weight"])
+    Wv = headwise_dense(sd["xlstm.v_proj.weight"])
+    zeros = np.zeros(H, np.float32)
+    bq = _opt(sd, "xlstm.q_proj.bias")
+    bk = _opt(sd, "xlstm.k_proj.bias")
+    bv = _opt(sd, "xlstm.v_proj.bias")
+    bq, bk, bv = [zeros if b is None else b for b in (bq, bk, bv)]
+
+    # Cell input is [xc | xm]: q, k read the conv branch, v the raw branch
+    cell_W = np.zeros((4 * H + 2, 2 * H), np.float32)
+    cell_b = np.zeros(4 * H + 2, np.float32)
+    cell_W[0:H, 0:H] = Wq
+    cell_W[H:2 * H, 0:H] = Wk
+    cell_W[2 * H:3 * H, H:2 * H] = Wv
+    cell_b[0:3 * H] = np.concatenate([bq, bk, bv])
+
+    # i/f gates act on cat(q, k, v): fold them through the projections
+    for row, gate in ((3 * H, "igate"), (3 * H + 1, "fgate")):
+        g = sd[f"xlstm.mlstm_cell.{gate}.weight"][0].astype(np.float32)
+        gq, gk, gv = g[0:H], g[H:2 * H], g[2 * H:3 * H]
+        cell_W[row, 0:H] = gq @ Wq + gk @ Wk
+        cell_W[row, H:2 * H] = gv @ Wv
+        cell_b[row] = (sd[f"xlstm.mlstm_cell.{gate}.bias"][0]
+                       + gq @ bq + gk @ bk + gv @ bv)
+    cell_b[3 * H + 2:] = OGATE_OPEN
+
+    conv_w, conv_b, K, _ = conv_tensors(sd, H)
+    tensors = {
+        "ln_w": norm_weight(sd["xlstm_norm.weight"], residual_norm),
+        "ln_b": _opt(sd, "xlstm_norm.bias"),
+        "up_W": up_W,
+        "up_b": _opt(sd, "xlstm.proj_up.bias"),
+        "conv_w": conv_w,
+        "conv_b": conv_b,
+        "cell_W": cell_W,
+        "cell_b": cell_b,
+        "gn_w": norm_weight(sd["xlstm.mlstm_cell.outnorm.weight"], residual_norm),
+        "skip": sd["xlstm.learnable_skip"].astype(np.float32),
+        "down_W": sd["xlstm.proj_down.weight"].astype(np.float32),
+        "down_b": _opt(sd, "xlstm.proj_down.bias"),
+    }
+    return {"kind": KIND_MLSTM_BLOCK_F32, "dims": (D, H, K, 1),
+            "tensors": tensors}
+
+
+def map_slstm_block(sd, residual_norm=True):
+    """NX-AI sLSTMBlock (with its gated FFN) -> XlstmSlstmBlock tensors."""
+    if "ffn.proj_up.weight" not in sd:
+        raise ValueError("sLSTM block without feedforward is not supported")
+    Wz = sd["xlstm.zgate.weight"]
+    NH, DH = Wz.shape[0], Wz.shape[1]
+    D = NH * DH
+
+    conv_w, conv_b, K, has_conv = conv_tensors(sd, D)
+    # Cell input is [xc | xn]: i, f read the conv branch (the normed input
+    # itself when the block has no conv), z, o the raw branch
+    if_cols = slice(0, D) if has_conv else slice(D, 2 * D)
+    cell_W = np.zeros((4 * D, 2 * D), np.float32)
+    cell_W[0:D, if_cols] = headwise_dense(sd["xlstm.igate.weight"])
+    cell_W[D:2 * D, if_cols] = headwise_dense(sd["xlstm.fgate.weight"])
+    cell_W[2 * D:3 * D, D:2 * D] = headwise_dense(Wz)
+    cell_W[3 * D:4 * D, D:2 * D] = headwise_dense(sd["xlstm.ogate.weight"])
+
+    # Per-head recurrent kernel [NH, 4, DH, DH] and bias [NH, 4, DH] in
+    # gate-major cell order: row g*D + h*DH + j
+    rk = sd["xlstm.slstm_cell._recurrent_kernel_"].reshape(NH, 4, DH, DH)
+    bias = sd["xlstm.slstm_cell._bias_"].reshape(NH, 4, DH)
+    cell_R = np.zeros((4 * D, D), np.float32)
+    cell_b = np.zeros(4 * D, np.float32)
+    for h in range(NH):
+        for g in range(4):
+            rows = slice(g * D + h * DH, g * D + (h + 1) * DH)
+            cell_R[rows, h * DH:(h + 1) * DH] = rk[h, g]
+            cell_b[rows] = bias[h, g]
+
+    up_W = sd["ffn.proj_up.weight"].astype(np.float32)
+    F = up_W.shape[0] // 2
+    tensors = {
+        "ln_w": norm_weight(sd["xlstm_norm.weight"], residual_norm),
+        "ln_b": _opt(sd, "xlstm_norm.bias"),
+        "conv_w": conv_w,
+        "conv_b": conv_b,
+        "cell_W": cell_W,
+        "cell_R": cell_R,
+        "cell_b": cell_b,
+        "gn_w": norm_weight(sd["xlstm.group_norm.weight"], residual_norm),
+        "ln2_w": norm_weight(sd["ffn_norm.weight"], residual_norm),
+        "ln2_b": _opt(sd, "ffn_norm.bias"),
+        "up_W": up_W,
+        "up_b": _opt(sd, "ffn.proj_up.bias"),
+        "down_W": sd["ffn.proj_down.weight"].astype(np.float32),
+        "down_b": _opt(sd, "ffn.proj_down.bias"),
+    }
+    return {"kind": KIND_SLSTM_BLOCK_F32, "dims": (D, F, K, NH),
+            "tensors": tensors}
+
+
+def map_block(sd, residual_norm=True):
+    if "xlstm.mlstm_cell.igate.weight" in sd:
+        return map_mlstm_block(sd, residual_norm)
+    if "xlstm.slstm_cell._recurrent_kernel_" in sd:
+        return map_slstm_block(sd, residual_norm)
+    raise ValueError("block is neither an mLSTM nor an sLSTM block")
+
+
+# ============================================================================
+# Calibration — f32 forward of the packed blocks (mirrors xlstm_block.c)
+# ============================================================================
+
+def silu(x):
+    return x / (1.0 + np.exp(-x))
+
+
+def sigmoid(x):
+    return 1.0 / (1.0 + np.exp(-x))
+
+
+def log_sigmoid(x):
+    return -np.logaddexp(0.0, -x)
+
+
+def gelu(x):
+    from math import erf
+    return 0.5 * x * (1.0 + np.vectorize(erf)(x / np.sqrt(2.0)))
+
+
+def layer_norm(x, w, b=None):
+    y = (x - x.mean()) / np.sqrt(x.var() + 1e-5) * w
+    return y if b is None else y + b
+
+
+def group_norm(x, w, groups):
+    g = x.reshape(groups, -1)
+    g = (g - g.mean(axis=1, keepdims=True)) / np.sqrt(g.var(axis=1, keepdims=True) + 1e-5)
+    return g.reshape(-1) * w
+
+
+def causal_conv(history, x, w, b):
+    """history: previous conv inputs, oldest first; w: [C, K]."""
+    K = w.shape[1]
+    window = (history + [x])[-K:]
+    window = [np.zeros_like(x)] * (K - len(window)) + window
+    out = sum(w[:, j] * window[j] for j in range(K))
+    return out if b is None else out + b
+
+
+def mlstm_update(state, q, k, v, i_raw, f_raw):
+    """Stabilized mLSTM step without output gate -> (h, state)."""
+    C, n, m = state
+    k = k / np.sqrt(len(k))
+    lfm = log_sigmoid(f_raw) + m
+    m_new = max(lfm, i_raw)
+    f, i = np.exp(lfm - m_new), np.exp(i_raw - m_new)
+    C = f * C + i * np.outer(k, v)
+    n = f * n + i * k
+    h = (q @ C) / (max(abs(q @ n), np.exp(-m_new)) + 1e-6)
+    return h, (C, n, m_new)
+
+
+def slstm_update(state, raw):
+    """sLSTM pointwise step on [i, f, z, o] pre-activations -> (y, state)."""
+    y, c, n, m = state
+    i_raw, f_raw, z_raw, o_raw = np.split(raw, 4)
+    lfm = m + log_sigmoid(f_raw)
+    m_new = np.where(n == 0, i_raw, np.maximum(i_raw, lfm))
+    i = np.minimum(np.exp(i_raw - m_new), 1.0)
+    f = np.minimum(np.exp(lfm - m_new), 1.0)
+    c = f * c + i * np.tanh(z_raw)
+    n = f * n + i
+    y = sigmoid(o_raw) * c / np.maximum(n, 1e-6)
+    return y, (y, c, n, m_new)
+
+
+def _track(stats, name, value):
+    if stats is not None:
+        stats[name] = max(stats.get(name, 0.0), float(np.max(np.abs(value))))
+
+
+def mlstm_block_forward(t, dims, xs, stats=None):
+    """Packed mLSTM block over xs [T, D]; stats collects cell abs maxima."""
+    D, H, K, heads = dims
+    state = (np.zeros((H, H)), np.zeros(H), 0.0)
+    hist, outs = [], []
+    for x in xs:
+        xn = layer_norm(x, t["ln_w"], t.get("ln_b"))
+        up = t["up_W"] @ xn
+        if t.get("up_b") is not None:
+            up = up + t["up_b"]
+        xm, z = np.split(up, 2)
+        xc = silu(causal_conv(hist, xm, t["conv_w"], t.get("conv_b")))
+        hist.append(xm)
+        cell_in = np.concatenate([xc, xm])
+        pre = t["cell_W"] @ cell_in + t["cell_b"]
+        h, state = mlstm_update(state, pre[:H], pre[H:2 * H], pre[2 * H:3 * H],
+                                pre[3 * H], pre[3 * H + 1])
+        h = sigmoid(pre[3 * H + 2:]) * h
+        for name, value in (("x", cell_in), ("y", h), ("c", state[0]), ("n", state[1])):
+            _track(stats, name, value)
+        h = (group_norm(h, t["gn_w"], heads) + t["skip"] * xc) * silu(z)
+        out = t["down_W"] @ h
+        outs.append(x + (out if t.get("down_b") is None else out + t["down_b"]))
+    return np.array(outs)
+
+
+def slstm_block_forward(t, dims, xs, stats=None):
+    """Packed sLSTM block over xs [T, D]; stats collects cell abs maxima."""
+    D, F, K, heads = dims
+    state = (np.zeros(D), np.zeros(D), np.zeros(D), np.zeros(D))
+    hist, outs = [], []
+    for x in xs:
+        xn = layer_norm(x, t["ln_w"], t.get("ln_b"))
+        xc = silu(causal_conv(hist, xn, t["conv_w"], t.get("conv_b")))
+        hist.append(xn)
+        cell_in = np.concatenate([xc, xn])
+        pre = t["cell_W"] @ cell_in + t["cell_R"] @ state[0] + t["cell_b"]
+        y, state = slstm_update(state, pre)
+        for name, value in (("x", cell_in), ("y", y), ("c", state[1]), ("n", state[2])):
+            _track(stats, name, value)
+        r = x + group_norm(y, t["gn_w"], heads)
+        up = t["up_W"] @ layer_norm(r, t["ln2_w"], t.get("ln2_b"))
+        if t.get("up_b") is not None:
+            up = up + t["up_b"]
+        u, g = np.split(up, 2)
+        out = t["down_W"] @ (gelu(u) * g)
+        outs.append(r + (out if t.get("down_b") is None else out + t["down_b"]))
+    return np.array(outs)
+
+
+def calibrate(layers, xs, margin=1.25):
+    """Run xs [T, D] through the f32 stack; per-layer symmetric ranges."""
+    ranges = []
+    for layer in layers:
+        stats = {}
+        forward = (mlstm_block_forward if layer["kind"] == KIND_MLSTM_BLOCK_F32
+                   else slstm_block_forward)
+        xs = forward(layer["tensors"], layer["dims"], xs, stats)
+        ranges.append({k: max(v * margin, 1e-3) for k, v in stats.items()})
+    return ranges
+
+
+# ============================================================================
+# Quantization — symmetric per tensor, as in xlstm_quant.h
+# ============================================================================
+
+def quantize_symmetric(w, qmax, dtype):
+    max_abs = float(np.max(np.abs(w)))
+    scale = max_abs / qmax if max_abs > 0 else 1.0
+    q = np.clip(np.round(w / scale), -qmax, qmax).astype(dtype)
+    return q, scale
+
+
+def quantize_layer(layer, ranges):
+    """F32 block layer -> Q8 block layer (INT8 weights, INT32 cell bias)."""
+    t = dict(layer["tensors"])
+    scales = {}
+    for name in Q8_WEIGHTS:
+        if name in t:
+            t[name], scales[name] = quantize_symmetric(t[name], 127, np.int8)
+    quant = {
+        "x": (ranges["x"] / 127.0, 0),
+        "y": (ranges["y"] / 127.0, 0),
+        "c": (ranges["c"] / 32767.0, 0),
+        "n": (ranges["n"] / 32767.0, 0),
+    }
+    # Cell bias is stored at the input*weight scale (slstm_q8.c, mlstm_q8.c)
+    b_scale = scales["cell_W"] * quant["x"][0]
+    t["cell_b"] = np.clip(np.round(t["cell_b"] / b_scale),
+                          -2**31, 2**31 - 1).astype(np.int32)
+    kind = {KIND_MLSTM_BLOCK_F32: KIND_MLSTM_BLOCK_Q8,
+            KIND_SLSTM_BLOCK_F32: KIND_SLSTM_BLOCK_Q8}[layer["kind"]]
+    return {"kind": kind, "dims": layer["dims"], "tensors": t,
+            "scales": scales, "quant": quant}
+
+
+# ============================================================================
+# Writer — byte-compatible with xlstm_model_write
+# ============================================================================
+
+def align_up(v):
+    return (v + MODEL_ALIGN - 1) & ~(MODEL_ALIGN - 1)
+
+
+def serialize(layers, cell_clip=0.0):
+    """Serialize mapped layers into the model file format (bytes)."""
+    entries = []
+    for layer in layers:
+        for name, arr in layer["tensors"].items():
+            if arr is None:
+                continue
+            arr = np.ascontiguousarray(arr)
+            rows = arr.shape[0]
+            cols = int(np.prod(arr.shape[1:])) if arr.ndim > 1 else 1
+            entries.append((layer, name, arr, rows, cols))
+
+    layer_offset = HEADER.size
+    tensor_offset = layer_offset + len(layers) * LAYER.size
+    pos = tensor_offset + len(entries) * TENSOR.size
+    offsets = []
+    for _, _, arr, _, _ in entries:
+        pos = align_up(pos)
+        offsets.append(pos)
+        pos += arr.nbytes
+    total = align_up(pos)
+
+    out = bytearray(total)
+    HEADER.pack_into(out, 0, MODEL_MAGIC, MODEL_VERSION, 0, len(layers),
+                     len(entries), total, layer_offset, tensor_offset)
+
+    first = 0
+    for index, layer in enumerate(layers):
+        count = sum(1 for e in entries if e[0] is layer)
+        quant = layer.get("quant", {})
+        q = [quant.get(k, (0.0, 0)) for k in ("x", "y", "c", "n")]
+        dims = list(layer["dims"]) + [0] * (4 - len(layer["dims"]))
+        LAYER.pack_into(out, layer_offset + index * LAYER.size,
+                        layer["kind"], *dims, first, count, cell_clip,
+                        *[v for pair in q for v in pair])
+        first += count
+
+    for index, (layer, name, arr, rows, cols) in enumerate(entries):
+        scale = layer.get("scales", {}).get(name, 0.0)
+        TENSOR.pack_into(out, tensor_offset + index * TENSOR.size,
+                         ROLE[name], DTYPE_OF[arr.dtype], 0, rows, cols, 0,
+                         offsets[index], arr.nbytes, scale, 0)
+        out[offsets[index]:offsets[index] + arr.nbytes] = arr.tobytes()
+    return bytes(out)
+
+
+def read_model(buf):
+    """Parse a model file into [(kind, dims, quant, {role: (ndarray, scale)})]."""
+    magic, version, _, num_layers, num_tensors, total, loff, toff = \
+        HEADER.unpack_from(buf, 0)
+    if magic != MODEL_MAGIC or version != MODEL_VERSION:
+        raise ValueError("not an xlstm.c model file")
+    if total > len(buf):
+        raise ValueError("truncated model file")
+    np_dtype = {v: k for k, v in DTYPE_OF.items()}
+    role_name = {v: k for k, v in ROLE.items()}
+    tensors = []
+    for i in range(num_tensors):
+        role, dtype, _, rows, cols, _, offset, nbytes, scale, _ = \
+            TENSOR.unpack_from(buf, toff + i * TENSOR.size)
+        arr = np.frombuffer(buf, dtype=np_dtype[dtype], count=rows * cols,
+                            offset=offset).reshape(rows, cols)
+        tensors.append((role_name[role], arr, scale))
+    layers = []
+    for i in range(num_layers):
+        rec = LAYER.unpack_from(buf, loff + i * LAYER.size)
+        kind, dims, first, count = rec[0], rec[1:5], rec[5], rec[6]
+        q = rec[8:]
+        quant = {k: (q[2 * j], q[2 * j + 1])
+                 for j, k in enumerate(("x", "y", "c", "n"))}
+        named = {n: (a, s) for n, a, s in tensors[first:first + count]}
+        layers.append((kind, dims, quant, named))
+    return layers
+
+
+# ============================================================================
+# Main
+# ============================================================================
+
+def convert(state_dict, q8=False, calib=None, ranges=None, residual_norm=True):
+    """Map a state dict to layer dicts; returns (layers, skipped keys).
+
+    For q8, activation ranges come from running calib [T, D] through the
+    f32 blocks; entries of ranges (name -> abs max) override them."""
+    blocks, skipped = split_blocks(state_dict)
+    if not blocks:
+        raise ValueError("no xLSTM blocks found (expected '...blocks.<i>.' keys)")
+    layers = [map_block(sd, residual_norm) for sd in blocks]
+    if q8:
+        if calib is None:
+            calib = np.random.default_rng(0).standard_normal(
+                (64, layers[0]["dims"][0])).astype(np.float32)
+        measured = calibrate(layers, calib)
+        layers = [quantize_layer(layer, dict(m, **(ranges or {})))
+                  for layer, m in zip(layers, measured)]
+    return layers, skipped
+
+
+def parse_ranges(items):
+    ranges = {}
+    for item in items or []:
+        name, _, value = item.partition("=")
+        if name not in RANGE_NAMES or not value:
+            raise SystemExit(f"--range expects one of x,y,c,n as name=value, got {item!r}")
+        ranges[name] = float(value)
+    return ranges
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("checkpoint", help=".safetensors, .pt, .pth or .bin")
+    parser.add_argument("output", help="model file to write")
+    parser.add_argument("--q8", action="store_true",
+                        help="emit INT8 blocks (xlstm_block_q8.h)")
+    parser.add_argument("--calib", metavar="NPY",
+                        help="calibration inputs [T, embed_dim] (.npy) for "
+                             "--q8; default: 64 steps of unit Gaussian noise")
+    parser.add_argument("--range", action="append", metavar="NAME=VALUE",
+                        help="fix the abs range of cell x, y, c|C or n for "
+                             "--q8 instead of calibrating it")
+    parser.add_argument("--no-residual-norm", action="store_true",
+                        help="norm weights are stored as-is, not as 1 + w")
+    args = parser.parse_args()
+
+    state_dict = load_checkpoint(args.checkpoint)
+    calib = np.load(args.calib).astype(np.float32) if args.calib else None
+    layers, skipped = convert(state_dict, args.q8, calib,
+                              parse_ranges(args.range), not args.no_residual_norm)
+    for name in skipped:
+        print(f"  skipped {name} (no layer kind)", file=sys.stderr)
+
+    data = serialize(layers)
+    tmp = args.output + ".tmp"
+    with open(tmp, "wb") as f:
+        f.write(data)
+    os.replace(tmp, args.output)
+
+    kinds = {5: "mLSTM", 6: "sLSTM", 7: "mLSTM q8", 8: "sLSTM q8"}
+    for i, layer in enumerate(layers):
+        print(f"  block {i}: {kinds[layer['kind']]} dims={layer['dims']}")
+    print(f"Wrote {args.output} ({len(data)} bytes, {len(layers)} blocks)")
+
+
+if __name__ == "__main__":
+    main()